@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2021 Gunar Schorcht
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     cpu_esp32
+ * @{
+ *
+ * @file
+ * @brief       Start of the APP cpu as executor for offloaded jobs
+ *
+ * @author      Gunar Schorcht <gunar@schorcht.net>
+ * @}
+ */
+
+#ifdef MODULE_ESP_OFFLOAD
+
+#include "esp_attr.h"
+#include "irq.h"
+#include "irq_arch.h"
+#include "kernel_defines.h"
+#include "log.h"
+
+#include "rom/ets_sys.h"
+#include "soc/cpu.h"
+#include "soc/dport_reg.h"
+#include "xtensa/xtensa_api.h"
+
+#include "esp_offload.h"
+
+#define ENABLE_DEBUG 0
+#include "debug.h"
+
+extern uint8_t _init_start;
+extern void ets_set_appcpu_boot_addr(uint32_t);
+
+/* the APP cpu must not use the ROM stack, it is reused as heap */
+static uint8_t _app_cpu_stack[ESP_OFFLOAD_STACKSIZE] __attribute__((aligned(16)));
+
+void IRAM_ATTR esp_offload_notify_pro(void)
+{
+    DPORT_WRITE_PERI_REG(DPORT_CPU_INTR_FROM_CPU_1_REG, 1);
+}
+
+void IRAM_ATTR esp_offload_idle(void)
+{
+    /* the APP cpu has nothing else to do than polling the ring */
+}
+
+static void IRAM_ATTR _app_cpu_isr(void *arg)
+{
+    (void)arg;
+
+    irq_isr_enter();
+
+    /* clear the level interrupt before the ring is emptied, so that no
+     * notification gets lost */
+    DPORT_WRITE_PERI_REG(DPORT_CPU_INTR_FROM_CPU_1_REG, 0);
+    esp_offload_complete();
+
+    irq_isr_exit();
+}
+
+static void IRAM_ATTR _app_cpu_main(void)
+{
+    esp_offload_executor();
+}
+
+static NORETURN void IRAM_ATTR _call_start_cpu1(void)
+{
+    cpu_configure_region_protection();
+
+    /* use the exception vectors in IRAM, needed for window exceptions */
+    __asm__ volatile ("wsr %0, vecbase\n" :: "r"(&_init_start));
+
+    ets_set_appcpu_boot_addr(0);
+
+    /* switch to the own stack and call the executor, it never returns */
+    __asm__ volatile ("mov a1, %0\n"
+                      "callx4 %1\n"
+                      :: "r"(_app_cpu_stack + sizeof(_app_cpu_stack)),
+                         "r"(_app_cpu_main));
+    UNREACHABLE();
+}
+
+void esp_offload_app_cpu_start(void)
+{
+    /* route the notification from the APP cpu to the PRO cpu */
+    intr_matrix_set(PRO_CPU_NUM, ETS_FROM_CPU_INTR1_SOURCE, CPU_INUM_APP_CPU);
+    xt_set_interrupt_handler(CPU_INUM_APP_CPU, _app_cpu_isr, NULL);
+    xt_ints_on(BIT(CPU_INUM_APP_CPU));
+
+    /* enable the APP cpu, the ROM code waits for the boot address */
+    DPORT_SET_PERI_REG_MASK(DPORT_APPCPU_CTRL_B_REG, DPORT_APPCPU_CLKGATE_EN);
+    DPORT_CLEAR_PERI_REG_MASK(DPORT_APPCPU_CTRL_C_REG, DPORT_APPCPU_RUNSTALL);
+    DPORT_SET_PERI_REG_MASK(DPORT_APPCPU_CTRL_A_REG, DPORT_APPCPU_RESETTING);
+    DPORT_CLEAR_PERI_REG_MASK(DPORT_APPCPU_CTRL_A_REG, DPORT_APPCPU_RESETTING);
+    ets_set_appcpu_boot_addr((uint32_t)_call_start_cpu1);
+
+    LOG_INFO("APP cpu started as executor for offloaded jobs\n");
+}
+
+#endif /* MODULE_ESP_OFFLOAD */
@@ -36,6 +36,7 @@
 
 #include "esp_common.h"
 #include "esp_attr.h"
+#include "esp_event_dispatch.h"
 #include "irq_arch.h"
 
 #include "esp_eth_params.h"
@@ -346,38 +347,43 @@ static void _esp_eth_isr(netdev_t *netdev)
     return;
 }
 
-static esp_err_t IRAM_ATTR _esp_system_event_handler(void *ctx, system_event_t *event)
+/*
+ * Handlers for esp system events. Changes of the link state are handled
+ * directly in the context of the ESP event task.
+ */
+static void IRAM_ATTR _esp_eth_link_changed(esp_event_sub_t *sub, unsigned id,
+                                            const void *info)
 {
-    switch(event->event_id) {
-        case SYSTEM_EVENT_ETH_START:
-            DEBUG("%s: Ethernet started\n", __func__);
-            break;
-        case SYSTEM_EVENT_ETH_STOP:
-            DEBUG("%s: Ethernet started\n", __func__);
-            break;
-        case SYSTEM_EVENT_ETH_CONNECTED:
-            DEBUG("%s Ethernet link up\n", __func__);
-            _esp_eth_dev.link_up = true;
-            if (SYSTEM_EVENT_MAX) {
-                _esp_eth_dev.event = SYSTEM_EVENT_ETH_CONNECTED;
-                netdev_trigger_event_isr(&_esp_eth_dev.netdev);
-            }
-            break;
-        case SYSTEM_EVENT_ETH_DISCONNECTED:
-            DEBUG("%s: Ethernet link up\n", __func__);
-            _esp_eth_dev.link_up = false;
-            if (SYSTEM_EVENT_MAX) {
-                _esp_eth_dev.event = SYSTEM_EVENT_ETH_DISCONNECTED;
-                netdev_trigger_event_isr(&_esp_eth_dev.netdev);
-            }
-            break;
-        default:
-            DEBUG("%s: event=%d\n", __func__, event->event_id);
-            break;
-    }
-    return ESP_OK;
+    (void)sub;
+    (void)info;
+
+    DEBUG("%s: Ethernet link %s\n", __func__,
+          (id == SYSTEM_EVENT_ETH_CONNECTED) ? "up" : "down");
+
+    _esp_eth_dev.link_up = (id == SYSTEM_EVENT_ETH_CONNECTED);
+    _esp_eth_dev.event = id;
+    netdev_trigger_event_isr(&_esp_eth_dev.netdev);
+}
+
+static void _esp_eth_started(esp_event_sub_t *sub, unsigned id,
+                             const void *info)
+{
+    (void)sub;
+    (void)info;
+
+    DEBUG("%s: Ethernet %s\n", __func__,
+          (id == SYSTEM_EVENT_ETH_START) ? "started" : "stopped");
 }
 
+static esp_event_sub_t _esp_eth_subs[] = {
+    { .id = SYSTEM_EVENT_ETH_START, .handler = _esp_eth_started,
+      .deferred = true },
+    { .id = SYSTEM_EVENT_ETH_STOP, .handler = _esp_eth_started,
+      .deferred = true },
+    { .id = SYSTEM_EVENT_ETH_CONNECTED, .handler = _esp_eth_link_changed },
+    { .id = SYSTEM_EVENT_ETH_DISCONNECTED, .handler = _esp_eth_link_changed },
+};
+
 static const netdev_driver_t _esp_eth_driver =
 {
     .send = _esp_eth_send,
@@ -388,9 +394,6 @@ static const netdev_driver_t _esp_eth_driver =
     .set = _esp_eth_set,
 };
 
-extern esp_err_t esp_system_event_add_handler (system_event_cb_t handler,
-                                               void *arg);
-
 void esp_eth_setup(esp_eth_netdev_t* dev)
 {
     (void)dev;
@@ -400,8 +403,10 @@ void esp_eth_setup(esp_eth_netdev_t* dev)
     /* initialize locking */
     mutex_init(&_esp_eth_dev.dev_lock);
 
-    /* init esp system event loop */
-    esp_system_event_add_handler(_esp_system_event_handler, NULL);
+    /* subscribe the handlers for the system events */
+    for (unsigned i = 0; i < ARRAY_SIZE(_esp_eth_subs); i++) {
+        esp_event_subscribe(&_esp_eth_subs[i]);
+    }
 
     /* set the netdev driver */
     _esp_eth_dev.netdev.driver = &_esp_eth_driver;
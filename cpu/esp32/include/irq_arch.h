@@ -38,6 +38,7 @@ extern "C" {
  */
 #define CPU_INUM_GPIO       2   /**< Level interrupt with low priority 1 */
 #define CPU_INUM_CAN        3   /**< Level interrupt with low priority 1 */
+#define CPU_INUM_APP_CPU    4   /**< Level interrupt with low priority 1 */
 #define CPU_INUM_UART       5   /**< Level interrupt with low priority 1 */
 #define CPU_INUM_RTC        9   /**< Level interrupt with low priority 1 */
 #define CPU_INUM_I2C        12  /**< Level interrupt with low priority 1 */
@@ -362,6 +362,12 @@ static NORETURN void IRAM system_init (void)
     xt_set_interrupt_handler(CPU_INUM_SOFTWARE, thread_yield_isr, NULL);
     xt_ints_on(BIT(CPU_INUM_SOFTWARE));
 
+#ifdef MODULE_ESP_OFFLOAD
+    /* start the APP cpu as executor for offloaded jobs */
+    extern void esp_offload_app_cpu_start(void);
+    esp_offload_app_cpu_start();
+#endif
+
     /* initialize ESP system event loop */
     extern void esp_event_handler_init(void);
     esp_event_handler_init();
@@ -28,6 +28,7 @@
 
 #include "esp_common.h"
 #include "esp_attr.h"
+#include "esp_event_dispatch.h"
 #include "esp_event_loop.h"
 #include "esp_now.h"
 #include "esp_system.h"
@@ -67,7 +68,8 @@ static const netdev_driver_t _esp_now_driver;
 
 static bool _esp_now_add_peer(const uint8_t* bssid, uint8_t channel, const uint8_t* key)
 {
-    if (esp_now_is_peer_exist(bssid)) {
+    /* all peers are added here, so the hashed table knows them all */
+    if (esp_now_peer_find(&_esp_now_dev.peers, bssid)) {
         return false;
     }
 
@@ -86,6 +88,9 @@ static bool _esp_now_add_peer(const uint8_t* bssid, uint8_t channel, const uint8
     DEBUG("esp_now_add_peer node %02x:%02x:%02x:%02x:%02x:%02x "
           "added with return value %d\n",
           bssid[0], bssid[1], bssid[2], bssid[3], bssid[4], bssid[5], ret);
+    if (ret == ESP_OK || ret == ESP_ERR_ESPNOW_EXIST) {
+        esp_now_peer_add(&_esp_now_dev.peers, bssid);
+    }
     return (ret == ESP_OK);
 }
 
@@ -222,32 +227,34 @@ static IRAM_ATTR void esp_now_recv_cb(const uint8_t *mac, const uint8_t *data, i
     }
     _in_recv_cb = true;
 
+    if ((len < 0) || (len > ESP_NOW_RX_FRAME_MAX_LEN)) {
+        DEBUG("%s: invalid frame length %d\n", __func__, len);
+        _in_recv_cb = false;
+        return;
+    }
+
     /*
-     * Since it is not possible to reenter the function `esp_now_recv_cb`, and
-     * the functions netif::_ recv and esp_now_netdev::_ recv are called
-     * directly in the same thread context, neither a mutual exclusion has to
-     * be realized nor have the interrupts to be deactivated.
-     * Therefore we can read directly from the `buf` and don't need a receive
-     * buffer.
+     * The data is only valid during the callback, so the frame is copied into
+     * the RX queue. If the queue is full, the frame is dropped and the drop
+     * is counted for the sender.
      */
-    if (_esp_now_dev.rx_len) {
-        DEBUG("%s: buffer full, dropping incoming packet of %d bytes\n", __func__, len);
+    if (!esp_now_rx_queue_put(&_esp_now_dev.rx_queue, &_esp_now_dev.peers,
+                              mac, data, len)) {
         _in_recv_cb = false;
         return;
     }
 
-    _esp_now_dev.rx_mac = (uint8_t*)mac;
-    _esp_now_dev.rx_data = (uint8_t*)data;
-    _esp_now_dev.rx_len = len;
-
     /*
-     * Since we are not in the interrupt context, we do not have to pass
-     * `NETDEV_EVENT_ISR` first. We can call the receive function directly.
+     * The queued frames are delivered in the context of the netdev thread.
+     * Because this function is not executed in interrupt context, the
+     * event message could block if frames are coming in faster than the
+     * events can be handled. To avoid blocking, we pretend we are in an ISR
+     * by incrementing the IRQ nesting counter, so that the non-blocking
+     * version of msg_send is used.
      */
-    if (_esp_now_dev.netdev.event_callback) {
-        _esp_now_dev.netdev.event_callback((netdev_t*)&_esp_now_dev,
-                                           NETDEV_EVENT_RX_COMPLETE);
-    }
+    irq_interrupt_nesting++;
+    netdev_trigger_event_isr(&_esp_now_dev.netdev);
+    irq_interrupt_nesting--;
 
     _in_recv_cb = false;
 }
@@ -266,28 +273,38 @@ static void IRAM_ATTR esp_now_send_cb(const uint8_t *mac, esp_now_send_status_t
 }
 
 /*
- * Event handler for esp system events.
+ * Handlers for esp system events. Evaluating the scan results locks the
+ * device, so the handlers are deferred to not block the ESP event task.
  */
-static esp_err_t IRAM_ATTR _esp_system_event_handler(void *ctx, system_event_t *event)
+static void _esp_now_sta_start(esp_event_sub_t *sub, unsigned id,
+                               const void *info)
 {
-    switch(event->event_id) {
-        case SYSTEM_EVENT_STA_START:
-            DEBUG("%s WiFi started\n", __func__);
-            break;
-        case SYSTEM_EVENT_SCAN_DONE:
-            DEBUG("%s WiFi scan done\n", __func__);
+    (void)sub;
+    (void)id;
+    (void)info;
+
+    DEBUG("%s WiFi started\n", __func__);
+}
+
+static void _esp_now_scan_done(esp_event_sub_t *sub, unsigned id,
+                               const void *info)
+{
+    (void)sub;
+    (void)id;
+    (void)info;
+
+    DEBUG("%s WiFi scan done\n", __func__);
 #if ESP_NOW_UNICAST
-            esp_now_scan_peers_done();
+    esp_now_scan_peers_done();
 #endif /* ESP_NOW_UNICAST */
-            break;
-        default:
-            break;
-    }
-    return ESP_OK;
 }
 
-extern esp_err_t esp_system_event_add_handler(system_event_cb_t handler,
-                                              void *arg);
+static esp_event_sub_t _esp_now_subs[] = {
+    { .id = SYSTEM_EVENT_STA_START, .handler = _esp_now_sta_start,
+      .deferred = true },
+    { .id = SYSTEM_EVENT_SCAN_DONE, .handler = _esp_now_scan_done,
+      .deferred = true },
+};
 
 /* ESP-NOW SoftAP configuration */
 static wifi_config_t wifi_config_ap = {};
@@ -303,11 +320,14 @@ esp_now_netdev_t *netdev_esp_now_setup(void)
         return dev;
     }
 
-    /* initialize buffer */
-    dev->rx_len = 0;
+    /* initialize RX queue and peer table */
+    esp_now_rx_queue_init(&dev->rx_queue);
+    esp_now_peer_table_init(&dev->peers);
 
-    /* set the event handler */
-    esp_system_event_add_handler(_esp_system_event_handler, NULL);
+    /* subscribe the handlers for the system events */
+    for (unsigned i = 0; i < ARRAY_SIZE(_esp_now_subs); i++) {
+        esp_event_subscribe(&_esp_now_subs[i]);
+    }
 
 #ifdef MCU_ESP32
     /* init the WiFi driver */
@@ -577,30 +597,12 @@ static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
     esp_now_netdev_t* dev = (esp_now_netdev_t*)netdev;
 
     /* we store source mac address and received data in `buf` */
-    uint16_t size = dev->rx_len ? ESP_NOW_ADDR_LEN + dev->rx_len : 0;
+    int size = esp_now_rx_queue_recv(&dev->rx_queue, buf, len);
 
-    if (!buf) {
-        /* get the size of the frame */
-        if (len > 0 && size) {
-            /* if len > 0, drop the frame */
-            dev->rx_len = 0;
-        }
+    if (!buf || size <= 0) {
         return size;
     }
 
-    if (len < size) {
-        /* buffer is smaller than the number of received bytes */
-        DEBUG("[esp_now] No space in receive buffers\n");
-        /* newest API requires to drop the frame in that case */
-        dev->rx_len = 0;
-        return -ENOBUFS;
-    }
-
-    /* copy the buffer */
-    memcpy(buf, dev->rx_mac, ESP_NOW_ADDR_LEN);
-    memcpy((char *)buf + ESP_NOW_ADDR_LEN, dev->rx_data, dev->rx_len);
-    dev->rx_len = 0;
-
     uint8_t *mac = buf;
     DEBUG("%s: received %d byte from %02x:%02x:%02x:%02x:%02x:%02x\n",
           __func__, size - ESP_NOW_ADDR_LEN,
@@ -610,7 +612,7 @@ static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
 #endif
 
 #if ESP_NOW_UNICAST
-    if (esp_now_is_peer_exist(mac) <= 0) {
+    if (!esp_now_peer_find(&dev->peers, mac)) {
         _esp_now_add_peer(mac, esp_now_params.channel, esp_now_params.key);
     }
 #endif
@@ -726,15 +728,27 @@ static void _isr(netdev_t *netdev)
     esp_now_netdev_t *dev = (esp_now_netdev_t*)netdev;
 
     critical_enter();
-
-    if (dev->scan_event) {
+    bool scan = dev->scan_event;
+    if (scan) {
         dev->scan_event--;
-        critical_exit();
+    }
+    critical_exit();
+
 #if ESP_NOW_UNICAST
+    if (scan) {
         esp_now_scan_peers_start();
+    }
 #endif
+
+    /*
+     * Deliver all frames queued so far in one go, the events triggered for
+     * the frames that follow the first one then find the queue empty. The
+     * number of frames is taken in advance so that a burst that keeps coming
+     * in does not starve the thread.
+     */
+    for (unsigned n = esp_now_rx_queue_pending(&dev->rx_queue); n; n--) {
+        dev->netdev.event_callback(netdev, NETDEV_EVENT_RX_COMPLETE);
     }
-    return;
 }
 
 static const netdev_driver_t _esp_now_driver =
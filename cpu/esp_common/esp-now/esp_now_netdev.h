@@ -23,6 +23,7 @@
 #include "net/netdev.h"
 #include "mutex.h"
 #include "net/ethernet/hdr.h"
+#include "esp_now_rx_queue.h"
 #ifdef MODULE_GNRC
 #include "net/gnrc/nettype.h"
 #endif
@@ -87,9 +88,8 @@ typedef struct
 
     uint8_t addr[ESP_NOW_ADDR_LEN];  /**< device addr (MAC address) */
 
-    uint8_t rx_len;                  /**< number of bytes received */
-    uint8_t* rx_mac;                 /**< source mac of received data */
-    uint8_t* rx_data;                /**< received */
+    esp_now_rx_queue_t rx_queue;     /**< received frames */
+    esp_now_peer_table_t peers;      /**< known peers */
 
     uint8_t tx_mem[ESP_NOW_MAX_SIZE_RAW]; /**< memory holding outgoing package */
 
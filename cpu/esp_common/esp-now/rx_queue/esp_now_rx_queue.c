@@ -0,0 +1,183 @@
+/*
+ * Copyright (C) 2021 Gunar Schorcht
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     cpu_esp_common_esp_now
+ * @{
+ *
+ * @file
+ * @brief       RX frame queue and peer table of the ESP-NOW netdev
+ *
+ * @author      Gunar Schorcht <gunar@schorcht.net>
+ * @}
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <string.h>
+
+#include "irq.h"
+#include "esp_now_rx_queue.h"
+
+#define ENABLE_DEBUG    0
+#include "debug.h"
+
+#define RX_QUEUE_MASK   (ESP_NOW_RX_QUEUE_LEN - 1)
+#define PEER_MASK       (ESP_NOW_PEER_TABLE_SIZE - 1)
+
+void esp_now_rx_queue_init(esp_now_rx_queue_t *queue)
+{
+    assert(queue != NULL);
+    memset(queue, 0, sizeof(*queue));
+}
+
+bool esp_now_rx_queue_put(esp_now_rx_queue_t *queue,
+                          esp_now_peer_table_t *peers,
+                          const uint8_t *mac, const uint8_t *data, size_t len)
+{
+    assert(queue != NULL);
+    assert(mac != NULL);
+    assert(data != NULL || len == 0);
+    assert(len <= ESP_NOW_RX_FRAME_MAX_LEN);
+
+    /* only the producer changes head, so it can be read without locking */
+    uint8_t head = queue->head;
+
+    if ((uint8_t)(head - queue->tail) == ESP_NOW_RX_QUEUE_LEN) {
+        DEBUG("[esp_now] %s: queue full, dropping frame of %u byte\n",
+              __func__, (unsigned)len);
+        queue->dropped++;
+        esp_now_peer_t *peer = peers ? esp_now_peer_find(peers, mac) : NULL;
+        if (peer) {
+            peer->rx_dropped++;
+        }
+        return false;
+    }
+
+    esp_now_rx_frame_t *frame = &queue->frames[head & RX_QUEUE_MASK];
+    memcpy(frame->mac, mac, ESP_NOW_RX_ADDR_LEN);
+    memcpy(frame->data, data, len);
+    frame->len = len;
+
+    /* publish the frame only after it was written completely, irq_disable
+     * also keeps the compiler from reordering the stores */
+    unsigned state = irq_disable();
+    queue->head = head + 1;
+    irq_restore(state);
+
+    return true;
+}
+
+static void _pop(esp_now_rx_queue_t *queue)
+{
+    unsigned state = irq_disable();
+    queue->tail++;
+    irq_restore(state);
+}
+
+int esp_now_rx_queue_recv(esp_now_rx_queue_t *queue, void *buf, size_t len)
+{
+    assert(queue != NULL);
+
+    /* only the consumer changes tail, so it can be read without locking */
+    uint8_t tail = queue->tail;
+
+    if (queue->head == tail) {
+        return 0;
+    }
+
+    esp_now_rx_frame_t *frame = &queue->frames[tail & RX_QUEUE_MASK];
+    int size = ESP_NOW_RX_ADDR_LEN + frame->len;
+
+    if (!buf) {
+        /* if len > 0, drop the frame */
+        if (len > 0) {
+            _pop(queue);
+        }
+        return size;
+    }
+
+    if (len < (size_t)size) {
+        DEBUG("[esp_now] %s: not enough space in receive buffer\n", __func__);
+        /* newest API requires to drop the frame in that case */
+        _pop(queue);
+        return -ENOBUFS;
+    }
+
+    memcpy(buf, frame->mac, ESP_NOW_RX_ADDR_LEN);
+    memcpy((uint8_t *)buf + ESP_NOW_RX_ADDR_LEN, frame->data, frame->len);
+    _pop(queue);
+
+    return size;
+}
+
+void esp_now_peer_table_init(esp_now_peer_table_t *peers)
+{
+    assert(peers != NULL);
+    memset(peers, 0, sizeof(*peers));
+}
+
+/* FNV-1a, the vendor specific first half of the addresses of a network is
+ * usually the same, so all bytes are mixed in */
+static unsigned _hash(const uint8_t *mac)
+{
+    uint32_t h = 2166136261U;
+
+    for (unsigned i = 0; i < ESP_NOW_RX_ADDR_LEN; i++) {
+        h = (h ^ mac[i]) * 16777619U;
+    }
+    return h;
+}
+
+esp_now_peer_t *esp_now_peer_find(esp_now_peer_table_t *peers,
+                                  const uint8_t *mac)
+{
+    assert(peers != NULL);
+    assert(mac != NULL);
+
+    unsigned idx = _hash(mac);
+
+    /* peers are never removed, so the first unused slot ends the probe */
+    for (unsigned i = 0; i < ESP_NOW_PEER_TABLE_SIZE; i++) {
+        esp_now_peer_t *peer = &peers->slots[(idx + i) & PEER_MASK];
+        if (!peer->used) {
+            return NULL;
+        }
+        if (memcmp(peer->mac, mac, ESP_NOW_RX_ADDR_LEN) == 0) {
+            return peer;
+        }
+    }
+    return NULL;
+}
+
+esp_now_peer_t *esp_now_peer_add(esp_now_peer_table_t *peers,
+                                 const uint8_t *mac)
+{
+    assert(peers != NULL);
+    assert(mac != NULL);
+
+    unsigned idx = _hash(mac);
+
+    for (unsigned i = 0; i < ESP_NOW_PEER_TABLE_SIZE; i++) {
+        esp_now_peer_t *peer = &peers->slots[(idx + i) & PEER_MASK];
+        if (!peer->used) {
+            memcpy(peer->mac, mac, ESP_NOW_RX_ADDR_LEN);
+            peer->rx_dropped = 0;
+            /* make the entry visible to lookups only when it is complete */
+            unsigned state = irq_disable();
+            peer->used = true;
+            irq_restore(state);
+            peers->numof++;
+            return peer;
+        }
+        if (memcmp(peer->mac, mac, ESP_NOW_RX_ADDR_LEN) == 0) {
+            return peer;
+        }
+    }
+    return NULL;
+}
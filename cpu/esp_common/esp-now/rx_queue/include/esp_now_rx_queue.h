@@ -0,0 +1,216 @@
+/*
+ * Copyright (C) 2021 Gunar Schorcht
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     cpu_esp_common_esp_now
+ * @{
+ *
+ * @file
+ * @brief       RX frame queue and peer table of the ESP-NOW netdev
+ *
+ * The ESP-NOW receive callback is executed in the context of the `wifi`
+ * thread and the received data is only valid during the callback. The queue
+ * takes a copy of each frame so that a burst of frames can be delivered to
+ * the network stack later on in one go.
+ *
+ * The peer table mirrors the peers registered with the ESP-NOW library. It
+ * is an open addressing hash table over the MAC addresses, so looking up
+ * the sender of each received frame does not scan the peer list. It also
+ * keeps per-peer counters of frames dropped because the queue was full.
+ *
+ * Neither depends on the ESP SDK, so they can be tested on any platform.
+ *
+ * @author      Gunar Schorcht <gunar@schorcht.net>
+ */
+
+#ifndef ESP_NOW_RX_QUEUE_H
+#define ESP_NOW_RX_QUEUE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Number of received frames that can be queued
+ *
+ * The number has to be a power of two.
+ */
+#ifndef ESP_NOW_RX_QUEUE_LEN
+#define ESP_NOW_RX_QUEUE_LEN        (4)
+#endif
+
+/**
+ * @brief   Number of slots in the peer table
+ *
+ * The number has to be a power of two. It should be well above the maximum
+ * number of peers of the ESP-NOW library (20) to keep probe sequences short.
+ */
+#ifndef ESP_NOW_PEER_TABLE_SIZE
+#define ESP_NOW_PEER_TABLE_SIZE     (32)
+#endif
+
+/**
+ * @brief   Maximum length of ESP-NOW frame data
+ */
+#define ESP_NOW_RX_FRAME_MAX_LEN    (250)
+
+/**
+ * @brief   Length of ESP-NOW addresses
+ */
+#define ESP_NOW_RX_ADDR_LEN         (6)
+
+#if (ESP_NOW_RX_QUEUE_LEN & (ESP_NOW_RX_QUEUE_LEN - 1)) || \
+    (ESP_NOW_RX_QUEUE_LEN > 128)
+#error "ESP_NOW_RX_QUEUE_LEN has to be a power of two not greater than 128"
+#endif
+
+#if (ESP_NOW_PEER_TABLE_SIZE & (ESP_NOW_PEER_TABLE_SIZE - 1))
+#error "ESP_NOW_PEER_TABLE_SIZE has to be a power of two"
+#endif
+
+/**
+ * @brief   Received frame
+ */
+typedef struct {
+    uint8_t mac[ESP_NOW_RX_ADDR_LEN];       /**< source address */
+    uint8_t len;                            /**< length of data */
+    uint8_t data[ESP_NOW_RX_FRAME_MAX_LEN]; /**< frame data */
+} esp_now_rx_frame_t;
+
+/**
+ * @brief   Peer table entry
+ */
+typedef struct {
+    uint8_t mac[ESP_NOW_RX_ADDR_LEN];       /**< address of the peer */
+    volatile bool used;                     /**< entry is in use */
+    uint32_t rx_dropped;                    /**< frames of the peer dropped */
+} esp_now_peer_t;
+
+/**
+ * @brief   Peer table
+ */
+typedef struct {
+    esp_now_peer_t slots[ESP_NOW_PEER_TABLE_SIZE];  /**< hash table */
+    unsigned numof;                                 /**< number of peers */
+} esp_now_peer_table_t;
+
+/**
+ * @brief   RX frame queue
+ *
+ * There is one producer, the ESP-NOW receive callback, and one consumer,
+ * the netdev `recv` function.
+ */
+typedef struct {
+    esp_now_rx_frame_t frames[ESP_NOW_RX_QUEUE_LEN]; /**< queued frames */
+    volatile uint8_t head;  /**< number of queued frames, wraps around */
+    volatile uint8_t tail;  /**< number of consumed frames, wraps around */
+    uint32_t dropped;       /**< frames dropped because the queue was full */
+} esp_now_rx_queue_t;
+
+/**
+ * @brief   Initialize an empty RX frame queue
+ *
+ * @param[out]  queue   RX frame queue
+ */
+void esp_now_rx_queue_init(esp_now_rx_queue_t *queue);
+
+/**
+ * @brief   Copy a received frame into the queue
+ *
+ * If the queue is full, the frame is dropped. The drop is counted in the
+ * queue and, if @p peers is given and knows the sender, for the sender.
+ *
+ * @param[in]   queue   RX frame queue
+ * @param[in]   peers   peer table for drop accounting, may be NULL
+ * @param[in]   mac     source address
+ * @param[in]   data    frame data
+ * @param[in]   len     length of @p data, at most ESP_NOW_RX_FRAME_MAX_LEN
+ *
+ * @return  true if the frame was queued
+ * @return  false if the frame was dropped
+ */
+bool esp_now_rx_queue_put(esp_now_rx_queue_t *queue,
+                          esp_now_peer_table_t *peers,
+                          const uint8_t *mac, const uint8_t *data, size_t len);
+
+/**
+ * @brief   Read the oldest queued frame with the semantics of the netdev
+ *          `recv` function
+ *
+ * The frame is stored as source address followed by the frame data.
+ *
+ * - With @p buf NULL and @p len 0, the size of the frame is returned.
+ * - With @p buf NULL and @p len > 0, the frame is dropped and its size is
+ *   returned.
+ * - Otherwise the frame is copied to @p buf. If @p len is too small, the
+ *   frame is dropped and -ENOBUFS is returned.
+ *
+ * @param[in]   queue   RX frame queue
+ * @param[out]  buf     buffer to copy the frame to, may be NULL
+ * @param[in]   len     size of @p buf
+ *
+ * @return  size of the frame including the source address, 0 if no frame
+ *          is queued
+ * @return  -ENOBUFS if @p buf is too small
+ */
+int esp_now_rx_queue_recv(esp_now_rx_queue_t *queue, void *buf, size_t len);
+
+/**
+ * @brief   Get the number of queued frames
+ *
+ * @param[in]   queue   RX frame queue
+ *
+ * @return  number of queued frames
+ */
+static inline unsigned esp_now_rx_queue_pending(const esp_now_rx_queue_t *queue)
+{
+    return (uint8_t)(queue->head - queue->tail);
+}
+
+/**
+ * @brief   Initialize an empty peer table
+ *
+ * @param[out]  peers   peer table
+ */
+void esp_now_peer_table_init(esp_now_peer_table_t *peers);
+
+/**
+ * @brief   Look up a peer
+ *
+ * @param[in]   peers   peer table
+ * @param[in]   mac     address of the peer
+ *
+ * @return  the peer, NULL if it is not in the table
+ */
+esp_now_peer_t *esp_now_peer_find(esp_now_peer_table_t *peers,
+                                  const uint8_t *mac);
+
+/**
+ * @brief   Add a peer
+ *
+ * The producer may look up peers concurrently, the table must not be
+ * changed from more than one thread though.
+ *
+ * @param[in]   peers   peer table
+ * @param[in]   mac     address of the peer
+ *
+ * @return  the new or already existing peer, NULL if the table is full
+ */
+esp_now_peer_t *esp_now_peer_add(esp_now_peer_table_t *peers,
+                                 const uint8_t *mac);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ESP_NOW_RX_QUEUE_H */
+/** @} */
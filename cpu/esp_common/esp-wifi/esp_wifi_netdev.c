@@ -21,6 +21,7 @@
 #include <string.h>
 #include <assert.h>
 #include <errno.h>
+#include <inttypes.h>
 
 #include "net/ethernet.h"
 #include "net/netdev/eth.h"
@@ -29,7 +30,9 @@
 
 #include "esp_common.h"
 #include "esp_attr.h"
+#include "esp_event_dispatch.h"
 #include "esp_event_loop.h"
+#include "esp_events.h"
 #ifndef MODULE_ESP_WIFI_AP
 #include "esp_now.h"
 #endif
@@ -111,11 +114,10 @@ static const netdev_driver_t _esp_wifi_driver;
 /** guard variable to avoid reentrance to _esp_wifi_send function */
 static bool _esp_wifi_send_is_in = false;
 
+#ifndef MODULE_ESP_WIFI_RX_DESC
 /** guard variable to to decive when receive buffer can be overwritten */
 static bool _esp_wifi_rx_in_progress = false;
-
-extern esp_err_t esp_system_event_add_handler (system_event_cb_t handler,
-                                               void *arg);
+#endif
 
 #ifdef MCU_ESP8266
 
@@ -328,6 +330,17 @@ esp_err_t _esp_wifi_rx_cb(void *buffer, uint16_t len, void *eb)
 
     ESP_WIFI_DEBUG("buf=%p len=%d eb=%p", buffer, len, eb);
 
+#ifdef MODULE_ESP_WIFI_RX_DESC
+    /*
+     * Only a descriptor is queued, the WiFi driver buffer is freed when the
+     * frame is read. If the ring is full, the frame is dropped and the buffer
+     * is freed immediately.
+     */
+    if (!esp_wifi_rx_desc_put(&_esp_wifi_dev.rx_desc, buffer, len, eb)) {
+        critical_exit();
+        return ESP_OK;
+    }
+#else /* MODULE_ESP_WIFI_RX_DESC */
     /*
      * The ring buffer uses two bytes for the pkt length, followed by the
      * actual packet data.
@@ -354,6 +367,7 @@ esp_err_t _esp_wifi_rx_cb(void *buffer, uint16_t len, void *eb)
     if (eb) {
         esp_wifi_internal_free_rx_buffer(eb);
     }
+#endif /* MODULE_ESP_WIFI_RX_DESC */
 
     /*
      * Because this function is not executed in interrupt context but in thread
@@ -421,135 +435,219 @@ static unsigned _esp_wifi_started = 0;
 static unsigned _esp_wifi_channel = 0;
 
 /*
- * Event handler for esp system events.
+ * Handlers for esp system events. They are subscribed per event ID, see
+ * _esp_wifi_subs. Handlers that change the connection state are called
+ * directly in the context of the ESP event task, handlers that only log
+ * are deferred.
+ */
+/*
+ * Frames that are still queued when the interface is stopped or disconnected
+ * hold RX buffers of the WiFi driver. The descriptor ring has a single
+ * consumer, so it is flushed in the netdev thread and not here.
  */
-static esp_err_t IRAM_ATTR _esp_system_event_handler(void *ctx, system_event_t *event)
+static inline void _esp_wifi_rx_flush(void)
+{
+#ifdef MODULE_ESP_WIFI_RX_DESC
+    _esp_wifi_dev.rx_desc_flush = true;
+    netdev_trigger_event_isr(&_esp_wifi_dev.netdev);
+#endif
+}
+
+#ifdef MODULE_ESP_WIFI_AP
+static void IRAM_ATTR _esp_wifi_ap_start(esp_event_sub_t *sub, unsigned id,
+                                         const void *info)
 {
-    assert(event != NULL);
+    (void)sub;
+    (void)id;
+    (void)info;
 
-#ifndef MODULE_ESP_WIFI_AP
-    esp_err_t result;
+    _esp_wifi_started = 1;
+    esp_wifi_internal_reg_rxcb(ESP_IF_WIFI_AP, _esp_wifi_rx_cb);
+    ESP_WIFI_DEBUG("WiFi started");
+}
 
-    uint8_t reason;
-    const char* reason_str = "UNKNOWN";
-#endif /* MODULE_ESP_WIFI_AP */
+static void IRAM_ATTR _esp_wifi_ap_stop(esp_event_sub_t *sub, unsigned id,
+                                        const void *info)
+{
+    (void)sub;
+    (void)id;
+    (void)info;
+
+    _esp_wifi_started = 0;
+    esp_wifi_internal_reg_rxcb(ESP_IF_WIFI_AP, NULL);
+    _esp_wifi_rx_flush();
+    ESP_WIFI_DEBUG("WiFi stopped");
+}
+
+static void IRAM_ATTR _esp_wifi_ap_sta_connected(esp_event_sub_t *sub,
+                                                 unsigned id, const void *info)
+{
+    (void)sub;
+    const system_event_ap_staconnected_t *event_info =
+        esp_event_ap_staconnected_info(id, info);
+
+    _esp_wifi_dev.sta_connected += 1;
+    ESP_WIFI_LOG_INFO("Station "MAC_STR" join (AID=%d)",
+                      MAC_STR_ARG(event_info->mac), event_info->aid);
+}
+
+static void IRAM_ATTR _esp_wifi_ap_sta_disconnected(esp_event_sub_t *sub,
+                                                    unsigned id,
+                                                    const void *info)
+{
+    (void)sub;
+    const system_event_ap_stadisconnected_t *event_info =
+        esp_event_ap_stadisconnected_info(id, info);
+
+    _esp_wifi_dev.sta_connected -= 1;
+    ESP_WIFI_LOG_INFO("Station "MAC_STR" leave (AID=%d)",
+                      MAC_STR_ARG(event_info->mac), event_info->aid);
+}
+
+static void _esp_wifi_ap_probe_req(esp_event_sub_t *sub, unsigned id,
+                                   const void *info)
+{
+    (void)sub;
+    const system_event_ap_probe_req_rx_t *event_info =
+        esp_event_ap_probereqrecved_info(id, info);
+
+    (void)event_info;
+    ESP_WIFI_LOG_DEBUG("Station "MAC_STR" probed (rssi=%d)",
+                       MAC_STR_ARG(event_info->mac), event_info->rssi);
+}
+
+static esp_event_sub_t _esp_wifi_subs[] = {
+    { .id = SYSTEM_EVENT_AP_START, .handler = _esp_wifi_ap_start },
+    { .id = SYSTEM_EVENT_AP_STOP, .handler = _esp_wifi_ap_stop },
+    { .id = SYSTEM_EVENT_AP_STACONNECTED,
+      .handler = _esp_wifi_ap_sta_connected },
+    { .id = SYSTEM_EVENT_AP_STADISCONNECTED,
+      .handler = _esp_wifi_ap_sta_disconnected },
+    { .id = SYSTEM_EVENT_AP_PROBEREQRECVED,
+      .handler = _esp_wifi_ap_probe_req, .deferred = true },
+};
 
-    switch (event->event_id) {
-#ifdef MODULE_ESP_WIFI_AP
-        case SYSTEM_EVENT_AP_START:
-            _esp_wifi_started = 1;
-            esp_wifi_internal_reg_rxcb(ESP_IF_WIFI_AP, _esp_wifi_rx_cb);
-            ESP_WIFI_DEBUG("WiFi started");
-            break;
-
-        case SYSTEM_EVENT_AP_STOP:
-            _esp_wifi_started = 0;
-            esp_wifi_internal_reg_rxcb(ESP_IF_WIFI_AP, NULL);
-            ESP_WIFI_DEBUG("WiFi stopped");
-            break;
-
-        case SYSTEM_EVENT_AP_STACONNECTED:
-            _esp_wifi_dev.sta_connected += 1;
-            ESP_WIFI_LOG_INFO("Station "MAC_STR" join (AID=%d)",
-                              MAC_STR_ARG(event->event_info.sta_connected.mac),
-                              event->event_info.sta_connected.aid);
-            break;
-
-        case SYSTEM_EVENT_AP_STADISCONNECTED:
-            _esp_wifi_dev.sta_connected -= 1;
-            ESP_WIFI_LOG_INFO("Station "MAC_STR" leave (AID=%d)",
-                              MAC_STR_ARG(event->event_info.sta_disconnected.mac),
-                              event->event_info.sta_disconnected.aid);
-            break;
-
-        case SYSTEM_EVENT_AP_PROBEREQRECVED:
-            ESP_WIFI_LOG_DEBUG("Station "MAC_STR" probed (rssi=%d)",
-                               MAC_STR_ARG(event->event_info.ap_probereqrecved.mac),
-                               event->event_info.ap_probereqrecved.rssi);
-            break;
 #else /* MODULE_ESP_WIFI_AP */
-        case SYSTEM_EVENT_STA_START:
-            _esp_wifi_started = 1;
-            ESP_WIFI_DEBUG("WiFi started");
-            result = esp_wifi_connect();
-            if (result != ESP_OK) {
-                ESP_WIFI_LOG_ERROR("esp_wifi_connect failed with return "
-                                   "value %d", result);
-            }
-            break;
-
-        case SYSTEM_EVENT_STA_STOP:
-            _esp_wifi_started = 0;
-            ESP_WIFI_DEBUG("WiFi stopped");
-            break;
-
-        case SYSTEM_EVENT_SCAN_DONE:
-            ESP_WIFI_DEBUG("WiFi scan done");
-            break;
-
-        case SYSTEM_EVENT_STA_CONNECTED:
-            ESP_WIFI_LOG_INFO("WiFi connected to ssid %s, channel %d",
-                              event->event_info.connected.ssid,
-                              event->event_info.connected.channel);
-            _esp_wifi_channel = event->event_info.connected.channel;
+
+static void IRAM_ATTR _esp_wifi_sta_start(esp_event_sub_t *sub, unsigned id,
+                                          const void *info)
+{
+    (void)sub;
+    (void)id;
+    (void)info;
+
+    _esp_wifi_started = 1;
+    ESP_WIFI_DEBUG("WiFi started");
+
+    esp_err_t result = esp_wifi_connect();
+    if (result != ESP_OK) {
+        ESP_WIFI_LOG_ERROR("esp_wifi_connect failed with return "
+                           "value %d", result);
+    }
+}
+
+static void IRAM_ATTR _esp_wifi_sta_stop(esp_event_sub_t *sub, unsigned id,
+                                         const void *info)
+{
+    (void)sub;
+    (void)id;
+    (void)info;
+
+    _esp_wifi_started = 0;
+    esp_wifi_internal_reg_rxcb(ESP_IF_WIFI_STA, NULL);
+    _esp_wifi_rx_flush();
+    ESP_WIFI_DEBUG("WiFi stopped");
+}
+
+static void _esp_wifi_scan_done(esp_event_sub_t *sub, unsigned id,
+                                const void *info)
+{
+    (void)sub;
+    (void)id;
+    (void)info;
+
+    ESP_WIFI_DEBUG("WiFi scan done");
+}
+
+static void IRAM_ATTR _esp_wifi_sta_connected(esp_event_sub_t *sub,
+                                              unsigned id, const void *info)
+{
+    (void)sub;
+    const system_event_sta_connected_t *event_info =
+        esp_event_sta_connected_info(id, info);
+
+    ESP_WIFI_LOG_INFO("WiFi connected to ssid %s, channel %d",
+                      event_info->ssid, event_info->channel);
+    _esp_wifi_channel = event_info->channel;
 #ifdef MODULE_ESP_NOW
-            extern void esp_now_set_channel(uint8_t channel);
-            esp_now_set_channel(_esp_wifi_channel);
+    extern void esp_now_set_channel(uint8_t channel);
+    esp_now_set_channel(_esp_wifi_channel);
 #endif
-            /* register RX callback function */
-            esp_wifi_internal_reg_rxcb(ESP_IF_WIFI_STA, _esp_wifi_rx_cb);
-
-            _esp_wifi_dev.connected = true;
-            _esp_wifi_dev.event_conn++;
-            netdev_trigger_event_isr(&_esp_wifi_dev.netdev);
-
-            break;
-
-        case SYSTEM_EVENT_STA_DISCONNECTED:
-            reason = event->event_info.disconnected.reason;
-            if (reason < REASON_BEACON_TIMEOUT) {
-                reason_str = _esp_wifi_disc_reasons[reason];
-            }
-            else if (reason <= REASON_HANDSHAKE_TIMEOUT) {
-                reason_str = _esp_wifi_disc_reasons[reason - INDEX_BEACON_TIMEOUT];
-            }
-            ESP_WIFI_LOG_INFO("WiFi disconnected from ssid %s, reason %d (%s)",
-                              event->event_info.disconnected.ssid,
-                              event->event_info.disconnected.reason, reason_str);
-
-            /* unregister RX callback function */
-            esp_wifi_internal_reg_rxcb(ESP_IF_WIFI_STA, NULL);
-
-            _esp_wifi_dev.connected = false;
-            _esp_wifi_dev.event_disc++;
-            netdev_trigger_event_isr(&_esp_wifi_dev.netdev);
-
-            if (reason != WIFI_REASON_ASSOC_LEAVE) {
-                /* call disconnect to reset internal state */
-                result = esp_wifi_disconnect();
-                if (result != ESP_OK) {
-                    ESP_WIFI_LOG_ERROR("esp_wifi_disconnect failed with "
-                                       "return value %d", result);
-                    return result;
-                }
-
-                /* try to reconnect */
-                if (_esp_wifi_started && ((result = esp_wifi_connect()) != ESP_OK)) {
-                   ESP_WIFI_LOG_ERROR("esp_wifi_connect failed with "
-                                      "return value %d", result);
-                }
-            }
-
-            break;
-#endif /* MODULE_ESP_WIFI_AP */
+    /* register RX callback function */
+    esp_wifi_internal_reg_rxcb(ESP_IF_WIFI_STA, _esp_wifi_rx_cb);
 
-        default:
-            ESP_WIFI_DEBUG("event %d", event->event_id);
-            break;
+    _esp_wifi_dev.connected = true;
+    _esp_wifi_dev.event_conn++;
+    netdev_trigger_event_isr(&_esp_wifi_dev.netdev);
+}
+
+static void IRAM_ATTR _esp_wifi_sta_disconnected(esp_event_sub_t *sub,
+                                                 unsigned id, const void *info)
+{
+    (void)sub;
+    const system_event_sta_disconnected_t *event_info =
+        esp_event_sta_disconnected_info(id, info);
+
+    esp_err_t result;
+    uint8_t reason = event_info->reason;
+    const char* reason_str = "UNKNOWN";
+
+    if (reason < REASON_BEACON_TIMEOUT) {
+        reason_str = _esp_wifi_disc_reasons[reason];
+    }
+    else if (reason <= REASON_HANDSHAKE_TIMEOUT) {
+        reason_str = _esp_wifi_disc_reasons[reason - INDEX_BEACON_TIMEOUT];
+    }
+    ESP_WIFI_LOG_INFO("WiFi disconnected from ssid %s, reason %d (%s)",
+                      event_info->ssid, event_info->reason, reason_str);
+
+    /* unregister RX callback function */
+    esp_wifi_internal_reg_rxcb(ESP_IF_WIFI_STA, NULL);
+    _esp_wifi_rx_flush();
+
+    _esp_wifi_dev.connected = false;
+    _esp_wifi_dev.event_disc++;
+    netdev_trigger_event_isr(&_esp_wifi_dev.netdev);
+
+    if (reason != WIFI_REASON_ASSOC_LEAVE) {
+        /* call disconnect to reset internal state */
+        result = esp_wifi_disconnect();
+        if (result != ESP_OK) {
+            ESP_WIFI_LOG_ERROR("esp_wifi_disconnect failed with "
+                               "return value %d", result);
+            return;
+        }
+
+        /* try to reconnect */
+        if (_esp_wifi_started && ((result = esp_wifi_connect()) != ESP_OK)) {
+           ESP_WIFI_LOG_ERROR("esp_wifi_connect failed with "
+                              "return value %d", result);
+        }
     }
-    return ESP_OK;
 }
 
+static esp_event_sub_t _esp_wifi_subs[] = {
+    { .id = SYSTEM_EVENT_STA_START, .handler = _esp_wifi_sta_start },
+    { .id = SYSTEM_EVENT_STA_STOP, .handler = _esp_wifi_sta_stop },
+    { .id = SYSTEM_EVENT_SCAN_DONE, .handler = _esp_wifi_scan_done,
+      .deferred = true },
+    { .id = SYSTEM_EVENT_STA_CONNECTED, .handler = _esp_wifi_sta_connected },
+    { .id = SYSTEM_EVENT_STA_DISCONNECTED,
+      .handler = _esp_wifi_sta_disconnected },
+};
+
+#endif /* MODULE_ESP_WIFI_AP */
+
 static int _esp_wifi_send(netdev_t *netdev, const iolist_t *iolist)
 {
     ESP_WIFI_DEBUG("netdev=%p iolist=%p", netdev, iolist);
@@ -630,6 +728,27 @@ static int _esp_wifi_recv(netdev_t *netdev, void *buf, size_t len, void *info)
     assert(netdev != NULL);
 
     esp_wifi_netdev_t* dev = (esp_wifi_netdev_t*)netdev;
+
+#ifdef MODULE_ESP_WIFI_RX_DESC
+    /*
+     * The descriptor ring has a single consumer and the frame is copied
+     * without holding the critical section, so that the WiFi driver thread
+     * can queue further frames in the meantime.
+     */
+    int size = esp_wifi_rx_desc_recv(&dev->rx_desc, buf, len);
+
+    if (size > 0 && buf && IS_ACTIVE(ENABLE_DEBUG)) {
+        ethernet_hdr_t *hdr = (ethernet_hdr_t *)buf;
+        ESP_WIFI_DEBUG("received %d byte from addr " MAC_STR " (%"PRIu32" dropped)",
+                       size, MAC_STR_ARG(hdr->src), dev->rx_desc.dropped);
+
+        if (IS_ACTIVE(ENABLE_DEBUG_HEXDUMP) && IS_USED(MODULE_OD)) {
+            od_hex_dump(buf, size, OD_WIDTH_DEFAULT);
+        }
+    }
+
+    return size;
+#else /* MODULE_ESP_WIFI_RX_DESC */
     uint16_t size;
 
     critical_enter();
@@ -678,6 +797,7 @@ static int _esp_wifi_recv(netdev_t *netdev, void *buf, size_t len, void *info)
 
     critical_exit();
     return size;
+#endif /* MODULE_ESP_WIFI_RX_DESC */
 }
 
 static int _esp_wifi_get(netdev_t *netdev, netopt_t opt, void *val, size_t max_len)
@@ -750,6 +870,13 @@ static void _esp_wifi_isr(netdev_t *netdev)
 
     esp_wifi_netdev_t *dev = (esp_wifi_netdev_t *) netdev;
 
+#ifdef MODULE_ESP_WIFI_RX_DESC
+    if (dev->rx_desc_flush) {
+        dev->rx_desc_flush = false;
+        esp_wifi_rx_desc_flush(&dev->rx_desc);
+    }
+#endif
+
     while (dev->event_recv) {
         dev->event_recv--;
         dev->netdev.event_callback(netdev, NETDEV_EVENT_RX_COMPLETE);
@@ -858,10 +985,16 @@ void esp_wifi_setup (esp_wifi_netdev_t* dev)
     ESP_WIFI_DEBUG("dev=%p", dev);
 
     /* initialize buffer */
+#ifdef MODULE_ESP_WIFI_RX_DESC
+    esp_wifi_rx_desc_init(&dev->rx_desc);
+#else
     ringbuffer_init(&dev->rx_buf, (char*)dev->rx_mem, sizeof(dev->rx_mem));
+#endif
 
-    /* set the event handler */
-    esp_system_event_add_handler(_esp_system_event_handler, NULL);
+    /* subscribe the handlers for the system events */
+    for (unsigned i = 0; i < ARRAY_SIZE(_esp_wifi_subs); i++) {
+        esp_event_subscribe(&_esp_wifi_subs[i]);
+    }
 
     /*
      * Init the WiFi driver. TODO It is not only required before ESP_WIFI is
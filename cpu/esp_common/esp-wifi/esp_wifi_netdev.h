@@ -25,6 +25,9 @@
 #include "net/ethernet.h"
 #include "net/netdev.h"
 #include "ringbuffer.h"
+#ifdef MODULE_ESP_WIFI_RX_DESC
+#include "esp_wifi_rx_desc.h"
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -49,8 +52,13 @@ typedef struct
 {
     netdev_t netdev;                   /**< netdev parent struct */
 
+#ifdef MODULE_ESP_WIFI_RX_DESC
+    esp_wifi_rx_desc_ring_t rx_desc;   /**< descriptors of incoming packages */
+    bool rx_desc_flush;                /**< drop the pending packages */
+#else
     uint8_t rx_mem[ESP_WIFI_BUFSIZE];  /**< memory holding incoming packages */
     ringbuffer_t rx_buf;               /**< ringbuffer for incoming packages */
+#endif
 
     uint16_t tx_len;                   /**< number of bytes in transmit buffer */
     uint8_t tx_buf[ETHERNET_MAX_LEN];  /**< transmit buffer */
@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2021 Gunar Schorcht
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     cpu_esp_common_esp_wifi
+ * @{
+ *
+ * @file
+ * @brief       Descriptor ring for zero-copy reception of ESP WiFi frames
+ *
+ * @author      Gunar Schorcht <gunar@schorcht.net>
+ * @}
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <string.h>
+
+#include "irq.h"
+#include "esp_wifi_internal.h"
+#include "esp_wifi_rx_desc.h"
+
+#define ENABLE_DEBUG    0
+#include "debug.h"
+
+#define RX_DESC_MASK    (ESP_WIFI_RX_DESC_NUMOF - 1)
+
+void esp_wifi_rx_desc_init(esp_wifi_rx_desc_ring_t *ring)
+{
+    assert(ring != NULL);
+    memset(ring, 0, sizeof(*ring));
+}
+
+bool esp_wifi_rx_desc_put(esp_wifi_rx_desc_ring_t *ring,
+                          void *buffer, uint16_t len, void *eb)
+{
+    assert(ring != NULL);
+    assert(buffer != NULL);
+
+    /* only the producer changes head, so it can be read without locking */
+    uint8_t head = ring->head;
+
+    if ((uint8_t)(head - ring->tail) == ESP_WIFI_RX_DESC_NUMOF) {
+        DEBUG("[esp_wifi] %s: ring full, dropping frame of %u byte\n",
+              __func__, len);
+        ring->dropped++;
+        if (eb) {
+            esp_wifi_internal_free_rx_buffer(eb);
+        }
+        return false;
+    }
+
+    esp_wifi_rx_desc_t *desc = &ring->desc[head & RX_DESC_MASK];
+    desc->buffer = buffer;
+    desc->eb = eb;
+    desc->len = len;
+
+    /* publish the descriptor only after it was written completely, irq_disable
+     * also keeps the compiler from reordering the stores */
+    unsigned state = irq_disable();
+    ring->head = head + 1;
+    irq_restore(state);
+
+    return true;
+}
+
+static void _release(esp_wifi_rx_desc_ring_t *ring, esp_wifi_rx_desc_t *desc)
+{
+    void *eb = desc->eb;
+
+    unsigned state = irq_disable();
+    ring->tail++;
+    irq_restore(state);
+
+    if (eb) {
+        esp_wifi_internal_free_rx_buffer(eb);
+    }
+}
+
+int esp_wifi_rx_desc_recv(esp_wifi_rx_desc_ring_t *ring, void *buf,
+                          size_t len)
+{
+    assert(ring != NULL);
+
+    /* only the consumer changes tail, so it can be read without locking */
+    uint8_t tail = ring->tail;
+
+    if (ring->head == tail) {
+        return 0;
+    }
+
+    esp_wifi_rx_desc_t *desc = &ring->desc[tail & RX_DESC_MASK];
+    uint16_t size = desc->len;
+
+    if (!buf) {
+        /* if len > 0, drop the frame */
+        if (len > 0) {
+            _release(ring, desc);
+        }
+        return size;
+    }
+
+    if (len < size) {
+        DEBUG("[esp_wifi] %s: not enough space in receive buffer\n", __func__);
+        /* newest API requires to drop the frame in that case */
+        _release(ring, desc);
+        return -ENOBUFS;
+    }
+
+    /* the only copy of the frame, directly from the vendor buffer */
+    memcpy(buf, desc->buffer, size);
+    _release(ring, desc);
+
+    return size;
+}
+
+void esp_wifi_rx_desc_flush(esp_wifi_rx_desc_ring_t *ring)
+{
+    assert(ring != NULL);
+
+    while (esp_wifi_rx_desc_pending(ring)) {
+        esp_wifi_rx_desc_recv(ring, NULL, 1);
+    }
+}
@@ -0,0 +1,147 @@
+/*
+ * Copyright (C) 2021 Gunar Schorcht
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     cpu_esp_common_esp_wifi
+ * @{
+ *
+ * @file
+ * @brief       Descriptor ring for zero-copy reception of ESP WiFi frames
+ *
+ * Instead of copying received frames into a ring buffer, the RX callback of
+ * the WiFi driver only queues a descriptor that refers to the receive buffer
+ * of the vendor WiFi driver. The frame is copied once, directly into the
+ * buffer of the network stack, when it is read. Only then the vendor buffer
+ * is released with `esp_wifi_internal_free_rx_buffer`.
+ *
+ * The ring is independent of the ESP SDK, it can be used on any platform
+ * that provides `esp_wifi_internal_free_rx_buffer`, e.g. a mock on the host.
+ *
+ * @author      Gunar Schorcht <gunar@schorcht.net>
+ */
+
+#ifndef ESP_WIFI_RX_DESC_H
+#define ESP_WIFI_RX_DESC_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Number of descriptors, i.e. the number of received frames that
+ *          can be pending
+ *
+ * Each pending frame holds one RX buffer of the vendor WiFi driver, which
+ * has only a limited number of them. The number has to be a power of two.
+ */
+#ifndef ESP_WIFI_RX_DESC_NUMOF
+#define ESP_WIFI_RX_DESC_NUMOF  (8)
+#endif
+
+#if (ESP_WIFI_RX_DESC_NUMOF & (ESP_WIFI_RX_DESC_NUMOF - 1)) || \
+    (ESP_WIFI_RX_DESC_NUMOF > 128)
+#error "ESP_WIFI_RX_DESC_NUMOF has to be a power of two not greater than 128"
+#endif
+
+/**
+ * @brief   Descriptor of a received frame
+ */
+typedef struct {
+    void *buffer;       /**< frame data */
+    void *eb;           /**< vendor buffer to be freed, may be NULL */
+    uint16_t len;       /**< frame length */
+} esp_wifi_rx_desc_t;
+
+/**
+ * @brief   Ring of descriptors of received frames
+ *
+ * There is one producer, the RX callback of the vendor WiFi driver, and one
+ * consumer, the netdev `recv` function.
+ */
+typedef struct {
+    esp_wifi_rx_desc_t desc[ESP_WIFI_RX_DESC_NUMOF]; /**< descriptors */
+    volatile uint8_t head;  /**< number of queued frames, wraps around */
+    volatile uint8_t tail;  /**< number of consumed frames, wraps around */
+    uint32_t dropped;       /**< frames dropped because the ring was full */
+} esp_wifi_rx_desc_ring_t;
+
+/**
+ * @brief   Initialize an empty descriptor ring
+ *
+ * @param[out]  ring    descriptor ring
+ */
+void esp_wifi_rx_desc_init(esp_wifi_rx_desc_ring_t *ring);
+
+/**
+ * @brief   Queue a received frame
+ *
+ * If the ring is full, the frame is dropped, the vendor buffer is freed
+ * immediately and the drop is counted.
+ *
+ * @param[in]   ring    descriptor ring
+ * @param[in]   buffer  frame data
+ * @param[in]   len     frame length
+ * @param[in]   eb      vendor buffer that holds the frame, may be NULL
+ *
+ * @return  true if the frame was queued
+ * @return  false if the frame was dropped
+ */
+bool esp_wifi_rx_desc_put(esp_wifi_rx_desc_ring_t *ring,
+                          void *buffer, uint16_t len, void *eb);
+
+/**
+ * @brief   Read the oldest queued frame with the semantics of the netdev
+ *          `recv` function
+ *
+ * - With @p buf NULL and @p len 0, the size of the frame is returned.
+ * - With @p buf NULL and @p len > 0, the frame is dropped and its size is
+ *   returned.
+ * - Otherwise the frame is copied to @p buf. If @p len is too small, the
+ *   frame is dropped and -ENOBUFS is returned.
+ *
+ * Whenever the frame leaves the ring, its vendor buffer is freed.
+ *
+ * @param[in]   ring    descriptor ring
+ * @param[out]  buf     buffer to copy the frame to, may be NULL
+ * @param[in]   len     size of @p buf
+ *
+ * @return  size of the frame, 0 if no frame is pending
+ * @return  -ENOBUFS if @p buf is too small
+ */
+int esp_wifi_rx_desc_recv(esp_wifi_rx_desc_ring_t *ring, void *buf,
+                          size_t len);
+
+/**
+ * @brief   Drop all queued frames and free their vendor buffers
+ *
+ * @param[in]   ring    descriptor ring
+ */
+void esp_wifi_rx_desc_flush(esp_wifi_rx_desc_ring_t *ring);
+
+/**
+ * @brief   Get the number of queued frames
+ *
+ * @param[in]   ring    descriptor ring
+ *
+ * @return  number of queued frames
+ */
+static inline unsigned esp_wifi_rx_desc_pending(const esp_wifi_rx_desc_ring_t *ring)
+{
+    return (uint8_t)(ring->head - ring->tail);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ESP_WIFI_RX_DESC_H */
+/** @} */
@@ -23,73 +23,30 @@
 #define ENABLE_DEBUG 0
 #include "debug.h"
 
+#include <assert.h>
 #include <string.h>
 
 #include "esp_common.h"
 #include "log.h"
 
 #include "esp_attr.h"
+#include "esp_event_dispatch.h"
 #include "esp_event_loop.h"
+#include "event/thread.h"
 #include "irq_arch.h"
 
-#define MAX_HANDLER_NUM     5
-
-static system_event_cb_t _handler[MAX_HANDLER_NUM] = {};
-static void* _handler_arg[MAX_HANDLER_NUM] = {};
-
-esp_err_t esp_system_event_add_handler (system_event_cb_t handler, void *arg)
-{
-    int i;
-
-    /* determine next free handler entry */
-    for (i = 0; i < MAX_HANDLER_NUM; i++) {
-        if (_handler[i] == NULL) {
-            break;
-        }
-    }
-
-    /* return if there is no free entry */
-    if (i == MAX_HANDLER_NUM) {
-        return ESP_FAIL;
-    }
-
-    /* set the handler and argument entry */
-    _handler[i] = handler;
-    _handler_arg[i] = arg;
-
-    return ESP_OK;
-}
-
-esp_err_t esp_system_event_del_handler (system_event_cb_t handler)
-{
-    int i;
-
-    /* determine the handler entry */
-    for (i = 0; i < MAX_HANDLER_NUM; i++) {
-        if (_handler[i] == handler) {
-            break;
-        }
-    }
-
-    /* return if entry was not found */
-    if (i == MAX_HANDLER_NUM) {
-        return ESP_FAIL;
-    }
-
-    /* clean handler and arg entry */
-    _handler[i] = NULL;
-    _handler_arg[i] = NULL;
-
-    return ESP_OK;
-}
+static_assert(SYSTEM_EVENT_MAX <= ESP_EVENT_ID_NUMOF,
+              "ESP_EVENT_ID_NUMOF is too small for the system events");
+static_assert(sizeof(system_event_info_t) <= ESP_EVENT_INFO_SIZE,
+              "ESP_EVENT_INFO_SIZE is too small for the system event info");
 
 static esp_err_t esp_system_event_handler(void *ctx, system_event_t *event)
 {
-    for (int i = 0; i < MAX_HANDLER_NUM; i++) {
-        if (_handler[i] != NULL) {
-            _handler[i](_handler_arg[i], event);
-        }
-    }
+    (void)ctx;
+
+    /* only the handlers subscribed for the event ID are called */
+    esp_event_dispatch(event->event_id, &event->event_info,
+                       sizeof(event->event_info));
     return ESP_OK;
 }
 
@@ -98,6 +55,7 @@ static esp_err_t esp_system_event_handler(void *ctx, system_event_t *event)
 void esp_event_handler_init(void)
 {
     #if defined(MODULE_ESP_WIFI_ANY) || defined(MODULE_ESP_ETH)
+    esp_event_dispatch_init(EVENT_PRIO_MEDIUM);
     esp_event_loop_init(esp_system_event_handler, NULL);
     #endif
 }
@@ -0,0 +1,219 @@
+/*
+ * Copyright (C) 2021 Gunar Schorcht
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     cpu_esp_common
+ * @{
+ *
+ * @file
+ * @brief       Dispatcher for ESP system events
+ *
+ * @author      Gunar Schorcht <gunar@schorcht.net>
+ * @}
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <string.h>
+
+#include "irq.h"
+#include "kernel_defines.h"
+#include "xtimer.h"
+
+#include "esp_event_dispatch.h"
+
+#define ENABLE_DEBUG    0
+#include "debug.h"
+
+/* copy of an event for deferred handlers */
+typedef struct {
+    event_t super;
+    uint32_t time;      /* time the event was dispatched */
+    uint8_t id;
+    bool used;
+    uint32_t info[(ESP_EVENT_INFO_SIZE + 3) >> 2];
+} _deferred_t;
+
+static esp_event_sub_t *_subs[ESP_EVENT_ID_NUMOF];
+static esp_event_stats_t _stats[ESP_EVENT_ID_NUMOF];
+static _deferred_t _deferred[ESP_EVENT_DEFER_NUMOF];
+static event_queue_t *_queue;
+
+static void _record_latency(unsigned id, uint32_t start)
+{
+    uint32_t latency = xtimer_now_usec() - start;
+
+    unsigned state = irq_disable();
+    _stats[id].latency_sum += latency;
+    if (latency > _stats[id].latency_max) {
+        _stats[id].latency_max = latency;
+    }
+    irq_restore(state);
+}
+
+static void _call_handlers(unsigned id, const void *info, bool deferred)
+{
+    for (esp_event_sub_t *sub = _subs[id]; sub; sub = sub->next) {
+        if (sub->deferred == deferred) {
+            sub->handler(sub, id, info);
+        }
+    }
+}
+
+static void _deferred_handler(event_t *event)
+{
+    _deferred_t *d = container_of(event, _deferred_t, super);
+
+    DEBUG("%s id=%u\n", __func__, d->id);
+
+    _call_handlers(d->id, d->info, true);
+    _record_latency(d->id, d->time);
+
+    d->used = false;
+}
+
+static _deferred_t *_deferred_alloc(void)
+{
+    _deferred_t *d = NULL;
+
+    unsigned state = irq_disable();
+    for (unsigned i = 0; i < ESP_EVENT_DEFER_NUMOF; i++) {
+        if (!_deferred[i].used) {
+            d = &_deferred[i];
+            d->used = true;
+            break;
+        }
+    }
+    irq_restore(state);
+
+    return d;
+}
+
+void esp_event_dispatch_init(event_queue_t *queue)
+{
+    _queue = queue;
+
+    for (unsigned i = 0; i < ESP_EVENT_DEFER_NUMOF; i++) {
+        _deferred[i].super.handler = _deferred_handler;
+    }
+}
+
+int esp_event_subscribe(esp_event_sub_t *sub)
+{
+    assert(sub != NULL);
+    assert(sub->handler != NULL);
+
+    if (sub->id >= ESP_EVENT_ID_NUMOF) {
+        return -EINVAL;
+    }
+
+    sub->next = NULL;
+
+    /* append the subscription, handlers are called in the order in which
+     * they were subscribed */
+    unsigned state = irq_disable();
+    esp_event_sub_t **p = &_subs[sub->id];
+    while (*p) {
+        p = &(*p)->next;
+    }
+    *p = sub;
+    irq_restore(state);
+
+    return 0;
+}
+
+int esp_event_unsubscribe(esp_event_sub_t *sub)
+{
+    assert(sub != NULL);
+
+    if (sub->id >= ESP_EVENT_ID_NUMOF) {
+        return -ENOENT;
+    }
+
+    /* the next pointer of the subscription is kept, so that handlers of the
+     * same event ID that are currently dispatched can still be reached */
+    unsigned state = irq_disable();
+    for (esp_event_sub_t **p = &_subs[sub->id]; *p; p = &(*p)->next) {
+        if (*p == sub) {
+            *p = sub->next;
+            irq_restore(state);
+            return 0;
+        }
+    }
+    irq_restore(state);
+
+    return -ENOENT;
+}
+
+void esp_event_dispatch(unsigned id, const void *info, size_t len)
+{
+    assert(id < ESP_EVENT_ID_NUMOF);
+    assert(len <= ESP_EVENT_INFO_SIZE);
+
+    if (id >= ESP_EVENT_ID_NUMOF) {
+        return;
+    }
+
+    DEBUG("%s id=%u\n", __func__, id);
+
+    uint32_t start = xtimer_now_usec();
+    bool defer = false;
+
+    unsigned state = irq_disable();
+    _stats[id].count++;
+    irq_restore(state);
+
+    for (esp_event_sub_t *sub = _subs[id]; sub; sub = sub->next) {
+        if (!sub->deferred) {
+            sub->handler(sub, id, info);
+        }
+        else {
+            defer = true;
+        }
+    }
+
+    if (!defer) {
+        _record_latency(id, start);
+        return;
+    }
+
+    _deferred_t *d = (_queue && len <= ESP_EVENT_INFO_SIZE) ? _deferred_alloc()
+                                                           : NULL;
+    if (d) {
+        d->id = id;
+        d->time = start;
+        memcpy(d->info, info, len);
+
+        state = irq_disable();
+        _stats[id].deferred++;
+        irq_restore(state);
+
+        event_post(_queue, &d->super);
+        return;
+    }
+
+    /* if the event can't be deferred, it is handled directly */
+    DEBUG("%s id=%u could not be deferred\n", __func__, id);
+
+    state = irq_disable();
+    _stats[id].overflows++;
+    irq_restore(state);
+
+    _call_handlers(id, info, true);
+    _record_latency(id, start);
+}
+
+void esp_event_dispatch_get_stats(unsigned id, esp_event_stats_t *stats)
+{
+    assert(id < ESP_EVENT_ID_NUMOF);
+    assert(stats != NULL);
+
+    unsigned state = irq_disable();
+    *stats = _stats[id];
+    irq_restore(state);
+}
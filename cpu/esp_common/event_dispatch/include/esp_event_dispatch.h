@@ -0,0 +1,165 @@
+/*
+ * Copyright (C) 2021 Gunar Schorcht
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     cpu_esp_common
+ * @{
+ *
+ * @file
+ * @brief       Dispatcher for ESP system events
+ *
+ * The ESP SDK reports system events such as WiFi connects and disconnects
+ * from the context of its event task. Handlers subscribe to single event
+ * IDs, so that each event is only passed to the handlers interested in it.
+ *
+ * A handler can either be urgent and is called directly in the context of
+ * the dispatching thread, or it is deferred and called by a RIOT event
+ * queue. Deferred handlers get a copy of the event information, so they
+ * don't block the SDK and can take as long as they need. If no deferral
+ * slot is free, deferred handlers are called directly instead of losing
+ * the event.
+ *
+ * For each event ID, the number of events, the number of deferrals and
+ * the latency from dispatching an event until all its handlers returned
+ * are recorded.
+ *
+ * The dispatcher does not depend on the ESP SDK, so it can be tested on
+ * any platform with synthetic events.
+ *
+ * @author      Gunar Schorcht <gunar@schorcht.net>
+ */
+
+#ifndef ESP_EVENT_DISPATCH_H
+#define ESP_EVENT_DISPATCH_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "event.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Number of event IDs, all event IDs have to be less
+ */
+#ifndef ESP_EVENT_ID_NUMOF
+#define ESP_EVENT_ID_NUMOF          (32)
+#endif
+
+/**
+ * @brief   Maximum size of the event information
+ */
+#ifndef ESP_EVENT_INFO_SIZE
+#define ESP_EVENT_INFO_SIZE         (64)
+#endif
+
+/**
+ * @brief   Number of events that can be deferred at the same time
+ */
+#ifndef ESP_EVENT_DEFER_NUMOF
+#define ESP_EVENT_DEFER_NUMOF       (4)
+#endif
+
+/**
+ * @brief   Subscription type
+ */
+typedef struct esp_event_sub esp_event_sub_t;
+
+/**
+ * @brief   Event handler
+ *
+ * @param[in]   sub     the subscription of the handler
+ * @param[in]   id      the event ID
+ * @param[in]   info    the event information, which is only valid during
+ *                      the call
+ */
+typedef void (*esp_event_handler_t)(esp_event_sub_t *sub, unsigned id,
+                                    const void *info);
+
+/**
+ * @brief   Subscription of a handler for an event ID
+ *
+ * The subscription is provided by the subscriber and has to stay valid
+ * until it is unsubscribed.
+ */
+struct esp_event_sub {
+    esp_event_sub_t *next;          /**< next subscription for the event ID */
+    esp_event_handler_t handler;    /**< handler to be called */
+    void *arg;                      /**< argument for the handler */
+    uint8_t id;                     /**< event ID */
+    bool deferred;                  /**< call the handler in the event queue */
+};
+
+/**
+ * @brief   Statistics of an event ID
+ */
+typedef struct {
+    uint32_t count;         /**< number of dispatched events */
+    uint32_t deferred;      /**< events that were deferred */
+    uint32_t overflows;     /**< events not deferred for lack of slots */
+    uint32_t latency_sum;   /**< sum of the latencies in us */
+    uint32_t latency_max;   /**< maximum latency in us */
+} esp_event_stats_t;
+
+/**
+ * @brief   Initialize the dispatcher
+ *
+ * @param[in]   queue   event queue for deferred handlers
+ */
+void esp_event_dispatch_init(event_queue_t *queue);
+
+/**
+ * @brief   Subscribe a handler for an event ID
+ *
+ * Members `handler`, `arg`, `id` and `deferred` of @p sub have to be set.
+ *
+ * @param[in]   sub     the subscription
+ *
+ * @return  0 on success
+ * @return  -EINVAL if the event ID is invalid
+ */
+int esp_event_subscribe(esp_event_sub_t *sub);
+
+/**
+ * @brief   Unsubscribe a handler
+ *
+ * @param[in]   sub     the subscription
+ *
+ * @return  0 on success
+ * @return  -ENOENT if @p sub was not subscribed
+ */
+int esp_event_unsubscribe(esp_event_sub_t *sub);
+
+/**
+ * @brief   Dispatch an event to the handlers subscribed for its ID
+ *
+ * Urgent handlers are called before this function returns.
+ *
+ * @param[in]   id      the event ID
+ * @param[in]   info    the event information
+ * @param[in]   len     size of the event information
+ */
+void esp_event_dispatch(unsigned id, const void *info, size_t len);
+
+/**
+ * @brief   Get the statistics of an event ID
+ *
+ * @param[in]   id      the event ID
+ * @param[out]  stats   the statistics
+ */
+void esp_event_dispatch_get_stats(unsigned id, esp_event_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ESP_EVENT_DISPATCH_H */
+/** @} */
@@ -14,14 +14,18 @@
 #include "debug.h"
 
 #include <assert.h>
+#include <stdlib.h>
 #include <string.h>
 
 #include "esp_common.h"
 #include "esp_attr.h"
+#include "irq.h"
 #include "irq_arch.h"
+#include "list.h"
 #include "log.h"
 #include "mutex.h"
 #include "rmutex.h"
+#include "sched.h"
 #include "syscalls.h"
 #include "thread.h"
 
@@ -49,8 +53,79 @@ typedef struct {
     uint32_t    item_front;  /* first item in queue */
     uint32_t    item_tail;   /* last item in queue */
     uint32_t    item_level;  /* num of items stored in queue */
+    uint32_t    item_mask;   /* item_num - 1 if item_num is a power of two */
+    uint32_t    waits;       /* num of times a thread had to wait */
+    uint32_t    wakeups;     /* num of times a waiting thread was woken up */
 } _queue_t;
 
+/*
+ * The fast paths of send and receive disable interrupts directly instead
+ * of using vTaskEnterCritical. On ESP8266, vTaskEnterCritical must not
+ * touch the interrupts in NMI context, so the fast paths are skipped there.
+ */
+static inline bool _queue_fast_path(void)
+{
+#ifdef MCU_ESP8266
+    return !NMIIrqIsOn;
+#else
+    return true;
+#endif
+}
+
+/*
+ * Ring index arithmetic without division. If the queue length is a power of
+ * two, the index is masked, otherwise it wraps around by comparison.
+ */
+static inline uint32_t _queue_next(const _queue_t *queue, uint32_t pos)
+{
+    if (queue->item_mask) {
+        return (pos + 1) & queue->item_mask;
+    }
+    return (pos + 1 == queue->item_num) ? 0 : pos + 1;
+}
+
+static inline uint32_t _queue_prev(const _queue_t *queue, uint32_t pos)
+{
+    if (queue->item_mask) {
+        return (pos - 1) & queue->item_mask;
+    }
+    return (pos == 0) ? queue->item_num - 1 : pos - 1;
+}
+
+/*
+ * Copies an item. Most queues used by the binary blobs hold pointers, which
+ * are copied by a single load and store instead of calling memcpy.
+ */
+static inline void _queue_copy(void *dst, const void *src, uint32_t size)
+{
+    if ((size == sizeof(void *)) &&
+        !(((uintptr_t)dst | (uintptr_t)src) & (sizeof(void *) - 1))) {
+        *(void **)dst = *(void * const *)src;
+    }
+    else {
+        memcpy(dst, src, size);
+    }
+}
+
+static inline void _queue_item_put(_queue_t *queue, uint32_t pos,
+                                   const void *item)
+{
+    /* if the item has no 0 size, copy it to the according place in queue */
+    if (queue->item_size && queue->queue && item) {
+        _queue_copy(queue->queue + pos * queue->item_size, item,
+                    queue->item_size);
+    }
+}
+
+static inline void _queue_item_get(_queue_t *queue, uint32_t pos, void *item)
+{
+    /* if the item has no 0 size, copy it from queue to buffer */
+    if (queue->item_size && queue->queue && item) {
+        _queue_copy(item, queue->queue + pos * queue->item_size,
+                    queue->item_size);
+    }
+}
+
 QueueHandle_t xQueueGenericCreate( const UBaseType_t uxQueueLength,
                                    const UBaseType_t uxItemSize,
                                    const uint8_t ucQueueType )
@@ -73,6 +148,8 @@ QueueHandle_t xQueueGenericCreate( const UBaseType_t uxQueueLength,
     queue->item_front = 0;
     queue->item_tail = 0;
     queue->item_level = 0;
+    queue->item_mask = ((uxQueueLength & (uxQueueLength - 1)) == 0) ?
+                       uxQueueLength - 1 : 0;
 
     DEBUG("queue=%p\n", queue);
 
@@ -125,6 +202,26 @@ BaseType_t IRAM_ATTR _queue_generic_send(QueueHandle_t xQueue,
 
     _queue_t* queue = (_queue_t*)xQueue;
 
+    /*
+     * Fast path for the common case that there is space in the queue and no
+     * thread is waiting to receive. Neither the bookkeeping of the FreeRTOS
+     * critical section nor the scheduler is needed then. Since RIOT runs on
+     * one core only, disabling interrupts is sufficient to serialize
+     * producers in threads and ISRs.
+     */
+    if ((xCopyPosition == queueSEND_TO_BACK) && _queue_fast_path()) {
+        unsigned state = irq_disable();
+        if (queue->item_level < queue->item_num &&
+            queue->receiving.next == NULL) {
+            _queue_item_put(queue, queue->item_tail, pvItemToQueue);
+            queue->item_tail = _queue_next(queue, queue->item_tail);
+            queue->item_level++;
+            irq_restore(state);
+            return pdPASS;
+        }
+        irq_restore(state);
+    }
+
     while (1) {
         vTaskEnterCritical(0);
 
@@ -134,11 +231,11 @@ BaseType_t IRAM_ATTR _queue_generic_send(QueueHandle_t xQueue,
             /* determine the write position in the queue and update positions */
             if (xCopyPosition == queueSEND_TO_BACK) {
                 write_pos = queue->item_tail;
-                queue->item_tail = (queue->item_tail + 1) % queue->item_num;
+                queue->item_tail = _queue_next(queue, queue->item_tail);
                 queue->item_level++;
             }
             else if (xCopyPosition == queueSEND_TO_FRONT) {
-                queue->item_front = (queue->item_front - 1) % queue->item_num;
+                queue->item_front = _queue_prev(queue, queue->item_front);
                 queue->item_level++;
                 write_pos = queue->item_front;
             }
@@ -149,11 +246,7 @@ BaseType_t IRAM_ATTR _queue_generic_send(QueueHandle_t xQueue,
                 }
             }
 
-            /* if the item has no 0 size, copy it to the according place in queue */
-            if (queue->item_size && queue->queue && pvItemToQueue) {
-                memcpy(queue->queue + write_pos * queue->item_size,
-                       pvItemToQueue, queue->item_size);
-            }
+            _queue_item_put(queue, write_pos, pvItemToQueue);
 
             /* indicates a required context switch */
             bool ctx_switch = false;
@@ -163,6 +256,7 @@ BaseType_t IRAM_ATTR _queue_generic_send(QueueHandle_t xQueue,
                 list_node_t *next = list_remove_head(&queue->receiving);
                 thread_t *proc = container_of((clist_node_t*)next, thread_t, rq_entry);
                 sched_set_status(proc, STATUS_PENDING);
+                queue->wakeups++;
                 ctx_switch = proc->priority < sched_threads[thread_getpid()]->priority;
 
                 DEBUG("%s pid=%d queue=%p unlock waiting pid=%d switch=%d\n",
@@ -201,6 +295,7 @@ BaseType_t IRAM_ATTR _queue_generic_send(QueueHandle_t xQueue,
             sched_set_status(me, STATUS_SEND_BLOCKED);
             /* waiting list is sorted by priority */
             thread_add_to_list(&queue->sending, me);
+            queue->waits++;
 
             DEBUG("%s pid=%d queue=%p suspended calling thread\n", __func__,
                   thread_getpid(), xQueue);
@@ -231,18 +326,31 @@ BaseType_t IRAM_ATTR _queue_generic_recv (QueueHandle_t xQueue,
 
     _queue_t* queue = (_queue_t*)xQueue;
 
+    /*
+     * Fast path for the common case that there is an item in the queue and
+     * no thread is waiting to send, see _queue_generic_send.
+     */
+    if (_queue_fast_path()) {
+        unsigned state = irq_disable();
+        if (queue->item_level > 0 && queue->sending.next == NULL) {
+            _queue_item_get(queue, queue->item_front, pvBuffer);
+            /* when only peeking leave the element in queue */
+            if (xJustPeeking != pdTRUE) {
+                queue->item_front = _queue_next(queue, queue->item_front);
+                queue->item_level--;
+            }
+            irq_restore(state);
+            return pdPASS;
+        }
+        irq_restore(state);
+    }
+
     while (1) {
         vTaskEnterCritical(0);
 
         /* if there is at least one item in the queue */
         if (queue->item_level > 0) {
-            /* if the item has no 0 size, copy it from queue to buffer */
-            if (queue->item_size && queue->item_num && queue->queue && pvBuffer) {
-                memcpy(pvBuffer,
-                       queue->queue + queue->item_front * queue->item_size,
-                       queue->item_size);
-            }
-
+            _queue_item_get(queue, queue->item_front, pvBuffer);
 
             /* when only peeking leave the element in queue */
             if (xJustPeeking == pdTRUE) {
@@ -253,7 +361,7 @@ BaseType_t IRAM_ATTR _queue_generic_recv (QueueHandle_t xQueue,
             }
 
             /* remove element from queue */
-            queue->item_front = (queue->item_front + 1) % queue->item_num;
+            queue->item_front = _queue_next(queue, queue->item_front);
             queue->item_level--;
 
             /* return if there is no waiting sending thread */
@@ -268,6 +376,7 @@ BaseType_t IRAM_ATTR _queue_generic_recv (QueueHandle_t xQueue,
             list_node_t *next = list_remove_head(&queue->sending);
             thread_t *proc = container_of((clist_node_t*)next, thread_t, rq_entry);
             sched_set_status(proc, STATUS_PENDING);
+            queue->wakeups++;
 
             /* test whether context switch is required */
             bool ctx_switch = proc->priority < sched_threads[thread_getpid()]->priority;
@@ -307,6 +416,7 @@ BaseType_t IRAM_ATTR _queue_generic_recv (QueueHandle_t xQueue,
             sched_set_status(me, STATUS_RECEIVE_BLOCKED);
             /* waiting list is sorted by priority */
             thread_add_to_list(&queue->receiving, me);
+            queue->waits++;
 
             DEBUG("%s pid=%d queue=%p suspended calling thread\n", __func__,
                   thread_getpid(), xQueue);
@@ -381,6 +491,23 @@ UBaseType_t uxQueueMessagesWaiting( QueueHandle_t xQueue )
     return queue->item_level;
 }
 
+void vQueueGetStats( QueueHandle_t xQueue, uint32_t *pulWaits,
+                     uint32_t *pulWakeups )
+{
+    assert(xQueue != NULL);
+
+    _queue_t* queue = (_queue_t*)xQueue;
+
+    unsigned state = irq_disable();
+    if (pulWaits) {
+        *pulWaits = queue->waits;
+    }
+    if (pulWakeups) {
+        *pulWakeups = queue->wakeups;
+    }
+    irq_restore(state);
+}
+
 BaseType_t xQueueGiveFromISR (QueueHandle_t xQueue,
                               BaseType_t * const pxHigherPriorityTaskWoken)
 {
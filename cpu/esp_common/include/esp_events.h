@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2021 Gunar Schorcht
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     cpu_esp_common
+ * @{
+ *
+ * @file
+ * @brief       Typed access to the information of ESP system events
+ *
+ * The dispatcher in module `esp_event_dispatch` does not depend on the ESP
+ * SDK and passes the event information of the SDK as `const void *` to the
+ * handlers. The accessors defined here return the member of
+ * `system_event_info_t` that belongs to the event ID and check that the ID
+ * matches.
+ *
+ * @author      Gunar Schorcht <gunar@schorcht.net>
+ */
+
+#ifndef ESP_EVENTS_H
+#define ESP_EVENTS_H
+
+#include <assert.h>
+
+#include "esp_event.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Get the information of event SYSTEM_EVENT_STA_CONNECTED
+ *
+ * @param[in]   id      the event ID passed to the handler
+ * @param[in]   info    the event information passed to the handler
+ */
+static inline const system_event_sta_connected_t *
+esp_event_sta_connected_info(unsigned id, const void *info)
+{
+    assert(id == SYSTEM_EVENT_STA_CONNECTED);
+    (void)id;
+    return &((const system_event_info_t *)info)->connected;
+}
+
+/**
+ * @brief   Get the information of event SYSTEM_EVENT_STA_DISCONNECTED
+ *
+ * @param[in]   id      the event ID passed to the handler
+ * @param[in]   info    the event information passed to the handler
+ */
+static inline const system_event_sta_disconnected_t *
+esp_event_sta_disconnected_info(unsigned id, const void *info)
+{
+    assert(id == SYSTEM_EVENT_STA_DISCONNECTED);
+    (void)id;
+    return &((const system_event_info_t *)info)->disconnected;
+}
+
+/**
+ * @brief   Get the information of event SYSTEM_EVENT_AP_STACONNECTED
+ *
+ * @param[in]   id      the event ID passed to the handler
+ * @param[in]   info    the event information passed to the handler
+ */
+static inline const system_event_ap_staconnected_t *
+esp_event_ap_staconnected_info(unsigned id, const void *info)
+{
+    assert(id == SYSTEM_EVENT_AP_STACONNECTED);
+    (void)id;
+    return &((const system_event_info_t *)info)->sta_connected;
+}
+
+/**
+ * @brief   Get the information of event SYSTEM_EVENT_AP_STADISCONNECTED
+ *
+ * @param[in]   id      the event ID passed to the handler
+ * @param[in]   info    the event information passed to the handler
+ */
+static inline const system_event_ap_stadisconnected_t *
+esp_event_ap_stadisconnected_info(unsigned id, const void *info)
+{
+    assert(id == SYSTEM_EVENT_AP_STADISCONNECTED);
+    (void)id;
+    return &((const system_event_info_t *)info)->sta_disconnected;
+}
+
+/**
+ * @brief   Get the information of event SYSTEM_EVENT_AP_PROBEREQRECVED
+ *
+ * @param[in]   id      the event ID passed to the handler
+ * @param[in]   info    the event information passed to the handler
+ */
+static inline const system_event_ap_probe_req_rx_t *
+esp_event_ap_probereqrecved_info(unsigned id, const void *info)
+{
+    assert(id == SYSTEM_EVENT_AP_PROBEREQRECVED);
+    (void)id;
+    return &((const system_event_info_t *)info)->ap_probereqrecved;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ESP_EVENTS_H */
+/** @} */
@@ -57,6 +57,14 @@ BaseType_t xQueueGiveFromISR (QueueHandle_t xQueue,
 
 UBaseType_t uxQueueMessagesWaiting( QueueHandle_t xQueue );
 
+/*
+ * RIOT specific extension: returns how often threads had to wait for the
+ * queue and how often waiting threads were woken up. Both counters may be
+ * NULL if not of interest.
+ */
+void vQueueGetStats( QueueHandle_t xQueue, uint32_t *pulWaits,
+                     uint32_t *pulWakeups );
+
 /*
  * PLEASE NOTE: Following definitions were copied directly from the FreeRTOS
  * distribution and are under the following copyright:
@@ -0,0 +1,176 @@
+/*
+ * Copyright (C) 2021 Gunar Schorcht
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     cpu_esp_common
+ * @{
+ *
+ * @file
+ * @brief       Offloading of jobs to the APP cpu of the ESP32
+ *
+ * @author      Gunar Schorcht <gunar@schorcht.net>
+ * @}
+ */
+
+#include <assert.h>
+#include <errno.h>
+
+#include "esp_attr.h"
+#include "irq.h"
+#include "mutex.h"
+
+#include "esp_offload.h"
+
+#define ENABLE_DEBUG    0
+#include "debug.h"
+
+#define RING_MASK   (ESP_OFFLOAD_RING_SIZE - 1)
+
+/* jobs from the PRO cpu to the APP cpu */
+static esp_offload_ring_t _submit_ring;
+/* finished jobs from the APP cpu to the PRO cpu */
+static esp_offload_ring_t _done_ring;
+
+/* jobs in flight, limited to the ring size so that the executor never
+ * finds the done ring full, only used on the PRO cpu */
+static unsigned _inflight;
+static esp_offload_stats_t _stats;
+
+/*
+ * Functions used on the APP cpu have to be in IRAM since the APP cpu runs
+ * without flash cache.
+ */
+bool IRAM_ATTR esp_offload_ring_put(esp_offload_ring_t *ring,
+                                    esp_offload_job_t *job)
+{
+    uint32_t head = __atomic_load_n(&ring->head, __ATOMIC_RELAXED);
+    uint32_t tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+
+    if ((head - tail) == ESP_OFFLOAD_RING_SIZE) {
+        return false;
+    }
+    ring->jobs[head & RING_MASK] = job;
+    /* the entry has to be visible before the new head */
+    __atomic_store_n(&ring->head, head + 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+esp_offload_job_t * IRAM_ATTR esp_offload_ring_get(esp_offload_ring_t *ring)
+{
+    uint32_t tail = __atomic_load_n(&ring->tail, __ATOMIC_RELAXED);
+    uint32_t head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+
+    if (head == tail) {
+        return NULL;
+    }
+    esp_offload_job_t *job = ring->jobs[tail & RING_MASK];
+    /* the entry has to be read before it can be overwritten */
+    __atomic_store_n(&ring->tail, tail + 1, __ATOMIC_RELEASE);
+    return job;
+}
+
+int esp_offload_submit(esp_offload_job_t *job)
+{
+    assert(job != NULL);
+    assert(job->func != NULL);
+
+    unsigned state = irq_disable();
+
+    if (_inflight == ESP_OFFLOAD_RING_SIZE) {
+        _stats.rejected++;
+        irq_restore(state);
+        return -ENOBUFS;
+    }
+    _inflight++;
+    _stats.submitted++;
+
+    /* can't fail, the number of jobs in flight is limited to the ring size */
+    esp_offload_ring_put(&_submit_ring, job);
+
+    irq_restore(state);
+
+    DEBUG("%s job=%p\n", __func__, (void *)job);
+    return 0;
+}
+
+static void _run_done(esp_offload_job_t *job)
+{
+    mutex_unlock(job->ctx);
+}
+
+int esp_offload_run(void (*func)(void *arg), void *arg)
+{
+    mutex_t lock = MUTEX_INIT_LOCKED;
+    esp_offload_job_t job = {
+        .func = func,
+        .arg = arg,
+        .done = _run_done,
+        .ctx = &lock,
+    };
+
+    int res = esp_offload_submit(&job);
+    if (res == 0) {
+        mutex_lock(&lock);
+    }
+    return res;
+}
+
+unsigned esp_offload_complete(void)
+{
+    esp_offload_job_t *job;
+    unsigned n = 0;
+
+    while ((job = esp_offload_ring_get(&_done_ring))) {
+        DEBUG("%s job=%p\n", __func__, (void *)job);
+
+        unsigned state = irq_disable();
+        _inflight--;
+        _stats.completed++;
+        irq_restore(state);
+
+        if (job->done) {
+            job->done(job);
+        }
+        n++;
+    }
+    return n;
+}
+
+bool IRAM_ATTR esp_offload_executor_poll(void)
+{
+    esp_offload_job_t *job = esp_offload_ring_get(&_submit_ring);
+
+    if (job == NULL) {
+        return false;
+    }
+
+    job->func(job->arg);
+
+    /* can't fail, the number of jobs in flight is limited to the ring size */
+    esp_offload_ring_put(&_done_ring, job);
+    esp_offload_notify_pro();
+    return true;
+}
+
+void IRAM_ATTR esp_offload_executor(void)
+{
+    while (1) {
+        if (!esp_offload_executor_poll()) {
+            esp_offload_idle();
+        }
+    }
+}
+
+void esp_offload_get_stats(esp_offload_stats_t *stats)
+{
+    assert(stats != NULL);
+
+    unsigned state = irq_disable();
+    *stats = _stats;
+    irq_restore(state);
+}
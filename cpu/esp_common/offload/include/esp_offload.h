@@ -0,0 +1,197 @@
+/*
+ * Copyright (C) 2021 Gunar Schorcht
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     cpu_esp_common
+ * @{
+ *
+ * @file
+ * @brief       Offloading of jobs to the APP cpu of the ESP32
+ *
+ * RIOT uses only the PRO cpu of the ESP32. With this module, the APP cpu
+ * runs a small executor that takes jobs, e.g. crypto or DSP functions, from
+ * the PRO cpu and runs them to completion one after the other.
+ *
+ * Jobs are passed to the APP cpu through a lock-free single producer single
+ * consumer ring of #ESP_OFFLOAD_RING_SIZE entries. Finished jobs are passed
+ * back through a second ring. The APP cpu then notifies the PRO cpu, which
+ * calls the completion callbacks of the jobs in interrupt context. Threads
+ * on the PRO cpu are serialized by disabling interrupts while submitting.
+ *
+ * The APP cpu runs without interrupts, without RIOT and without the flash
+ * cache. Job functions therefore have to be located in IRAM, must only use
+ * data in internal RAM and must not call any RIOT function.
+ *
+ * Rings and executor only depend on the hooks @ref esp_offload_notify_pro
+ * and @ref esp_offload_idle, so they can be tested on any platform with
+ * two threads.
+ *
+ * @author      Gunar Schorcht <gunar@schorcht.net>
+ */
+
+#ifndef ESP_OFFLOAD_H
+#define ESP_OFFLOAD_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Number of entries of the rings, the maximum number of jobs in
+ *          flight
+ *
+ * It has to be a power of two.
+ */
+#ifndef ESP_OFFLOAD_RING_SIZE
+#define ESP_OFFLOAD_RING_SIZE       (16)
+#endif
+
+/**
+ * @brief   Stack size of the executor on the APP cpu
+ */
+#ifndef ESP_OFFLOAD_STACKSIZE
+#define ESP_OFFLOAD_STACKSIZE       (2048)
+#endif
+
+#if (ESP_OFFLOAD_RING_SIZE & (ESP_OFFLOAD_RING_SIZE - 1))
+#error "ESP_OFFLOAD_RING_SIZE has to be a power of two"
+#endif
+
+/**
+ * @brief   Job type
+ */
+typedef struct esp_offload_job esp_offload_job_t;
+
+/**
+ * @brief   Job descriptor
+ *
+ * The descriptor is provided by the submitter and has to stay valid until
+ * the completion callback was called.
+ */
+struct esp_offload_job {
+    void (*func)(void *arg);                /**< function run by the executor */
+    void *arg;                              /**< argument of the function */
+    void (*done)(esp_offload_job_t *job);   /**< completion callback or NULL */
+    void *ctx;                              /**< context of the callback */
+};
+
+/**
+ * @brief   Single producer single consumer ring of jobs
+ *
+ * Head and tail are free running counters. Each of them is only written by
+ * one side, with release semantics, and read by the other side with acquire
+ * semantics.
+ */
+typedef struct {
+    uint32_t head;                                  /**< written by producer */
+    uint32_t tail;                                  /**< written by consumer */
+    esp_offload_job_t *jobs[ESP_OFFLOAD_RING_SIZE]; /**< ring entries */
+} esp_offload_ring_t;
+
+/**
+ * @brief   Statistics
+ */
+typedef struct {
+    uint32_t submitted;     /**< jobs passed to the executor */
+    uint32_t rejected;      /**< jobs rejected because the ring was full */
+    uint32_t completed;     /**< jobs whose completion was handled */
+} esp_offload_stats_t;
+
+/**
+ * @brief   Put a job into a ring, only called by the producer
+ *
+ * @return  true on success, false if the ring is full
+ */
+bool esp_offload_ring_put(esp_offload_ring_t *ring, esp_offload_job_t *job);
+
+/**
+ * @brief   Get a job from a ring, only called by the consumer
+ *
+ * @return  the job or NULL if the ring is empty
+ */
+esp_offload_job_t *esp_offload_ring_get(esp_offload_ring_t *ring);
+
+/**
+ * @brief   Submit a job to the executor
+ *
+ * May be called from threads and interrupt service routines on the PRO cpu.
+ *
+ * @param[in]   job     the job, member `func` has to be set
+ *
+ * @return  0 on success
+ * @return  -ENOBUFS if #ESP_OFFLOAD_RING_SIZE jobs are in flight
+ */
+int esp_offload_submit(esp_offload_job_t *job);
+
+/**
+ * @brief   Run a function on the APP cpu and wait for it
+ *
+ * Must be called from a thread on the PRO cpu.
+ *
+ * @param[in]   func    the function
+ * @param[in]   arg     the argument of the function
+ *
+ * @return  0 on success
+ * @return  -ENOBUFS if #ESP_OFFLOAD_RING_SIZE jobs are in flight
+ */
+int esp_offload_run(void (*func)(void *arg), void *arg);
+
+/**
+ * @brief   Handle finished jobs on the PRO cpu
+ *
+ * Calls the completion callbacks of all finished jobs. It is called by the
+ * interrupt service routine triggered by @ref esp_offload_notify_pro.
+ *
+ * @return  number of handled jobs
+ */
+unsigned esp_offload_complete(void);
+
+/**
+ * @brief   Run one job on the APP cpu
+ *
+ * @return  true if a job was run, false if no job was pending
+ */
+bool esp_offload_executor_poll(void);
+
+/**
+ * @brief   Executor loop on the APP cpu, calls @ref esp_offload_idle when
+ *          no job is pending
+ */
+void esp_offload_executor(void);
+
+/**
+ * @brief   Get the statistics
+ *
+ * @param[out]  stats   the statistics
+ */
+void esp_offload_get_stats(esp_offload_stats_t *stats);
+
+/**
+ * @name    CPU specific hooks
+ * @{
+ */
+/**
+ * @brief   Notify the PRO cpu that jobs are finished, called on the APP cpu
+ */
+void esp_offload_notify_pro(void);
+
+/**
+ * @brief   Called on the APP cpu if no job is pending
+ */
+void esp_offload_idle(void);
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ESP_OFFLOAD_H */
+/** @} */
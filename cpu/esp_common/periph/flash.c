@@ -40,6 +40,8 @@
 
 #include "rom/cache.h"
 #include "rom/spi_flash.h"
+#include "soc/soc.h"
+#include "esp_flash_io.h"
 #include "esp_spi_flash.h"
 
 #else /* MCU_ESP32 */
@@ -220,7 +222,27 @@ void spi_flash_drive_init (void)
     return ESP_FAIL; \
 } while(0)
 
-uint8_t _flash_buf[ESP_ROM_SPIFLASH_BUFF_BYTE_READ_NUM];
+unsigned IRAM_ATTR esp_flash_io_enter(void)
+{
+    /* disable interrupts and the cache */
+    unsigned state = irq_disable();
+    Cache_Read_Disable(PRO_CPU_NUM);
+    return state;
+}
+
+void IRAM_ATTR esp_flash_io_exit(unsigned state)
+{
+    /* enable interrupts and the cache */
+    Cache_Read_Enable(PRO_CPU_NUM);
+    irq_restore(state);
+}
+
+bool IRAM_ATTR esp_flash_io_is_internal(const void *ptr, size_t len)
+{
+    /* the ROM functions can't access data in SPI RAM or flash */
+    return ((uintptr_t)ptr >= SOC_DRAM_LOW) &&
+           ((uintptr_t)ptr + len <= SOC_DRAM_HIGH);
+}
 
 esp_err_t IRAM_ATTR spi_flash_read(size_t addr, void *buff, size_t size)
 {
@@ -231,69 +253,7 @@ esp_err_t IRAM_ATTR spi_flash_read(size_t addr, void *buff, size_t size)
     /* size must be within the flash address space */
     CHECK_PARAM_RET (addr + size <= _flash_end, -EOVERFLOW);
 
-    int result = ESP_ROM_SPIFLASH_RESULT_OK;
-    uint32_t len = size;
-
-    /* if addr is not 4 byte aligned, we need to read the first full word */
-    if (addr & 0x3) {
-        uint32_t word_addr = addr & ~0x3;
-        uint32_t pos_in_word = addr & 0x3;
-        uint32_t len_in_word = 4 - pos_in_word;
-        len_in_word = (len_in_word < len) ? len_in_word : len;
-
-        /* disable interrupts and the cache */
-        critical_enter();
-        Cache_Read_Disable(PRO_CPU_NUM);
-
-        result = esp_rom_spiflash_read (word_addr, (uint32_t*)_flash_buf, 4);
-        memcpy(buff, _flash_buf + pos_in_word, len_in_word);
-
-        /* enable interrupts and the cache */
-        Cache_Read_Enable(PRO_CPU_NUM);
-        critical_exit();
-
-        buff  = (uint8_t*)buff + len_in_word;
-        addr += len_in_word;
-        len  -= len_in_word;
-    }
-
-    /* read all full words, maximum ESP_ROM_SPIFLASH_BUFF_BYTE_READ_NUM
-       in one read operation */
-    while (len > 4 && result == ESP_ROM_SPIFLASH_RESULT_OK) {
-        uint32_t len_full_words = len & ~0x3;
-        if (len_full_words > ESP_ROM_SPIFLASH_BUFF_BYTE_READ_NUM) {
-            len_full_words = ESP_ROM_SPIFLASH_BUFF_BYTE_READ_NUM;
-        }
-
-        /* disable interrupts and the cache */
-        critical_enter();
-        Cache_Read_Disable(PRO_CPU_NUM);
-
-        result |= esp_rom_spiflash_read (addr, (uint32_t*)_flash_buf, len_full_words);
-        memcpy(buff, _flash_buf, len_full_words);
-
-        /* enable interrupts and the cache */
-        Cache_Read_Enable(PRO_CPU_NUM);
-        critical_exit();
-
-        buff  = (uint8_t*)buff + len_full_words;
-        addr += len_full_words;
-        len  -= len_full_words;
-    }
-
-    /* if there is some remaining, we need to prepare last word */
-    if (len && result == ESP_ROM_SPIFLASH_RESULT_OK) {
-        /* disable interrupts and the cache */
-        critical_enter();
-        Cache_Read_Disable(PRO_CPU_NUM);
-
-        result |= esp_rom_spiflash_read (addr, (uint32_t*)_flash_buf, 4);
-        memcpy(buff, _flash_buf, len);
-
-        /* enable interrupts and the cache */
-        Cache_Read_Enable(PRO_CPU_NUM);
-        critical_exit();
-    }
+    int result = esp_flash_io_read(addr, buff, size);
 
     /* return with the ESP-IDF error code that is mapped from ROM error code */
     RETURN_WITH_ESP_ERR_CODE(result);
@@ -310,69 +270,9 @@ esp_err_t IRAM_ATTR spi_flash_write(size_t addr, const void *buff, size_t size)
 
     /* prepare for write access */
     int result = esp_rom_spiflash_unlock();
-    uint32_t len = size;
-
-    /* if addr is not 4 byte aligned, we need to prepare first full word */
-    if (addr & 0x3 && result == ESP_ROM_SPIFLASH_RESULT_OK) {
-        uint32_t word_addr = addr & ~0x3;
-        uint32_t pos_in_word = addr & 0x3;
-        uint32_t len_in_word = 4 - pos_in_word;
-        len_in_word = (len_in_word < len) ? len_in_word : len;
-
-        /* disable interrupts and the cache */
-        critical_enter();
-        Cache_Read_Disable(PRO_CPU_NUM);
-
-        result |= esp_rom_spiflash_read (word_addr, (uint32_t*)_flash_buf, 4);
-        memcpy(_flash_buf + pos_in_word, buff, len_in_word);
-        result |= esp_rom_spiflash_write (word_addr, (uint32_t*)_flash_buf, 4);
-
-        /* enable interrupts and the cache */
-        Cache_Read_Enable(PRO_CPU_NUM);
-        critical_exit();
-
-        buff  = (uint8_t*)buff + len_in_word;
-        addr += len_in_word;
-        len  -= len_in_word;
-    }
-
-    /* write all full words, maximum ESP_ROM_SPIFLASH_BUFF_BYTE_WRITE_NUM
-       in one write operation */
-    while (len > 4 && result == ESP_ROM_SPIFLASH_RESULT_OK) {
-        uint32_t len_full_words = len & ~0x3;
-        if (len_full_words > ESP_ROM_SPIFLASH_BUFF_BYTE_WRITE_NUM) {
-            len_full_words = ESP_ROM_SPIFLASH_BUFF_BYTE_WRITE_NUM;
-        }
-
-        /* disable interrupts and the cache */
-        critical_enter();
-        Cache_Read_Disable(PRO_CPU_NUM);
-
-        memcpy(_flash_buf, buff, len_full_words);
-        result |= esp_rom_spiflash_write (addr, (uint32_t*)_flash_buf, len_full_words);
-
-        /* enable interrupts and the cache */
-        Cache_Read_Enable(PRO_CPU_NUM);
-        critical_exit();
 
-        buff  = (uint8_t*)buff + len_full_words;
-        addr += len_full_words;
-        len  -= len_full_words;
-    }
-
-    /* if there is some remaining, we need to prepare last word */
-    if (len && result == ESP_ROM_SPIFLASH_RESULT_OK) {
-        /* disable interrupts and the cache */
-        critical_enter();
-        Cache_Read_Disable(PRO_CPU_NUM);
-
-        result |= esp_rom_spiflash_read (addr, (uint32_t*)_flash_buf, 4);
-        memcpy(_flash_buf, buff, len);
-        result |= esp_rom_spiflash_write (addr, (uint32_t*)_flash_buf, 4);
-
-        /* enable interrupts and the cache */
-        Cache_Read_Enable(PRO_CPU_NUM);
-        critical_exit();
+    if (result == ESP_ROM_SPIFLASH_RESULT_OK) {
+        result = esp_flash_io_write(addr, buff, size);
     }
 
     /* reset write access */
@@ -425,6 +325,11 @@ esp_err_t IRAM_ATTR spi_flash_erase_range(size_t addr, size_t size)
         critical_exit();
     }
 
+    /* cached data of the erased sectors becomes invalid, this is done after
+     * the erase, since a read during the erase could fill the cache again,
+     * and also on errors, since some sectors may have been erased */
+    esp_flash_io_invalidate(addr, size);
+
     /* reset write access */
     esp_rom_spiflash_lock();
 
@@ -0,0 +1,346 @@
+/*
+ * Copyright (C) 2021 Gunar Schorcht
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     cpu_esp_common
+ * @{
+ *
+ * @file
+ * @brief       Chunked SPI flash access with read cache for ESP SoCs
+ *
+ * @author      Gunar Schorcht <gunar@schorcht.net>
+ * @}
+ */
+
+#include <assert.h>
+#include <inttypes.h>
+#include <string.h>
+
+#include "esp_attr.h"
+#include "mutex.h"
+#include "rom/spi_flash.h"
+
+#include "esp_flash_io.h"
+
+#define ENABLE_DEBUG    0
+#include "debug.h"
+
+/* the bounce buffer is used for reads and writes */
+#define BOUNCE_SIZE     (ESP_ROM_SPIFLASH_BUFF_BYTE_READ_NUM)
+#define LINE_MASK       (ESP_FLASH_IO_CACHE_LINE_SIZE - 1)
+
+#if ESP_ROM_SPIFLASH_BUFF_BYTE_WRITE_NUM > ESP_ROM_SPIFLASH_BUFF_BYTE_READ_NUM
+#error "The bounce buffer is too small for writes"
+#endif
+
+/* serializes the use of the bounce buffer and the cache */
+static mutex_t _lock = MUTEX_INIT;
+static uint32_t _bounce[BOUNCE_SIZE >> 2];
+static esp_flash_io_stats_t _stats;
+
+#if ESP_FLASH_IO_CACHE_NUMOF
+typedef struct {
+    uint32_t addr;      /* flash address of the line */
+    bool valid;         /* line contains the data at addr */
+    uint32_t data[ESP_FLASH_IO_CACHE_LINE_SIZE >> 2];
+} _cache_line_t;
+
+static _cache_line_t _cache[ESP_FLASH_IO_CACHE_NUMOF];
+static unsigned _cache_victim;  /* next line to be replaced */
+#endif
+
+static inline uint32_t _min(uint32_t a, uint32_t b)
+{
+    return (a < b) ? a : b;
+}
+
+/*
+ * The ROM functions are called with the flash cache disabled, therefore
+ * the calling code has to be in IRAM.
+ */
+static int IRAM_ATTR _rom_read(uint32_t addr, uint32_t *buf, uint32_t len)
+{
+    unsigned state = esp_flash_io_enter();
+    int res = esp_rom_spiflash_read(addr, buf, len);
+    esp_flash_io_exit(state);
+    return res;
+}
+
+static int IRAM_ATTR _rom_write(uint32_t addr, const uint32_t *buf,
+                                uint32_t len)
+{
+    unsigned state = esp_flash_io_enter();
+    int res = esp_rom_spiflash_write(addr, buf, len);
+    esp_flash_io_exit(state);
+    return res;
+}
+
+/* word aligned buffers in internal RAM are passed to the ROM functions */
+static bool _is_direct(const void *buf, size_t len)
+{
+    return !((uintptr_t)buf & 0x3) && esp_flash_io_is_internal(buf, len);
+}
+
+static int _read_uncached(uint32_t addr, uint8_t *buf, size_t len)
+{
+    int res = ESP_ROM_SPIFLASH_RESULT_OK;
+
+    /* if addr is not 4 byte aligned, we need to read the first full word */
+    if (addr & 0x3) {
+        uint32_t pos_in_word = addr & 0x3;
+        uint32_t len_in_word = _min(4 - pos_in_word, len);
+
+        res = _rom_read(addr & ~0x3, _bounce, 4);
+        memcpy(buf, (uint8_t *)_bounce + pos_in_word, len_in_word);
+        _stats.rom_bounced++;
+
+        buf  += len_in_word;
+        addr += len_in_word;
+        len  -= len_in_word;
+    }
+
+    /* read all full words, directly in chunks if possible */
+    bool direct = _is_direct(buf, len);
+
+    while (len >= 4 && res == ESP_ROM_SPIFLASH_RESULT_OK) {
+        uint32_t len_full_words = len & ~0x3;
+
+        if (direct) {
+            len_full_words = _min(len_full_words, ESP_FLASH_IO_CHUNK_SIZE);
+            /* alignment was checked by _is_direct */
+            res = _rom_read(addr, (uint32_t *)(uintptr_t)buf, len_full_words);
+            _stats.rom_direct++;
+        }
+        else {
+            len_full_words = _min(len_full_words, BOUNCE_SIZE);
+            res = _rom_read(addr, _bounce, len_full_words);
+            memcpy(buf, _bounce, len_full_words);
+            _stats.rom_bounced++;
+        }
+
+        buf  += len_full_words;
+        addr += len_full_words;
+        len  -= len_full_words;
+    }
+
+    /* if there is some remaining, we need to read the last word */
+    if (len && res == ESP_ROM_SPIFLASH_RESULT_OK) {
+        res = _rom_read(addr, _bounce, 4);
+        memcpy(buf, _bounce, len);
+        _stats.rom_bounced++;
+    }
+
+    return res;
+}
+
+static int _write_words(uint32_t addr, const uint8_t *buf, size_t len,
+                        size_t *written)
+{
+    int res = ESP_ROM_SPIFLASH_RESULT_OK;
+    bool direct = _is_direct(buf, len);
+
+    *written = 0;
+    while (len >= 4 && res == ESP_ROM_SPIFLASH_RESULT_OK) {
+        uint32_t len_full_words = len & ~0x3;
+
+        if (direct) {
+            len_full_words = _min(len_full_words, ESP_FLASH_IO_CHUNK_SIZE);
+            /* alignment was checked by _is_direct */
+            res = _rom_write(addr, (const uint32_t *)(uintptr_t)buf,
+                             len_full_words);
+            _stats.rom_direct++;
+        }
+        else {
+            len_full_words = _min(len_full_words,
+                                  ESP_ROM_SPIFLASH_BUFF_BYTE_WRITE_NUM);
+            memcpy(_bounce, buf, len_full_words);
+            res = _rom_write(addr, _bounce, len_full_words);
+            _stats.rom_bounced++;
+        }
+
+        buf  += len_full_words;
+        addr += len_full_words;
+        len  -= len_full_words;
+        *written += len_full_words;
+    }
+    return res;
+}
+
+/* read-modify-write of a part of a word */
+static int _write_part_of_word(uint32_t addr, const uint8_t *buf, size_t len)
+{
+    uint32_t pos_in_word = addr & 0x3;
+
+    assert(pos_in_word + len <= 4);
+
+    int res = _rom_read(addr & ~0x3, _bounce, 4);
+    if (res == ESP_ROM_SPIFLASH_RESULT_OK) {
+        memcpy((uint8_t *)_bounce + pos_in_word, buf, len);
+        res = _rom_write(addr & ~0x3, _bounce, 4);
+    }
+    _stats.rom_bounced += 2;
+    return res;
+}
+
+static void _invalidate(uint32_t addr, size_t len)
+{
+#if ESP_FLASH_IO_CACHE_NUMOF
+    for (unsigned i = 0; i < ESP_FLASH_IO_CACHE_NUMOF; i++) {
+        _cache_line_t *line = &_cache[i];
+        if (line->valid && (line->addr < addr + len) &&
+            (addr < line->addr + ESP_FLASH_IO_CACHE_LINE_SIZE)) {
+            DEBUG("%s line=%u addr=%08"PRIx32"\n", __func__, i, line->addr);
+            line->valid = false;
+            _stats.invalidations++;
+        }
+    }
+#else
+    (void)addr;
+    (void)len;
+#endif
+}
+
+#if ESP_FLASH_IO_CACHE_NUMOF
+static _cache_line_t *_cache_get(uint32_t line_addr, int *res)
+{
+    for (unsigned i = 0; i < ESP_FLASH_IO_CACHE_NUMOF; i++) {
+        if (_cache[i].valid && _cache[i].addr == line_addr) {
+            _stats.cache_hits++;
+            return &_cache[i];
+        }
+    }
+
+    /* replace the lines round robin */
+    _cache_line_t *line = &_cache[_cache_victim];
+    _cache_victim = (_cache_victim + 1) % ESP_FLASH_IO_CACHE_NUMOF;
+
+    DEBUG("%s fill addr=%08"PRIx32"\n", __func__, line_addr);
+
+    line->valid = false;
+    _stats.cache_misses++;
+
+    /* the line is in internal RAM and word aligned */
+    for (uint32_t off = 0; off < ESP_FLASH_IO_CACHE_LINE_SIZE;
+         off += ESP_FLASH_IO_CHUNK_SIZE) {
+        *res = _rom_read(line_addr + off, &line->data[off >> 2],
+                         ESP_FLASH_IO_CHUNK_SIZE);
+        _stats.rom_direct++;
+        if (*res != ESP_ROM_SPIFLASH_RESULT_OK) {
+            return NULL;
+        }
+    }
+
+    line->addr = line_addr;
+    line->valid = true;
+    return line;
+}
+#endif
+
+int esp_flash_io_read(uint32_t addr, void *buf, size_t len)
+{
+    assert(buf != NULL || len == 0);
+
+    int res = ESP_ROM_SPIFLASH_RESULT_OK;
+    uint8_t *dst = buf;
+
+    mutex_lock(&_lock);
+    _stats.reads++;
+
+#if ESP_FLASH_IO_CACHE_NUMOF
+    /* small reads are served from the cache, large reads would thrash it */
+    if (len < ESP_FLASH_IO_CACHE_LINE_SIZE) {
+        while (len && res == ESP_ROM_SPIFLASH_RESULT_OK) {
+            uint32_t off = addr & LINE_MASK;
+            uint32_t len_in_line = _min(len, ESP_FLASH_IO_CACHE_LINE_SIZE - off);
+
+            _cache_line_t *line = _cache_get(addr - off, &res);
+            if (line) {
+                memcpy(dst, (uint8_t *)line->data + off, len_in_line);
+            }
+
+            dst  += len_in_line;
+            addr += len_in_line;
+            len  -= len_in_line;
+        }
+        mutex_unlock(&_lock);
+        return res;
+    }
+#endif
+
+    res = _read_uncached(addr, dst, len);
+
+    mutex_unlock(&_lock);
+    return res;
+}
+
+int esp_flash_io_write(uint32_t addr, const void *buf, size_t len)
+{
+    assert(buf != NULL || len == 0);
+
+    int res = ESP_ROM_SPIFLASH_RESULT_OK;
+    const uint8_t *src = buf;
+
+    mutex_lock(&_lock);
+    _stats.writes++;
+
+    /* invalidate first, the data may be changed partially on errors */
+    _invalidate(addr, len);
+
+    /* if addr is not 4 byte aligned, we need to prepare first full word */
+    if (addr & 0x3) {
+        uint32_t len_in_word = _min(4 - (addr & 0x3), len);
+
+        res = _write_part_of_word(addr, src, len_in_word);
+
+        src  += len_in_word;
+        addr += len_in_word;
+        len  -= len_in_word;
+    }
+
+    /* write all full words, directly in chunks if possible */
+    if (res == ESP_ROM_SPIFLASH_RESULT_OK) {
+        size_t written;
+
+        res = _write_words(addr, src, len, &written);
+
+        src  += written;
+        addr += written;
+        len  -= written;
+    }
+
+    /* if there is some remaining, we need to prepare last word */
+    if (len && res == ESP_ROM_SPIFLASH_RESULT_OK) {
+        res = _write_part_of_word(addr, src, len);
+    }
+
+    mutex_unlock(&_lock);
+    return res;
+}
+
+void esp_flash_io_invalidate(uint32_t addr, size_t len)
+{
+    mutex_lock(&_lock);
+    _invalidate(addr, len);
+    mutex_unlock(&_lock);
+}
+
+void esp_flash_io_get_stats(esp_flash_io_stats_t *stats)
+{
+    assert(stats != NULL);
+
+    mutex_lock(&_lock);
+    *stats = _stats;
+    mutex_unlock(&_lock);
+}
+
+void esp_flash_io_reset_stats(void)
+{
+    mutex_lock(&_lock);
+    memset(&_stats, 0, sizeof(_stats));
+    mutex_unlock(&_lock);
+}
@@ -0,0 +1,184 @@
+/*
+ * Copyright (C) 2021 Gunar Schorcht
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     cpu_esp_common
+ * @{
+ *
+ * @file
+ * @brief       Chunked SPI flash access with read cache for ESP SoCs
+ *
+ * The ROM functions `esp_rom_spiflash_*` can only be called with the flash
+ * cache disabled, so they must not access data in memory that is mapped
+ * through the cache, such as external SPI RAM. Data is therefore bounced
+ * through a small static buffer in internal RAM. Word aligned buffers that
+ * are located in internal RAM are transferred directly in chunks of
+ * #ESP_FLASH_IO_CHUNK_SIZE bytes instead.
+ *
+ * Optionally, small reads are served from a cache of
+ * #ESP_FLASH_IO_CACHE_NUMOF lines of #ESP_FLASH_IO_CACHE_LINE_SIZE bytes,
+ * which is useful for file systems that read the same metadata over and over
+ * again. Lines are invalidated when data is written to or erased from their
+ * address range.
+ *
+ * The module does not depend on the ESP SDK other than on the ROM function
+ * interface, so it can be tested on any platform against an emulation of
+ * the ROM functions.
+ *
+ * @author      Gunar Schorcht <gunar@schorcht.net>
+ */
+
+#ifndef ESP_FLASH_IO_H
+#define ESP_FLASH_IO_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Maximum number of bytes transferred directly from or to a buffer
+ *          with the flash cache disabled
+ *
+ * Limits the time interrupts are disabled. It has to be a multiple of 4.
+ */
+#ifndef ESP_FLASH_IO_CHUNK_SIZE
+#define ESP_FLASH_IO_CHUNK_SIZE         (256)
+#endif
+
+/**
+ * @brief   Number of lines in the read cache, the cache is disabled by
+ *          default
+ *
+ * Each line takes #ESP_FLASH_IO_CACHE_LINE_SIZE bytes of RAM.
+ */
+#ifndef ESP_FLASH_IO_CACHE_NUMOF
+#define ESP_FLASH_IO_CACHE_NUMOF        (0)
+#endif
+
+/**
+ * @brief   Size of a line of the read cache
+ *
+ * It has to be a power of two and a multiple of #ESP_FLASH_IO_CHUNK_SIZE.
+ * Reads of at least this size bypass the cache. A read that misses the
+ * cache reads a whole line from the flash, so larger lines only pay off if
+ * small reads hit close to each other.
+ */
+#ifndef ESP_FLASH_IO_CACHE_LINE_SIZE
+#define ESP_FLASH_IO_CACHE_LINE_SIZE    (ESP_FLASH_IO_CHUNK_SIZE)
+#endif
+
+#if (ESP_FLASH_IO_CHUNK_SIZE & 0x3)
+#error "ESP_FLASH_IO_CHUNK_SIZE has to be a multiple of 4"
+#endif
+
+#if (ESP_FLASH_IO_CACHE_LINE_SIZE & (ESP_FLASH_IO_CACHE_LINE_SIZE - 1)) || \
+    (ESP_FLASH_IO_CACHE_LINE_SIZE % ESP_FLASH_IO_CHUNK_SIZE)
+#error "ESP_FLASH_IO_CACHE_LINE_SIZE has to be a power of two and a multiple of ESP_FLASH_IO_CHUNK_SIZE"
+#endif
+
+/**
+ * @brief   Statistics of the flash accesses
+ */
+typedef struct {
+    uint32_t reads;         /**< number of read requests */
+    uint32_t writes;        /**< number of write requests */
+    uint32_t cache_hits;    /**< cache lines found for read requests */
+    uint32_t cache_misses;  /**< cache lines filled for read requests */
+    uint32_t invalidations; /**< cache lines invalidated by writes/erases */
+    uint32_t rom_direct;    /**< ROM calls with the caller's buffer */
+    uint32_t rom_bounced;   /**< ROM calls with the bounce buffer */
+} esp_flash_io_stats_t;
+
+/**
+ * @brief   Read data from the SPI flash
+ *
+ * @param[in]   addr    flash address of the data
+ * @param[out]  buf     buffer for the data
+ * @param[in]   len     number of bytes to read
+ *
+ * @return  `ESP_ROM_SPIFLASH_RESULT_OK` on success
+ * @return  the error of the ROM function otherwise
+ */
+int esp_flash_io_read(uint32_t addr, void *buf, size_t len);
+
+/**
+ * @brief   Write data to the SPI flash
+ *
+ * The affected region has to be erased before.
+ *
+ * @param[in]   addr    flash address of the data
+ * @param[in]   buf     data to write
+ * @param[in]   len     number of bytes to write
+ *
+ * @return  `ESP_ROM_SPIFLASH_RESULT_OK` on success
+ * @return  the error of the ROM function otherwise
+ */
+int esp_flash_io_write(uint32_t addr, const void *buf, size_t len);
+
+/**
+ * @brief   Invalidate cached data in a region of the SPI flash
+ *
+ * Has to be called when the region is changed by other means than
+ * @ref esp_flash_io_write, e.g. when it is erased.
+ *
+ * @param[in]   addr    flash address of the region
+ * @param[in]   len     size of the region in bytes
+ */
+void esp_flash_io_invalidate(uint32_t addr, size_t len);
+
+/**
+ * @brief   Get the statistics of the flash accesses
+ *
+ * @param[out]  stats   the statistics
+ */
+void esp_flash_io_get_stats(esp_flash_io_stats_t *stats);
+
+/**
+ * @brief   Reset the statistics of the flash accesses
+ */
+void esp_flash_io_reset_stats(void);
+
+/**
+ * @name    Functions provided by the CPU
+ * @{
+ */
+/**
+ * @brief   Disable interrupts and the flash cache for a ROM function call
+ *
+ * @return  the interrupt state to be restored by @ref esp_flash_io_exit
+ */
+unsigned esp_flash_io_enter(void);
+
+/**
+ * @brief   Enable the flash cache and restore interrupts after a ROM
+ *          function call
+ *
+ * @param[in]   state   interrupt state returned by @ref esp_flash_io_enter
+ */
+void esp_flash_io_exit(unsigned state);
+
+/**
+ * @brief   Check whether a buffer can be accessed with the flash cache
+ *          disabled, i.e. whether it is located in internal RAM
+ *
+ * @param[in]   ptr     start of the buffer
+ * @param[in]   len     size of the buffer in bytes
+ */
+bool esp_flash_io_is_internal(const void *ptr, size_t len);
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ESP_FLASH_IO_H */
+/** @} */
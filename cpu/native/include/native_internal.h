@@ -20,6 +20,7 @@
 #define NATIVE_INTERNAL_H
 
 #include <signal.h>
+#include <stdbool.h>
 #include <stdio.h>
 #include <poll.h>
 /* enable signal handler register access on different platforms
@@ -167,6 +168,16 @@ ssize_t _native_read(int fd, void *buf, size_t count);
 ssize_t _native_write(int fd, const void *buf, size_t count);
 ssize_t _native_writev(int fildes, const struct iovec *iov, int iovcnt);
 
+#ifdef MODULE_NATIVE_VIRTUAL_TIME
+/**
+ * Advance the virtual clock to the next timer expiry and queue the timer
+ * interrupt. Called from the idle loop when all threads are blocked.
+ *
+ * @return true if a timer interrupt is pending, false if no timer is armed
+ */
+bool native_virtual_time_advance(void);
+#endif
+
 /**
  * @endcond
  */
@@ -43,12 +43,20 @@ extern "C" {
 /**
  * @brief xtimer configuration
  */
+#ifdef MODULE_NATIVE_VIRTUAL_TIME
+/* virtual time does not pass while the CPU is busy, so timer_set_absolute()
+ * cannot underflow, but xtimer would spin forever waiting for short timeouts.
+ */
+#define XTIMER_BACKOFF      1
+#define XTIMER_ISR_BACKOFF  1
+#else
 /* timer_set_absolute() has a high margin for possible underflow if set with
  * value not far in the future. To prevent this, we set high backoff values
  * here.
  */
 #define XTIMER_BACKOFF      200
 #define XTIMER_ISR_BACKOFF  200
+#endif
 
 /** @} */
 
@@ -143,6 +143,49 @@ void native_print_signals(void)
     }
 }
 
+#ifdef MODULE_NATIVE_IRQ_SOFT
+/*
+ * Software interrupt masking: the host signal mask is left untouched and
+ * only the native_interrupts_enabled flag is toggled. Signals arriving while
+ * the flag is cleared are queued by native_isr_entry() in the signal pipe and
+ * replayed by _native_syscall_leave() once interrupts get enabled again.
+ */
+unsigned irq_disable(void)
+{
+    unsigned int prev_state = native_interrupts_enabled;
+
+    native_interrupts_enabled = 0;
+
+    return prev_state;
+}
+
+unsigned irq_enable(void)
+{
+    unsigned int prev_state;
+
+    if (_native_in_isr == 1) {
+        DEBUG("irq_enable + _native_in_isr\n");
+    }
+
+    _native_syscall_enter();
+    prev_state = native_interrupts_enabled;
+    native_interrupts_enabled = 1;
+    /* dispatches deferred signals, if any */
+    _native_syscall_leave();
+
+    return prev_state;
+}
+
+void irq_restore(unsigned state)
+{
+    if (state == 1) {
+        irq_enable();
+    }
+    else {
+        native_interrupts_enabled = 0;
+    }
+}
+#else /* MODULE_NATIVE_IRQ_SOFT */
 /**
  * block signals
  */
@@ -219,6 +262,7 @@ void irq_restore(unsigned state)
 
     return;
 }
+#endif /* MODULE_NATIVE_IRQ_SOFT */
 
 int irq_is_in(void)
 {
@@ -254,9 +298,28 @@ void native_irq_handler(void)
 {
     DEBUG("\n\n\t\tnative_irq_handler\n\n");
 
-    while (_native_sigpend > 0) {
-        int sig = _native_popsig();
-        _native_sigpend--;
+    while (1) {
+#ifdef MODULE_NATIVE_IRQ_SOFT
+        /* the signals are not blocked during the ISR in this mode, block
+         * them while taking the next one, native_isr_entry() updates
+         * _native_sigpend as well */
+        sigset_t prev;
+        if (sigprocmask(SIG_SETMASK, &_native_sig_set_dint, &prev) == -1) {
+            err(EXIT_FAILURE, "native_irq_handler: sigprocmask");
+        }
+#endif
+        int sig = (_native_sigpend > 0) ? _native_popsig() : 0;
+        if (sig) {
+            _native_sigpend--;
+        }
+#ifdef MODULE_NATIVE_IRQ_SOFT
+        if (sigprocmask(SIG_SETMASK, &prev, NULL) == -1) {
+            err(EXIT_FAILURE, "native_irq_handler: sigprocmask");
+        }
+#endif
+        if (sig == 0) {
+            break;
+        }
 
         if (native_irq_handlers[sig] != NULL) {
             DEBUG("native_irq_handler: calling interrupt handler for %i\n", sig);
@@ -276,7 +339,12 @@ void native_irq_handler(void)
 
 void isr_set_sigmask(ucontext_t *ctx)
 {
+#ifdef MODULE_NATIVE_IRQ_SOFT
+    /* signals stay unblocked, native_isr_entry() defers them */
+    (void)ctx;
+#else
     ctx->uc_sigmask = _native_sig_set_dint;
+#endif
     native_interrupts_enabled = 0;
 }
 
@@ -380,6 +448,16 @@ void set_signal_handler(int sig, bool add)
         err(EXIT_FAILURE, "set_signal_handler: sigdelset");
     }
 
+#ifdef MODULE_NATIVE_IRQ_SOFT
+    /* irq_enable() does not touch the host signal mask in this mode, so the
+     * updated mask has to be applied right away */
+    _native_syscall_enter();
+    if (sigprocmask(SIG_SETMASK, &_native_sig_set, NULL) == -1) {
+        err(EXIT_FAILURE, "set_signal_handler: sigprocmask");
+    }
+    _native_syscall_leave();
+#endif
+
     memset(&sa, 0, sizeof(sa));
 
     /* Disable other signal during execution of the handler for this signal. */
@@ -541,6 +619,11 @@ void native_interrupt_init(void)
         err(EXIT_FAILURE, "native_interrupt_init: sigaction");
     }
 
+#ifdef MODULE_NATIVE_IRQ_SOFT
+    if (sigprocmask(SIG_SETMASK, &_native_sig_set, NULL) == -1) {
+        err(EXIT_FAILURE, "native_interrupt_init: sigprocmask");
+    }
+#endif
 
     puts("RIOT native interrupts/signals initialized.");
 }
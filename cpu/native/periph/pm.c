@@ -39,7 +39,20 @@
 static void _native_sleep(void)
 {
     _native_in_syscall++; /* no switching here */
+#if defined(MODULE_NATIVE_VIRTUAL_TIME)
+    /* all threads are idle: jump to the next timer expiry instead of waiting
+     * for it, only block if there is nothing left to do */
+    if ((_native_sigpend == 0) && !native_virtual_time_advance()) {
+        real_pause();
+    }
+#elif defined(MODULE_NATIVE_IRQ_SOFT)
+    /* signals may already be queued while interrupts were soft-disabled */
+    if (_native_sigpend == 0) {
+        real_pause();
+    }
+#else
     real_pause();
+#endif
     _native_in_syscall--;
 
     if (_native_sigpend > 0) {
@@ -17,6 +17,10 @@
  *
  * Uses POSIX realtime clock and POSIX itimer to mimic hardware.
  *
+ * With the `native_virtual_time` module, the timer is driven by a virtual
+ * clock instead: it only advances when all threads are idle, then jumps
+ * directly to the next expiry (see @ref native_virtual_time_advance).
+ *
  * This is based on native's hwtimer implementation by Ludwig Knüpfer.
  * I removed the multiplexing, as xtimer does the same. (kaspar)
  *
@@ -38,7 +42,9 @@
 #include <time.h>
 #include <sys/time.h>
 #include <signal.h>
+#include <stdbool.h>
 #include <stdint.h>
+#include <inttypes.h>
 #include <stdlib.h>
 #include <string.h>
 #include <err.h>
@@ -58,8 +64,57 @@ static unsigned long time_null;
 static timer_cb_t _callback;
 static void *_cb_arg;
 
+#ifndef MODULE_NATIVE_VIRTUAL_TIME
 static struct itimerval itv;
+#endif
+
+#ifdef MODULE_NATIVE_VIRTUAL_TIME
+static uint64_t _vt_now;          /**< virtual time in ticks */
+static uint64_t _vt_deadline;     /**< absolute expiry of the armed timer */
+static uint32_t _vt_interval;     /**< reload value for periodic timers */
+static uint32_t _vt_remaining;    /**< ticks left when the timer was stopped */
+static bool _vt_armed;
+static bool _vt_pending;          /**< expiry queued but not yet dispatched */
 
+/**
+ * queue a timer interrupt like native_isr_entry() does for SIGALRM
+ */
+static void _vt_fire(void)
+{
+    int sig = SIGALRM;
+
+    if (_vt_interval) {
+        _vt_deadline += _vt_interval;
+    }
+    else {
+        _vt_armed = false;
+    }
+
+    _vt_pending = true;
+    if (real_write(_sig_pipefd[1], &sig, sizeof(int)) == -1) {
+        err(EXIT_FAILURE, "_vt_fire: real_write()");
+    }
+    /* a signal handler might increment concurrently */
+    __atomic_fetch_add(&_native_sigpend, 1, __ATOMIC_SEQ_CST);
+}
+
+bool native_virtual_time_advance(void)
+{
+    if (!_vt_armed || _vt_pending) {
+        return _vt_pending;
+    }
+
+    if (_vt_deadline > _vt_now) {
+        DEBUG("%s: %" PRIu64 " -> %" PRIu64 "\n", __func__, _vt_now, _vt_deadline);
+        _vt_now = _vt_deadline;
+    }
+    _vt_fire();
+
+    return true;
+}
+#endif
+
+#ifndef MODULE_NATIVE_VIRTUAL_TIME
 /**
  * returns ticks for give timespec
  */
@@ -68,6 +123,7 @@ static unsigned long ts2ticks(struct timespec *tp)
     /* TODO: check for overflow */
     return (((unsigned long)tp->tv_sec * NATIVE_TIMER_SPEED) + (tp->tv_nsec / 1000));
 }
+#endif
 
 /**
  * native timer signal handler
@@ -78,6 +134,10 @@ void native_isr_timer(void)
 {
     DEBUG("%s\n", __func__);
 
+#ifdef MODULE_NATIVE_VIRTUAL_TIME
+    _vt_pending = false;
+#endif
+
     _callback(_cb_arg, 0);
 }
 
@@ -113,6 +173,12 @@ static void do_timer_set(tim_t dev, unsigned int offset, bool periodic)
         offset = NATIVE_TIMER_MIN_RES;
     }
 
+#ifdef MODULE_NATIVE_VIRTUAL_TIME
+    _vt_armed = (offset != 0);
+    _vt_deadline = _vt_now + offset;
+    _vt_interval = periodic ? offset : 0;
+    (void)dev;
+#else
     memset(&itv, 0, sizeof(itv));
     itv.it_value.tv_sec = (offset / 1000000);
     itv.it_value.tv_usec = offset % 1000000;
@@ -123,6 +189,7 @@ static void do_timer_set(tim_t dev, unsigned int offset, bool periodic)
     DEBUG("timer_set(): setting %lu.%06lu\n", itv.it_value.tv_sec, itv.it_value.tv_usec);
 
     timer_start(dev);
+#endif
 }
 
 int timer_set(tim_t dev, int channel, unsigned int offset)
@@ -175,11 +242,19 @@ void timer_start(tim_t dev)
     (void)dev;
     DEBUG("%s\n", __func__);
 
+#ifdef MODULE_NATIVE_VIRTUAL_TIME
+    if (!_vt_armed && _vt_remaining) {
+        _vt_armed = true;
+        _vt_deadline = _vt_now + _vt_remaining;
+        _vt_remaining = 0;
+    }
+#else
     _native_syscall_enter();
     if (real_setitimer(ITIMER_REAL, &itv, NULL) == -1) {
         err(EXIT_FAILURE, "timer_arm: setitimer");
     }
     _native_syscall_leave();
+#endif
 }
 
 void timer_stop(tim_t dev)
@@ -187,6 +262,12 @@ void timer_stop(tim_t dev)
     (void)dev;
     DEBUG("%s\n", __func__);
 
+#ifdef MODULE_NATIVE_VIRTUAL_TIME
+    if (_vt_armed) {
+        _vt_remaining = _vt_deadline - _vt_now;
+        _vt_armed = false;
+    }
+#else
     _native_syscall_enter();
     struct itimerval zero = {0};
     if (real_setitimer(ITIMER_REAL, &zero, &itv) == -1) {
@@ -195,6 +276,7 @@ void timer_stop(tim_t dev)
     _native_syscall_leave();
 
     DEBUG("time left: %lu.%06lu\n", itv.it_value.tv_sec, itv.it_value.tv_usec);
+#endif
 }
 
 unsigned int timer_read(tim_t dev)
@@ -203,10 +285,14 @@ unsigned int timer_read(tim_t dev)
         return 0;
     }
 
-    struct timespec t;
-
     DEBUG("timer_read()\n");
 
+#ifdef MODULE_NATIVE_VIRTUAL_TIME
+    /* time only passes when all threads are idle */
+    return _vt_now - time_null;
+#else
+    struct timespec t;
+
     _native_syscall_enter();
 #ifdef __MACH__
     clock_serv_t cclock;
@@ -226,4 +312,5 @@ unsigned int timer_read(tim_t dev)
     _native_syscall_leave();
 
     return ts2ticks(&t) - time_null;
+#endif
 }
@@ -346,7 +346,7 @@ struct netdev {
     netdev_t *lower;                               /**< ptr to the lower netdev layer */
 #endif
 #ifdef MODULE_L2FILTER
-    l2filter_t filter[CONFIG_L2FILTER_LISTSIZE];   /**< link layer address filters */
+    l2filter_list_t filter;                        /**< link layer address filters */
 #endif
 #ifdef MODULE_NETDEV_REGISTER
     netdev_type_t type;                     /**< driver type used for netdev */
@@ -15,6 +15,9 @@
  * @brief        This module defines implements the netdev API on top of the
  * IEEE 802.15.4 radio HAL
  *
+ * With the pseudomodule `netdev_ieee802154_submac_burst`, the fragments of a
+ * 6LoWPAN datagram are sent as a burst (see @ref ieee802154_send_burst).
+ *
  * @{
  *
  * @author       José I. Alamos <jose.alamos@haw-hamburg.de>
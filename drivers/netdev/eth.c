@@ -71,7 +71,7 @@ int netdev_eth_get(netdev_t *dev, netopt_t opt, void *value, size_t max_len)
         case NETOPT_L2FILTER:
             {
                 assert(max_len >= sizeof(l2filter_t **));
-                *((l2filter_t **)value) = dev->filter;
+                *((l2filter_t **)value) = dev->filter.entries;
                 res = sizeof(l2filter_t **);
                 break;
             }
@@ -100,10 +100,10 @@ int netdev_eth_set(netdev_t *dev, netopt_t opt, const void *value, size_t value_
 
 #ifdef MODULE_L2FILTER
         case NETOPT_L2FILTER:
-            res = l2filter_add(dev->filter, value, value_len);
+            res = l2filter_add(&dev->filter, value, value_len);
             break;
         case NETOPT_L2FILTER_RM:
-            res = l2filter_rm(dev->filter, value, value_len);
+            res = l2filter_rm(&dev->filter, value, value_len);
             break;
 #endif
         default:
@@ -168,7 +168,7 @@ int netdev_ieee802154_get(netdev_ieee802154_t *dev, netopt_t opt, void *value,
 #ifdef MODULE_L2FILTER
         case NETOPT_L2FILTER:
             assert(max_len >= sizeof(l2filter_t **));
-            *((l2filter_t **)value) = dev->netdev.filter;
+            *((l2filter_t **)value) = dev->netdev.filter.entries;
             res = sizeof(l2filter_t **);
             break;
 #endif
@@ -289,10 +289,10 @@ int netdev_ieee802154_set(netdev_ieee802154_t *dev, netopt_t opt, const void *va
 #endif
 #ifdef MODULE_L2FILTER
         case NETOPT_L2FILTER:
-            res = l2filter_add(dev->netdev.filter, value, len);
+            res = l2filter_add(&dev->netdev.filter, value, len);
             break;
         case NETOPT_L2FILTER_RM:
-            res = l2filter_rm(dev->netdev.filter, value, len);
+            res = l2filter_rm(&dev->netdev.filter, value, len);
             break;
 #endif
         default:
@@ -13,7 +13,10 @@
  * @author José I. Alamos <jose.alamos@haw-hamburg.de>
  */
 
+#include <string.h>
+
 #include "net/netdev/ieee802154_submac.h"
+#include "net/sixlowpan.h"
 #include "event/thread.h"
 
 static const ieee802154_submac_cb_t _cb;
@@ -150,11 +153,88 @@ void ieee802154_submac_ack_timer_cancel(ieee802154_submac_t *submac)
     xtimer_remove(&netdev_submac->ack_timer);
 }
 
+#if IS_USED(MODULE_NETDEV_IEEE802154_SUBMAC_BURST)
+static size_t _iolist_peek(const iolist_t *iol, size_t offset, void *buf,
+                           size_t len)
+{
+    size_t res = 0;
+
+    for (; iol && res < len; iol = iol->iol_next) {
+        if (offset >= iol->iol_len) {
+            offset -= iol->iol_len;
+            continue;
+        }
+        size_t n = iol->iol_len - offset;
+        if (n > len - res) {
+            n = len - res;
+        }
+        memcpy((uint8_t *)buf + res, (uint8_t *)iol->iol_base + offset, n);
+        res += n;
+        offset = 0;
+    }
+
+    return res;
+}
+
+/* Returns 1 if the frame is a 6LoWPAN fragment that is followed by further
+ * fragments of the same datagram, 0 if it is the last fragment and -1 if it
+ * is not a fragment. first is set if it is the first fragment. */
+static int _frag_more(const iolist_t *pkt, bool *first)
+{
+    const uint8_t *mhr = pkt->iol_base;
+    sixlowpan_frag_n_t hdr;
+
+    if ((pkt->iol_len < IEEE802154_FCF_LEN) ||
+        ((mhr[0] & IEEE802154_FCF_TYPE_MASK) != IEEE802154_FCF_TYPE_DATA) ||
+        (mhr[0] & IEEE802154_FCF_SECURITY_EN)) {
+        return -1;
+    }
+
+    size_t mhr_len = ieee802154_get_frame_hdr_len(mhr);
+    if ((mhr_len == 0) || (mhr_len > pkt->iol_len)) {
+        return -1;
+    }
+
+    size_t hdr_len = _iolist_peek(pkt, mhr_len, &hdr, sizeof(hdr));
+    if ((hdr_len < sizeof(sixlowpan_frag_t)) ||
+        !sixlowpan_frag_is((sixlowpan_frag_t *)&hdr)) {
+        return -1;
+    }
+
+    /* the first fragment is never the last one */
+    *first = sixlowpan_frag_1_is((sixlowpan_frag_t *)&hdr);
+    if (*first) {
+        return 1;
+    }
+    if (hdr_len < sizeof(hdr)) {
+        return -1;
+    }
+
+    size_t end = sixlowpan_frag_offset(&hdr) + iolist_size(pkt) - mhr_len -
+                 sizeof(sixlowpan_frag_n_t);
+    return end < sixlowpan_frag_datagram_size((sixlowpan_frag_t *)&hdr);
+}
+#endif
+
 static int _send(netdev_t *netdev, const iolist_t *pkt)
 {
     netdev_ieee802154_submac_t *netdev_submac =
         (netdev_ieee802154_submac_t *)netdev;
 
+#if IS_USED(MODULE_NETDEV_IEEE802154_SUBMAC_BURST)
+    /* the fragments of a datagram are sent as a burst */
+    bool first;
+    int more = _frag_more(pkt, &first);
+    if (more >= 0) {
+        if (first) {
+            /* the previous datagram may have ended without its last
+             * fragment, the first one starts a new burst in any case */
+            ieee802154_end_burst(&netdev_submac->submac);
+        }
+        return ieee802154_send_burst(&netdev_submac->submac, pkt, more);
+    }
+#endif
+
     return ieee802154_send(&netdev_submac->submac, pkt);
 }
 
@@ -62,3 +62,45 @@ bool bloom_check(bloom_t *bloom, const uint8_t *buf, size_t len)
 
     return true; /* ? */
 }
+
+/* binary logarithm in Q8 fixed point */
+static uint32_t _log2_q8(uint32_t x)
+{
+    unsigned ip = 0;
+
+    while (x >> (ip + 1)) {
+        ip++;
+    }
+
+    /* mantissa in [1, 2) in Q15 */
+    uint32_t m = (ip >= 15) ? (x >> (ip - 15)) : (x << (15 - ip));
+    uint32_t res = ip << 8;
+
+    for (unsigned bit = 1 << 7; bit; bit >>= 1) {
+        m = (m * m) >> 15;
+        if (m >= (2UL << 15)) {
+            m >>= 1;
+            res |= bit;
+        }
+    }
+
+    return res;
+}
+
+size_t bloom_calc_bits(size_t n, uint32_t fp_inv)
+{
+    /* m = -n * ln(p) / ln(2)^2 = n * log2(1 / p) / ln(2) */
+    uint64_t bits = ((uint64_t)n * _log2_q8(fp_inv < 2 ? 2 : fp_inv) * 739) >> 17;
+
+    bits = (bits + CHAR_BIT - 1) & ~(CHAR_BIT - 1);
+
+    return bits ? bits : CHAR_BIT;
+}
+
+size_t bloom_calc_hashes(uint32_t fp_inv)
+{
+    /* k = (m / n) * ln(2) = log2(1 / p) */
+    size_t k = (_log2_q8(fp_inv < 2 ? 2 : fp_inv) + 128) >> 8;
+
+    return k ? k : 1;
+}
@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2021 Gunar Schorcht
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_bloom
+ * @{
+ *
+ * @file
+ * @brief       Blocked Bloom filter implementation
+ *
+ * @author      Gunar Schorcht <gunar@schorcht.net>
+ *
+ * @}
+ */
+
+#include <string.h>
+
+#include "bloom.h"
+#include "bitfield.h"
+
+#define BLOCK_BITS  (CONFIG_BLOOM_BLOCKED_BLOCK_SIZE * 8)
+
+#if CONFIG_BLOOM_BLOCKED_BLOCK_SIZE & (CONFIG_BLOOM_BLOCKED_BLOCK_SIZE - 1)
+#error "CONFIG_BLOOM_BLOCKED_BLOCK_SIZE must be a power of two"
+#endif
+
+/* the lower half of the hash selects the block, the upper and the lower half
+ * are the two hashes of the positions inside the block */
+static uint8_t *_block(const bloom_blocked_t *bloom, uint64_t hash)
+{
+    size_t idx = ((hash & UINT32_MAX) * bloom->blocks) >> 32;
+
+    return &bloom->a[idx * CONFIG_BLOOM_BLOCKED_BLOCK_SIZE];
+}
+
+/* enhanced double hashing, the plain variant repeats the same few patterns
+ * of positions in a block of a power of two bits too often */
+static inline size_t _next(uint32_t *x, uint32_t *y, size_t n)
+{
+    size_t pos = *x & (BLOCK_BITS - 1);
+
+    *x += *y;
+    *y += n;
+
+    return pos;
+}
+
+void bloom_blocked_init(bloom_blocked_t *bloom, uint8_t *blocks, size_t numof,
+                        size_t k)
+{
+    memset(blocks, 0, BLOOM_BLOCKED_BYTES(numof));
+    bloom->a = blocks;
+    bloom->blocks = numof;
+    bloom->k = k;
+}
+
+size_t bloom_blocked_calc_blocks(size_t n, uint32_t fp_inv)
+{
+    /* the elements are not distributed evenly over the blocks, the more
+     * loaded blocks increase the false positive rate the more, the more bits
+     * are set per element, which is compensated by k / 32 more bits */
+    size_t bits = bloom_calc_bits(n, fp_inv);
+
+    bits += bits * bloom_calc_hashes(fp_inv) / 32;
+
+    return (bits + BLOCK_BITS - 1) / BLOCK_BITS;
+}
+
+void bloom_blocked_add(bloom_blocked_t *bloom, const uint8_t *buf, size_t len)
+{
+    uint64_t hash = bloom_hash64(buf, len);
+    uint8_t *block = _block(bloom, hash);
+    uint32_t x = hash >> 32;
+    uint32_t y = hash;
+
+    for (size_t n = 0; n < bloom->k; n++) {
+        bf_set(block, _next(&x, &y, n));
+    }
+}
+
+bool bloom_blocked_check(const bloom_blocked_t *bloom, const uint8_t *buf,
+                         size_t len)
+{
+    uint64_t hash = bloom_hash64(buf, len);
+    uint8_t *block = _block(bloom, hash);
+    uint32_t x = hash >> 32;
+    uint32_t y = hash;
+
+    for (size_t n = 0; n < bloom->k; n++) {
+        if (!bf_isset(block, _next(&x, &y, n))) {
+            return false;
+        }
+    }
+
+    return true;
+}
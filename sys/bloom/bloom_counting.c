@@ -0,0 +1,131 @@
+/*
+ * Copyright (C) 2021 Gunar Schorcht
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_bloom
+ * @{
+ *
+ * @file
+ * @brief       Counting Bloom filter implementation
+ *
+ * @author      Gunar Schorcht <gunar@schorcht.net>
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "bloom.h"
+
+#define COUNTER_MAX     (0xf)
+
+static unsigned _get(const bloom_counting_t *bloom, size_t pos)
+{
+    return (bloom->c[pos / 2] >> ((pos % 2) * 4)) & COUNTER_MAX;
+}
+
+static void _set(bloom_counting_t *bloom, size_t pos, unsigned val)
+{
+    unsigned shift = (pos % 2) * 4;
+
+    bloom->c[pos / 2] = (bloom->c[pos / 2] & ~(COUNTER_MAX << shift)) |
+                        (val << shift);
+}
+
+/* enhanced double hashing, the modulo is calculated only once */
+typedef struct {
+    size_t pos;
+    size_t step;
+} _iter_t;
+
+static void _iter_init(const bloom_counting_t *bloom, _iter_t *it,
+                       const uint8_t *buf, size_t len)
+{
+    uint64_t hash = bloom_hash64(buf, len);
+
+    it->pos = (uint32_t)hash % bloom->m;
+    it->step = (uint32_t)(hash >> 32) % bloom->m;
+}
+
+static size_t _iter_next(const bloom_counting_t *bloom, _iter_t *it)
+{
+    size_t pos = it->pos;
+
+    it->pos += it->step;
+    if (it->pos >= bloom->m) {
+        it->pos -= bloom->m;
+    }
+    if (++it->step >= bloom->m) {
+        it->step = 0;
+    }
+
+    return pos;
+}
+
+void bloom_counting_init(bloom_counting_t *bloom, uint8_t *counters, size_t m,
+                         size_t k)
+{
+    memset(counters, 0, BLOOM_COUNTING_BYTES(m));
+    bloom->c = counters;
+    bloom->m = m;
+    bloom->k = k;
+}
+
+void bloom_counting_add(bloom_counting_t *bloom, const uint8_t *buf, size_t len)
+{
+    _iter_t it;
+
+    _iter_init(bloom, &it, buf, len);
+    for (size_t n = 0; n < bloom->k; n++) {
+        size_t pos = _iter_next(bloom, &it);
+        unsigned val = _get(bloom, pos);
+
+        /* saturated counters stick */
+        if (val < COUNTER_MAX) {
+            _set(bloom, pos, val + 1);
+        }
+    }
+}
+
+int bloom_counting_remove(bloom_counting_t *bloom, const uint8_t *buf, size_t len)
+{
+    _iter_t it;
+
+    if (!bloom_counting_check(bloom, buf, len)) {
+        return -ENOENT;
+    }
+
+    _iter_init(bloom, &it, buf, len);
+    for (size_t n = 0; n < bloom->k; n++) {
+        size_t pos = _iter_next(bloom, &it);
+        unsigned val = _get(bloom, pos);
+
+        /* a saturated counter may count more elements than it can hold */
+        if ((val > 0) && (val < COUNTER_MAX)) {
+            _set(bloom, pos, val - 1);
+        }
+    }
+
+    return 0;
+}
+
+bool bloom_counting_check(const bloom_counting_t *bloom, const uint8_t *buf,
+                          size_t len)
+{
+    _iter_t it;
+
+    _iter_init(bloom, &it, buf, len);
+    for (size_t n = 0; n < bloom->k; n++) {
+        if (_get(bloom, _iter_next(bloom, &it)) == 0) {
+            return false;
+        }
+    }
+
+    return true;
+}
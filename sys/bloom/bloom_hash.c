@@ -0,0 +1,61 @@
+/*
+ * Copyright (C) 2021 Gunar Schorcht
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_bloom
+ * @{
+ *
+ * @file
+ * @brief       64 bit hash of the blocked and the counting Bloom filter
+ *
+ * MurmurHash64A by Austin Appleby, which is in the public domain.
+ *
+ * @author      Gunar Schorcht <gunar@schorcht.net>
+ *
+ * @}
+ */
+
+#include <string.h>
+
+#include "bloom.h"
+
+uint64_t bloom_hash64(const uint8_t *buf, size_t len)
+{
+    const uint64_t m = 0xc6a4a7935bd1e995ULL;
+    const unsigned r = 47;
+    uint64_t h = len * m;
+
+    while (len >= sizeof(uint64_t)) {
+        uint64_t k;
+
+        /* buf doesn't have to be aligned */
+        memcpy(&k, buf, sizeof(k));
+        k *= m;
+        k ^= k >> r;
+        k *= m;
+
+        h ^= k;
+        h *= m;
+
+        buf += sizeof(k);
+        len -= sizeof(k);
+    }
+
+    if (len) {
+        while (len--) {
+            h ^= (uint64_t)buf[len] << (8 * len);
+        }
+        h *= m;
+    }
+
+    h ^= h >> r;
+    h *= m;
+    h ^= h >> r;
+
+    return h;
+}
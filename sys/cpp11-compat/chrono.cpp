@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2021 Hamburg University of Applied Sciences (HAW)
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup cpp11-compat
+ * @{
+ *
+ * @file
+ * @brief   C++11 chrono clocks based on ztimer
+ *
+ * @}
+ */
+
+#include "irq.h"
+#include "ztimer.h"
+
+#include "riot/chrono.hpp"
+
+namespace riot {
+
+constexpr bool steady_clock::is_steady;
+constexpr bool system_clock::is_steady;
+
+namespace {
+
+#if !MODULE_ZTIMER_NOW64
+uint32_t last_lower;
+uint64_t checkpoint;
+ztimer_t keepalive;
+
+/* needs interrupts disabled */
+uint64_t extend(uint32_t lower) {
+  checkpoint += static_cast<uint32_t>(lower - last_lower);
+  last_lower = lower;
+  return checkpoint;
+}
+
+/* makes sure the clock is read at least once per half wrap-around, even if
+ * nobody calls now() for a long time */
+void keepalive_cb(void*) {
+  extend(ztimer_now(ZTIMER_USEC));
+  ztimer_set(ZTIMER_USEC, &keepalive, UINT32_MAX >> 1);
+}
+#endif
+
+int64_t system_offset;
+
+uint64_t now_usec() {
+#if MODULE_ZTIMER_NOW64
+  return ztimer_now(ZTIMER_USEC);
+#else
+  unsigned state = irq_disable();
+  uint64_t res = extend(ztimer_now(ZTIMER_USEC));
+  if (keepalive.callback == nullptr) {
+    keepalive.callback = keepalive_cb;
+    ztimer_set(ZTIMER_USEC, &keepalive, UINT32_MAX >> 1);
+  }
+  irq_restore(state);
+  return res;
+#endif
+}
+
+} // namespace anonymous
+
+steady_clock::time_point steady_clock::now() noexcept {
+  return time_point(duration(static_cast<rep>(now_usec())));
+}
+
+system_clock::time_point system_clock::now() noexcept {
+  return time_point(duration(static_cast<rep>(now_usec()) + system_offset));
+}
+
+void system_clock::set(const time_point& t) noexcept {
+  system_offset = t.time_since_epoch().count() -
+                  static_cast<rep>(now_usec());
+}
+
+} // namespace riot
@@ -25,7 +25,7 @@
 #include "sched.h"
 #include "thread.h"
 #include "timex.h"
-#include "xtimer.h"
+#include "ztimer.h"
 #include "priority_queue.h"
 
 #include "riot/condition_variable.hpp"
@@ -99,18 +99,26 @@ void condition_variable::wait(unique_lock<mutex>& lock) noexcept {
 
 cv_status condition_variable::wait_until(unique_lock<mutex>& lock,
                                          const time_point& timeout_time) {
-  xtimer_t timer;
-  // todo: use function to wait for absolute timepoint once available
-  timex_t before;
-  xtimer_now_timex(&before);
-  auto diff = timex_sub(timeout_time.native_handle(), before);
-  xtimer_set_wakeup(&timer, timex_uint64(diff), thread_getpid());
+  auto now = riot::now();
+  if (timeout_time <= now) {
+    return cv_status::timeout;
+  }
+  auto diff = timex_sub(timeout_time.native_handle(), now.native_handle());
+  return wait_usec(lock, timex_uint64(diff));
+}
+
+cv_status condition_variable::wait_usec(unique_lock<mutex>& lock,
+                                        uint64_t usec) {
+  auto before = steady_clock::now();
+  ztimer_t timer;
+  // longer timeouts end up as spurious wakeups, which callers have to expect
+  uint32_t chunk = (usec > UINT32_MAX) ? UINT32_MAX : usec;
+  ztimer_set_wakeup(ZTIMER_USEC, &timer, chunk, thread_getpid());
   wait(lock);
-  timex_t after;
-  xtimer_now_timex(&after);
-  xtimer_remove(&timer);
-  auto cmp = timex_cmp(after, timeout_time.native_handle());
-  return cmp < 1 ? cv_status::no_timeout : cv_status::timeout;
+  ztimer_remove(ZTIMER_USEC, &timer);
+  auto passed = steady_clock::now() - before;
+  return passed < microseconds(usec) ? cv_status::no_timeout
+                                     : cv_status::timeout;
 }
 
 } // namespace riot
@@ -11,8 +11,8 @@
  * @{
  *
  * @file
- * @brief  C++11 chrono drop in replacement that adds the function now based on
- *         xtimer/timex
+ * @brief  C++11 chrono drop in replacement that adds the function now and
+ *         clocks based on ztimer/timex
  * @see    <a href="http://en.cppreference.com/w/cpp/thread/thread">
  *           std::thread, defined in header thread
  *         </a>
@@ -26,10 +26,12 @@
 #define RIOT_CHRONO_HPP
 
 #include <chrono>
+#include <ctime>
+#include <cstdint>
 #include <algorithm>
 
 #include "time.h"
-#include "xtimer.h"
+#include "timex.h"
 
 namespace riot {
 
@@ -37,6 +39,96 @@ namespace {
 constexpr uint32_t microsecs_in_sec = 1000000;
 } // namespace anaonymous
 
+/**
+ * @brief Monotonic clock counting microseconds since boot, based on
+ *        `ZTIMER_USEC`
+ *
+ * The 32 bit ztimer count is extended to 64 bit in software, so the clock
+ * does not wrap around. Usable with the `std::chrono` time points and the
+ * timed waits of @ref riot::mutex and @ref riot::condition_variable.
+ */
+struct steady_clock {
+  using duration = std::chrono::microseconds;             /**< duration */
+  using rep = duration::rep;                              /**< tick type */
+  using period = duration::period;                        /**< tick period */
+  using time_point = std::chrono::time_point<steady_clock>; /**< time point */
+  static constexpr bool is_steady = true;                 /**< monotonic */
+
+  /**
+   * @brief Returns the current time.
+   */
+  static time_point now() noexcept;
+};
+
+/**
+ * @brief Wall clock, based on @ref riot::steady_clock
+ *
+ * RIOT has no notion of the wall time by itself. The clock starts at the
+ * epoch on boot and follows @ref riot::steady_clock from the time set with
+ * set().
+ */
+struct system_clock {
+  using duration = std::chrono::microseconds;             /**< duration */
+  using rep = duration::rep;                              /**< tick type */
+  using period = duration::period;                        /**< tick period */
+  using time_point = std::chrono::time_point<system_clock>; /**< time point */
+  static constexpr bool is_steady = false;                /**< may jump */
+
+  /**
+   * @brief Returns the current time.
+   */
+  static time_point now() noexcept;
+
+  /**
+   * @brief Set the current time.
+   */
+  static void set(const time_point& t) noexcept;
+
+  /**
+   * @brief Convert a time point to seconds since the epoch.
+   */
+  static std::time_t to_time_t(const time_point& t) noexcept {
+    using namespace std::chrono;
+    return static_cast<std::time_t>(
+      duration_cast<seconds>(t.time_since_epoch()).count());
+  }
+
+  /**
+   * @brief Convert seconds since the epoch to a time point.
+   */
+  static time_point from_time_t(std::time_t t) noexcept {
+    return time_point(std::chrono::seconds(t));
+  }
+};
+
+/**
+ * @brief There is no clock of higher resolution than @ref riot::steady_clock.
+ */
+using high_resolution_clock = steady_clock;
+
+/** @cond INTERNAL */
+namespace detail {
+
+/**
+ * @brief Convert @p d to microseconds, rounding up and mapping negative
+ *        durations to 0.
+ */
+template <class Rep, class Period>
+inline uint64_t to_usec(const std::chrono::duration<Rep, Period>& d) {
+  using namespace std::chrono;
+  if (d <= d.zero()) {
+    return 0;
+  }
+  auto us = duration_cast<microseconds>(d);
+  if (us < d) {
+    ++us;
+  }
+  return static_cast<uint64_t>(us.count());
+}
+
+} // namespace detail
+/** @endcond */
+
 /**
  * @brief A time point for timed wait, as clocks from the standard are not
  *        available on RIOT.
@@ -105,9 +197,8 @@ class time_point {
  * @return time_point containing the current time.
  */
 inline time_point now() {
-  timex_t tp;
-  xtimer_now_timex(&tp);
-  return time_point(std::move(tp));
+  auto us = steady_clock::now().time_since_epoch().count();
+  return time_point(timex_from_uint64(static_cast<uint64_t>(us)));
 }
 
 /**
@@ -24,8 +24,10 @@
 #ifndef RIOT_CONDITION_VARIABLE_HPP
 #define RIOT_CONDITION_VARIABLE_HPP
 
+#include <chrono>
+#include <cstdint>
+
 #include "sched.h"
-#include "xtimer.h"
 #include "priority_queue.h"
 
 #include "riot/mutex.hpp"
@@ -106,6 +108,36 @@ public:
   template <class Predicate>
   bool wait_until(unique_lock<mutex>& lock, const time_point& timeout_time,
                   Predicate pred);
+  /**
+   * @brief Block until woken up through the condition variable or a specified
+   *        point in time of a `std::chrono` compatible clock, e.g.
+   *        @ref riot::steady_clock, is reached. The lock is reacquired either
+   *        way.
+   * @param lock          A lock that is locked by the current thread.
+   * @param timeout_time  Point in time when the thread is woken up
+   *                      independently of the condition variable.
+   * @return A status to signify if woken up due to a timeout or the cv.
+   */
+  template <class Clock, class Duration>
+  cv_status wait_until(
+    unique_lock<mutex>& lock,
+    const std::chrono::time_point<Clock, Duration>& timeout_time);
+  /**
+   * @brief Block until woken up through the condition variable and a predicate
+   *        is fulfilled or a specified point in time of a `std::chrono`
+   *        compatible clock is reached. The lock is reacquired either way.
+   * @param lock          A lock that is locked by the current thread.
+   * @param timeout_time  Point in time when the thread is woken up
+   *                      independently of the condition variable.
+   * @param pred          A predicate that returns a bool to signify if the
+   *                      thread should continue to wait when woken up through
+   *                      the cv.
+   * @return Result of the pred when the function returns.
+   */
+  template <class Clock, class Duration, class Predicate>
+  bool wait_until(unique_lock<mutex>& lock,
+                  const std::chrono::time_point<Clock, Duration>& timeout_time,
+                  Predicate pred);
 
   /**
    * @brief Blocks until woken up through the condition variable or when the
@@ -140,6 +172,8 @@ private:
   condition_variable(const condition_variable&);
   condition_variable& operator=(const condition_variable&);
 
+  cv_status wait_usec(unique_lock<mutex>& lock, uint64_t usec);
+
   priority_queue_t m_queue;
 };
 
@@ -162,29 +196,34 @@ bool condition_variable::wait_until(unique_lock<mutex>& lock,
   return true;
 }
 
+template <class Clock, class Duration>
+cv_status condition_variable::wait_until(
+  unique_lock<mutex>& lock,
+  const std::chrono::time_point<Clock, Duration>& timeout_time) {
+  return wait_for(lock, timeout_time - Clock::now());
+}
+
+template <class Clock, class Duration, class Predicate>
+bool condition_variable::wait_until(
+  unique_lock<mutex>& lock,
+  const std::chrono::time_point<Clock, Duration>& timeout_time,
+  Predicate pred) {
+  while (!pred()) {
+    if (wait_until(lock, timeout_time) == cv_status::timeout) {
+      return pred();
+    }
+  }
+  return true;
+}
+
 template <class Rep, class Period>
 cv_status condition_variable::wait_for(unique_lock<mutex>& lock,
                                        const std::chrono::duration
                                        <Rep, Period>& timeout_duration) {
-  using namespace std::chrono;
-  using std::chrono::duration;
   if (timeout_duration <= timeout_duration.zero()) {
     return cv_status::timeout;
   }
-  timex_t timeout, before, after;
-  auto s = duration_cast<seconds>(timeout_duration);
-  timeout.seconds = s.count();
-  timeout.microseconds
-    = (duration_cast<microseconds>(timeout_duration - s)).count();
-  xtimer_now_timex(&before);
-  xtimer_t timer;
-  xtimer_set_wakeup(&timer, timex_uint64(timeout), thread_getpid());
-  wait(lock);
-  xtimer_now_timex(&after);
-  xtimer_remove(&timer);
-  auto passed = timex_sub(after, before);
-  auto cmp = timex_cmp(passed, timeout);
-  return cmp < 1 ? cv_status::no_timeout : cv_status::timeout;
+  return wait_usec(lock, detail::to_usec(timeout_duration));
 }
 
 template <class Rep, class Period, class Predicate>
@@ -192,7 +231,7 @@ inline bool condition_variable::wait_for(unique_lock<mutex>& lock,
                                          const std::chrono::duration
                                          <Rep, Period>& timeout_duration,
                                          Predicate pred) {
-  return wait_until(lock, std::chrono::steady_clock::now() + timeout_duration,
+  return wait_until(lock, steady_clock::now() + timeout_duration,
                     std::move(pred));
 }
 
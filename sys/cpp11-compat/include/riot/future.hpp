@@ -0,0 +1,458 @@
+/*
+ * Copyright (C) 2021 Hamburg University of Applied Sciences (HAW)
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup cpp11-compat
+ * @{
+ *
+ * @file
+ * @brief   C++11 future and promise drop in replacement with continuations
+ * @see     <a href="http://en.cppreference.com/w/cpp/thread/future">
+ *            std::future, std::promise
+ *          </a>
+ *
+ * In addition to the standard interface, a future can be chained with
+ * @ref riot::future::then(). The continuation runs in the context of the
+ * thread fulfilling the promise, or right away if the value is available
+ * already.
+ *
+ * @}
+ */
+
+#ifndef RIOT_FUTURE_HPP
+#define RIOT_FUTURE_HPP
+
+#include <memory>
+#include <utility>
+#include <exception>
+#include <stdexcept>
+#include <functional>
+#include <type_traits>
+
+#include "riot/mutex.hpp"
+#include "riot/condition_variable.hpp"
+
+namespace riot {
+
+template <class T>
+class future;
+
+template <class T>
+class promise;
+
+namespace detail {
+
+/**
+ * @brief Result type of calling @p F with @p Args.
+ *
+ * `std::result_of` is deprecated in C++17 and removed in C++20.
+ */
+#if __cplusplus >= 201703L
+template <class F, class... Args>
+using invoke_result_t = typename std::invoke_result<F, Args...>::type;
+#else
+template <class F, class... Args>
+using invoke_result_t = typename std::result_of<F(Args...)>::type;
+#endif
+
+/**
+ * @brief State shared between a promise and its future, independent of the
+ *        value type.
+ */
+class shared_state_base {
+public:
+  /**
+   * @brief Block until a value or an exception was stored.
+   */
+  void wait() {
+    unique_lock<mutex> lk(m_mtx);
+    m_cv.wait(lk, [this] { return m_ready; });
+  }
+
+  /**
+   * @brief Query if a value or an exception was stored.
+   */
+  bool is_ready() {
+    lock_guard<mutex> lk(m_mtx);
+    return m_ready;
+  }
+
+  /**
+   * @brief Store an exception instead of a value.
+   */
+  void set_exception(std::exception_ptr e) {
+    unique_lock<mutex> lk(m_mtx);
+    check_not_ready();
+    m_exception = e;
+    make_ready(lk);
+  }
+
+  /**
+   * @brief Store an exception unless a value or an exception was stored
+   *        already.
+   *
+   * Unlike set_exception(), the check and the store happen under the same
+   * lock and nothing is thrown, which makes it safe to use in destructors.
+   */
+  void set_exception_if_not_ready(std::exception_ptr e) noexcept {
+    unique_lock<mutex> lk(m_mtx);
+    if (!m_ready) {
+      m_exception = e;
+      make_ready(lk);
+    }
+  }
+
+  /**
+   * @brief Run @p f once the state is ready, right away if it is already.
+   */
+  void set_continuation(std::function<void()> f) {
+    unique_lock<mutex> lk(m_mtx);
+    if (m_ready) {
+      lk.unlock();
+      f();
+    } else {
+      m_continuation = std::move(f);
+    }
+  }
+
+  /** @cond INTERNAL */
+  void rethrow_if_failed() {
+    if (m_exception) {
+      std::rethrow_exception(m_exception);
+    }
+  }
+
+protected:
+  void check_not_ready() {
+    if (m_ready) {
+      throw std::logic_error("promise already satisfied");
+    }
+  }
+
+  void make_ready(unique_lock<mutex>& lk) {
+    m_ready = true;
+    std::function<void()> cont;
+    std::swap(cont, m_continuation);
+    lk.unlock();
+    m_cv.notify_all();
+    if (cont) {
+      cont();
+    }
+  }
+
+  mutex m_mtx;
+  condition_variable m_cv;
+  bool m_ready = false;
+  std::exception_ptr m_exception;
+  std::function<void()> m_continuation;
+  /** @endcond */
+};
+
+/**
+ * @brief State shared between a promise and its future.
+ */
+template <class T>
+class shared_state : public shared_state_base {
+public:
+  ~shared_state() {
+    if (m_has_value) {
+      reinterpret_cast<T*>(&m_storage)->~T();
+    }
+  }
+
+  /**
+   * @brief Store the value.
+   */
+  template <class U>
+  void set_value(U&& value) {
+    unique_lock<mutex> lk(m_mtx);
+    check_not_ready();
+    new (&m_storage) T(std::forward<U>(value));
+    m_has_value = true;
+    make_ready(lk);
+  }
+
+  /**
+   * @brief Wait for and take the value.
+   */
+  T get() {
+    wait();
+    rethrow_if_failed();
+    return std::move(*reinterpret_cast<T*>(&m_storage));
+  }
+
+private:
+  typename std::aligned_storage<sizeof(T), alignof(T)>::type m_storage;
+  bool m_has_value = false;
+};
+
+/**
+ * @brief State shared between a promise and its future without a value.
+ */
+template <>
+class shared_state<void> : public shared_state_base {
+public:
+  /**
+   * @brief Mark the state as ready.
+   */
+  void set_value() {
+    unique_lock<mutex> lk(m_mtx);
+    check_not_ready();
+    make_ready(lk);
+  }
+
+  /**
+   * @brief Wait for the state to become ready.
+   */
+  void get() {
+    wait();
+    rethrow_if_failed();
+  }
+};
+
+/** @cond INTERNAL */
+template <class R>
+struct fulfill {
+  template <class F, class... Args>
+  static void run(promise<R>& p, F& f, Args&&... args) {
+    try {
+      p.set_value(f(std::forward<Args>(args)...));
+    }
+    catch (...) {
+      p.set_exception(std::current_exception());
+    }
+  }
+};
+
+template <>
+struct fulfill<void> {
+  template <class P, class F, class... Args>
+  static void run(P& p, F& f, Args&&... args) {
+    try {
+      f(std::forward<Args>(args)...);
+      p.set_value();
+    }
+    catch (...) {
+      p.set_exception(std::current_exception());
+    }
+  }
+};
+
+template <class T>
+struct continuation {
+  template <class R, class F>
+  static void run(shared_state<T>& state, promise<R>& p, F& f) {
+    try {
+      auto value = state.get();
+      fulfill<R>::run(p, f, std::move(value));
+    }
+    catch (...) {
+      p.set_exception(std::current_exception());
+    }
+  }
+};
+
+template <>
+struct continuation<void> {
+  template <class R, class F>
+  static void run(shared_state<void>& state, promise<R>& p, F& f) {
+    try {
+      state.get();
+      fulfill<R>::run(p, f);
+    }
+    catch (...) {
+      p.set_exception(std::current_exception());
+    }
+  }
+};
+
+template <class T, class F>
+struct then_result {
+  using type = invoke_result_t<F, T>;
+};
+
+template <class F>
+struct then_result<void, F> {
+  using type = invoke_result_t<F>;
+};
+/** @endcond */
+
+} // namespace detail
+
+/**
+ * @brief   C++11 compliant implementation of future, extended by
+ *          continuations
+ * @see     <a href="http://en.cppreference.com/w/cpp/thread/future">
+ *            std::future
+ *          </a>
+ */
+template <class T>
+class future {
+  friend class promise<T>;
+
+public:
+  /**
+   * @brief Creates a future without shared state.
+   */
+  future() noexcept = default;
+  /**
+   * @brief Move constructor.
+   */
+  future(future&&) noexcept = default;
+  /**
+   * @brief Move assignment operator.
+   */
+  future& operator=(future&&) noexcept = default;
+  /**
+   * @brief Disallow copy constructor.
+   */
+  future(const future&) = delete;
+  /**
+   * @brief Disallow copy assignment operator.
+   */
+  future& operator=(const future&) = delete;
+
+  /**
+   * @brief Query if the future refers to a shared state.
+   */
+  inline bool valid() const noexcept { return m_state != nullptr; }
+
+  /**
+   * @brief Block until the result is available.
+   */
+  void wait() const { m_state->wait(); }
+
+  /**
+   * @brief Query if the result is available without blocking.
+   */
+  bool is_ready() const { return m_state->is_ready(); }
+
+  /**
+   * @brief Wait for the result and return it. Rethrows the exception stored
+   *        in the promise, if any. The future is invalid afterwards.
+   */
+  T get() {
+    auto state = std::move(m_state);
+    return state->get();
+  }
+
+  /**
+   * @brief Attach a continuation to be called with the result.
+   *
+   * @p f is called with the value (nothing for `future<void>`) in the
+   * context of the thread fulfilling the promise. If the promise stored an
+   * exception, @p f is not called and the exception is forwarded to the
+   * returned future. This future is invalid afterwards.
+   *
+   * @param[in] f   The continuation.
+   *
+   * @return  A future for the result of @p f.
+   */
+  template <class F>
+  future<typename detail::then_result<T, F>::type> then(F&& f) {
+    using R = typename detail::then_result<T, F>::type;
+    auto state = std::move(m_state);
+    auto p = std::make_shared<promise<R>>();
+    auto res = p->get_future();
+    auto fn = std::make_shared<typename std::decay<F>::type>(
+      std::forward<F>(f));
+    auto raw = state.get();
+    raw->set_continuation([state, p, fn] {
+      detail::continuation<T>::run(*state, *p, *fn);
+    });
+    return res;
+  }
+
+private:
+  explicit future(std::shared_ptr<detail::shared_state<T>> state)
+      : m_state{std::move(state)} {}
+
+  std::shared_ptr<detail::shared_state<T>> m_state;
+};
+
+/**
+ * @brief   C++11 compliant implementation of promise
+ * @see     <a href="http://en.cppreference.com/w/cpp/thread/promise">
+ *            std::promise
+ *          </a>
+ */
+template <class T>
+class promise {
+public:
+  /**
+   * @brief Creates a promise with an empty shared state.
+   */
+  promise() : m_state{std::make_shared<detail::shared_state<T>>()} {}
+  /**
+   * @brief Stores a `std::logic_error` if the promise was not fulfilled.
+   */
+  ~promise() {
+    if (m_state) {
+      m_state->set_exception_if_not_ready(
+        std::make_exception_ptr(std::logic_error("broken promise")));
+    }
+  }
+  /**
+   * @brief Move constructor.
+   */
+  promise(promise&&) noexcept = default;
+  /**
+   * @brief Move assignment operator.
+   */
+  promise& operator=(promise&&) noexcept = default;
+  /**
+   * @brief Disallow copy constructor.
+   */
+  promise(const promise&) = delete;
+  /**
+   * @brief Disallow copy assignment operator.
+   */
+  promise& operator=(const promise&) = delete;
+
+  /**
+   * @brief Returns the future associated with this promise. Must only be
+   *        called once.
+   */
+  future<T> get_future() {
+    if (m_retrieved) {
+      throw std::logic_error("future already retrieved");
+    }
+    m_retrieved = true;
+    return future<T>{m_state};
+  }
+
+  /**
+   * @brief Store the value and wake up the waiting threads.
+   */
+  template <class U = T>
+  typename std::enable_if<!std::is_void<U>::value>::type
+  set_value(U&& value) {
+    m_state->set_value(std::forward<U>(value));
+  }
+
+  /**
+   * @brief Mark a `promise<void>` as fulfilled.
+   */
+  template <class U = T>
+  typename std::enable_if<std::is_void<U>::value>::type set_value() {
+    m_state->set_value();
+  }
+
+  /**
+   * @brief Store an exception and wake up the waiting threads.
+   */
+  void set_exception(std::exception_ptr e) { m_state->set_exception(e); }
+
+private:
+  std::shared_ptr<detail::shared_state<T>> m_state;
+  bool m_retrieved = false;
+};
+
+} // namespace riot
+
+#endif // RIOT_FUTURE_HPP
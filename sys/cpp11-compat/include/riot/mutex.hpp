@@ -26,10 +26,14 @@
 
 #include "mutex.h"
 
+#include <chrono>
+#include <cstdint>
 #include <utility>
 #include <stdexcept>
 #include <system_error>
 
+#include "riot/chrono.hpp"
+
 namespace riot {
 
 /**
@@ -59,6 +63,23 @@ public:
    * @return `true` if the mutex was locked, `false` otherwise.
    */
   bool try_lock() noexcept;
+  /**
+   * @brief Try to lock the mutex, give up after @p timeout_duration.
+   * @return `true` if the mutex was locked, `false` otherwise.
+   */
+  template <class Rep, class Period>
+  bool try_lock_for(const std::chrono::duration<Rep, Period>& timeout_duration) {
+    return try_lock_usec(detail::to_usec(timeout_duration));
+  }
+  /**
+   * @brief Try to lock the mutex, give up at @p timeout_time.
+   * @return `true` if the mutex was locked, `false` otherwise.
+   */
+  template <class Clock, class Duration>
+  bool try_lock_until(
+    const std::chrono::time_point<Clock, Duration>& timeout_time) {
+    return try_lock_for(timeout_time - Clock::now());
+  }
   /**
    * @brief Unlock the mutex.
    */
@@ -74,6 +95,8 @@ private:
   mutex(const mutex&);
   mutex& operator=(const mutex&);
 
+  bool try_lock_usec(uint64_t usec);
+
   mutex_t m_mtx;
 };
 
@@ -209,6 +209,20 @@ inline void sleep_until(const riot::time_point& sleep_time) {
     cv.wait_until(lk, sleep_time);
   }
 }
+/**
+ * @brief Puts the current thread to sleep.
+ * @param[in] sleep_time    A point in time of a `std::chrono` compatible
+ *                          clock, e.g. @ref riot::steady_clock, that specifies
+ *                          when the thread should wake up.
+ */
+template <class Clock, class Duration>
+void sleep_until(const std::chrono::time_point<Clock, Duration>& sleep_time) {
+  auto now = Clock::now();
+  while (now < sleep_time) {
+    sleep_for(sleep_time - now);
+    now = Clock::now();
+  }
+}
 } // namespace this_thread
 
 /**
@@ -0,0 +1,219 @@
+/*
+ * Copyright (C) 2021 Hamburg University of Applied Sciences (HAW)
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup cpp11-compat
+ * @{
+ *
+ * @file
+ * @brief   Thread pool with a bounded task queue
+ *
+ * A thread pool runs tasks on a fixed set of worker threads, so applications
+ * do not need to create a thread (and its stack) for every concurrent job.
+ * Tasks are queued in a ring buffer of fixed capacity; posting to a full
+ * queue blocks until a worker took a task out.
+ *
+ * The number of workers is a template parameter and not derived from
+ * riot::thread::hardware_concurrency(): all RIOT threads share one core, so
+ * more than one worker only pays off for tasks that block.
+ *
+ * @code{.cpp}
+ * riot::thread_pool<2, 8> pool;
+ * auto f = riot::async(pool, [](int x) { return x * x; }, 7);
+ * printf("%d\n", f.get());
+ * @endcode
+ *
+ * @}
+ */
+
+#ifndef RIOT_THREAD_POOL_HPP
+#define RIOT_THREAD_POOL_HPP
+
+#include <array>
+#include <memory>
+#include <utility>
+#include <functional>
+#include <type_traits>
+
+#include "riot/mutex.hpp"
+#include "riot/thread.hpp"
+#include "riot/future.hpp"
+#include "riot/condition_variable.hpp"
+
+namespace riot {
+
+/**
+ * @brief   Pool of @p Workers threads processing tasks from a queue of
+ *          @p QueueSize entries
+ *
+ * The destructor lets the workers finish all queued tasks before joining
+ * them.
+ */
+template <size_t Workers, size_t QueueSize = 8>
+class thread_pool {
+  static_assert(Workers > 0, "a thread pool needs at least one worker");
+  static_assert(QueueSize > 0, "the task queue needs at least one entry");
+
+public:
+  /**
+   * @brief Type of the tasks in the queue.
+   */
+  using task_type = std::function<void()>;
+
+  /**
+   * @brief Start the worker threads.
+   */
+  thread_pool() {
+    for (auto& w : m_workers) {
+      w = thread([this] { work(); });
+    }
+  }
+
+  /**
+   * @brief Finish all queued tasks and join the worker threads.
+   */
+  ~thread_pool() {
+    {
+      lock_guard<mutex> lk(m_mtx);
+      m_stop = true;
+    }
+    m_not_empty.notify_all();
+    for (auto& w : m_workers) {
+      w.join();
+    }
+  }
+
+  thread_pool(const thread_pool&) = delete;
+  thread_pool& operator=(const thread_pool&) = delete;
+
+  /**
+   * @brief Queue a task, block while the queue is full.
+   */
+  void post(task_type task) {
+    unique_lock<mutex> lk(m_mtx);
+    m_not_full.wait(lk, [this] { return m_count < QueueSize; });
+    push(std::move(task));
+    lk.unlock();
+    m_not_empty.notify_one();
+  }
+
+  /**
+   * @brief Queue a task if there is space left.
+   *
+   * @return  `true` if the task was queued, `false` if the queue is full.
+   */
+  bool try_post(task_type task) {
+    unique_lock<mutex> lk(m_mtx);
+    if (m_count == QueueSize) {
+      return false;
+    }
+    push(std::move(task));
+    lk.unlock();
+    m_not_empty.notify_one();
+    return true;
+  }
+
+  /**
+   * @brief Queue @p f to be called with @p args, block while the queue is
+   *        full.
+   *
+   * @return  A future for the result of the call.
+   */
+  template <class F, class... Args>
+  future<detail::invoke_result_t<F, Args...>>
+  submit(F&& f, Args&&... args) {
+    using R = detail::invoke_result_t<F, Args...>;
+    auto p = std::make_shared<promise<R>>();
+    auto res = p->get_future();
+    auto fn = std::make_shared<decltype(
+      std::bind(std::forward<F>(f), std::forward<Args>(args)...))>(
+      std::bind(std::forward<F>(f), std::forward<Args>(args)...));
+    post([p, fn] { detail::fulfill<R>::run(*p, *fn); });
+    return res;
+  }
+
+  /**
+   * @brief Number of tasks waiting in the queue.
+   */
+  size_t pending() {
+    lock_guard<mutex> lk(m_mtx);
+    return m_count;
+  }
+
+  /**
+   * @brief Number of worker threads.
+   */
+  static constexpr size_t size() noexcept { return Workers; }
+
+private:
+  void push(task_type&& task) {
+    m_queue[(m_head + m_count) % QueueSize] = std::move(task);
+    m_count++;
+  }
+
+  void work() {
+    for (;;) {
+      task_type task;
+      {
+        unique_lock<mutex> lk(m_mtx);
+        m_not_empty.wait(lk, [this] { return m_stop || m_count > 0; });
+        if (m_count == 0) {
+          /* stopped and drained */
+          return;
+        }
+        task = std::move(m_queue[m_head]);
+        m_head = (m_head + 1) % QueueSize;
+        m_count--;
+      }
+      m_not_full.notify_one();
+      task();
+    }
+  }
+
+  mutex m_mtx;
+  condition_variable m_not_empty;
+  condition_variable m_not_full;
+  std::array<task_type, QueueSize> m_queue;
+  size_t m_head = 0;
+  size_t m_count = 0;
+  bool m_stop = false;
+  std::array<thread, Workers> m_workers;
+};
+
+/**
+ * @brief Run @p f with @p args on a worker of @p pool.
+ *
+ * @return  A future for the result of the call.
+ */
+template <size_t Workers, size_t QueueSize, class F, class... Args>
+future<detail::invoke_result_t<F, Args...>>
+async(thread_pool<Workers, QueueSize>& pool, F&& f, Args&&... args) {
+  return pool.submit(std::forward<F>(f), std::forward<Args>(args)...);
+}
+
+/**
+ * @brief Run @p f with @p args in a new, detached thread.
+ *
+ * @return  A future for the result of the call.
+ */
+template <class F, class... Args>
+future<detail::invoke_result_t<F, Args...>>
+async(F&& f, Args&&... args) {
+  using R = detail::invoke_result_t<F, Args...>;
+  auto p = std::make_shared<promise<R>>();
+  auto res = p->get_future();
+  auto fn = std::bind(std::forward<F>(f), std::forward<Args>(args)...);
+  thread t([p](decltype(fn)& call) { detail::fulfill<R>::run(*p, call); },
+           std::move(fn));
+  t.detach();
+  return res;
+}
+
+} // namespace riot
+
+#endif // RIOT_THREAD_POOL_HPP
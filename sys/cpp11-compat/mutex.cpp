@@ -18,6 +18,8 @@
  * @}
  */
 
+#include "ztimer.h"
+
 #include "riot/mutex.hpp"
 
 namespace riot {
@@ -30,6 +32,20 @@ void mutex::lock() { mutex_lock(&m_mtx); }
 
 bool mutex::try_lock() noexcept { return (1 == mutex_trylock(&m_mtx)); }
 
+bool mutex::try_lock_usec(uint64_t usec) {
+  if (try_lock()) {
+    return true;
+  }
+  while (usec > 0) {
+    uint32_t chunk = (usec > UINT32_MAX) ? UINT32_MAX : usec;
+    if (ztimer_mutex_lock_timeout(ZTIMER_USEC, &m_mtx, chunk) == 0) {
+      return true;
+    }
+    usec -= chunk;
+  }
+  return false;
+}
+
 void mutex::unlock() noexcept { mutex_unlock(&m_mtx); }
 
 } // namespace riot
@@ -18,11 +18,12 @@
  * @}
  */
 
-#include "xtimer.h"
-
 #include <cerrno>
+#include <cstdint>
 #include <system_error>
 
+#include "ztimer.h"
+
 #include "riot/thread.hpp"
 
 using namespace std;
@@ -73,7 +74,12 @@ namespace this_thread {
 void sleep_for(const chrono::nanoseconds& ns) {
   using namespace chrono;
   if (ns > nanoseconds::zero()) {
-    xtimer_usleep64(static_cast<uint64_t>(duration_cast<microseconds>(ns).count()));
+    uint64_t usec = detail::to_usec(ns);
+    while (usec > 0) {
+      uint32_t chunk = (usec > UINT32_MAX) ? UINT32_MAX : usec;
+      ztimer_sleep(ZTIMER_USEC, chunk);
+      usec -= chunk;
+    }
   }
 }
 
@@ -0,0 +1,175 @@
+/*
+ * Copyright (C) 2021 Hamburg University of Applied Sciences (HAW)
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup sys_cpp_containers
+ * @{
+ *
+ * @file
+ * @brief   STL allocator backed by a fixed size arena
+ *
+ * @}
+ */
+
+#ifndef RIOT_ARENA_ALLOCATOR_HPP
+#define RIOT_ARENA_ALLOCATOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+namespace riot {
+
+/**
+ * @brief   Bump allocator over a fixed buffer, independent of the buffer
+ *          size
+ *
+ * Use @ref riot::arena to create one.
+ */
+class arena_resource {
+public:
+  arena_resource(const arena_resource&) = delete;
+  arena_resource& operator=(const arena_resource&) = delete;
+
+  /**
+   * @brief Number of bytes in use.
+   */
+  std::size_t used() const noexcept { return m_cur - m_begin; }
+
+  /**
+   * @brief Number of bytes left.
+   */
+  std::size_t available() const noexcept { return m_end - m_cur; }
+
+  /**
+   * @brief Take @p bytes bytes aligned to @p align.
+   *
+   * @return  the memory, `nullptr` if the arena is exhausted
+   */
+  void *allocate(std::size_t bytes, std::size_t align) noexcept {
+    std::uintptr_t p = reinterpret_cast<std::uintptr_t>(m_cur);
+    p = (p + align - 1) & ~(std::uintptr_t)(align - 1);
+    unsigned char *res = reinterpret_cast<unsigned char *>(p);
+    if ((res > m_end) || (bytes > (std::size_t)(m_end - res))) {
+      return nullptr;
+    }
+    m_cur = res + bytes;
+    return res;
+  }
+
+  /**
+   * @brief Give back memory. Only the most recent allocation is actually
+   *        reclaimed, everything else is freed by reset().
+   */
+  void deallocate(void *ptr, std::size_t bytes) noexcept {
+    if (static_cast<unsigned char *>(ptr) + bytes == m_cur) {
+      m_cur = static_cast<unsigned char *>(ptr);
+    }
+  }
+
+  /**
+   * @brief Free everything at once.
+   *
+   * @pre No object allocated from the arena is in use anymore.
+   */
+  void reset() noexcept { m_cur = m_begin; }
+
+protected:
+  /** @cond INTERNAL */
+  arena_resource(unsigned char *data, std::size_t size) noexcept
+      : m_begin{data}, m_cur{data}, m_end{data + size} {}
+  /** @endcond */
+
+private:
+  unsigned char *m_begin;
+  unsigned char *m_cur;
+  unsigned char *m_end;
+};
+
+/**
+ * @brief   Arena of @p Size bytes
+ */
+template <std::size_t Size>
+class arena : public arena_resource {
+public:
+  arena() noexcept : arena_resource(m_storage, Size) {}
+
+private:
+  alignas(std::max_align_t) unsigned char m_storage[Size];
+};
+
+/**
+ * @brief   STL allocator taking memory from a @ref riot::arena_resource
+ *
+ * Suited for containers that are built once and then only read or dropped
+ * as a whole, e.g. a `std::vector` that is reserved up front or a
+ * `std::string` assembled for a single message. Allocating is a pointer
+ * increment; exhausting the arena throws `std::bad_alloc`.
+ */
+template <class T>
+class arena_allocator {
+  template <class U>
+  friend class arena_allocator;
+
+public:
+  using value_type = T; /**< allocated type */
+
+  /**
+   * @brief Allocate from @p a.
+   */
+  explicit arena_allocator(arena_resource& a) noexcept : m_arena{&a} {}
+
+  /**
+   * @brief Rebinding copy constructor, shares the arena.
+   */
+  template <class U>
+  arena_allocator(const arena_allocator<U>& other) noexcept
+      : m_arena{other.m_arena} {}
+
+  /**
+   * @brief Allocate @p n objects.
+   */
+  T *allocate(std::size_t n) {
+    void *p = (n <= SIZE_MAX / sizeof(T))
+              ? m_arena->allocate(n * sizeof(T), alignof(T)) : nullptr;
+    if (!p) {
+      throw std::bad_alloc();
+    }
+    return static_cast<T *>(p);
+  }
+
+  /**
+   * @brief Release objects allocated by allocate().
+   */
+  void deallocate(T *p, std::size_t n) noexcept {
+    m_arena->deallocate(p, n * sizeof(T));
+  }
+
+  /**
+   * @brief Allocators compare equal if they share the arena.
+   */
+  template <class U>
+  bool operator==(const arena_allocator<U>& other) const noexcept {
+    return m_arena == other.m_arena;
+  }
+
+  /**
+   * @brief Allocators compare equal if they share the arena.
+   */
+  template <class U>
+  bool operator!=(const arena_allocator<U>& other) const noexcept {
+    return m_arena != other.m_arena;
+  }
+
+private:
+  arena_resource *m_arena;
+};
+
+} // namespace riot
+
+#endif // RIOT_ARENA_ALLOCATOR_HPP
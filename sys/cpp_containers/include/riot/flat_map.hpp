@@ -0,0 +1,188 @@
+/*
+ * Copyright (C) 2021 Hamburg University of Applied Sciences (HAW)
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup sys_cpp_containers
+ * @{
+ *
+ * @file
+ * @brief   Sorted map with a fixed capacity and inline storage
+ *
+ * @}
+ */
+
+#ifndef RIOT_FLAT_MAP_HPP
+#define RIOT_FLAT_MAP_HPP
+
+#include <cassert>
+#include <cstddef>
+#include <tuple>
+#include <utility>
+#include <algorithm>
+#include <functional>
+
+#include "riot/static_vector.hpp"
+
+namespace riot {
+
+/**
+ * @brief   Map of at most @p N entries, kept as a sorted array
+ *
+ * Lookups are binary searches over contiguous memory, which beats a node
+ * based map for the small sizes typical on constrained devices. Inserting
+ * and erasing move the following entries.
+ */
+template <class Key, class T, std::size_t N, class Compare = std::less<Key>>
+class flat_map {
+public:
+  using key_type = Key;                         /**< key type */
+  using mapped_type = T;                        /**< mapped type */
+  using value_type = std::pair<Key, T>;         /**< entry type */
+  using size_type = std::size_t;                /**< size type */
+  /** iterator */
+  using iterator = typename static_vector<value_type, N>::iterator;
+  /** const iterator */
+  using const_iterator = typename static_vector<value_type, N>::const_iterator;
+
+  /** @name Iterators
+   * @{
+   */
+  iterator begin() noexcept { return m_entries.begin(); }
+  const_iterator begin() const noexcept { return m_entries.begin(); }
+  iterator end() noexcept { return m_entries.end(); }
+  const_iterator end() const noexcept { return m_entries.end(); }
+  /** @} */
+
+  /** @name Capacity
+   * @{
+   */
+  size_type size() const noexcept { return m_entries.size(); }
+  bool empty() const noexcept { return m_entries.empty(); }
+  bool full() const noexcept { return m_entries.full(); }
+  static constexpr size_type capacity() noexcept { return N; }
+  /** @} */
+
+  /**
+   * @brief First entry with a key not less than @p key.
+   */
+  iterator lower_bound(const Key& key) {
+    return std::lower_bound(begin(), end(), key, entry_less{});
+  }
+
+  /**
+   * @brief First entry with a key not less than @p key.
+   */
+  const_iterator lower_bound(const Key& key) const {
+    return std::lower_bound(begin(), end(), key, entry_less{});
+  }
+
+  /**
+   * @brief Look up the entry with @p key.
+   *
+   * @return  iterator to the entry, end() if there is none
+   */
+  iterator find(const Key& key) {
+    iterator it = lower_bound(key);
+    return ((it != end()) && !Compare{}(key, it->first)) ? it : end();
+  }
+
+  /**
+   * @brief Look up the entry with @p key.
+   *
+   * @return  iterator to the entry, end() if there is none
+   */
+  const_iterator find(const Key& key) const {
+    const_iterator it = lower_bound(key);
+    return ((it != end()) && !Compare{}(key, it->first)) ? it : end();
+  }
+
+  /**
+   * @brief Query if there is an entry with @p key.
+   */
+  bool contains(const Key& key) const { return find(key) != end(); }
+
+  /**
+   * @brief Insert an entry, unless there is one with the same key already.
+   *
+   * @return  iterator to the entry with the key and `true` if it was
+   *          inserted. end() and `false` if the map is full.
+   */
+  template <class... Args>
+  std::pair<iterator, bool> try_emplace(const Key& key, Args&&... args) {
+    iterator it = lower_bound(key);
+    if ((it != end()) && !Compare{}(key, it->first)) {
+      return {it, false};
+    }
+    if (full()) {
+      return {end(), false};
+    }
+    it = m_entries.emplace(it, std::piecewise_construct,
+                           std::forward_as_tuple(key),
+                           std::forward_as_tuple(std::forward<Args>(args)...));
+    return {it, true};
+  }
+
+  /**
+   * @brief Insert @p value, unless there is an entry with the same key
+   *        already.
+   *
+   * @return  see try_emplace()
+   */
+  std::pair<iterator, bool> insert(const value_type& value) {
+    return try_emplace(value.first, value.second);
+  }
+
+  /**
+   * @brief Access the entry with @p key, default constructing it if there is
+   *        none. The map must not be full in that case.
+   */
+  T& operator[](const Key& key) {
+    auto res = try_emplace(key);
+    assert(res.first != end());
+    return res.first->second;
+  }
+
+  /**
+   * @brief Remove the entry at @p pos.
+   *
+   * @return  iterator following the removed entry
+   */
+  iterator erase(const_iterator pos) { return m_entries.erase(pos); }
+
+  /**
+   * @brief Remove the entry with @p key.
+   *
+   * @return  number of removed entries
+   */
+  size_type erase(const Key& key) {
+    iterator it = find(key);
+    if (it == end()) {
+      return 0;
+    }
+    m_entries.erase(it);
+    return 1;
+  }
+
+  /**
+   * @brief Remove all entries.
+   */
+  void clear() noexcept { m_entries.clear(); }
+
+private:
+  struct entry_less {
+    bool operator()(const value_type& entry, const Key& key) const {
+      return Compare{}(entry.first, key);
+    }
+  };
+
+  static_vector<value_type, N> m_entries;
+};
+
+} // namespace riot
+
+#endif // RIOT_FLAT_MAP_HPP
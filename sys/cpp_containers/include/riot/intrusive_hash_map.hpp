@@ -0,0 +1,184 @@
+/*
+ * Copyright (C) 2021 Hamburg University of Applied Sciences (HAW)
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup sys_cpp_containers
+ * @{
+ *
+ * @file
+ * @brief   Intrusive hash map with a fixed number of buckets
+ *
+ * @}
+ */
+
+#ifndef RIOT_INTRUSIVE_HASH_MAP_HPP
+#define RIOT_INTRUSIVE_HASH_MAP_HPP
+
+#include <cstddef>
+#include <functional>
+
+namespace riot {
+
+/**
+ * @brief   Link of an element of an @ref riot::intrusive_hash_map
+ *
+ * Elements derive from this class. An element can be in one map at a time.
+ */
+class intrusive_hash_node {
+  template <class T, class Key, Key T::*KeyMember, std::size_t Buckets,
+            class Hash>
+  friend class intrusive_hash_map;
+
+public:
+  intrusive_hash_node() noexcept = default;
+  intrusive_hash_node(const intrusive_hash_node&) noexcept {}
+  intrusive_hash_node& operator=(const intrusive_hash_node&) noexcept {
+    return *this;
+  }
+
+private:
+  intrusive_hash_node *m_next = nullptr;
+};
+
+/**
+ * @brief   Hash map of elements of type @p T, keyed by the member
+ *          @p KeyMember
+ *
+ * @p T derives from @ref riot::intrusive_hash_node. The map does not own the
+ * elements and never allocates; it only holds @p Buckets pointers. Collisions
+ * are chained through the elements, so the map never gets full, but lookups
+ * degrade once it holds many more elements than buckets. A power of two for
+ * @p Buckets turns the modulo into a mask.
+ *
+ * @code{.cpp}
+ * struct neighbor : riot::intrusive_hash_node {
+ *   uint16_t addr;
+ *   int8_t rssi;
+ * };
+ *
+ * riot::intrusive_hash_map<neighbor, uint16_t, &neighbor::addr, 16> map;
+ * @endcode
+ */
+template <class T, class Key, Key T::*KeyMember, std::size_t Buckets,
+          class Hash = std::hash<Key>>
+class intrusive_hash_map {
+  static_assert(Buckets > 0, "an intrusive_hash_map needs buckets");
+
+public:
+  /**
+   * @brief Create an empty map.
+   */
+  intrusive_hash_map() noexcept = default;
+  intrusive_hash_map(const intrusive_hash_map&) = delete;
+  intrusive_hash_map& operator=(const intrusive_hash_map&) = delete;
+
+  /**
+   * @brief Number of elements.
+   */
+  std::size_t size() const noexcept { return m_size; }
+
+  /**
+   * @brief Query if the map is empty.
+   */
+  bool empty() const noexcept { return m_size == 0; }
+
+  /**
+   * @brief Insert @p elem, unless an element with the same key is in the
+   *        map already.
+   *
+   * @return  `true` if @p elem was inserted
+   */
+  bool insert(T& elem) {
+    if (find(elem.*KeyMember)) {
+      return false;
+    }
+    intrusive_hash_node& n = elem;
+    intrusive_hash_node *& head = m_buckets[bucket(elem.*KeyMember)];
+    n.m_next = head;
+    head = &n;
+    m_size++;
+    return true;
+  }
+
+  /**
+   * @brief Look up the element with @p key.
+   *
+   * @return  the element, `nullptr` if there is none
+   */
+  T *find(const Key& key) const {
+    for (intrusive_hash_node *n = m_buckets[bucket(key)]; n; n = n->m_next) {
+      T *elem = static_cast<T *>(n);
+      if (elem->*KeyMember == key) {
+        return elem;
+      }
+    }
+    return nullptr;
+  }
+
+  /**
+   * @brief Remove the element with @p key.
+   *
+   * @return  the removed element, `nullptr` if there is none
+   */
+  T *erase(const Key& key) {
+    for (intrusive_hash_node **p = &m_buckets[bucket(key)]; *p;
+         p = &(*p)->m_next) {
+      T *elem = static_cast<T *>(*p);
+      if (elem->*KeyMember == key) {
+        *p = (*p)->m_next;
+        static_cast<intrusive_hash_node *>(elem)->m_next = nullptr;
+        m_size--;
+        return elem;
+      }
+    }
+    return nullptr;
+  }
+
+  /**
+   * @brief Call @p f for every element, in no particular order.
+   */
+  template <class F>
+  void for_each(F&& f) const {
+    for (intrusive_hash_node *head : m_buckets) {
+      for (intrusive_hash_node *n = head; n;) {
+        /* f may unlink the element */
+        intrusive_hash_node *next = n->m_next;
+        f(*static_cast<T *>(n));
+        n = next;
+      }
+    }
+  }
+
+  /**
+   * @brief Unlink all elements.
+   */
+  void clear() noexcept {
+    for (intrusive_hash_node *& head : m_buckets) {
+      while (head) {
+        intrusive_hash_node *n = head;
+        head = n->m_next;
+        n->m_next = nullptr;
+      }
+    }
+    m_size = 0;
+  }
+
+private:
+  static std::size_t bucket(const Key& key) {
+    std::size_t h = Hash{}(key);
+    return ((Buckets & (Buckets - 1)) == 0) ? (h & (Buckets - 1))
+                                            : (h % Buckets);
+  }
+
+  intrusive_hash_node *m_buckets[Buckets] = {};
+  std::size_t m_size = 0;
+};
+
+} // namespace riot
+
+#endif // RIOT_INTRUSIVE_HASH_MAP_HPP
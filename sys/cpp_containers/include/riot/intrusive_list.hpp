@@ -0,0 +1,262 @@
+/*
+ * Copyright (C) 2021 Hamburg University of Applied Sciences (HAW)
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup sys_cpp_containers
+ * @{
+ *
+ * @file
+ * @brief   Intrusive doubly linked list
+ *
+ * @}
+ */
+
+#ifndef RIOT_INTRUSIVE_LIST_HPP
+#define RIOT_INTRUSIVE_LIST_HPP
+
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+
+namespace riot {
+
+/**
+ * @brief   Links of an element of an @ref riot::intrusive_list
+ *
+ * Elements derive from this class. An element can be in one list at a time.
+ */
+class intrusive_list_node {
+  template <class T>
+  friend class intrusive_list;
+
+public:
+  intrusive_list_node() noexcept = default;
+  intrusive_list_node(const intrusive_list_node&) noexcept {}
+  intrusive_list_node& operator=(const intrusive_list_node&) noexcept {
+    return *this;
+  }
+
+  /**
+   * @brief Query if the element is in a list.
+   */
+  bool linked() const noexcept { return m_next != nullptr; }
+
+private:
+  intrusive_list_node *m_prev = nullptr;
+  intrusive_list_node *m_next = nullptr;
+};
+
+/**
+ * @brief   Doubly linked list of elements of type @p T, which derives from
+ *          @ref riot::intrusive_list_node
+ *
+ * The list does not own the elements and never allocates. Inserting and
+ * removing elements is O(1); the list is circular with a sentinel node, so
+ * neither needs a special case for the ends.
+ */
+template <class T>
+class intrusive_list {
+public:
+  /**
+   * @brief Bidirectional iterator over the elements.
+   */
+  template <class V>
+  class basic_iterator {
+    friend class intrusive_list;
+
+  public:
+    using iterator_category = std::bidirectional_iterator_tag; /**< category */
+    using value_type = V;                                      /**< value */
+    using difference_type = std::ptrdiff_t;                    /**< diff */
+    using pointer = V*;                                        /**< pointer */
+    using reference = V&;                                      /**< reference */
+
+    /** @cond INTERNAL */
+    reference operator*() const { return static_cast<reference>(*m_node); }
+    pointer operator->() const { return static_cast<pointer>(m_node); }
+    basic_iterator& operator++() {
+      m_node = m_node->m_next;
+      return *this;
+    }
+    basic_iterator operator++(int) {
+      basic_iterator tmp = *this;
+      ++*this;
+      return tmp;
+    }
+    basic_iterator& operator--() {
+      m_node = m_node->m_prev;
+      return *this;
+    }
+    basic_iterator operator--(int) {
+      basic_iterator tmp = *this;
+      --*this;
+      return tmp;
+    }
+    bool operator==(const basic_iterator& other) const {
+      return m_node == other.m_node;
+    }
+    bool operator!=(const basic_iterator& other) const {
+      return m_node != other.m_node;
+    }
+    /** @endcond */
+
+  private:
+    explicit basic_iterator(intrusive_list_node *node) : m_node{node} {}
+    intrusive_list_node *m_node;
+  };
+
+  using iterator = basic_iterator<T>;               /**< iterator */
+  using const_iterator = basic_iterator<const T>;   /**< const iterator */
+
+  /**
+   * @brief Create an empty list.
+   */
+  intrusive_list() noexcept {
+    m_head.m_next = &m_head;
+    m_head.m_prev = &m_head;
+  }
+  intrusive_list(const intrusive_list&) = delete;
+  intrusive_list& operator=(const intrusive_list&) = delete;
+
+  /**
+   * @brief Unlinks all elements.
+   */
+  ~intrusive_list() { clear(); }
+
+  /** @name Iterators
+   * @{
+   */
+  iterator begin() noexcept { return iterator{m_head.m_next}; }
+  iterator end() noexcept { return iterator{&m_head}; }
+  const_iterator begin() const noexcept {
+    return const_iterator{m_head.m_next};
+  }
+  const_iterator end() const noexcept {
+    return const_iterator{const_cast<intrusive_list_node *>(&m_head)};
+  }
+  /** @} */
+
+  /**
+   * @brief Query if the list is empty.
+   */
+  bool empty() const noexcept { return m_head.m_next == &m_head; }
+
+  /**
+   * @brief Number of elements, O(n).
+   */
+  std::size_t size() const noexcept {
+    std::size_t n = 0;
+    for (const intrusive_list_node *p = m_head.m_next; p != &m_head;
+         p = p->m_next) {
+      n++;
+    }
+    return n;
+  }
+
+  /**
+   * @brief First element.
+   */
+  T& front() {
+    assert(!empty());
+    return static_cast<T&>(*m_head.m_next);
+  }
+
+  /**
+   * @brief Last element.
+   */
+  T& back() {
+    assert(!empty());
+    return static_cast<T&>(*m_head.m_prev);
+  }
+
+  /**
+   * @brief Insert @p elem at the front.
+   */
+  void push_front(T& elem) noexcept { link(m_head.m_next, elem); }
+
+  /**
+   * @brief Insert @p elem at the back.
+   */
+  void push_back(T& elem) noexcept { link(&m_head, elem); }
+
+  /**
+   * @brief Insert @p elem before @p pos.
+   *
+   * @return  iterator to @p elem
+   */
+  iterator insert(iterator pos, T& elem) noexcept {
+    link(pos.m_node, elem);
+    return iterator{&elem};
+  }
+
+  /**
+   * @brief Remove and return the first element.
+   */
+  T& pop_front() noexcept {
+    T& elem = front();
+    remove(elem);
+    return elem;
+  }
+
+  /**
+   * @brief Remove and return the last element.
+   */
+  T& pop_back() noexcept {
+    T& elem = back();
+    remove(elem);
+    return elem;
+  }
+
+  /**
+   * @brief Remove @p elem, which must be in this list.
+   */
+  void remove(T& elem) noexcept {
+    intrusive_list_node& n = elem;
+    assert(n.linked());
+    n.m_prev->m_next = n.m_next;
+    n.m_next->m_prev = n.m_prev;
+    n.m_next = nullptr;
+    n.m_prev = nullptr;
+  }
+
+  /**
+   * @brief Remove the element at @p pos.
+   *
+   * @return  iterator following the removed element
+   */
+  iterator erase(iterator pos) noexcept {
+    iterator next{pos.m_node->m_next};
+    remove(*pos);
+    return next;
+  }
+
+  /**
+   * @brief Unlink all elements.
+   */
+  void clear() noexcept {
+    while (!empty()) {
+      pop_front();
+    }
+  }
+
+private:
+  static void link(intrusive_list_node *next, T& elem) noexcept {
+    intrusive_list_node& n = elem;
+    assert(!n.linked());
+    n.m_next = next;
+    n.m_prev = next->m_prev;
+    next->m_prev->m_next = &n;
+    next->m_prev = &n;
+  }
+
+  intrusive_list_node m_head;
+};
+
+} // namespace riot
+
+#endif // RIOT_INTRUSIVE_LIST_HPP
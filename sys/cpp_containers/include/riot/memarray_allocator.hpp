@@ -0,0 +1,173 @@
+/*
+ * Copyright (C) 2021 Hamburg University of Applied Sciences (HAW)
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup sys_cpp_containers
+ * @{
+ *
+ * @file
+ * @brief   STL allocator backed by a @ref sys_memarray pool
+ *
+ * @}
+ */
+
+#ifndef RIOT_MEMARRAY_ALLOCATOR_HPP
+#define RIOT_MEMARRAY_ALLOCATOR_HPP
+
+#include <cstddef>
+#include <new>
+
+#include "memarray.h"
+
+namespace riot {
+
+/**
+ * @brief   Pool of fixed size blocks, independent of the pool size
+ *
+ * Use @ref riot::memarray_pool to create one.
+ */
+class memarray_resource {
+public:
+  memarray_resource(const memarray_resource&) = delete;
+  memarray_resource& operator=(const memarray_resource&) = delete;
+
+  /**
+   * @brief Size of a block.
+   */
+  std::size_t block_size() const noexcept { return m_pool.size; }
+
+  /**
+   * @brief Number of free blocks.
+   */
+  std::size_t available() noexcept { return memarray_available(&m_pool); }
+
+  /**
+   * @brief Take a block for @p bytes bytes.
+   *
+   * @return  the block, `nullptr` if @p bytes does not fit into a block or
+   *          the pool is exhausted
+   */
+  void *allocate(std::size_t bytes) noexcept {
+    return (bytes <= m_pool.size) ? memarray_alloc(&m_pool) : nullptr;
+  }
+
+  /**
+   * @brief Return a block to the pool.
+   */
+  void deallocate(void *ptr) noexcept { memarray_free(&m_pool, ptr); }
+
+protected:
+  /** @cond INTERNAL */
+  memarray_resource(void *data, std::size_t size, std::size_t num) noexcept {
+    memarray_init(&m_pool, data, size, num);
+  }
+  /** @endcond */
+
+private:
+  memarray_t m_pool;
+};
+
+/**
+ * @brief   Pool of @p Blocks blocks of @p BlockSize bytes
+ *
+ * The block size is rounded up to keep every block aligned for any type.
+ */
+template <std::size_t BlockSize, std::size_t Blocks>
+class memarray_pool : public memarray_resource {
+  static constexpr std::size_t align = alignof(std::max_align_t);
+
+public:
+  /**
+   * @brief Size of a block after rounding.
+   */
+  static constexpr std::size_t size =
+    ((BlockSize < sizeof(void *) ? sizeof(void *) : BlockSize) + align - 1) /
+    align * align;
+
+  memarray_pool() noexcept : memarray_resource(m_storage, size, Blocks) {}
+
+private:
+  alignas(std::max_align_t) unsigned char m_storage[size * Blocks];
+};
+
+/**
+ * @brief   STL allocator taking single objects from a
+ *          @ref riot::memarray_resource
+ *
+ * Suited for node based containers such as `std::list`, `std::map` or
+ * `std::unordered_map` nodes, which allocate one node at a time. Every
+ * allocation takes one block, so the pool's block size must fit the node
+ * type the container rebinds the allocator to. Requests that do not fit or
+ * find the pool exhausted throw `std::bad_alloc`.
+ *
+ * @code{.cpp}
+ * riot::memarray_pool<32, 16> pool;
+ * std::list<int, riot::memarray_allocator<int>> list{
+ *   riot::memarray_allocator<int>{pool}};
+ * @endcode
+ */
+template <class T>
+class memarray_allocator {
+  template <class U>
+  friend class memarray_allocator;
+
+public:
+  using value_type = T; /**< allocated type */
+
+  /**
+   * @brief Allocate from @p pool.
+   */
+  explicit memarray_allocator(memarray_resource& pool) noexcept
+      : m_pool{&pool} {}
+
+  /**
+   * @brief Rebinding copy constructor, shares the pool.
+   */
+  template <class U>
+  memarray_allocator(const memarray_allocator<U>& other) noexcept
+      : m_pool{other.m_pool} {}
+
+  /**
+   * @brief Allocate @p n objects.
+   */
+  T *allocate(std::size_t n) {
+    void *p = m_pool->allocate(n * sizeof(T));
+    if (!p) {
+      throw std::bad_alloc();
+    }
+    return static_cast<T *>(p);
+  }
+
+  /**
+   * @brief Release objects allocated by allocate().
+   */
+  void deallocate(T *p, std::size_t) noexcept { m_pool->deallocate(p); }
+
+  /**
+   * @brief Allocators compare equal if they share the pool.
+   */
+  template <class U>
+  bool operator==(const memarray_allocator<U>& other) const noexcept {
+    return m_pool == other.m_pool;
+  }
+
+  /**
+   * @brief Allocators compare equal if they share the pool.
+   */
+  template <class U>
+  bool operator!=(const memarray_allocator<U>& other) const noexcept {
+    return m_pool != other.m_pool;
+  }
+
+private:
+  memarray_resource *m_pool;
+};
+
+} // namespace riot
+
+#endif // RIOT_MEMARRAY_ALLOCATOR_HPP
@@ -0,0 +1,191 @@
+/*
+ * Copyright (C) 2021 Hamburg University of Applied Sciences (HAW)
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup sys_cpp_containers
+ * @{
+ *
+ * @file
+ * @brief   FIFO ring buffer with a fixed capacity and inline storage
+ *
+ * @}
+ */
+
+#ifndef RIOT_RING_BUFFER_HPP
+#define RIOT_RING_BUFFER_HPP
+
+#include <cassert>
+#include <cstddef>
+#include <new>
+#include <utility>
+
+namespace riot {
+
+/**
+ * @brief   FIFO of at most @p N elements of type @p T
+ *
+ * Unlike @ref ringbuffer_t, the buffer stores objects rather than bytes and
+ * constructs and destroys them in place. It is not thread safe; guard it
+ * with a mutex or disable interrupts when sharing it between contexts.
+ *
+ * A capacity that is a power of two turns the index wrap-around into a mask.
+ */
+template <class T, std::size_t N>
+class ring_buffer {
+  static_assert(N > 0, "a ring_buffer needs a capacity");
+
+public:
+  using value_type = T;             /**< element type */
+  using size_type = std::size_t;    /**< size type */
+  using reference = T&;             /**< element reference */
+  using const_reference = const T&; /**< const element reference */
+
+  /**
+   * @brief Create an empty buffer.
+   */
+  ring_buffer() noexcept = default;
+  ring_buffer(const ring_buffer&) = delete;
+  ring_buffer& operator=(const ring_buffer&) = delete;
+
+  ~ring_buffer() { clear(); }
+
+  /**
+   * @brief Number of elements in the buffer.
+   */
+  size_type size() const noexcept { return m_count; }
+  /**
+   * @brief Query if the buffer is empty.
+   */
+  bool empty() const noexcept { return m_count == 0; }
+  /**
+   * @brief Query if the buffer is full.
+   */
+  bool full() const noexcept { return m_count == N; }
+  /**
+   * @brief Maximum number of elements.
+   */
+  static constexpr size_type capacity() noexcept { return N; }
+
+  /**
+   * @brief Construct an element in place at the end.
+   *
+   * @return  `false` if the buffer is full
+   */
+  template <class... Args>
+  bool emplace(Args&&... args) {
+    if (full()) {
+      return false;
+    }
+    new (slot(wrap(m_head + m_count))) T(std::forward<Args>(args)...);
+    m_count++;
+    return true;
+  }
+
+  /**
+   * @brief Append a copy of @p value.
+   *
+   * @return  `false` if the buffer is full
+   */
+  bool push(const T& value) { return emplace(value); }
+
+  /**
+   * @brief Append @p value.
+   *
+   * @return  `false` if the buffer is full
+   */
+  bool push(T&& value) { return emplace(std::move(value)); }
+
+  /**
+   * @brief Take the oldest element.
+   *
+   * @param[out] value  the element
+   *
+   * @return  `false` if the buffer is empty
+   */
+  bool pop(T& value) {
+    if (empty()) {
+      return false;
+    }
+    value = std::move(front());
+    drop();
+    return true;
+  }
+
+  /**
+   * @brief The oldest element.
+   */
+  reference front() {
+    assert(!empty());
+    return *slot(m_head);
+  }
+
+  /**
+   * @brief The oldest element.
+   */
+  const_reference front() const {
+    assert(!empty());
+    return *slot(m_head);
+  }
+
+  /**
+   * @brief The @p pos th oldest element.
+   */
+  reference operator[](size_type pos) {
+    assert(pos < m_count);
+    return *slot(wrap(m_head + pos));
+  }
+
+  /**
+   * @brief The @p pos th oldest element.
+   */
+  const_reference operator[](size_type pos) const {
+    assert(pos < m_count);
+    return *slot(wrap(m_head + pos));
+  }
+
+  /**
+   * @brief Remove the oldest element.
+   */
+  void drop() {
+    assert(!empty());
+    slot(m_head)->~T();
+    m_head = wrap(m_head + 1);
+    m_count--;
+  }
+
+  /**
+   * @brief Remove all elements.
+   */
+  void clear() noexcept {
+    while (!empty()) {
+      drop();
+    }
+    m_head = 0;
+  }
+
+private:
+  static size_type wrap(size_type idx) noexcept {
+    return ((N & (N - 1)) == 0) ? (idx & (N - 1)) : (idx % N);
+  }
+
+  T *slot(size_type idx) noexcept {
+    return reinterpret_cast<T *>(m_storage) + idx;
+  }
+
+  const T *slot(size_type idx) const noexcept {
+    return reinterpret_cast<const T *>(m_storage) + idx;
+  }
+
+  alignas(T) unsigned char m_storage[N * sizeof(T)];
+  size_type m_head = 0;
+  size_type m_count = 0;
+};
+
+} // namespace riot
+
+#endif // RIOT_RING_BUFFER_HPP
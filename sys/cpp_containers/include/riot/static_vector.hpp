@@ -0,0 +1,301 @@
+/*
+ * Copyright (C) 2021 Hamburg University of Applied Sciences (HAW)
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup sys_cpp_containers
+ * @{
+ *
+ * @file
+ * @brief   Vector with a fixed capacity and inline storage
+ *
+ * @}
+ */
+
+#ifndef RIOT_STATIC_VECTOR_HPP
+#define RIOT_STATIC_VECTOR_HPP
+
+#include <cassert>
+#include <cstddef>
+#include <new>
+#include <utility>
+#include <iterator>
+#include <algorithm>
+#include <type_traits>
+#include <initializer_list>
+
+namespace riot {
+
+/**
+ * @brief   Vector of at most @p N elements of type @p T
+ *
+ * The elements are stored inside the object, so a static_vector never
+ * allocates. Exceeding the capacity is a programming error and caught by
+ * `assert()`; use full() to check before adding elements when the number of
+ * elements is not known in advance.
+ */
+template <class T, std::size_t N>
+class static_vector {
+  static_assert(N > 0, "a static_vector needs a capacity");
+
+public:
+  using value_type = T;                   /**< element type */
+  using size_type = std::size_t;          /**< size type */
+  using difference_type = std::ptrdiff_t; /**< difference type */
+  using reference = T&;                   /**< element reference */
+  using const_reference = const T&;       /**< const element reference */
+  using pointer = T*;                     /**< element pointer */
+  using const_pointer = const T*;         /**< const element pointer */
+  using iterator = T*;                    /**< iterator */
+  using const_iterator = const T*;        /**< const iterator */
+  /** reverse iterator */
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  /** const reverse iterator */
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+  /**
+   * @brief Create an empty vector.
+   */
+  static_vector() noexcept = default;
+
+  /**
+   * @brief Create a vector of @p count copies of @p value.
+   */
+  static_vector(size_type count, const T& value) {
+    assert(count <= N);
+    while (m_size < count) {
+      push_back(value);
+    }
+  }
+
+  /**
+   * @brief Create a vector from an initializer list.
+   */
+  static_vector(std::initializer_list<T> init) {
+    assert(init.size() <= N);
+    for (const auto& v : init) {
+      push_back(v);
+    }
+  }
+
+  /**
+   * @brief Copy constructor.
+   */
+  static_vector(const static_vector& other) {
+    for (const auto& v : other) {
+      push_back(v);
+    }
+  }
+
+  /**
+   * @brief Move constructor, moves the elements one by one.
+   */
+  static_vector(static_vector&& other) noexcept(
+    std::is_nothrow_move_constructible<T>::value) {
+    for (auto& v : other) {
+      push_back(std::move(v));
+    }
+    other.clear();
+  }
+
+  /**
+   * @brief Copy assignment operator.
+   */
+  static_vector& operator=(const static_vector& other) {
+    if (this != &other) {
+      clear();
+      for (const auto& v : other) {
+        push_back(v);
+      }
+    }
+    return *this;
+  }
+
+  /**
+   * @brief Move assignment operator.
+   */
+  static_vector& operator=(static_vector&& other) noexcept(
+    std::is_nothrow_move_constructible<T>::value) {
+    if (this != &other) {
+      clear();
+      for (auto& v : other) {
+        push_back(std::move(v));
+      }
+      other.clear();
+    }
+    return *this;
+  }
+
+  ~static_vector() { clear(); }
+
+  /** @name Iterators
+   * @{
+   */
+  iterator begin() noexcept { return data(); }
+  const_iterator begin() const noexcept { return data(); }
+  const_iterator cbegin() const noexcept { return data(); }
+  iterator end() noexcept { return data() + m_size; }
+  const_iterator end() const noexcept { return data() + m_size; }
+  const_iterator cend() const noexcept { return data() + m_size; }
+  reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+  const_reverse_iterator rbegin() const noexcept {
+    return const_reverse_iterator(end());
+  }
+  reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+  const_reverse_iterator rend() const noexcept {
+    return const_reverse_iterator(begin());
+  }
+  /** @} */
+
+  /** @name Capacity
+   * @{
+   */
+  size_type size() const noexcept { return m_size; }
+  bool empty() const noexcept { return m_size == 0; }
+  bool full() const noexcept { return m_size == N; }
+  static constexpr size_type capacity() noexcept { return N; }
+  static constexpr size_type max_size() noexcept { return N; }
+  /** @} */
+
+  /** @name Element access
+   * @{
+   */
+  T *data() noexcept { return reinterpret_cast<T *>(m_storage); }
+  const T *data() const noexcept {
+    return reinterpret_cast<const T *>(m_storage);
+  }
+  reference operator[](size_type pos) {
+    assert(pos < m_size);
+    return data()[pos];
+  }
+  const_reference operator[](size_type pos) const {
+    assert(pos < m_size);
+    return data()[pos];
+  }
+  reference front() { return (*this)[0]; }
+  const_reference front() const { return (*this)[0]; }
+  reference back() { return (*this)[m_size - 1]; }
+  const_reference back() const { return (*this)[m_size - 1]; }
+  /** @} */
+
+  /**
+   * @brief Append a copy of @p value.
+   */
+  void push_back(const T& value) { emplace_back(value); }
+
+  /**
+   * @brief Append @p value.
+   */
+  void push_back(T&& value) { emplace_back(std::move(value)); }
+
+  /**
+   * @brief Construct an element in place at the end.
+   *
+   * @return  reference to the new element
+   */
+  template <class... Args>
+  reference emplace_back(Args&&... args) {
+    assert(m_size < N);
+    T *p = new (data() + m_size) T(std::forward<Args>(args)...);
+    m_size++;
+    return *p;
+  }
+
+  /**
+   * @brief Remove the last element.
+   */
+  void pop_back() {
+    assert(m_size > 0);
+    m_size--;
+    data()[m_size].~T();
+  }
+
+  /**
+   * @brief Construct an element in place before @p pos.
+   *
+   * @return  iterator to the new element
+   */
+  template <class... Args>
+  iterator emplace(const_iterator pos, Args&&... args) {
+    size_type idx = pos - begin();
+    assert(idx <= m_size);
+    emplace_back(std::forward<Args>(args)...);
+    std::rotate(begin() + idx, end() - 1, end());
+    return begin() + idx;
+  }
+
+  /**
+   * @brief Insert a copy of @p value before @p pos.
+   */
+  iterator insert(const_iterator pos, const T& value) {
+    return emplace(pos, value);
+  }
+
+  /**
+   * @brief Insert @p value before @p pos.
+   */
+  iterator insert(const_iterator pos, T&& value) {
+    return emplace(pos, std::move(value));
+  }
+
+  /**
+   * @brief Remove the element at @p pos.
+   *
+   * @return  iterator following the removed element
+   */
+  iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+
+  /**
+   * @brief Remove the elements in [@p first, @p last).
+   *
+   * @return  iterator following the removed elements
+   */
+  iterator erase(const_iterator first, const_iterator last) {
+    iterator f = begin() + (first - begin());
+    iterator l = begin() + (last - begin());
+    iterator new_end = std::move(l, end(), f);
+    while (end() != new_end) {
+      pop_back();
+    }
+    return f;
+  }
+
+  /**
+   * @brief Remove all elements.
+   */
+  void clear() noexcept {
+    while (m_size > 0) {
+      m_size--;
+      data()[m_size].~T();
+    }
+  }
+
+private:
+  alignas(T) unsigned char m_storage[N * sizeof(T)];
+  size_type m_size = 0;
+};
+
+/**
+ * @brief Compare two vectors element by element.
+ */
+template <class T, std::size_t N>
+bool operator==(const static_vector<T, N>& lhs, const static_vector<T, N>& rhs) {
+  return (lhs.size() == rhs.size()) &&
+         std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+/**
+ * @brief Compare two vectors element by element.
+ */
+template <class T, std::size_t N>
+bool operator!=(const static_vector<T, N>& lhs, const static_vector<T, N>& rhs) {
+  return !(lhs == rhs);
+}
+
+} // namespace riot
+
+#endif // RIOT_STATIC_VECTOR_HPP
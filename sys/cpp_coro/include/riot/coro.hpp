@@ -0,0 +1,638 @@
+/*
+ * Copyright (C) 2021 Hamburg University of Applied Sciences (HAW)
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup sys_cpp_coro
+ * @{
+ *
+ * @file
+ * @brief   C++20 coroutine tasks on top of @ref sys_event
+ *
+ * @}
+ */
+
+#ifndef RIOT_CORO_HPP
+#define RIOT_CORO_HPP
+
+#include <cerrno>
+#include <cstdint>
+#include <utility>
+#include <optional>
+#include <exception>
+#include <coroutine>
+
+#include "irq.h"
+#include "kernel_defines.h"
+#include "event.h"
+#include "ztimer.h"
+
+#if IS_USED(MODULE_SOCK_UDP) && IS_USED(MODULE_SOCK_ASYNC)
+#include "net/sock/udp.h"
+#include "net/sock/async.h"
+#endif
+
+namespace riot {
+namespace coro {
+
+class executor;
+
+template <class T = void>
+class task;
+
+namespace detail {
+
+/**
+ * @brief Event resuming a suspended coroutine when handled.
+ */
+struct resume_event {
+  event_t super;                    /**< event_t structure that gets extended */
+  std::coroutine_handle<> handle;   /**< coroutine to resume */
+
+  resume_event() noexcept : super{}, handle{} { super.handler = handler; }
+  resume_event(const resume_event&) = delete;
+  resume_event& operator=(const resume_event&) = delete;
+
+  static void handler(event_t *ev) {
+    reinterpret_cast<resume_event *>(ev)->handle.resume();
+  }
+};
+
+/** @cond INTERNAL */
+class promise_base {
+  friend class riot::coro::executor;
+
+public:
+  struct final_awaiter {
+    bool await_ready() noexcept { return false; }
+
+    template <class P>
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<P> h) noexcept;
+
+    void await_resume() noexcept {}
+  };
+
+  std::suspend_always initial_suspend() noexcept { return {}; }
+  final_awaiter final_suspend() noexcept { return {}; }
+  void unhandled_exception() noexcept {
+    m_exception = std::current_exception();
+  }
+
+  executor *get_executor() const noexcept { return m_executor; }
+
+  void set_caller(std::coroutine_handle<> caller, executor *ex) noexcept {
+    m_continuation = caller;
+    m_executor = ex;
+  }
+
+protected:
+  void rethrow_if_failed() {
+    if (m_exception) {
+      std::rethrow_exception(m_exception);
+    }
+  }
+
+private:
+  std::coroutine_handle<> m_continuation;
+  executor *m_executor = nullptr;
+  std::exception_ptr m_exception;
+  resume_event m_start;
+  bool m_detached = false;
+};
+
+template <class T>
+class promise : public promise_base {
+public:
+  task<T> get_return_object() noexcept;
+
+  template <class U>
+  void return_value(U&& value) {
+    m_value.emplace(std::forward<U>(value));
+  }
+
+  T result() {
+    rethrow_if_failed();
+    return std::move(*m_value);
+  }
+
+private:
+  std::optional<T> m_value;
+};
+
+template <>
+class promise<void> : public promise_base {
+public:
+  task<void> get_return_object() noexcept;
+
+  void return_void() noexcept {}
+
+  void result() { rethrow_if_failed(); }
+};
+/** @endcond */
+
+} // namespace detail
+
+/**
+ * @brief   Runs coroutines on an event queue
+ *
+ * All coroutines spawned on an executor and everything they `co_await`
+ * resume in the thread calling run(). Wake-ups from timers or the network
+ * stack are posted to the event queue, so a single thread with a single
+ * stack serves any number of concurrent tasks.
+ */
+class executor {
+public:
+  /**
+   * @brief Create an executor, the queue is claimed by run().
+   */
+  executor() noexcept { event_queue_init_detached(&m_queue); }
+
+  executor(const executor&) = delete;
+  executor& operator=(const executor&) = delete;
+
+  /**
+   * @brief Start @p t on this executor and let it run to completion on its
+   *        own.
+   *
+   * The task starts when run() is called or, if it is running already, as
+   * soon as the currently running coroutine suspends. Must be called before
+   * run() or from a coroutine on this executor. An exception leaving a
+   * spawned task terminates the program.
+   */
+  template <class T>
+  void spawn(task<T> t);
+
+  /**
+   * @brief Run the coroutines until all spawned tasks completed.
+   *
+   * The first call binds the executor to the calling thread, later calls
+   * must come from the same thread.
+   */
+  void run() {
+    if (m_queue.waiter == nullptr) {
+      event_queue_claim(&m_queue);
+    }
+    while (m_active > 0) {
+      event_t *ev = event_wait(&m_queue);
+      ev->handler(ev);
+    }
+  }
+
+  /**
+   * @brief Number of spawned tasks that did not complete yet.
+   */
+  unsigned active() const noexcept { return m_active; }
+
+  /**
+   * @brief The event queue the coroutines are resumed from. Other events may
+   *        be posted to it as well.
+   */
+  event_queue_t *queue() noexcept { return &m_queue; }
+
+  /** @cond INTERNAL */
+  void post(detail::resume_event& ev) noexcept {
+    event_post(&m_queue, &ev.super);
+  }
+
+  void task_done() noexcept { m_active--; }
+  /** @endcond */
+
+private:
+  event_queue_t m_queue;
+  unsigned m_active = 0;
+};
+
+/**
+ * @brief   Coroutine returning a value of type @p T
+ *
+ * A task does not start before it is awaited with `co_await` from another
+ * task, which is suspended until the result is available, or handed to
+ * executor::spawn(). An exception leaving the task is rethrown in the
+ * awaiting task.
+ */
+template <class T>
+class task {
+public:
+  /**
+   * @brief Promise type of the coroutine.
+   */
+  using promise_type = detail::promise<T>;
+  /**
+   * @brief Handle of the coroutine.
+   */
+  using handle_type = std::coroutine_handle<promise_type>;
+
+  task(task&& other) noexcept : m_handle{std::exchange(other.m_handle, {})} {}
+  task& operator=(task&& other) noexcept {
+    if (this != &other) {
+      destroy();
+      m_handle = std::exchange(other.m_handle, {});
+    }
+    return *this;
+  }
+  task(const task&) = delete;
+  task& operator=(const task&) = delete;
+
+  ~task() { destroy(); }
+
+  /**
+   * @brief Start the task and suspend the caller until it completed.
+   */
+  auto operator co_await() && noexcept { return awaiter{m_handle}; }
+
+  /**
+   * @brief Give up ownership of the coroutine.
+   */
+  handle_type release() noexcept { return std::exchange(m_handle, {}); }
+
+private:
+  friend class detail::promise<T>;
+
+  struct awaiter {
+    handle_type h;
+
+    bool await_ready() noexcept { return false; }
+
+    template <class P>
+    std::coroutine_handle<> await_suspend(
+      std::coroutine_handle<P> caller) noexcept {
+      h.promise().set_caller(caller, caller.promise().get_executor());
+      return h;
+    }
+
+    T await_resume() { return h.promise().result(); }
+  };
+
+  explicit task(handle_type h) noexcept : m_handle{h} {}
+
+  void destroy() noexcept {
+    if (m_handle) {
+      m_handle.destroy();
+    }
+  }
+
+  handle_type m_handle;
+};
+
+/** @cond INTERNAL */
+namespace detail {
+
+template <class T>
+inline task<T> promise<T>::get_return_object() noexcept {
+  return task<T>{std::coroutine_handle<promise<T>>::from_promise(*this)};
+}
+
+inline task<void> promise<void>::get_return_object() noexcept {
+  return task<void>{std::coroutine_handle<promise<void>>::from_promise(*this)};
+}
+
+template <class P>
+inline std::coroutine_handle<>
+promise_base::final_awaiter::await_suspend(std::coroutine_handle<P> h) noexcept {
+  promise_base& p = h.promise();
+  if (p.m_continuation) {
+    /* resume the awaiting task without growing the stack */
+    return p.m_continuation;
+  }
+  if (p.m_detached) {
+    if (p.m_exception) {
+      std::terminate();
+    }
+    executor *ex = p.m_executor;
+    h.destroy();
+    ex->task_done();
+  }
+  return std::noop_coroutine();
+}
+
+} // namespace detail
+/** @endcond */
+
+template <class T>
+void executor::spawn(task<T> t) {
+  auto h = t.release();
+  auto& p = h.promise();
+  p.m_executor = this;
+  p.m_detached = true;
+  p.m_start.handle = h;
+  m_active++;
+  post(p.m_start);
+}
+
+/**
+ * @brief   Awaitable suspending the current task until the other ready
+ *          tasks of the executor had their turn
+ */
+class yield_awaiter {
+public:
+  /** @cond INTERNAL */
+  bool await_ready() noexcept { return false; }
+
+  template <class P>
+  void await_suspend(std::coroutine_handle<P> h) noexcept {
+    m_ev.handle = h;
+    h.promise().get_executor()->post(m_ev);
+  }
+
+  void await_resume() noexcept {}
+  /** @endcond */
+
+private:
+  detail::resume_event m_ev;
+};
+
+/**
+ * @brief   Let the other ready tasks run before continuing.
+ *
+ * @code{.cpp}
+ * co_await riot::coro::yield();
+ * @endcode
+ */
+inline yield_awaiter yield() noexcept { return {}; }
+
+/**
+ * @brief   Awaitable suspending the current task for a fixed time
+ */
+class sleep_awaiter {
+public:
+  /** @cond INTERNAL */
+  sleep_awaiter(ztimer_clock_t *clock, uint32_t duration) noexcept
+      : m_clock{clock}, m_duration{duration}, m_timer{} {}
+
+  bool await_ready() noexcept { return m_duration == 0; }
+
+  template <class P>
+  void await_suspend(std::coroutine_handle<P> h) noexcept {
+    m_ev.handle = h;
+    m_executor = h.promise().get_executor();
+    m_timer.callback = _expired;
+    m_timer.arg = this;
+    ztimer_set(m_clock, &m_timer, m_duration);
+  }
+
+  void await_resume() noexcept {}
+  /** @endcond */
+
+private:
+  static void _expired(void *arg) {
+    auto self = static_cast<sleep_awaiter *>(arg);
+    /* called in ISR context, event_post() is safe to use there */
+    self->m_executor->post(self->m_ev);
+  }
+
+  ztimer_clock_t *m_clock;
+  uint32_t m_duration;
+  ztimer_t m_timer;
+  executor *m_executor = nullptr;
+  detail::resume_event m_ev;
+};
+
+/**
+ * @brief   Suspend the current task for @p duration ticks of @p clock.
+ *
+ * @code{.cpp}
+ * co_await riot::coro::sleep_for(ZTIMER_MSEC, 100);
+ * @endcode
+ */
+inline sleep_awaiter sleep_for(ztimer_clock_t *clock, uint32_t duration) noexcept {
+  return {clock, duration};
+}
+
+/**
+ * @brief   Mutex for tasks
+ *
+ * Unlike @ref mutex_t, waiting for the mutex only suspends the awaiting
+ * task, not the thread running the executor. Ownership is handed to the
+ * longest waiting task on unlock().
+ */
+class mutex {
+  struct waiter {
+    waiter *next = nullptr;
+    executor *ex = nullptr;
+    detail::resume_event ev;
+  };
+
+public:
+  /**
+   * @brief Awaitable returned by lock().
+   */
+  class lock_awaiter {
+  public:
+    /** @cond INTERNAL */
+    explicit lock_awaiter(mutex& m) noexcept : m_mutex{m} {}
+
+    bool await_ready() noexcept { return m_mutex.try_lock(); }
+
+    template <class P>
+    bool await_suspend(std::coroutine_handle<P> h) noexcept {
+      m_waiter.ev.handle = h;
+      m_waiter.ex = h.promise().get_executor();
+      return m_mutex.enqueue(&m_waiter);
+    }
+
+    void await_resume() noexcept {}
+    /** @endcond */
+
+  private:
+    mutex& m_mutex;
+    waiter m_waiter;
+  };
+
+  mutex() noexcept = default;
+  mutex(const mutex&) = delete;
+  mutex& operator=(const mutex&) = delete;
+
+  /**
+   * @brief Suspend the current task until it owns the mutex.
+   *
+   * @code{.cpp}
+   * co_await m.lock();
+   * @endcode
+   */
+  lock_awaiter lock() noexcept { return lock_awaiter{*this}; }
+
+  /**
+   * @brief Take the mutex if it is free.
+   *
+   * @return  `true` if the mutex was taken.
+   */
+  bool try_lock() noexcept {
+    unsigned state = irq_disable();
+    bool res = !m_locked;
+    m_locked = true;
+    irq_restore(state);
+    return res;
+  }
+
+  /**
+   * @brief Release the mutex and resume the next waiting task, if any.
+   */
+  void unlock() noexcept {
+    unsigned state = irq_disable();
+    waiter *w = m_head;
+    if (w) {
+      /* the mutex stays locked, it now belongs to w */
+      m_head = w->next;
+      if (!m_head) {
+        m_tail = nullptr;
+      }
+    }
+    else {
+      m_locked = false;
+    }
+    irq_restore(state);
+    if (w) {
+      w->ex->post(w->ev);
+    }
+  }
+
+private:
+  /* returns false if the mutex got free in the meantime and was taken */
+  bool enqueue(waiter *w) noexcept {
+    unsigned state = irq_disable();
+    if (!m_locked) {
+      m_locked = true;
+      irq_restore(state);
+      return false;
+    }
+    if (m_tail) {
+      m_tail->next = w;
+    }
+    else {
+      m_head = w;
+    }
+    m_tail = w;
+    irq_restore(state);
+    return true;
+  }
+
+  waiter *m_head = nullptr;
+  waiter *m_tail = nullptr;
+  bool m_locked = false;
+};
+
+#if IS_USED(MODULE_SOCK_UDP) && IS_USED(MODULE_SOCK_ASYNC)
+/** @cond INTERNAL */
+namespace detail {
+
+/* Tries to receive once; suspends until the network stack signals new data
+ * if nothing was available. -EAGAIN after resuming means the data was taken
+ * in the meantime and the caller has to wait again. */
+class udp_recv_awaiter {
+  enum : uint8_t {
+    IDLE,       /* callback not installed */
+    ARMED,      /* callback installed, task running */
+    SUSPENDED,  /* callback installed, task suspended */
+    FIRED,      /* callback reported data */
+  };
+
+public:
+  udp_recv_awaiter(sock_udp_t *sock, void *data, size_t max_len,
+                   sock_udp_ep_t *remote) noexcept
+      : m_sock{sock}, m_data{data}, m_max_len{max_len}, m_remote{remote} {}
+
+  bool await_ready() noexcept { return false; }
+
+  template <class P>
+  bool await_suspend(std::coroutine_handle<P> h) noexcept {
+    m_ev.handle = h;
+    m_executor = h.promise().get_executor();
+    m_state = ARMED;
+    /* install the callback before checking, so no packet gets lost */
+    sock_udp_set_cb(m_sock, _cb, this);
+    m_res = sock_udp_recv(m_sock, m_data, m_max_len, 0, m_remote);
+
+    unsigned state = irq_disable();
+    bool suspend = (m_res == -EAGAIN) && (m_state == ARMED);
+    m_state = suspend ? SUSPENDED : IDLE;
+    irq_restore(state);
+    return suspend;
+  }
+
+  ssize_t await_resume() noexcept {
+    sock_udp_set_cb(m_sock, nullptr, nullptr);
+    if (m_res == -EAGAIN) {
+      m_res = sock_udp_recv(m_sock, m_data, m_max_len, 0, m_remote);
+    }
+    return m_res;
+  }
+
+private:
+  static void _cb(sock_udp_t *sock, sock_async_flags_t flags, void *arg) {
+    (void)sock;
+    if (!(flags & SOCK_ASYNC_MSG_RECV)) {
+      return;
+    }
+    auto self = static_cast<udp_recv_awaiter *>(arg);
+    unsigned state = irq_disable();
+    if (self->m_state == SUSPENDED) {
+      self->m_state = FIRED;
+      self->m_executor->post(self->m_ev);
+    }
+    else if (self->m_state == ARMED) {
+      self->m_state = FIRED;
+    }
+    irq_restore(state);
+  }
+
+  sock_udp_t *m_sock;
+  void *m_data;
+  size_t m_max_len;
+  sock_udp_ep_t *m_remote;
+  ssize_t m_res = -EAGAIN;
+  executor *m_executor = nullptr;
+  resume_event m_ev;
+  volatile uint8_t m_state = IDLE;
+};
+
+} // namespace detail
+/** @endcond */
+
+/**
+ * @brief   Receive a UDP message, suspending the current task until one
+ *          is available.
+ *
+ * Only one task may wait on a sock at a time, as the asynchronous callback
+ * of @p sock is used for the wake-up.
+ *
+ * @param[in] sock      A UDP sock object.
+ * @param[out] data     Pointer where the received data should be stored.
+ * @param[in] max_len   Maximum space available at @p data.
+ * @param[out] remote   Remote end point of the received data. May be NULL.
+ *
+ * @return  The number of bytes received on success, or the negative error
+ *          code of sock_udp_recv().
+ */
+inline task<ssize_t> udp_recv(sock_udp_t *sock, void *data, size_t max_len,
+                              sock_udp_ep_t *remote = nullptr) {
+  for (;;) {
+    ssize_t res = co_await detail::udp_recv_awaiter{sock, data, max_len,
+                                                    remote};
+    if (res != -EAGAIN) {
+      co_return res;
+    }
+  }
+}
+
+/**
+ * @brief   Send a UDP message.
+ *
+ * sock_udp_send() hands the message to the network stack without waiting
+ * for it to be sent, so the task never suspends.
+ *
+ * @return  The result of sock_udp_send().
+ */
+inline task<ssize_t> udp_send(sock_udp_t *sock, const void *data, size_t len,
+                              const sock_udp_ep_t *remote = nullptr) {
+  co_return sock_udp_send(sock, data, len, remote);
+}
+#endif /* IS_USED(MODULE_SOCK_UDP) && IS_USED(MODULE_SOCK_ASYNC) */
+
+} // namespace coro
+} // namespace riot
+
+#endif // RIOT_CORO_HPP
@@ -228,6 +228,224 @@ void bloom_add(bloom_t *bloom, const uint8_t *buf, size_t len);
  */
 bool bloom_check(bloom_t *bloom, const uint8_t *buf, size_t len);
 
+/**
+ * @name    Sizing
+ *
+ * The false positive rate is given as 1 / @p fp_inv, e.g. 100 for 1 %.
+ * The functions use integer arithmetic only.
+ * @{
+ */
+/**
+ * @brief Calculate the size of a Bloom filter
+ *
+ * @param n         expected number of elements in the filter
+ * @param fp_inv    inverse of the target false positive rate
+ *
+ * @return          size of the filter in bits, a multiple of 8
+ */
+size_t bloom_calc_bits(size_t n, uint32_t fp_inv);
+
+/**
+ * @brief Calculate the optimal number of hash functions
+ *
+ * This is the number of bits set per element for a filter sized with
+ * @ref bloom_calc_bits(), @ref bloom_blocked_calc_blocks() or
+ * @ref bloom_counting_calc_counters().
+ *
+ * @param fp_inv    inverse of the target false positive rate
+ *
+ * @return          number of hash functions
+ */
+size_t bloom_calc_hashes(uint32_t fp_inv);
+/** @} */
+
+/**
+ * @brief 64 bit hash used by the blocked and the counting Bloom filter
+ *
+ * The k positions of an element are derived from this single hash by double
+ * hashing instead of calling k hash functions. The hash is MurmurHash64A,
+ * its value depends on the byte order of the host.
+ *
+ * @param buf    data to hash
+ * @param len    the length of @p buf
+ *
+ * @return       64 bit hash of @p buf
+ */
+uint64_t bloom_hash64(const uint8_t *buf, size_t len);
+
+/**
+ * @name    Blocked Bloom filter
+ *
+ * All bits of an element are set in one block of the size of a cache line
+ * that is selected by the hash, so a check touches a single cache line
+ * instead of k random locations of the filter. In exchange, the false
+ * positive rate is slightly higher than that of a classic filter of the same
+ * size, which is compensated by @ref bloom_blocked_calc_blocks().
+ * @{
+ */
+/**
+ * @brief Size of a block in bytes
+ *
+ * Should be the size of a cache line of the CPU and must be a power of two.
+ * The array of blocks should be aligned to it.
+ */
+#ifndef CONFIG_BLOOM_BLOCKED_BLOCK_SIZE
+#define CONFIG_BLOOM_BLOCKED_BLOCK_SIZE     (64U)
+#endif
+
+/**
+ * @brief Size of the array for a number of blocks in bytes
+ */
+#define BLOOM_BLOCKED_BYTES(blocks)     ((blocks) * CONFIG_BLOOM_BLOCKED_BLOCK_SIZE)
+
+/**
+ * @brief blocked Bloom filter object
+ */
+typedef struct {
+    /** the blocks */
+    uint8_t *a;
+    /** number of blocks */
+    size_t blocks;
+    /** number of bits set per element */
+    size_t k;
+} bloom_blocked_t;
+
+/**
+ * @brief Initialize a blocked Bloom filter
+ *
+ * @param bloom     bloom_blocked_t to initialize
+ * @param blocks    memory of the blocks, is cleared
+ * @param numof     number of blocks
+ * @param k         number of bits set per element
+ *
+ * @pre     @p blocks MUST hold BLOOM_BLOCKED_BYTES(@p numof) bytes.
+ */
+void bloom_blocked_init(bloom_blocked_t *bloom, uint8_t *blocks, size_t numof,
+                        size_t k);
+
+/**
+ * @brief Calculate the number of blocks of a blocked Bloom filter
+ *
+ * @param n         expected number of elements in the filter
+ * @param fp_inv    inverse of the target false positive rate
+ *
+ * @return          number of blocks
+ */
+size_t bloom_blocked_calc_blocks(size_t n, uint32_t fp_inv);
+
+/**
+ * @brief Add an element to a blocked Bloom filter
+ *
+ * @param bloom  blocked Bloom filter
+ * @param buf    element to add
+ * @param len    the length of @p buf
+ */
+void bloom_blocked_add(bloom_blocked_t *bloom, const uint8_t *buf, size_t len);
+
+/**
+ * @brief Determine if an element is in a blocked Bloom filter
+ *
+ * @param bloom  blocked Bloom filter
+ * @param buf    element to check
+ * @param len    the length of @p buf
+ *
+ * @return       false if the element is not in the filter
+ * @return       true if the element may be in the filter
+ */
+bool bloom_blocked_check(const bloom_blocked_t *bloom, const uint8_t *buf,
+                         size_t len);
+/** @} */
+
+/**
+ * @name    Counting Bloom filter
+ *
+ * Each position is a 4 bit counter instead of a bit, so that elements can
+ * be removed again. It needs four times the memory of a classic filter with
+ * the same false positive rate. A counter that reaches its maximum is not
+ * decremented anymore, so removing elements never causes false negatives.
+ * @{
+ */
+/**
+ * @brief Size of the array for a number of counters in bytes
+ */
+#define BLOOM_COUNTING_BYTES(counters)  (((counters) + 1) / 2)
+
+/**
+ * @brief counting Bloom filter object
+ */
+typedef struct {
+    /** the counters, two per byte */
+    uint8_t *c;
+    /** number of counters */
+    size_t m;
+    /** number of counters incremented per element */
+    size_t k;
+} bloom_counting_t;
+
+/**
+ * @brief Initialize a counting Bloom filter
+ *
+ * @param bloom     bloom_counting_t to initialize
+ * @param counters  memory of the counters, is cleared
+ * @param m         number of counters
+ * @param k         number of counters incremented per element
+ *
+ * @pre     @p counters MUST hold BLOOM_COUNTING_BYTES(@p m) bytes.
+ */
+void bloom_counting_init(bloom_counting_t *bloom, uint8_t *counters, size_t m,
+                         size_t k);
+
+/**
+ * @brief Calculate the number of counters of a counting Bloom filter
+ *
+ * @param n         expected number of elements in the filter
+ * @param fp_inv    inverse of the target false positive rate
+ *
+ * @return          number of counters
+ */
+static inline size_t bloom_counting_calc_counters(size_t n, uint32_t fp_inv)
+{
+    return bloom_calc_bits(n, fp_inv);
+}
+
+/**
+ * @brief Add an element to a counting Bloom filter
+ *
+ * @param bloom  counting Bloom filter
+ * @param buf    element to add
+ * @param len    the length of @p buf
+ */
+void bloom_counting_add(bloom_counting_t *bloom, const uint8_t *buf, size_t len);
+
+/**
+ * @brief Remove an element from a counting Bloom filter
+ *
+ * Only elements that were added before must be removed. Otherwise, other
+ * elements may be removed as well.
+ *
+ * @param bloom  counting Bloom filter
+ * @param buf    element to remove
+ * @param len    the length of @p buf
+ *
+ * @return       0 on success
+ * @return       -ENOENT if the element is not in the filter
+ */
+int bloom_counting_remove(bloom_counting_t *bloom, const uint8_t *buf, size_t len);
+
+/**
+ * @brief Determine if an element is in a counting Bloom filter
+ *
+ * @param bloom  counting Bloom filter
+ * @param buf    element to check
+ * @param len    the length of @p buf
+ *
+ * @return       false if the element is not in the filter
+ * @return       true if the element may be in the filter
+ */
+bool bloom_counting_check(const bloom_counting_t *bloom, const uint8_t *buf,
+                          size_t len);
+/** @} */
+
 #ifdef __cplusplus
 }
 #endif
@@ -25,6 +25,7 @@
 #ifndef NET_CSMA_SENDER_H
 #define NET_CSMA_SENDER_H
 
+#include <stdbool.h>
 #include <stdint.h>
 
 #include "net/netdev.h"
@@ -67,8 +68,31 @@ extern "C" {
 #ifndef CONFIG_CSMA_SENDER_BACKOFF_PERIOD_UNIT
 #define CONFIG_CSMA_SENDER_BACKOFF_PERIOD_UNIT     (320U)
 #endif
+
+/**
+ * @brief Lowest initial backoff exponent of the adaptive CSMA/CA
+ *
+ * On an idle channel the adaptive CSMA/CA starts with this backoff exponent
+ * instead of csma_sender_conf_t::min_be.
+ */
+#ifndef CONFIG_CSMA_SENDER_ADAPTIVE_MIN_BE
+#define CONFIG_CSMA_SENDER_ADAPTIVE_MIN_BE         (1U)
+#endif
+
+/**
+ * @brief Weight of a new sample in the moving averages of the adaptive
+ *        CSMA/CA as a power of two, i.e. a sample is weighted with 1/2^n
+ */
+#ifndef CONFIG_CSMA_SENDER_ADAPTIVE_WEIGHT_EXP
+#define CONFIG_CSMA_SENDER_ADAPTIVE_WEIGHT_EXP     (3U)
+#endif
 /** @} */
 
+/**
+ * @brief   Ratio 1.0 of the moving averages of the adaptive CSMA/CA
+ */
+#define CSMA_SENDER_ADAPTIVE_RATIO_ONE             (1U << 15)
+
 /**
  * @brief   Configuration type for backoff
  */
@@ -79,6 +103,35 @@ typedef struct {
     uint32_t backoff_period;    /**< backoff period in microseconds */
 } csma_sender_conf_t;
 
+/**
+ * @brief   Channel statistics of the adaptive CSMA/CA
+ */
+typedef struct {
+    uint32_t cca;               /**< number of CCAs */
+    uint32_t cca_busy;          /**< number of CCAs that found the channel busy */
+    uint32_t tx_acked;          /**< number of acknowledged frames */
+    uint32_t tx_noack;          /**< number of frames without ACK */
+    uint32_t fail;              /**< number of frames not sent, channel busy */
+} csma_sender_stats_t;
+
+/**
+ * @brief   State of the adaptive CSMA/CA
+ *
+ * The adaptive CSMA/CA keeps moving averages of the share of CCAs that
+ * found the channel busy and of the share of frames that were not
+ * acknowledged. The initial backoff exponent of a transmission grows
+ * linearly with the greater one of both from
+ * @ref CONFIG_CSMA_SENDER_ADAPTIVE_MIN_BE to csma_sender_conf_t::max_be.
+ * Within a transmission, the backoff exponent is incremented after each
+ * busy CCA as with the fixed CSMA/CA.
+ */
+typedef struct {
+    const csma_sender_conf_t *conf; /**< configuration, must not be NULL */
+    csma_sender_stats_t stats;      /**< channel statistics */
+    uint16_t busy;                  /**< moving average of the busy CCAs */
+    uint16_t noack;                 /**< moving average of the ACK losses */
+} csma_sender_adaptive_t;
+
 /**
  * @brief   Default configuration.
  */
@@ -139,6 +192,80 @@ int csma_sender_csma_ca_send(netdev_t *dev, iolist_t *iolist,
  */
 int csma_sender_cca_send(netdev_t *dev, iolist_t *iolist);
 
+/**
+ * @brief   Initializes the state of the adaptive CSMA/CA
+ *
+ * @param[out] state    state of the adaptive CSMA/CA
+ * @param[in] conf      configuration for the backoff;
+ *                      will be set to @ref CSMA_SENDER_CONF_DEFAULT if NULL.
+ */
+void csma_sender_adaptive_init(csma_sender_adaptive_t *state,
+                               const csma_sender_conf_t *conf);
+
+/**
+ * @brief   Sends a 802.15.4 frame using the adaptive CSMA/CA method
+ *
+ * @pre `dev != NULL && state != NULL`
+ *
+ * Same as @ref csma_sender_csma_ca_send, but the software procedure
+ * starts with the backoff exponent of @ref csma_sender_adaptive_be and
+ * records the results of the CCAs in @p state.
+ *
+ * @param[in] dev       netdev device, needs to be already initialized
+ * @param[in] iolist    pointer to the data
+ * @param[in,out] state state of the adaptive CSMA/CA
+ *
+ * @return              see @ref csma_sender_csma_ca_send
+ */
+int csma_sender_csma_ca_send_adaptive(netdev_t *dev, iolist_t *iolist,
+                                      csma_sender_adaptive_t *state);
+
+/**
+ * @brief   Gets the initial backoff exponent of the next transmission
+ *
+ * @param[in] state     state of the adaptive CSMA/CA
+ *
+ * @return              the backoff exponent
+ */
+uint8_t csma_sender_adaptive_be(const csma_sender_adaptive_t *state);
+
+/**
+ * @brief   Records the result of a CCA
+ *
+ * Called by @ref csma_sender_csma_ca_send_adaptive, only needed if the
+ * CCAs are performed otherwise.
+ *
+ * @param[in,out] state state of the adaptive CSMA/CA
+ * @param[in] busy      the CCA found the channel busy
+ */
+void csma_sender_adaptive_cca(csma_sender_adaptive_t *state, bool busy);
+
+/**
+ * @brief   Records whether a frame was acknowledged
+ *
+ * Has to be called by the user of the adaptive CSMA/CA when the
+ * transmission of a frame that requested an ACK has completed, i.e. on
+ * @ref NETDEV_EVENT_TX_COMPLETE and @ref NETDEV_EVENT_TX_NOACK.
+ *
+ * @param[in,out] state state of the adaptive CSMA/CA
+ * @param[in] acked     the frame was acknowledged
+ */
+void csma_sender_adaptive_tx_done(csma_sender_adaptive_t *state, bool acked);
+
+/**
+ * @brief   Gets the share of CCAs that found the channel busy
+ *
+ * @param[in] state     state of the adaptive CSMA/CA
+ *
+ * @return              busy CCAs per mille since the initialization
+ */
+static inline unsigned csma_sender_busy_ratio(const csma_sender_adaptive_t *state)
+{
+    return state->stats.cca
+           ? (unsigned)((uint64_t)state->stats.cca_busy * 1000 / state->stats.cca)
+           : 0;
+}
+
 
 #ifdef __cplusplus
 }
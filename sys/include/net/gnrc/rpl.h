@@ -249,12 +249,43 @@ extern "C" {
 /**
  * @brief   Number of implemented Objective Functions
  */
-#define GNRC_RPL_IMPLEMENTED_OFS_NUMOF (1)
+#define GNRC_RPL_IMPLEMENTED_OFS_NUMOF (1 + IS_USED(MODULE_GNRC_RPL_MRHOF))
 
 /**
- * @brief   Default Objective Code Point (OF0)
+ * @name Objective Code Points
+ * @{
+ */
+#define GNRC_RPL_OCP_OF0    (0)     /**< Objective Function Zero */
+#define GNRC_RPL_OCP_MRHOF  (1)     /**< Minimum Rank with Hysteresis OF */
+/** @} */
+
+/**
+ * @brief   Default Objective Code Point (MRHOF if module `gnrc_rpl_mrhof` is
+ *          used, OF0 otherwise)
+ */
+#ifndef CONFIG_GNRC_RPL_DEFAULT_OCP
+#if IS_USED(MODULE_GNRC_RPL_MRHOF)
+#define CONFIG_GNRC_RPL_DEFAULT_OCP (GNRC_RPL_OCP_MRHOF)
+#else
+#define CONFIG_GNRC_RPL_DEFAULT_OCP (GNRC_RPL_OCP_OF0)
+#endif
+#endif
+
+/**
+ * @brief   Default Objective Code Point
+ */
+#define GNRC_RPL_DEFAULT_OCP (CONFIG_GNRC_RPL_DEFAULT_OCP)
+
+/**
+ * @name Routing metric types
+ * @see <a href="https://tools.ietf.org/html/rfc6551#section-6.1">
+ *          RFC6551, section 6.1, Routing Metric/Constraint Type
+ *      </a>
+ * @{
  */
-#define GNRC_RPL_DEFAULT_OCP (0)
+#define GNRC_RPL_METRIC_NONE    (0)     /**< no metric */
+#define GNRC_RPL_METRIC_ETX     (7)     /**< Expected Transmission Count */
+/** @} */
 
 /**
  * @brief   Default Instance ID
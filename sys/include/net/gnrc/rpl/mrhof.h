@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2021 Gunar Schorcht
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_rpl_mrhof RPL MRHOF
+ * @ingroup     net_gnrc_rpl
+ * @brief       Minimum Rank with Hysteresis Objective Function
+ *
+ * Implementation of MRHOF ([RFC6719](https://tools.ietf.org/html/rfc6719))
+ * with the ETX metric. The ETX of the links to the parents is taken from
+ * `netstats_neighbor`. Since DIOs don't carry a metric container, the Rank
+ * of a parent is used as its path cost.
+ *
+ * The preferred parent is only replaced if the path cost through another
+ * parent is lower by more than @ref CONFIG_GNRC_RPL_MRHOF_PARENT_SWITCH_THRESHOLD.
+ * Parents whose link metric exceeds @ref CONFIG_GNRC_RPL_MRHOF_MAX_LINK_METRIC
+ * are only selected if there is no other parent.
+ *
+ * The root uses MRHOF if the module `gnrc_rpl_mrhof` is used, other nodes
+ * use the objective function announced by the root.
+ *
+ * @{
+ *
+ * @file
+ * @brief       RPL MRHOF definitions
+ *
+ * @author      Gunar Schorcht <gunar@schorcht.net>
+ */
+#ifndef NET_GNRC_RPL_MRHOF_H
+#define NET_GNRC_RPL_MRHOF_H
+
+#include "net/gnrc/rpl/structs.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Maximum link metric (ETX * 128) of a parent
+ */
+#ifndef CONFIG_GNRC_RPL_MRHOF_MAX_LINK_METRIC
+#define CONFIG_GNRC_RPL_MRHOF_MAX_LINK_METRIC       (512)
+#endif
+
+/**
+ * @brief   Maximum path cost, nodes with a higher path cost have an
+ *          infinite Rank
+ */
+#ifndef CONFIG_GNRC_RPL_MRHOF_MAX_PATH_COST
+#define CONFIG_GNRC_RPL_MRHOF_MAX_PATH_COST         (32768)
+#endif
+
+/**
+ * @brief   Difference of the path costs (ETX * 128) that is needed to switch
+ *          the preferred parent
+ */
+#ifndef CONFIG_GNRC_RPL_MRHOF_PARENT_SWITCH_THRESHOLD
+#define CONFIG_GNRC_RPL_MRHOF_PARENT_SWITCH_THRESHOLD   (192)
+#endif
+
+/**
+ * @brief   Return the address of the MRHOF objective function
+ *
+ * @return  Address of the MRHOF objective function
+ */
+gnrc_rpl_of_t *gnrc_rpl_get_of_mrhof(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_RPL_MRHOF_H */
+/** @} */
@@ -0,0 +1,223 @@
+/*
+ * Copyright (C) 2021 Gunar Schorcht
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_rpl_routes RPL downward route table
+ * @ingroup     net_gnrc_rpl
+ * @brief       Compact table of the downward routes learned from DAOs in
+ *              storing mode
+ *
+ * The table is sorted by target, so that the route of a target is found by
+ * a binary search. Next hops are shared by all routes through the same child.
+ *
+ * Routes are refreshed by every DAO, but the routes in the NIB forwarding
+ * table are only updated if a route is new, its next hop changed or the
+ * lifetime of the NIB entry is more than half over. This avoids that the
+ * NIB is updated for each target of each DAO.
+ *
+ * DAOs carry several targets with one transit option. Targets are encoded
+ * with the variable length of RFC 6550, section 6.7.7. With an aggregation
+ * prefix, which has to be delegated to the node, only the prefix is
+ * advertised instead of the targets it covers.
+ *
+ * @{
+ *
+ * @file
+ * @brief       RPL downward route table definitions
+ *
+ * @author      Gunar Schorcht <gunar@schorcht.net>
+ */
+#ifndef NET_GNRC_RPL_ROUTES_H
+#define NET_GNRC_RPL_ROUTES_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "net/gnrc/rpl/structs.h"
+#include "net/ipv6/addr.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Number of downward routes
+ */
+#ifndef CONFIG_GNRC_RPL_ROUTES_NUMOF
+#define CONFIG_GNRC_RPL_ROUTES_NUMOF            (16)
+#endif
+
+/**
+ * @brief   Number of different next hops of the downward routes, i.e. the
+ *          maximum number of children
+ */
+#ifndef CONFIG_GNRC_RPL_ROUTES_NEXT_HOPS_NUMOF
+#define CONFIG_GNRC_RPL_ROUTES_NEXT_HOPS_NUMOF  (8)
+#endif
+
+/**
+ * @brief   Maximum number of targets in one DAO
+ */
+#ifndef CONFIG_GNRC_RPL_DAO_TARGETS_MAX
+#define CONFIG_GNRC_RPL_DAO_TARGETS_MAX         (8)
+#endif
+
+/**
+ * @brief   Target of a DAO
+ */
+typedef struct {
+    ipv6_addr_t prefix;         /**< target address or prefix */
+    uint8_t prefix_len;         /**< prefix length in bits */
+} gnrc_rpl_routes_target_t;
+
+/**
+ * @brief   Downward route
+ */
+typedef struct {
+    ipv6_addr_t target;         /**< target address or prefix */
+    uint8_t prefix_len;         /**< prefix length in bits */
+    uint8_t next_hop;           /**< index in the next hop table */
+    uint32_t expires;           /**< expiration of the route in seconds */
+    uint32_t nib_expires;       /**< expiration of the NIB entry in seconds */
+} gnrc_rpl_route_t;
+
+/**
+ * @brief   Next hop of downward routes
+ */
+typedef struct {
+    ipv6_addr_t addr;           /**< address of the child */
+    uint16_t iface;             /**< interface to the child */
+    uint16_t refs;              /**< number of routes, 0 if unused */
+} gnrc_rpl_route_next_hop_t;
+
+/**
+ * @brief   Downward route table
+ */
+typedef struct {
+    /** routes sorted by target and prefix length */
+    gnrc_rpl_route_t routes[CONFIG_GNRC_RPL_ROUTES_NUMOF];
+    /** next hops of the routes */
+    gnrc_rpl_route_next_hop_t next_hops[CONFIG_GNRC_RPL_ROUTES_NEXT_HOPS_NUMOF];
+    unsigned numof;             /**< number of routes */
+    ipv6_addr_t aggr_prefix;    /**< aggregation prefix */
+    uint8_t aggr_prefix_len;    /**< aggregation prefix length, 0 if unused */
+} gnrc_rpl_routes_t;
+
+/**
+ * @brief   Downward route table of RPL
+ */
+extern gnrc_rpl_routes_t gnrc_rpl_routes;
+
+/**
+ * @brief   Initialize a route table
+ *
+ * @param[out]  table   the route table
+ */
+void gnrc_rpl_routes_init(gnrc_rpl_routes_t *table);
+
+/**
+ * @brief   Remove all routes and the aggregation prefix of a route table
+ *
+ * The routes are also removed from the NIB.
+ *
+ * @param[in,out]   table   the route table
+ */
+void gnrc_rpl_routes_clear(gnrc_rpl_routes_t *table);
+
+/**
+ * @brief   Update the routes of the targets of one transit option
+ *
+ * @param[in,out]   table       the route table
+ * @param[in]       targets     the targets
+ * @param[in]       numof       number of @p targets
+ * @param[in]       next_hop    the child that sent the DAO
+ * @param[in]       iface       interface to @p next_hop
+ * @param[in]       lifetime    path lifetime in seconds, 0 removes the routes
+ *                              of the targets via @p next_hop (No-Path DAO)
+ * @param[in]       now         current time in seconds
+ *
+ * @return  number of targets whose routes were updated
+ */
+unsigned gnrc_rpl_routes_update(gnrc_rpl_routes_t *table,
+                                const gnrc_rpl_routes_target_t *targets,
+                                unsigned numof, const ipv6_addr_t *next_hop,
+                                unsigned iface, uint32_t lifetime,
+                                uint32_t now);
+
+/**
+ * @brief   Get the route of the longest prefix that matches @p dst
+ *
+ * @param[in]   table   the route table
+ * @param[in]   dst     the destination
+ * @param[in]   now     current time in seconds
+ *
+ * @return  the route or NULL if there is none
+ */
+const gnrc_rpl_route_t *gnrc_rpl_routes_lookup(const gnrc_rpl_routes_t *table,
+                                               const ipv6_addr_t *dst,
+                                               uint32_t now);
+
+/**
+ * @brief   Remove the expired routes
+ *
+ * @param[in,out]   table   the route table
+ * @param[in]       now     current time in seconds
+ */
+void gnrc_rpl_routes_expire(gnrc_rpl_routes_t *table, uint32_t now);
+
+/**
+ * @brief   Set the aggregation prefix
+ *
+ * The prefix has to be delegated to the node, i.e. all addresses of the
+ * prefix have to be reachable through the node.
+ *
+ * @param[in,out]   table       the route table
+ * @param[in]       prefix      the prefix or NULL to remove it
+ * @param[in]       prefix_len  the prefix length in bits
+ */
+void gnrc_rpl_routes_aggregate(gnrc_rpl_routes_t *table,
+                               const ipv6_addr_t *prefix, uint8_t prefix_len);
+
+/**
+ * @brief   Encode the targets of the next DAO
+ *
+ * The targets are the aggregation prefix, the address of the node and the
+ * targets of the routes that are not covered by the aggregation prefix. At
+ * most @ref CONFIG_GNRC_RPL_DAO_TARGETS_MAX targets are encoded.
+ *
+ * @param[in]       table   the route table
+ * @param[in]       own     address of the node
+ * @param[in,out]   pos     position of the next target, 0 for the first DAO
+ * @param[out]      buf     buffer for the target options
+ * @param[in]       len     length of @p buf
+ * @param[in]       now     current time in seconds
+ *
+ * @return  length of the target options, 0 if all targets were encoded
+ */
+size_t gnrc_rpl_routes_dao_targets(const gnrc_rpl_routes_t *table,
+                                   const ipv6_addr_t *own, unsigned *pos,
+                                   uint8_t *buf, size_t len, uint32_t now);
+
+/**
+ * @brief   Decode a target option
+ *
+ * @param[in]   opt     the target option
+ * @param[out]  target  the target
+ *
+ * @return  0 on success
+ * @return  -EINVAL if the option is malformed
+ */
+int gnrc_rpl_routes_target_get(const gnrc_rpl_opt_target_t *opt,
+                               gnrc_rpl_routes_target_t *target);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_RPL_ROUTES_H */
+/** @} */
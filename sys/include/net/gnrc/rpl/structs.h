@@ -304,6 +304,15 @@ typedef struct {
      */
     void (*init)(gnrc_rpl_dodag_t *dodag);
     void (*process_dio)(void);  /**< DIO processing callback (acc. to OF0 spec, chpt 5) */
+
+    /**
+     * @brief Update the link metric of a parent before the parents are compared
+     *
+     * May be NULL if the objective function doesn't use link metrics.
+     *
+     * @param[in,out]   parent  Parent whose link metric is updated.
+     */
+    void (*update_link_metric)(gnrc_rpl_parent_t *parent);
 } gnrc_rpl_of_t;
 
 /**
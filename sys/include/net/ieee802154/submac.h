@@ -38,6 +38,22 @@ extern "C" {
 
 #define IEEE802154_SUBMAC_MAX_RETRANSMISSIONS (4U)  /**< maximum number of frame retransmissions */
 
+/**
+ * @brief Backoff exponent for the frames of a burst after the first one
+ *
+ * The frames that follow a successfully transmitted frame of the same burst
+ * are sent after a random backoff of up to 2^BE - 1 backoff periods instead
+ * of starting the CSMA-CA with the minimum backoff exponent. With 0, they are
+ * sent right after a CCA. The backoff grows as usual if the CCA fails.
+ *
+ * @note Radios with @ref IEEE802154_CAP_AUTO_CSMA or
+ *       @ref IEEE802154_CAP_FRAME_RETRANS perform the CSMA-CA in hardware,
+ *       only the frame pending bit is set for them.
+ */
+#ifndef CONFIG_IEEE802154_SUBMAC_BURST_BE
+#define CONFIG_IEEE802154_SUBMAC_BURST_BE     (0U)
+#endif
+
 /**
  * @brief IEEE 802.15.4 SubMAC forward declaration
  */
@@ -100,6 +116,16 @@ typedef struct {
                     ieee802154_tx_info_t *info);
 } ieee802154_submac_cb_t;
 
+/**
+ * @brief IEEE 802.15.4 SubMAC burst statistics
+ */
+typedef struct {
+    uint32_t bursts;        /**< number of started bursts */
+    uint32_t frames;        /**< number of frames sent as part of a burst */
+    uint32_t fast;          /**< number of frames sent with the burst backoff */
+    uint32_t aborted;       /**< number of bursts ended by a failed frame */
+} ieee802154_submac_burst_stats_t;
+
 /**
  * @brief IEEE 802.15.4 SubMAC descriptor
  */
@@ -111,6 +137,10 @@ struct ieee802154_submac {
     ieee802154_csma_be_t be;            /**< CSMA-CA backoff exponent params */
     bool wait_for_ack;                  /**< SubMAC is waiting for an ACK frame */
     bool tx;                            /**< SubMAC is currently transmitting a frame */
+    bool burst_tx;                      /**< the current frame is part of a burst */
+    bool burst_more;                    /**< more frames of the burst follow the current one */
+    bool burst;                         /**< the next frame continues a burst */
+    bool burst_fast;                    /**< the current frame uses the burst backoff */
     uint16_t panid;                     /**< IEEE 802.15.4 PAN ID */
     uint16_t channel_num;               /**< IEEE 802.15.4 channel number */
     uint8_t channel_page;               /**< IEEE 802.15.4 channel page */
@@ -121,6 +151,7 @@ struct ieee802154_submac {
     int8_t tx_pow;                      /**< Transmission power (in dBm) */
     ieee802154_submac_state_t state;    /**< State of the SubMAC */
     ieee802154_phy_mode_t phy_mode;     /**< IEEE 802.15.4 PHY mode */
+    ieee802154_submac_burst_stats_t burst_stats; /**< burst statistics */
 };
 
 /**
@@ -161,6 +192,56 @@ int ieee802154_set_state(ieee802154_submac_t *submac, ieee802154_submac_state_t
  */
 int ieee802154_send(ieee802154_submac_t *submac, const iolist_t *iolist);
 
+/**
+ * @brief Transmit an IEEE 802.15.4 PSDU as part of a burst
+ *
+ * A burst is a train of frames that are sent back to back, e.g. the
+ * 6LoWPAN fragments of a datagram. The frame pending bit of the frame is set
+ * if @p more is true and cleared otherwise. The first frame of a burst is
+ * sent with the regular CSMA-CA, the following frames are sent with the
+ * backoff exponent @ref CONFIG_IEEE802154_SUBMAC_BURST_BE as long as the
+ * previous frame was sent successfully. The burst ends with the frame sent
+ * with @p more set to false, with a failed transmission or with a frame sent
+ * with @ref ieee802154_send.
+ *
+ * @param[in] submac pointer to the SubMAC descriptor
+ * @param[in] iolist pointer to the PSDU frame (without FCS), the frame
+ *                   control field is modified
+ * @param[in] more   more frames of the burst follow this one
+ *
+ * @return 0 on success
+ * @return negative errno on error
+ */
+int ieee802154_send_burst(ieee802154_submac_t *submac, const iolist_t *iolist,
+                          bool more);
+
+/**
+ * @brief End the current burst
+ *
+ * The next frame sent with @ref ieee802154_send_burst starts a new burst
+ * with the regular CSMA-CA, e.g. when the first fragment of a datagram is
+ * sent although the last fragment of the previous one was not.
+ *
+ * @param[in] submac pointer to the SubMAC descriptor
+ */
+static inline void ieee802154_end_burst(ieee802154_submac_t *submac)
+{
+    submac->burst = false;
+}
+
+/**
+ * @brief Get the burst statistics of the SubMAC
+ *
+ * @param[in] submac pointer to the SubMAC descriptor
+ *
+ * @return pointer to the burst statistics
+ */
+static inline const ieee802154_submac_burst_stats_t *ieee802154_get_burst_stats(
+    const ieee802154_submac_t *submac)
+{
+    return &submac->burst_stats;
+}
+
 /**
  * @brief Set the IEEE 802.15.4 short address
  *
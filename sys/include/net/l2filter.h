@@ -21,6 +21,17 @@
  * The actual memory for the filter lists should be allocated for every network
  * device. This is done centrally in netdev_t type.
  *
+ * The entries of a list are kept sorted by address, with the empty entries at
+ * the end, so that @ref l2filter_pass() needs a binary search only. Adding
+ * and removing entries is linear in the size of the list instead.
+ *
+ * For large lists, e.g. the devices allowed on a gateway, the module
+ * `l2filter_bloom` additionally keeps a blocked Bloom filter (see @ref
+ * sys_bloom) of the addresses in the list. Most addresses that are not in the
+ * list are then found without a search. The Bloom filter is part of the list
+ * and has @ref CONFIG_L2FILTER_BLOOM_BITS bits per entry, rounded up to
+ * blocks of @ref CONFIG_BLOOM_BLOCKED_BLOCK_SIZE bytes.
+ *
  * @{
  * @file
  * @brief       Link layer address filter interface definition
@@ -36,6 +47,10 @@
 #include <stdbool.h>
 #include <errno.h>
 
+#if defined(MODULE_L2FILTER_BLOOM) || defined(DOXYGEN)
+#include "bloom.h"
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -58,8 +73,40 @@ extern "C" {
 #ifndef CONFIG_L2FILTER_LISTSIZE
 #define CONFIG_L2FILTER_LISTSIZE               (8U)
 #endif
+
+/**
+ * @brief   Bits of the Bloom filter per filter entry
+ *
+ * With the default of 16 bits per address and
+ * @ref CONFIG_L2FILTER_BLOOM_HASHES of 4, less than 3 % of the addresses
+ * that are not in a full list need a search.
+ *
+ * @note    Only used with the module `l2filter_bloom`.
+ */
+#ifndef CONFIG_L2FILTER_BLOOM_BITS
+#define CONFIG_L2FILTER_BLOOM_BITS             (16U)
+#endif
+
+/**
+ * @brief   Number of bits set in the Bloom filter per address
+ *
+ * @note    Only used with the module `l2filter_bloom`.
+ */
+#ifndef CONFIG_L2FILTER_BLOOM_HASHES
+#define CONFIG_L2FILTER_BLOOM_HASHES           (4U)
+#endif
 /** @} */
 
+#if defined(MODULE_L2FILTER_BLOOM) || defined(DOXYGEN)
+/**
+ * @brief   Number of blocks of the Bloom filter of a filter list
+ */
+#define L2FILTER_BLOOM_BLOCKS   ((CONFIG_L2FILTER_LISTSIZE * \
+                                  CONFIG_L2FILTER_BLOOM_BITS + \
+                                  CONFIG_BLOOM_BLOCKED_BLOCK_SIZE * 8 - 1) / \
+                                 (CONFIG_BLOOM_BLOCKED_BLOCK_SIZE * 8))
+#endif
+
 /**
  * @brief   Filter list entries
  *
@@ -72,6 +119,38 @@ typedef struct {
     size_t addr_len;                               /**< address length in byte */
 } l2filter_t;
 
+/**
+ * @brief   Filter list
+ *
+ * A list that is initialized with zeros is an empty list.
+ */
+typedef struct {
+    l2filter_t entries[CONFIG_L2FILTER_LISTSIZE];  /**< sorted entries */
+#if defined(MODULE_L2FILTER_BLOOM) || defined(DOXYGEN)
+    /**
+     * @brief   Bloom filter of the addresses in @ref l2filter_list_t::entries
+     *
+     * Initialized with the first address that is added to the list.
+     */
+    bloom_blocked_t bloom;
+    /**
+     * @brief   Blocks of @ref l2filter_list_t::bloom
+     */
+    uint8_t bloom_blocks[BLOOM_BLOCKED_BYTES(L2FILTER_BLOOM_BLOCKS)];
+#endif
+} l2filter_list_t;
+
+/**
+ * @brief   Remove all entries from a filter list
+ *
+ * A list that is initialized with zeros is empty as well.
+ *
+ * @param[out] list     pointer to the filter list
+ *
+ * @pre     @p list != NULL
+ */
+void l2filter_init(l2filter_list_t *list);
+
 /**
  * @brief   Add an entry to a devices filter list
  *
@@ -84,9 +163,10 @@ typedef struct {
  * @pre     @p addr_maxlen <= @ref CONFIG_L2FILTER_ADDR_MAXLEN
  *
  * @return  0 on success
+ * @return  -EINVAL if @p addr_len is 0
  * @return  -ENOMEM if no empty slot left in list
  */
-int l2filter_add(l2filter_t *list, const void *addr, size_t addr_len);
+int l2filter_add(l2filter_list_t *list, const void *addr, size_t addr_len);
 
 /**
  * @brief   Remove an entry from the given filter list
@@ -102,7 +182,7 @@ int l2filter_add(l2filter_t *list, const void *addr, size_t addr_len);
  * @return  0 on success
  * @return  -ENOENT if @p addr was not found in @p list
  */
-int l2filter_rm(l2filter_t *list, const void *addr, size_t addr_len);
+int l2filter_rm(l2filter_list_t *list, const void *addr, size_t addr_len);
 
 /**
  * @brief   Check if the given address passes the set filters
@@ -125,7 +205,7 @@ int l2filter_rm(l2filter_t *list, const void *addr, size_t addr_len);
  * @return  in blacklist mode: true if @p addr is not in @p list
  * @return  in blacklist mode: false if @p addr is in @p list
  */
-bool l2filter_pass(const l2filter_t *list, const void *addr, size_t addr_len);
+bool l2filter_pass(const l2filter_list_t *list, const void *addr, size_t addr_len);
 
 #ifdef __cplusplus
 }
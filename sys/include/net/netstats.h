@@ -43,6 +43,30 @@ extern "C" {
 #define NETSTATS_NB_QUEUE_SIZE  (4)
 #endif
 
+/**
+ * @brief   The number of slots of the L2 address index of the peer stats table
+ *
+ * Must be a power of two and greater than @ref NETSTATS_NB_SIZE. The default
+ * keeps the load of the index below 50 %.
+ */
+#ifndef NETSTATS_NB_HASH_SIZE
+#if NETSTATS_NB_SIZE <= 4
+#define NETSTATS_NB_HASH_SIZE   (8)
+#elif NETSTATS_NB_SIZE <= 8
+#define NETSTATS_NB_HASH_SIZE   (16)
+#elif NETSTATS_NB_SIZE <= 16
+#define NETSTATS_NB_HASH_SIZE   (32)
+#elif NETSTATS_NB_SIZE <= 32
+#define NETSTATS_NB_HASH_SIZE   (64)
+#elif NETSTATS_NB_SIZE <= 64
+#define NETSTATS_NB_HASH_SIZE   (128)
+#elif NETSTATS_NB_SIZE <= 128
+#define NETSTATS_NB_HASH_SIZE   (256)
+#else
+#define NETSTATS_NB_HASH_SIZE   (512)
+#endif
+#endif
+
 /**
  * @name @ref net_netstats module names
  * @{
@@ -97,6 +121,17 @@ typedef struct {
 #endif
 } netstats_nb_t;
 
+/**
+ * @brief       Index of an entry in the peer stats table
+ *
+ * The maximum value marks an unused slot or the end of a list.
+ */
+#if (NETSTATS_NB_SIZE < UINT8_MAX) || DOXYGEN
+typedef uint8_t netstats_nb_idx_t;
+#else
+typedef uint16_t netstats_nb_idx_t;
+#endif
+
 /**
  * @brief       L2 Peer Info struct
  */
@@ -121,6 +156,31 @@ typedef struct {
      */
     netstats_nb_t pstats[NETSTATS_NB_SIZE];
 
+    /**
+     * @brief Indices of the entries hashed by their L2 address
+     */
+    netstats_nb_idx_t hash[NETSTATS_NB_HASH_SIZE];
+
+    /**
+     * @brief Next less recently updated entry
+     */
+    netstats_nb_idx_t lru_next[NETSTATS_NB_SIZE];
+
+    /**
+     * @brief Previous more recently updated entry
+     */
+    netstats_nb_idx_t lru_prev[NETSTATS_NB_SIZE];
+
+    /**
+     * @brief Most recently updated entry
+     */
+    netstats_nb_idx_t lru_head;
+
+    /**
+     * @brief Least recently updated entry, empty entries are at the end
+     */
+    netstats_nb_idx_t lru_tail;
+
     /**
      * @brief Neighbor Table access lock
      */
@@ -128,6 +128,21 @@ void netstats_nb_init(netif_t *netif);
  */
 bool netstats_nb_get(netif_t *netif, const uint8_t *l2_addr, uint8_t len, netstats_nb_t *out);
 
+/**
+ * @brief Copy the statistics of all known neighbors
+ *
+ * Provides a consistent view of the table for monitoring, e.g. to export it
+ * periodically. The entries are ordered from the most to the least recently
+ * updated one, so a small @p buf receives the most active neighbors.
+ *
+ * @param[in] netif     network interface descriptor
+ * @param[out] buf      destination for the neighbor entries
+ * @param[in] numof     maximum number of entries in @p buf
+ *
+ * @return number of entries copied to @p buf
+ */
+unsigned netstats_nb_snapshot(netif_t *netif, netstats_nb_t *buf, unsigned numof);
+
 /**
  * @brief Store this neighbor as next in the transmission queue.
  *
@@ -67,6 +67,8 @@ typedef struct {
     uint32_t dao_ack_tx_ucast_bytes;    /**< unicast dao_ack sent in bytes */
     uint32_t dao_ack_tx_mcast_count;    /**< multicast dao_ack sent in packets */
     uint32_t dao_ack_tx_mcast_bytes;    /**< multicast dao_ack sent in bytes*/
+    /* parents */
+    uint32_t parent_switches;           /**< changes of the preferred parent */
 } netstats_rpl_t;
 
 #ifdef __cplusplus
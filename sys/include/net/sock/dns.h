@@ -27,8 +27,13 @@
 #include <stdint.h>
 #include <unistd.h>
 
+#include "kernel_defines.h"
 #include "net/sock/udp.h"
 
+#if IS_USED(MODULE_SOCK_DNS_ASYNC) || defined(DOXYGEN)
+#include "event.h"
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -52,15 +57,78 @@ typedef struct {
  */
 #define DNS_TYPE_A              (1)
 #define DNS_TYPE_AAAA           (28)
+#define DNS_TYPE_SOA            (6)
 #define DNS_CLASS_IN            (1)
 
 #define SOCK_DNS_PORT           (53)
 #define SOCK_DNS_RETRIES        (2)
 
+#define SOCK_DNS_TIMEOUT        (1000000LU) /* timeout per try in us */
+
+#ifndef SOCK_DNS_BUF_LEN
 #define SOCK_DNS_BUF_LEN        (128)       /* we're in embedded context. */
+#endif
 #define SOCK_DNS_MAX_NAME_LEN   (SOCK_DNS_BUF_LEN - sizeof(sock_dns_hdr_t) - 4)
 /** @} */
 
+/**
+ * @defgroup net_sock_dns_conf  DNS sock compile configurations
+ * @ingroup  config
+ * @{
+ */
+/**
+ * @brief   Maximum number of different queries that are resolved at the same
+ *          time
+ *
+ * Concurrent queries for the same name and family are coalesced, only the
+ * first one contacts the DNS server and the others wait for its result.
+ * If all slots are in use, queries are sent without coalescing.
+ */
+#ifndef CONFIG_SOCK_DNS_INFLIGHT_NUMOF
+#define CONFIG_SOCK_DNS_INFLIGHT_NUMOF  (4)
+#endif
+
+/**
+ * @brief   Number of entries of the DNS cache (module `sock_dns_cache`)
+ *
+ * Each address family of a name needs its own entry. An entry stores the
+ * name, so it takes about #SOCK_DNS_MAX_NAME_LEN + 30 bytes.
+ */
+#ifndef CONFIG_SOCK_DNS_CACHE_SIZE
+#define CONFIG_SOCK_DNS_CACHE_SIZE      (8)
+#endif
+
+/**
+ * @brief   Maximum time in seconds an entry is kept in the DNS cache,
+ *          independent of the TTL of the record
+ */
+#ifndef CONFIG_SOCK_DNS_CACHE_MAX_TTL
+#define CONFIG_SOCK_DNS_CACHE_MAX_TTL   (86400U)
+#endif
+
+/**
+ * @brief   Time in seconds a name that does not exist is kept in the DNS
+ *          cache if the server did not provide an SOA record (RFC 2308)
+ */
+#ifndef CONFIG_SOCK_DNS_CACHE_NEG_TTL
+#define CONFIG_SOCK_DNS_CACHE_NEG_TTL   (60U)
+#endif
+
+/**
+ * @brief   Stack size of the resolver thread (module `sock_dns_async`)
+ */
+#ifndef SOCK_DNS_ASYNC_STACKSIZE
+#define SOCK_DNS_ASYNC_STACKSIZE        (THREAD_STACKSIZE_DEFAULT)
+#endif
+
+/**
+ * @brief   Priority of the resolver thread (module `sock_dns_async`)
+ */
+#ifndef SOCK_DNS_ASYNC_PRIO
+#define SOCK_DNS_ASYNC_PRIO             (THREAD_PRIORITY_MAIN - 1)
+#endif
+/** @} */
+
 /**
  * @brief Get IP address for DNS name
  *
@@ -71,7 +139,13 @@ typedef struct {
  * records (IPv4), AAAA records (IPv6) or both can be selected.
  *
  * This function will return the first DNS record it receives. IF both A and
- * AAAA are requested, AAAA will be preferred.
+ * AAAA are requested, both queries are sent at the same time and AAAA will be
+ * preferred.
+ *
+ * The function is thread-safe. Concurrent queries for the same name are
+ * coalesced into one request to the server. With module `sock_dns_cache`,
+ * results are cached for the TTL of the records, names that do not exist
+ * are cached as well.
  *
  * @note @p addr_out needs to provide space for any possible result!
  *       (4byte when family==AF_INET, 16byte otherwise)
@@ -81,10 +155,63 @@ typedef struct {
  * @param[in]   family          Either AF_INET, AF_INET6 or AF_UNSPEC
  *
  * @return      the size of the resolved address on success
- * @return      < 0 otherwise
+ * @return      -ENOENT if the name does not exist or has no record of @p family
+ * @return      -ETIMEDOUT if the server did not reply
+ * @return      < 0 on other errors
  */
 int sock_dns_query(const char *domain_name, void *addr_out, int family);
 
+/**
+ * @brief Remove all entries from the DNS cache
+ *
+ * @note Only available with module `sock_dns_cache`.
+ */
+void sock_dns_cache_flush(void);
+
+#if IS_USED(MODULE_SOCK_DNS_ASYNC) || defined(DOXYGEN)
+/**
+ * @brief Asynchronous DNS query
+ *
+ * The query is an event that is posted to the queue given to
+ * @ref sock_dns_query_async when the result is available. All members are
+ * private, except the result members that can be read by the handler.
+ */
+typedef struct {
+    event_t super;                  /**< event posted with the result */
+    event_handler_t handler;        /**< handler of the caller */
+    const char *domain_name;        /**< DNS name to resolve */
+    event_queue_t *queue;           /**< queue for the result */
+    int family;                     /**< requested address family */
+    int res;                        /**< result as of @ref sock_dns_query */
+    uint8_t addr[16];               /**< resolved address if res > 0 */
+} sock_dns_async_t;
+
+/**
+ * @brief Get IP address for DNS name asynchronously
+ *
+ * The query is resolved by a resolver thread that is started with the first
+ * query. Cached results are posted at once. When the result is available,
+ * @p handler is called by the thread of @p queue with the `super` member of
+ * @p query as argument.
+ *
+ * @note Only available with module `sock_dns_async`.
+ *
+ * @param[out]  query           query object, must stay valid until the
+ *                              handler was called
+ * @param[in]   domain_name     DNS name to resolve, must stay valid until the
+ *                              handler was called
+ * @param[in]   family          Either AF_INET, AF_INET6 or AF_UNSPEC
+ * @param[in]   queue           queue the result is posted to
+ * @param[in]   handler         handler called with the result
+ *
+ * @return      0 on success
+ * @return      -ENOSPC if @p domain_name is too long
+ */
+int sock_dns_query_async(sock_dns_async_t *query, const char *domain_name,
+                         int family, event_queue_t *queue,
+                         event_handler_t handler);
+#endif
+
 /**
  * @brief global DNS server endpoint
  */
@@ -0,0 +1,61 @@
+/*
+ * Copyright (C) 2021 Gunar Schorcht
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup net_sock_dns
+ * @internal
+ * @{
+ *
+ * @file
+ * @brief   DNS cache of the sock DNS client
+ *
+ * @author  Gunar Schorcht <gunar@schorcht.net>
+ */
+#ifndef PRIV_DNS_CACHE_H
+#define PRIV_DNS_CACHE_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Look up a name in the DNS cache
+ *
+ * For AF_UNSPEC, the AAAA entry is preferred. The A entry is only used if
+ * the AAAA entry is negative.
+ *
+ * @param[in]   domain_name     DNS name
+ * @param[out]  addr_out        buffer for the address
+ * @param[in]   family          Either AF_INET, AF_INET6 or AF_UNSPEC
+ *
+ * @return  the size of the address on a positive hit
+ * @return  -ENOENT on a negative hit
+ * @return  0 if the name is not cached
+ */
+int dns_cache_query(const char *domain_name, void *addr_out, int family);
+
+/**
+ * @brief   Add a result to the DNS cache
+ *
+ * @param[in]   domain_name     DNS name
+ * @param[in]   addr            the address, ignored if @p res is negative
+ * @param[in]   family          Either AF_INET or AF_INET6
+ * @param[in]   res             size of the address or -ENOENT
+ * @param[in]   ttl             time to live in seconds
+ */
+void dns_cache_add(const char *domain_name, const void *addr, int family,
+                   int res, uint32_t ttl);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PRIV_DNS_CACHE_H */
+/** @} */
@@ -12,13 +12,20 @@
  * @file
  * @brief   sock DNS client implementation
  * @author  Kaspar Schleiser <kaspar@schleiser.de>
+ * @author  Gunar Schorcht <gunar@schorcht.net>
  * @}
  */
 
 #include <arpa/inet.h>
+#include <stdbool.h>
 #include <string.h>
+#include <strings.h>
 #include <stdio.h>
 
+#include "cond.h"
+#include "irq.h"
+#include "kernel_defines.h"
+#include "mutex.h"
 #include "net/dns.h"
 #include "net/sock/udp.h"
 #include "net/sock/dns.h"
@@ -27,12 +34,60 @@
 #include "byteorder.h"
 #endif
 
+#include "_dns_cache.h"
+
+#define ENABLE_DEBUG    0
+#include "debug.h"
+
 /* min domain name length is 1, so minimum record length is 7 */
 #define DNS_MIN_REPLY_LEN   (unsigned)(sizeof(sock_dns_hdr_t ) + 7)
 
+/* flags of the DNS header */
+#define DNS_FLAG_QR         (0x8000)
+#define DNS_RCODE_MASK      (0x000f)
+#define DNS_RCODE_NXDOMAIN  (3)
+
+/* SOA RDATA ends with the MINIMUM field used as TTL for negative caching */
+#define DNS_SOA_MIN_LEN     (22U)
+
+/* one query per address family, AAAA first as it is preferred */
+typedef struct {
+    uint16_t id;
+    uint8_t family;
+    bool done;
+    int res;
+    uint32_t ttl;
+    uint8_t addr[16];
+} _query_t;
+
+/* query that is currently resolved, concurrent queries for the same name
+ * and family wait for its result instead of sending their own request */
+typedef struct {
+    const char *domain_name;        /* NULL if the slot is free */
+    int family;
+    bool done;
+    unsigned waiters;
+    int res;
+    uint8_t addr[16];
+} _inflight_t;
+
+/* resource record */
+typedef struct {
+    uint16_t type;
+    uint16_t class;
+    uint32_t ttl;
+    uint16_t rdlength;
+    const uint8_t *rdata;
+} _rr_t;
+
 /* global DNS server UDP endpoint */
 sock_udp_ep_t sock_dns_server;
 
+static _inflight_t _inflight[CONFIG_SOCK_DNS_INFLIGHT_NUMOF];
+static mutex_t _inflight_lock = MUTEX_INIT;
+static cond_t _inflight_cond = COND_INIT;
+static uint16_t _id;
+
 static ssize_t _enc_domain_name(uint8_t *out, const char *domain_name)
 {
     /*
@@ -68,14 +123,22 @@ static unsigned _put_short(uint8_t *out, uint16_t val)
     return 2;
 }
 
-static unsigned _get_short(uint8_t *buf)
+static unsigned _get_short(const uint8_t *buf)
 {
     uint16_t _tmp;
     memcpy(&_tmp, buf, 2);
     return _tmp;
 }
 
-static ssize_t _skip_hostname(const uint8_t *buf, size_t len, uint8_t *bufpos)
+static uint32_t _get_long(const uint8_t *buf)
+{
+    uint32_t _tmp;
+    memcpy(&_tmp, buf, 4);
+    return _tmp;
+}
+
+static ssize_t _skip_hostname(const uint8_t *buf, size_t len,
+                              const uint8_t *bufpos)
 {
     const uint8_t *buflim = buf + len;
     unsigned res = 0;
@@ -84,15 +147,15 @@ static ssize_t _skip_hostname(const uint8_t *buf, size_t len, uint8_t *bufpos)
         /* out-of-bound */
         return -EBADMSG;
     }
-    /* handle DNS Message Compression */
-    if (*bufpos >= 192) {
-        if ((bufpos + 2) >= buflim) {
-            return -EBADMSG;
-        }
-        return 2;
-    }
 
     while (bufpos[res]) {
+        /* handle DNS Message Compression, a pointer ends the name */
+        if (bufpos[res] >= 192) {
+            if ((&bufpos[res] + 2) >= buflim) {
+                return -EBADMSG;
+            }
+            return res + 2;
+        }
         res += bufpos[res] + 1;
         if ((&bufpos[res]) >= buflim) {
             /* out-of-bound */
@@ -102,11 +165,77 @@ static ssize_t _skip_hostname(const uint8_t *buf, size_t len, uint8_t *bufpos)
     return res + 1;
 }
 
-static int _parse_dns_reply(uint8_t *buf, size_t len, void* addr_out, int family)
+static ssize_t _get_rr(const uint8_t *buf, size_t len, const uint8_t *bufpos,
+                       _rr_t *rr)
 {
     const uint8_t *buflim = buf + len;
-    sock_dns_hdr_t *hdr = (sock_dns_hdr_t*) buf;
-    uint8_t *bufpos = buf + sizeof(*hdr);
+    const uint8_t *start = bufpos;
+
+    ssize_t tmp = _skip_hostname(buf, len, bufpos);
+    if (tmp < 0) {
+        return tmp;
+    }
+    bufpos += tmp;
+    if ((bufpos + RR_TYPE_LENGTH + RR_CLASS_LENGTH +
+         RR_TTL_LENGTH + RR_RDLENGTH_LENGTH) > buflim) {
+        return -EBADMSG;
+    }
+    rr->type = ntohs(_get_short(bufpos));
+    bufpos += RR_TYPE_LENGTH;
+    rr->class = ntohs(_get_short(bufpos));
+    bufpos += RR_CLASS_LENGTH;
+    rr->ttl = ntohl(_get_long(bufpos));
+    bufpos += RR_TTL_LENGTH;
+    rr->rdlength = ntohs(_get_short(bufpos));
+    bufpos += RR_RDLENGTH_LENGTH;
+    if ((bufpos + rr->rdlength) > buflim) {
+        return -EBADMSG;
+    }
+    rr->rdata = bufpos;
+    bufpos += rr->rdlength;
+
+    return bufpos - start;
+}
+
+static uint32_t _neg_ttl(const uint8_t *buf, size_t len, const uint8_t *bufpos)
+{
+    const sock_dns_hdr_t *hdr = (const sock_dns_hdr_t *)buf;
+
+    /* RFC 2308: the TTL of a negative answer is the minimum of the TTL
+     * of the SOA record in the authority section and its MINIMUM field */
+    for (unsigned n = 0; n < ntohs(hdr->nscount); n++) {
+        _rr_t rr;
+        ssize_t tmp = _get_rr(buf, len, bufpos, &rr);
+        if (tmp < 0) {
+            break;
+        }
+        bufpos += tmp;
+        if ((rr.type == DNS_TYPE_SOA) && (rr.rdlength >= DNS_SOA_MIN_LEN)) {
+            uint32_t minimum = ntohl(_get_long(rr.rdata + rr.rdlength - 4));
+            return (rr.ttl < minimum) ? rr.ttl : minimum;
+        }
+    }
+    return CONFIG_SOCK_DNS_CACHE_NEG_TTL;
+}
+
+static int _parse_dns_reply(const uint8_t *buf, size_t len, void *addr_out,
+                            int family, uint32_t *ttl)
+{
+    const sock_dns_hdr_t *hdr = (const sock_dns_hdr_t *)buf;
+    const uint8_t *bufpos = buf + sizeof(*hdr);
+    uint16_t flags = ntohs(hdr->flags);
+    uint16_t type = (family == AF_INET) ? DNS_TYPE_A : DNS_TYPE_AAAA;
+    unsigned addrlen = (family == AF_INET) ? INADDRSZ : IN6ADDRSZ;
+    uint32_t min_ttl = UINT32_MAX;
+
+    if (!(flags & DNS_FLAG_QR)) {
+        return -EBADMSG;
+    }
+    if (((flags & DNS_RCODE_MASK) != 0) &&
+        ((flags & DNS_RCODE_MASK) != DNS_RCODE_NXDOMAIN)) {
+        /* server failure or refused, the query may be repeated */
+        return -EAGAIN;
+    }
 
     /* skip all queries that are part of the reply */
     for (unsigned n = 0; n < ntohs(hdr->qdcount); n++) {
@@ -120,124 +249,251 @@ static int _parse_dns_reply(uint8_t *buf, size_t len, void* addr_out, int family
     }
 
     for (unsigned n = 0; n < ntohs(hdr->ancount); n++) {
-        ssize_t tmp = _skip_hostname(buf, len, bufpos);
+        _rr_t rr;
+        ssize_t tmp = _get_rr(buf, len, bufpos, &rr);
         if (tmp < 0) {
             return tmp;
         }
         bufpos += tmp;
-        if ((bufpos + RR_TYPE_LENGTH + RR_CLASS_LENGTH +
-             RR_TTL_LENGTH + sizeof(uint16_t)) >= buflim) {
-            return -EBADMSG;
+        /* the answer is only valid as long as all records of a possible
+         * CNAME chain are */
+        if (rr.ttl < min_ttl) {
+            min_ttl = rr.ttl;
         }
-        uint16_t _type = ntohs(_get_short(bufpos));
-        bufpos += RR_TYPE_LENGTH;
-        uint16_t class = ntohs(_get_short(bufpos));
-        bufpos += RR_CLASS_LENGTH;
-        bufpos += RR_TTL_LENGTH; /* skip ttl */
-
-        unsigned addrlen = ntohs(_get_short(bufpos));
         /* skip unwanted answers */
-        if ((class != DNS_CLASS_IN) ||
-                ((_type == DNS_TYPE_A) && (family == AF_INET6)) ||
-                ((_type == DNS_TYPE_AAAA) && (family == AF_INET)) ||
-                ! ((_type == DNS_TYPE_A) || ((_type == DNS_TYPE_AAAA))
-                    )) {
-            if (addrlen > len) {
-                /* buffer wraps around memory space */
-                return -EBADMSG;
-            }
-            bufpos += addrlen;
-            /* other out-of-bound is checked in `_skip_hostname()` at start of
-             * loop */
+        if ((rr.class != DNS_CLASS_IN) || (rr.type != type)) {
             continue;
         }
-        if (((addrlen != INADDRSZ) && (family == AF_INET)) ||
-            ((addrlen != IN6ADDRSZ) && (family == AF_INET6)) ||
-            ((addrlen != IN6ADDRSZ) && (addrlen != INADDRSZ) &&
-             (family == AF_UNSPEC))) {
+        if (rr.rdlength != addrlen) {
             return -EBADMSG;
         }
-        bufpos += RR_RDLENGTH_LENGTH;
-        if ((bufpos + addrlen) > buflim) {
-            return -EBADMSG;
-        }
-
-        memcpy(addr_out, bufpos, addrlen);
+        memcpy(addr_out, rr.rdata, addrlen);
+        *ttl = min_ttl;
         return addrlen;
     }
 
-    return -1;
+    /* the name does not exist or has no record of the family */
+    *ttl = _neg_ttl(buf, len, bufpos);
+    return -ENOENT;
 }
 
-int sock_dns_query(const char *domain_name, void *addr_out, int family)
+static uint16_t _next_id(void)
 {
-    static uint8_t dns_buf[SOCK_DNS_BUF_LEN];
+    unsigned state = irq_disable();
+    uint16_t id = ++_id;
+    irq_restore(state);
+    return id;
+}
 
-    if (sock_dns_server.port == 0) {
-        return -ECONNREFUSED;
+static size_t _build_query(uint8_t *buf, uint16_t id, const char *domain_name,
+                           int family)
+{
+    sock_dns_hdr_t *hdr = (sock_dns_hdr_t*) buf;
+    memset(hdr, 0, sizeof(*hdr));
+    hdr->id = id;
+    hdr->flags = htons(0x0120);
+    hdr->qdcount = htons(1);
+
+    uint8_t *bufpos = buf + sizeof(*hdr);
+    bufpos += _enc_domain_name(bufpos, domain_name);
+    bufpos += _put_short(bufpos, htons((family == AF_INET) ? DNS_TYPE_A
+                                                            : DNS_TYPE_AAAA));
+    bufpos += _put_short(bufpos, htons(DNS_CLASS_IN));
+
+    return bufpos - buf;
+}
+
+static bool _finished(const _query_t *queries, unsigned numof)
+{
+    for (unsigned i = 0; i < numof; i++) {
+        if (!queries[i].done) {
+            return false;
+        }
+        if (queries[i].res > 0) {
+            /* a preferred address was found */
+            return true;
+        }
     }
+    return true;
+}
 
-    if (strlen(domain_name) > SOCK_DNS_MAX_NAME_LEN) {
-        return -ENOSPC;
+static _query_t *_find_query(_query_t *queries, unsigned numof, uint16_t id)
+{
+    for (unsigned i = 0; i < numof; i++) {
+        if ((queries[i].id == id) && !queries[i].done) {
+            return &queries[i];
+        }
     }
+    return NULL;
+}
 
+static int _resolve(const char *domain_name, void *addr_out, int family)
+{
+    uint8_t buf[SOCK_DNS_BUF_LEN];
+    _query_t queries[2];
+    unsigned numof = 0;
     sock_udp_t sock_dns;
 
+    /* for AF_UNSPEC, AAAA and A are queried at the same time */
+    if (family != AF_INET) {
+        queries[numof++].family = AF_INET6;
+    }
+    if (family != AF_INET6) {
+        queries[numof++].family = AF_INET;
+    }
+    for (unsigned i = 0; i < numof; i++) {
+        queries[i].id = _next_id();
+        queries[i].done = false;
+        queries[i].res = -ETIMEDOUT;
+    }
+
     ssize_t res = sock_udp_create(&sock_dns, NULL, &sock_dns_server, 0);
     if (res) {
-        goto out;
+        return res;
     }
 
-    uint16_t id = 0; /* random? */
-    for (int i = 0; i < SOCK_DNS_RETRIES; i++) {
-        uint8_t *buf = dns_buf;
-
-        sock_dns_hdr_t *hdr = (sock_dns_hdr_t*) buf;
-        memset(hdr, 0, sizeof(*hdr));
-        hdr->id = id;
-        hdr->flags = htons(0x0120);
-        hdr->qdcount = htons(1 + (family == AF_UNSPEC));
-
-        uint8_t *bufpos = buf + sizeof(*hdr);
-
-        unsigned _name_ptr;
-        if ((family == AF_INET6) || (family == AF_UNSPEC)) {
-            _name_ptr = (bufpos - buf);
-            bufpos += _enc_domain_name(bufpos, domain_name);
-            bufpos += _put_short(bufpos, htons(DNS_TYPE_AAAA));
-            bufpos += _put_short(bufpos, htons(DNS_CLASS_IN));
+    for (int i = 0; (i < SOCK_DNS_RETRIES) && !_finished(queries, numof); i++) {
+        for (unsigned n = 0; n < numof; n++) {
+            if (!queries[n].done) {
+                size_t len = _build_query(buf, queries[n].id, domain_name,
+                                          queries[n].family);
+                res = sock_udp_send(&sock_dns, buf, len, NULL);
+                if (res <= 0) {
+                    queries[n].res = res;
+                }
+            }
         }
 
-        if ((family == AF_INET) || (family == AF_UNSPEC)) {
-            if (family == AF_UNSPEC) {
-                bufpos += _put_short(bufpos, htons((0xc000) | (_name_ptr)));
+        while (!_finished(queries, numof)) {
+            res = sock_udp_recv(&sock_dns, buf, sizeof(buf), SOCK_DNS_TIMEOUT,
+                                NULL);
+            if (res <= 0) {
+                break;
             }
-            else {
-                bufpos += _enc_domain_name(bufpos, domain_name);
+            if (res <= (int)DNS_MIN_REPLY_LEN) {
+                continue;
             }
-            bufpos += _put_short(bufpos, htons(DNS_TYPE_A));
-            bufpos += _put_short(bufpos, htons(DNS_CLASS_IN));
+            _query_t *query = _find_query(queries, numof,
+                                          ((sock_dns_hdr_t *)buf)->id);
+            if (query == NULL) {
+                /* late reply to an earlier query */
+                continue;
+            }
+            int tmp = _parse_dns_reply(buf, res, query->addr, query->family,
+                                       &query->ttl);
+            query->res = tmp;
+            query->done = (tmp > 0) || (tmp == -ENOENT);
         }
+    }
 
-        res = sock_udp_send(&sock_dns, buf, (bufpos-buf), NULL);
-        if (res <= 0) {
-            continue;
+    /* the first address in the order of preference, else the error of the
+     * preferred query */
+    res = queries[0].res;
+    for (unsigned n = 0; n < numof; n++) {
+        if (queries[n].res > 0) {
+            res = queries[n].res;
+            memcpy(addr_out, queries[n].addr, res);
+            break;
         }
-        res = sock_udp_recv(&sock_dns, dns_buf, sizeof(dns_buf), 1000000LU, NULL);
-        if (res > 0) {
-            if (res > (int)DNS_MIN_REPLY_LEN) {
-                if ((res = _parse_dns_reply(dns_buf, res, addr_out,
-                                            family)) > 0) {
-                    goto out;
-                }
-            }
-            else {
-                res = -EBADMSG;
+    }
+
+    if (IS_USED(MODULE_SOCK_DNS_CACHE)) {
+        for (unsigned n = 0; n < numof; n++) {
+            if (queries[n].done) {
+                dns_cache_add(domain_name, queries[n].addr, queries[n].family,
+                              queries[n].res, queries[n].ttl);
             }
         }
     }
 
-out:
     sock_udp_close(&sock_dns);
     return res;
 }
+
+static _inflight_t *_inflight_find(const char *domain_name, int family)
+{
+    for (unsigned i = 0; i < CONFIG_SOCK_DNS_INFLIGHT_NUMOF; i++) {
+        _inflight_t *slot = &_inflight[i];
+        if (slot->domain_name && !slot->done && (slot->family == family) &&
+            (strcasecmp(slot->domain_name, domain_name) == 0)) {
+            return slot;
+        }
+    }
+    return NULL;
+}
+
+static _inflight_t *_inflight_alloc(const char *domain_name, int family)
+{
+    for (unsigned i = 0; i < CONFIG_SOCK_DNS_INFLIGHT_NUMOF; i++) {
+        _inflight_t *slot = &_inflight[i];
+        if (slot->domain_name == NULL) {
+            slot->domain_name = domain_name;
+            slot->family = family;
+            slot->done = false;
+            slot->waiters = 0;
+            return slot;
+        }
+    }
+    return NULL;
+}
+
+int sock_dns_query(const char *domain_name, void *addr_out, int family)
+{
+    if (sock_dns_server.port == 0) {
+        return -ECONNREFUSED;
+    }
+
+    if (strlen(domain_name) > SOCK_DNS_MAX_NAME_LEN) {
+        return -ENOSPC;
+    }
+
+    if (IS_USED(MODULE_SOCK_DNS_CACHE)) {
+        int res = dns_cache_query(domain_name, addr_out, family);
+        if (res != 0) {
+            return res;
+        }
+    }
+
+    mutex_lock(&_inflight_lock);
+
+    _inflight_t *slot = _inflight_find(domain_name, family);
+    if (slot) {
+        /* wait for the result of the query that is already in flight */
+        DEBUG("sock_dns: waiting for query of %s\n", domain_name);
+        slot->waiters++;
+        while (!slot->done) {
+            cond_wait(&_inflight_cond, &_inflight_lock);
+        }
+        int res = slot->res;
+        if (res > 0) {
+            memcpy(addr_out, slot->addr, res);
+        }
+        if (--slot->waiters == 0) {
+            slot->domain_name = NULL;
+        }
+        mutex_unlock(&_inflight_lock);
+        return res;
+    }
+
+    /* if no slot is free, the query is not coalesced */
+    slot = _inflight_alloc(domain_name, family);
+    mutex_unlock(&_inflight_lock);
+
+    int res = _resolve(domain_name, addr_out, family);
+
+    if (slot) {
+        mutex_lock(&_inflight_lock);
+        slot->res = res;
+        if (res > 0) {
+            memcpy(slot->addr, addr_out, res);
+        }
+        slot->done = true;
+        if (slot->waiters == 0) {
+            slot->domain_name = NULL;
+        }
+        cond_broadcast(&_inflight_cond);
+        mutex_unlock(&_inflight_lock);
+    }
+
+    return res;
+}
@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2021 Gunar Schorcht
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup net_sock_dns
+ * @{
+ * @file
+ * @brief   Asynchronous sock DNS client
+ *
+ * Queries are events that are handled by a resolver thread. When the result
+ * is available, the same event is posted to the queue of the caller with the
+ * handler of the caller.
+ *
+ * @author  Gunar Schorcht <gunar@schorcht.net>
+ * @}
+ */
+
+#include <assert.h>
+#include <string.h>
+
+#include "event.h"
+#include "kernel_defines.h"
+#include "mutex.h"
+#include "net/sock/dns.h"
+#include "thread.h"
+
+#include "_dns_cache.h"
+
+#define ENABLE_DEBUG    0
+#include "debug.h"
+
+static event_queue_t _queue;
+static char _stack[SOCK_DNS_ASYNC_STACKSIZE];
+static kernel_pid_t _pid = KERNEL_PID_UNDEF;
+static mutex_t _lock = MUTEX_INIT;
+
+static void *_resolver(void *arg)
+{
+    (void)arg;
+
+    event_queue_claim(&_queue);
+    event_loop(&_queue);
+
+    return NULL;
+}
+
+static void _post_result(sock_dns_async_t *query)
+{
+    query->super.handler = query->handler;
+    event_post(query->queue, &query->super);
+}
+
+static void _resolve(event_t *event)
+{
+    sock_dns_async_t *query = container_of(event, sock_dns_async_t, super);
+
+    query->res = sock_dns_query(query->domain_name, query->addr,
+                                query->family);
+    _post_result(query);
+}
+
+static void _start_resolver(void)
+{
+    mutex_lock(&_lock);
+    if (_pid == KERNEL_PID_UNDEF) {
+        /* queries posted before the thread claims the queue are kept */
+        event_queue_init_detached(&_queue);
+        _pid = thread_create(_stack, sizeof(_stack), SOCK_DNS_ASYNC_PRIO,
+                             THREAD_CREATE_STACKTEST, _resolver, NULL,
+                             "dns");
+    }
+    mutex_unlock(&_lock);
+}
+
+int sock_dns_query_async(sock_dns_async_t *query, const char *domain_name,
+                         int family, event_queue_t *queue,
+                         event_handler_t handler)
+{
+    assert(query && domain_name && queue && handler);
+
+    if (strlen(domain_name) > SOCK_DNS_MAX_NAME_LEN) {
+        return -ENOSPC;
+    }
+
+    query->domain_name = domain_name;
+    query->family = family;
+    query->queue = queue;
+    query->handler = handler;
+
+    if (IS_USED(MODULE_SOCK_DNS_CACHE)) {
+        query->res = dns_cache_query(domain_name, query->addr, family);
+        if (query->res != 0) {
+            DEBUG("sock_dns_async: %s is cached\n", domain_name);
+            _post_result(query);
+            return 0;
+        }
+    }
+
+    _start_resolver();
+
+    query->super.handler = _resolve;
+    event_post(&_queue, &query->super);
+
+    return 0;
+}
@@ -0,0 +1,177 @@
+/*
+ * Copyright (C) 2021 Gunar Schorcht
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup net_sock_dns
+ * @{
+ * @file
+ * @brief   DNS cache of the sock DNS client
+ *
+ * Entries are identified by the name and the address family. The names are
+ * compared case-insensitively, a 32-bit FNV-1a hash of the lower case name
+ * is only used to skip entries of other names quickly.
+ *
+ * @author  Gunar Schorcht <gunar@schorcht.net>
+ * @}
+ */
+
+#include <arpa/inet.h>
+#include <ctype.h>
+#include <errno.h>
+#include <string.h>
+#include <strings.h>
+
+#include "mutex.h"
+#include "net/sock/dns.h"
+#include "timex.h"
+#include "ztimer.h"
+
+#include "_dns_cache.h"
+
+#define ENABLE_DEBUG    0
+#include "debug.h"
+
+typedef struct {
+    uint32_t hash;
+    uint32_t expires;       /* in ms of ZTIMER_MSEC */
+    int16_t res;            /* size of the address or -ENOENT, 0 if unused */
+    uint8_t family;
+    uint8_t addr[16];
+    char name[SOCK_DNS_MAX_NAME_LEN + 1];
+} _entry_t;
+
+static _entry_t _cache[CONFIG_SOCK_DNS_CACHE_SIZE];
+static mutex_t _lock = MUTEX_INIT;
+
+static uint32_t _hash(const char *domain_name)
+{
+    uint32_t hash = 0x811c9dc5;
+
+    /* DNS names are case-insensitive */
+    while (*domain_name) {
+        hash ^= (uint8_t)tolower((unsigned char)*domain_name++);
+        hash *= 0x01000193;
+    }
+    return hash;
+}
+
+static bool _expired(const _entry_t *entry, uint32_t now)
+{
+    return (int32_t)(entry->expires - now) <= 0;
+}
+
+static bool _match(const _entry_t *entry, const char *domain_name,
+                   uint32_t hash, int family)
+{
+    return entry->res && (entry->hash == hash) && (entry->family == family) &&
+           (strcasecmp(entry->name, domain_name) == 0);
+}
+
+static _entry_t *_find(const char *domain_name, uint32_t hash, int family,
+                       uint32_t now)
+{
+    for (unsigned i = 0; i < CONFIG_SOCK_DNS_CACHE_SIZE; i++) {
+        _entry_t *entry = &_cache[i];
+        if (_match(entry, domain_name, hash, family)) {
+            if (_expired(entry, now)) {
+                entry->res = 0;
+                return NULL;
+            }
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+int dns_cache_query(const char *domain_name, void *addr_out, int family)
+{
+    uint32_t hash = _hash(domain_name);
+    int res = 0;
+
+    mutex_lock(&_lock);
+    uint32_t now = ztimer_now(ZTIMER_MSEC);
+
+    _entry_t *entry = NULL;
+    if ((family == AF_INET6) || (family == AF_UNSPEC)) {
+        entry = _find(domain_name, hash, AF_INET6, now);
+    }
+    if ((family == AF_INET) ||
+        ((family == AF_UNSPEC) && entry && (entry->res < 0))) {
+        entry = _find(domain_name, hash, AF_INET, now);
+    }
+
+    if (entry) {
+        res = entry->res;
+        if (res > 0) {
+            memcpy(addr_out, entry->addr, res);
+        }
+    }
+    mutex_unlock(&_lock);
+
+    DEBUG("dns_cache: %s %s family %d: %d\n", res ? "hit" : "miss",
+          domain_name, family, res);
+    return res;
+}
+
+void dns_cache_add(const char *domain_name, const void *addr, int family,
+                   int res, uint32_t ttl)
+{
+    uint32_t hash = _hash(domain_name);
+
+    /* names that don't fit into an entry are not cached */
+    if ((ttl == 0) || (strlen(domain_name) > SOCK_DNS_MAX_NAME_LEN)) {
+        return;
+    }
+    if (ttl > CONFIG_SOCK_DNS_CACHE_MAX_TTL) {
+        ttl = CONFIG_SOCK_DNS_CACHE_MAX_TTL;
+    }
+
+    mutex_lock(&_lock);
+    uint32_t now = ztimer_now(ZTIMER_MSEC);
+
+    /* replace the entry of the same name, an unused or expired entry or
+     * else the entry that expires first */
+    _entry_t *entry = NULL;
+    for (unsigned i = 0; i < CONFIG_SOCK_DNS_CACHE_SIZE; i++) {
+        _entry_t *e = &_cache[i];
+        if (_match(e, domain_name, hash, family)) {
+            entry = e;
+            break;
+        }
+        if (!e->res || _expired(e, now)) {
+            if (!entry || entry->res) {
+                entry = e;
+                entry->res = 0;
+            }
+        }
+        else if (!entry || (entry->res &&
+                            (int32_t)(e->expires - entry->expires) < 0)) {
+            entry = e;
+        }
+    }
+
+    entry->hash = hash;
+    strcpy(entry->name, domain_name);
+    entry->family = family;
+    entry->expires = now + ttl * MS_PER_SEC;
+    entry->res = res;
+    if (res > 0) {
+        memcpy(entry->addr, addr, res);
+    }
+    mutex_unlock(&_lock);
+
+    DEBUG("dns_cache: add %s family %d: %d ttl %lu\n", domain_name, family,
+          res, (unsigned long)ttl);
+}
+
+void sock_dns_cache_flush(void)
+{
+    mutex_lock(&_lock);
+    memset(_cache, 0, sizeof(_cache));
+    mutex_unlock(&_lock);
+}
@@ -222,7 +222,7 @@ static gnrc_pktsnip_t *_recv(gnrc_netif_t *netif)
         ethernet_hdr_t *hdr = (ethernet_hdr_t *)eth_hdr->data;
 
 #ifdef MODULE_L2FILTER
-        if (!l2filter_pass(dev->filter, hdr->src, ETHERNET_ADDR_LEN)) {
+        if (!l2filter_pass(&dev->filter, hdr->src, ETHERNET_ADDR_LEN)) {
             DEBUG("gnrc_netif_ethernet: incoming packet filtered by l2filter\n");
             goto safe_out;
         }
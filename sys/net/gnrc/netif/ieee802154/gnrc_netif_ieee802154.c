@@ -154,7 +154,7 @@ static gnrc_pktsnip_t *_recv(gnrc_netif_t *netif)
             hdr = netif_hdr->data;
 
 #ifdef MODULE_L2FILTER
-            if (!l2filter_pass(dev->filter, gnrc_netif_hdr_get_src_addr(hdr),
+            if (!l2filter_pass(&dev->filter, gnrc_netif_hdr_get_src_addr(hdr),
                                hdr->src_l2addr_len)) {
                 gnrc_pktbuf_release(pkt);
                 gnrc_pktbuf_release(netif_hdr);
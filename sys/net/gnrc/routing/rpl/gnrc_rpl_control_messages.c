@@ -35,6 +35,7 @@
 #endif
 
 #include "net/gnrc/rpl.h"
+#include "net/gnrc/rpl/routes.h"
 #include "gnrc_rpl_internal/validation.h"
 
 #ifdef MODULE_GNRC_RPL_P2P
@@ -497,12 +498,54 @@ static inline uint32_t _sec_to_ms(uint32_t sec)
     }
 }
 
-/** @todo allow target prefixes in target options to be of variable length */
+static inline uint32_t _now_sec(void)
+{
+    return (xtimer_now_usec64() / US_PER_SEC) & UINT32_MAX;
+}
+
+/* updates the routes of the targets of a DAO */
+static void _targets_update(gnrc_rpl_instance_t *inst,
+                            const gnrc_rpl_routes_target_t *targets, unsigned numof,
+                            ipv6_addr_t *src, uint32_t lifetime)
+{
+    gnrc_rpl_dodag_t *dodag = &inst->dodag;
+
+    gnrc_rpl_routes_update(&gnrc_rpl_routes, targets, numof, src, dodag->iface,
+                           lifetime, _now_sec());
+}
+
+/* checks all target options of a DAO before any route is updated, so that a
+ * malformed target doesn't leave the routes of the DAO partially updated */
+static bool _targets_valid(gnrc_rpl_opt_t *opt, uint16_t len)
+{
+    uint16_t l = 0;
+    gnrc_rpl_routes_target_t target;
+
+    while (l < len) {
+        if (opt->type == GNRC_RPL_OPT_PAD1) {
+            l += 1;
+            opt = (gnrc_rpl_opt_t *) (((uint8_t *) opt) + 1);
+            continue;
+        }
+        if ((opt->type == GNRC_RPL_OPT_TARGET) &&
+            (gnrc_rpl_routes_target_get((gnrc_rpl_opt_target_t *) opt, &target) < 0)) {
+            DEBUG("RPL: malformed RPL TARGET DAO option\n");
+            return false;
+        }
+        l += opt->length + sizeof(gnrc_rpl_opt_t);
+        opt = (gnrc_rpl_opt_t *) (((uint8_t *) (opt + 1)) + opt->length);
+    }
+    return true;
+}
+
 bool _parse_options(int msg_type, gnrc_rpl_instance_t *inst, gnrc_rpl_opt_t *opt, uint16_t len,
                     ipv6_addr_t *src, uint32_t *included_opts)
 {
     uint16_t l = 0;
-    gnrc_rpl_opt_target_t *first_target = NULL;
+    /* targets are collected until the transit option, so that the routes of
+     * all targets are updated at once */
+    gnrc_rpl_routes_target_t targets[CONFIG_GNRC_RPL_DAO_TARGETS_MAX];
+    unsigned targets_numof = 0;
     gnrc_rpl_dodag_t *dodag = &inst->dodag;
     eui64_t iid;
     *included_opts = 0;
@@ -513,6 +556,10 @@ bool _parse_options(int msg_type, gnrc_rpl_instance_t *inst, gnrc_rpl_opt_t *opt
         }
     }
 
+    if ((msg_type == GNRC_RPL_ICMPV6_CODE_DAO) && !_targets_valid(opt, len)) {
+        return false;
+    }
+
     while(l < len) {
         switch(opt->type) {
             case (GNRC_RPL_OPT_PAD1):
@@ -617,48 +664,38 @@ bool _parse_options(int msg_type, gnrc_rpl_instance_t *inst, gnrc_rpl_opt_t *opt
                 *included_opts |= ((uint32_t) 1) << GNRC_RPL_OPT_TARGET;
 
                 gnrc_rpl_opt_target_t *target = (gnrc_rpl_opt_target_t *) opt;
-                if (first_target == NULL) {
-                    first_target = target;
+                if (targets_numof == CONFIG_GNRC_RPL_DAO_TARGETS_MAX) {
+                    /* more targets than expected, they get the default lifetime */
+                    _targets_update(inst, targets, targets_numof, src,
+                                    dodag->default_lifetime * dodag->lifetime_unit);
+                    targets_numof = 0;
+                }
+                if (gnrc_rpl_routes_target_get(target, &targets[targets_numof]) < 0) {
+                    DEBUG("RPL: malformed RPL TARGET DAO option\n");
+                    return false;
                 }
 
-                DEBUG("RPL: adding FT entry %s/%d\n",
-                      ipv6_addr_to_str(addr_str, &(target->target), (unsigned)sizeof(addr_str)),
+                DEBUG("RPL: adding target %s/%d\n",
+                      ipv6_addr_to_str(addr_str, &targets[targets_numof].prefix,
+                                       sizeof(addr_str)),
                       target->prefix_length);
-
-                gnrc_ipv6_nib_ft_del(&(target->target), target->prefix_length);
-                gnrc_ipv6_nib_ft_add(&(target->target), target->prefix_length, src,
-                                     dodag->iface,
-                                     dodag->default_lifetime * dodag->lifetime_unit);
+                targets_numof++;
                 break;
 
             case (GNRC_RPL_OPT_TRANSIT):
                 DEBUG("RPL: RPL TRANSIT INFO DAO option parsed\n");
                 *included_opts |= ((uint32_t) 1) << GNRC_RPL_OPT_TRANSIT;
                 gnrc_rpl_opt_transit_t *transit = (gnrc_rpl_opt_transit_t *) opt;
-                if (first_target == NULL) {
+                if (targets_numof == 0) {
                     DEBUG("RPL: Encountered a RPL TRANSIT DAO option without "
                           "a preceding RPL TARGET DAO option\n");
                     break;
                 }
 
-                do {
-                    DEBUG("RPL: updating FT entry %s/%d\n",
-                          ipv6_addr_to_str(addr_str, &(first_target->target), sizeof(addr_str)),
-                          first_target->prefix_length);
-
-                    gnrc_ipv6_nib_ft_del(&(first_target->target),
-                                         first_target->prefix_length);
-                    gnrc_ipv6_nib_ft_add(&(first_target->target),
-                                         first_target->prefix_length, src,
-                                         dodag->iface,
-                                         transit->path_lifetime * dodag->lifetime_unit);
-
-                    first_target = (gnrc_rpl_opt_target_t *) (((uint8_t *) (first_target)) +
-                                   sizeof(gnrc_rpl_opt_t) + first_target->length);
-                }
-                while (first_target->type == GNRC_RPL_OPT_TARGET);
-
-                first_target = NULL;
+                DEBUG("RPL: updating %u routes\n", targets_numof);
+                _targets_update(inst, targets, targets_numof, src,
+                                transit->path_lifetime * dodag->lifetime_unit);
+                targets_numof = 0;
                 break;
 
 #ifdef MODULE_GNRC_RPL_P2P
@@ -670,6 +707,12 @@ bool _parse_options(int msg_type, gnrc_rpl_instance_t *inst, gnrc_rpl_opt_t *opt
         l += opt->length + sizeof(gnrc_rpl_opt_t);
         opt = (gnrc_rpl_opt_t *) (((uint8_t *) (opt + 1)) + opt->length);
     }
+
+    if (targets_numof) {
+        /* targets without transit option get the default lifetime */
+        _targets_update(inst, targets, targets_numof, src,
+                        dodag->default_lifetime * dodag->lifetime_unit);
+    }
     return true;
 }
 
@@ -919,25 +962,6 @@ void gnrc_rpl_recv_DIO(gnrc_rpl_dio_t *dio, kernel_pid_t iface, ipv6_addr_t *src
     }
 }
 
-gnrc_pktsnip_t *_dao_target_build(gnrc_pktsnip_t *pkt, ipv6_addr_t *addr, uint8_t prefix_length)
-{
-    gnrc_rpl_opt_target_t *target;
-    gnrc_pktsnip_t *opt_snip;
-    if ((opt_snip = gnrc_pktbuf_add(pkt, NULL, sizeof(gnrc_rpl_opt_target_t),
-                               GNRC_NETTYPE_UNDEF)) == NULL) {
-        DEBUG("RPL: Send DAO - no space left in packet buffer\n");
-        gnrc_pktbuf_release(pkt);
-        return NULL;
-    }
-    target = opt_snip->data;
-    target->type = GNRC_RPL_OPT_TARGET;
-    target->length = sizeof(target->flags) + sizeof(target->prefix_length) + sizeof(target->target);
-    target->flags = 0;
-    target->prefix_length = prefix_length;
-    target->target = *addr;
-    return opt_snip;
-}
-
 gnrc_pktsnip_t *_dao_transit_build(gnrc_pktsnip_t *pkt, uint8_t lifetime, bool external)
 {
     gnrc_rpl_opt_transit_t *transit;
@@ -959,85 +983,37 @@ gnrc_pktsnip_t *_dao_transit_build(gnrc_pktsnip_t *pkt, uint8_t lifetime, bool e
     return opt_snip;
 }
 
-void gnrc_rpl_send_DAO(gnrc_rpl_instance_t *inst, ipv6_addr_t *destination, uint8_t lifetime)
+static bool _send_DAO(gnrc_rpl_instance_t *inst, ipv6_addr_t *destination, uint8_t lifetime,
+                      const ipv6_addr_t *me, unsigned *pos, uint32_t now)
 {
-    gnrc_rpl_dodag_t *dodag;
-
-    if (inst == NULL) {
-        DEBUG("RPL: Error - trying to send DAO without being part of a dodag.\n");
-        return;
-    }
-
-    dodag = &inst->dodag;
-
-    if (dodag->node_status == GNRC_RPL_ROOT_NODE) {
-        return;
-    }
-
-#ifdef MODULE_GNRC_RPL_P2P
-    if (dodag->instance->mop == GNRC_RPL_P2P_MOP) {
-        return;
-    }
-#endif
-
-    if (destination == NULL) {
-        if (dodag->parents == NULL) {
-            DEBUG("RPL: dodag has no preferred parent\n");
-            return;
-        }
-
-        destination = &(dodag->parents->addr);
-    }
-
+    gnrc_rpl_dodag_t *dodag = &inst->dodag;
     gnrc_pktsnip_t *pkt = NULL, *tmp = NULL;
     gnrc_rpl_dao_t *dao;
 
-    /* find my address */
-    ipv6_addr_t *me = NULL;
-    gnrc_netif_t *netif = gnrc_netif_get_by_prefix(&dodag->dodag_id);
-    int idx;
-
-    if (netif == NULL) {
-        DEBUG("RPL: no address configured\n");
-        return;
-    }
-    idx = gnrc_netif_ipv6_addr_match(netif, &dodag->dodag_id);
-    if (idx < 0) {
-        DEBUG("RPL: no address matching DODAG ID found\n");
-        return;
+    /* all targets of a DAO share one transit option */
+    if ((pkt = _dao_transit_build(NULL, lifetime, false)) == NULL) {
+        DEBUG("RPL: Send DAO - no space left in packet buffer\n");
+        return false;
     }
-    me = &netif->ipv6.addrs[idx];
-
-    /* add external and RPL FT entries */
-    /* TODO: nib: dropped support for external transit options for now */
-    void *ft_state = NULL;
-    gnrc_ipv6_nib_ft_t fte;
-    while(gnrc_ipv6_nib_ft_iter(NULL, dodag->iface, &ft_state, &fte)) {
-        DEBUG("RPL: Send DAO - building transit option\n");
-
-        if ((pkt = _dao_transit_build(pkt, lifetime, false)) == NULL) {
-            DEBUG("RPL: Send DAO - no space left in packet buffer\n");
-            return;
-        }
-        if (ipv6_addr_is_global(&fte.dst) &&
-            !ipv6_addr_is_unspecified(&fte.next_hop)) {
-            DEBUG("RPL: Send DAO - building target %s/%d\n",
-                  ipv6_addr_to_str(addr_str, &fte.dst, sizeof(addr_str)), fte.dst_len);
 
-            if ((pkt = _dao_target_build(pkt, &fte.dst, fte.dst_len)) == NULL) {
-                DEBUG("RPL: Send DAO - no space left in packet buffer\n");
-                return;
-            }
-        }
+    if ((tmp = gnrc_pktbuf_add(pkt, NULL,
+                               CONFIG_GNRC_RPL_DAO_TARGETS_MAX * sizeof(gnrc_rpl_opt_target_t),
+                               GNRC_NETTYPE_UNDEF)) == NULL) {
+        DEBUG("RPL: Send DAO - no space left in packet buffer\n");
+        gnrc_pktbuf_release(pkt);
+        return false;
     }
+    pkt = tmp;
 
-    /* add own address */
-    DEBUG("RPL: Send DAO - building target %s/128\n",
-          ipv6_addr_to_str(addr_str, me, sizeof(addr_str)));
-    if ((pkt = _dao_target_build(pkt, me, IPV6_ADDR_BIT_LEN)) == NULL) {
-        DEBUG("RPL: Send DAO - no space left in packet buffer\n");
-        return;
+    size_t targets_len = gnrc_rpl_routes_dao_targets(&gnrc_rpl_routes, me, pos, pkt->data,
+                                                     pkt->size, now);
+    if (targets_len == 0) {
+        /* all targets were sent */
+        gnrc_pktbuf_release(pkt);
+        return false;
     }
+    DEBUG("RPL: Send DAO - %u bytes of targets\n", (unsigned)targets_len);
+    gnrc_pktbuf_realloc_data(pkt, targets_len);
 
     bool local_instance = (inst->id & GNRC_RPL_INSTANCE_ID_MSB) ? true : false;
 
@@ -1046,7 +1022,7 @@ void gnrc_rpl_send_DAO(gnrc_rpl_instance_t *inst, ipv6_addr_t *destination, uint
                                    GNRC_NETTYPE_UNDEF)) == NULL) {
             DEBUG("RPL: Send DAO - no space left in packet buffer\n");
             gnrc_pktbuf_release(pkt);
-            return;
+            return false;
         }
         pkt = tmp;
     }
@@ -1054,7 +1030,7 @@ void gnrc_rpl_send_DAO(gnrc_rpl_instance_t *inst, ipv6_addr_t *destination, uint
     if ((tmp = gnrc_pktbuf_add(pkt, NULL, sizeof(gnrc_rpl_dao_t), GNRC_NETTYPE_UNDEF)) == NULL) {
         DEBUG("RPL: Send DAO - no space left in packet buffer\n");
         gnrc_pktbuf_release(pkt);
-        return;
+        return false;
     }
     pkt = tmp;
     dao = pkt->data;
@@ -1076,7 +1052,7 @@ void gnrc_rpl_send_DAO(gnrc_rpl_instance_t *inst, ipv6_addr_t *destination, uint
                                  sizeof(icmpv6_hdr_t))) == NULL) {
         DEBUG("RPL: Send DAO - no space left in packet buffer\n");
         gnrc_pktbuf_release(pkt);
-        return;
+        return false;
     }
     pkt = tmp;
 
@@ -1088,6 +1064,64 @@ void gnrc_rpl_send_DAO(gnrc_rpl_instance_t *inst, ipv6_addr_t *destination, uint
     gnrc_rpl_send(pkt, dodag->iface, NULL, destination, &dodag->dodag_id);
 
     GNRC_RPL_COUNTER_INCREMENT(dodag->dao_seq);
+
+    return true;
+}
+
+void gnrc_rpl_send_DAO(gnrc_rpl_instance_t *inst, ipv6_addr_t *destination, uint8_t lifetime)
+{
+    gnrc_rpl_dodag_t *dodag;
+
+    if (inst == NULL) {
+        DEBUG("RPL: Error - trying to send DAO without being part of a dodag.\n");
+        return;
+    }
+
+    dodag = &inst->dodag;
+
+    if (dodag->node_status == GNRC_RPL_ROOT_NODE) {
+        return;
+    }
+
+#ifdef MODULE_GNRC_RPL_P2P
+    if (dodag->instance->mop == GNRC_RPL_P2P_MOP) {
+        return;
+    }
+#endif
+
+    if (destination == NULL) {
+        if (dodag->parents == NULL) {
+            DEBUG("RPL: dodag has no preferred parent\n");
+            return;
+        }
+
+        destination = &(dodag->parents->addr);
+    }
+
+    /* find my address */
+    ipv6_addr_t *me = NULL;
+    gnrc_netif_t *netif = gnrc_netif_get_by_prefix(&dodag->dodag_id);
+    int idx;
+
+    if (netif == NULL) {
+        DEBUG("RPL: no address configured\n");
+        return;
+    }
+    idx = gnrc_netif_ipv6_addr_match(netif, &dodag->dodag_id);
+    if (idx < 0) {
+        DEBUG("RPL: no address matching DODAG ID found\n");
+        return;
+    }
+    me = &netif->ipv6.addrs[idx];
+
+    /* the own address and the downward routes are sent as targets, as many
+     * targets as possible are aggregated in one DAO */
+    /* TODO: nib: dropped support for external transit options for now */
+    uint32_t now = _now_sec();
+    unsigned pos = 0;
+
+    gnrc_rpl_routes_expire(&gnrc_rpl_routes, now);
+    while (_send_DAO(inst, destination, lifetime, me, &pos, now)) {}
 }
 
 void gnrc_rpl_send_DAO_ACK(gnrc_rpl_instance_t *inst, ipv6_addr_t *destination, uint8_t seq)
@@ -1192,6 +1226,8 @@ void gnrc_rpl_recv_DAO(gnrc_rpl_dao_t *dao, kernel_pid_t iface, ipv6_addr_t *src
     }
 #endif
 
+    gnrc_rpl_routes_expire(&gnrc_rpl_routes, _now_sec());
+
     uint32_t included_opts = 0;
     if(!_parse_options(GNRC_RPL_ICMPV6_CODE_DAO, inst, opts, len, src, &included_opts)) {
         DEBUG("RPL: Error encountered during DAO option parsing - ignore DAO\n");
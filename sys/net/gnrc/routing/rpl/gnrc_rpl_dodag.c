@@ -24,8 +24,10 @@
 #include "net/gnrc/ipv6.h"
 #include "net/gnrc/netif/internal.h"
 #include "net/gnrc/rpl/dodag.h"
+#include "net/gnrc/rpl/routes.h"
 #include "net/gnrc/rpl/structs.h"
 #include "gnrc_rpl_internal/globals.h"
+#include "gnrc_rpl_internal/netstats.h"
 #include "utlist.h"
 
 #include "net/gnrc/rpl.h"
@@ -127,6 +129,8 @@ bool gnrc_rpl_instance_remove(gnrc_rpl_instance_t *inst)
     gnrc_rpl_p2p_ext_remove(dodag);
 #endif
     gnrc_rpl_dodag_remove_all_parents(dodag);
+    /* the downward routes were learned in the DODAG */
+    gnrc_rpl_routes_clear(&gnrc_rpl_routes);
     trickle_stop(&dodag->trickle);
     evtimer_del(&gnrc_rpl_evtimer, (evtimer_event_t *)&dodag->dao_event);
     evtimer_del(&gnrc_rpl_evtimer, (evtimer_event_t *)&inst->cleanup_event);
@@ -328,14 +332,26 @@ static gnrc_rpl_parent_t *_gnrc_rpl_find_preferred_parent(gnrc_rpl_dodag_t *doda
         return NULL;
     }
 
-    LL_SORT(dodag->parents, dodag->instance->of->parent_cmp);
+    if (dodag->instance->of->update_link_metric) {
+        LL_FOREACH(dodag->parents, elt) {
+            dodag->instance->of->update_link_metric(elt);
+        }
+    }
+
+    /* sort a copy of the list head, the objective function may need to know
+     * the current preferred parent while comparing */
     new_best = dodag->parents;
+    LL_SORT(new_best, dodag->instance->of->parent_cmp);
+    dodag->parents = new_best;
 
     if (new_best->rank == GNRC_RPL_INFINITE_RANK) {
         return NULL;
     }
 
     if (new_best != old_best) {
+#ifdef MODULE_NETSTATS_RPL
+        gnrc_rpl_netstats_parent_switch(&gnrc_rpl_netstats);
+#endif
         /* no-path DAOs only for the storing mode */
         if ((dodag->instance->mop == GNRC_RPL_MOP_STORING_MODE_NO_MC) ||
             (dodag->instance->mop == GNRC_RPL_MOP_STORING_MODE_MC)) {
@@ -180,6 +180,16 @@ static inline void gnrc_rpl_netstats_tx_DAO_ACK(netstats_rpl_t *netstats, size_t
     }
 }
 
+/**
+ * @brief   Increase statistics for changes of the preferred parent
+ *
+ * @param[in]   netstats    Pointer to netstats_rpl_t
+ */
+static inline void gnrc_rpl_netstats_parent_switch(netstats_rpl_t *netstats)
+{
+    netstats->parent_switches++;
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,179 @@
+/*
+ * Copyright (C) 2021 Gunar Schorcht
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc_rpl_mrhof
+ * @{
+ * @file
+ * @brief       Minimum Rank with Hysteresis Objective Function
+ *
+ * @author      Gunar Schorcht <gunar@schorcht.net>
+ * @}
+ */
+
+#include "net/gnrc/ipv6/nib/nc.h"
+#include "net/gnrc/netif.h"
+#include "net/gnrc/rpl.h"
+#include "net/gnrc/rpl/mrhof.h"
+#include "net/netstats/neighbor.h"
+
+#define ENABLE_DEBUG 0
+#include "debug.h"
+
+#define ETX_DEFAULT     (NETSTATS_NB_ETX_INIT * NETSTATS_NB_ETX_DIVISOR)
+
+static uint16_t calc_rank(gnrc_rpl_dodag_t *, uint16_t);
+static int parent_cmp(gnrc_rpl_parent_t *, gnrc_rpl_parent_t *);
+static gnrc_rpl_dodag_t *which_dodag(gnrc_rpl_dodag_t *, gnrc_rpl_dodag_t *);
+static void reset(gnrc_rpl_dodag_t *);
+static void update_link_metric(gnrc_rpl_parent_t *);
+
+static gnrc_rpl_of_t gnrc_rpl_mrhof = {
+    .ocp          = GNRC_RPL_OCP_MRHOF,
+    .calc_rank    = calc_rank,
+    .parent_cmp   = parent_cmp,
+    .which_dodag  = which_dodag,
+    .reset        = reset,
+    .parent_state_callback = NULL,
+    .init         = NULL,
+    .process_dio  = NULL,
+    .update_link_metric = update_link_metric
+};
+
+gnrc_rpl_of_t *gnrc_rpl_get_of_mrhof(void)
+{
+    return &gnrc_rpl_mrhof;
+}
+
+static uint16_t _link_metric(const gnrc_rpl_parent_t *parent)
+{
+    if (parent->link_metric_type != GNRC_RPL_METRIC_ETX) {
+        return ETX_DEFAULT;
+    }
+    return (uint16_t)parent->link_metric;
+}
+
+static uint32_t _path_cost(const gnrc_rpl_parent_t *parent)
+{
+    if (parent->rank == GNRC_RPL_INFINITE_RANK) {
+        return GNRC_RPL_INFINITE_RANK;
+    }
+
+    uint32_t cost = parent->rank + _link_metric(parent);
+    return (cost > CONFIG_GNRC_RPL_MRHOF_MAX_PATH_COST) ? GNRC_RPL_INFINITE_RANK
+                                                        : cost;
+}
+
+void reset(gnrc_rpl_dodag_t *dodag)
+{
+    /* Nothing to do in MRHOF */
+    (void)dodag;
+}
+
+uint16_t calc_rank(gnrc_rpl_dodag_t *dodag, uint16_t base_rank)
+{
+    uint16_t min_hop_rank_inc = CONFIG_GNRC_RPL_DEFAULT_MIN_HOP_RANK_INCREASE;
+    uint16_t link_metric = ETX_DEFAULT;
+
+    if (dodag->parents != NULL) {
+        min_hop_rank_inc = dodag->instance->min_hop_rank_inc;
+        link_metric = _link_metric(dodag->parents);
+    }
+
+    if (base_rank == 0) {
+        if (dodag->parents == NULL) {
+            return GNRC_RPL_INFINITE_RANK;
+        }
+
+        base_rank = dodag->parents->rank;
+    }
+
+    if (base_rank == GNRC_RPL_INFINITE_RANK) {
+        return GNRC_RPL_INFINITE_RANK;
+    }
+
+    /* the Rank has to increase at least by MinHopRankIncrease */
+    uint32_t rank = base_rank + ((link_metric > min_hop_rank_inc) ? link_metric
+                                                                  : min_hop_rank_inc);
+
+    if (rank > CONFIG_GNRC_RPL_MRHOF_MAX_PATH_COST) {
+        return GNRC_RPL_INFINITE_RANK;
+    }
+
+    return rank;
+}
+
+int parent_cmp(gnrc_rpl_parent_t *parent1, gnrc_rpl_parent_t *parent2)
+{
+    bool valid1 = _link_metric(parent1) <= CONFIG_GNRC_RPL_MRHOF_MAX_LINK_METRIC;
+    bool valid2 = _link_metric(parent2) <= CONFIG_GNRC_RPL_MRHOF_MAX_LINK_METRIC;
+
+    /* parents with a too high link metric are only used as last resort */
+    if (valid1 != valid2) {
+        return valid1 ? -1 : 1;
+    }
+
+    uint32_t cost1 = _path_cost(parent1);
+    uint32_t cost2 = _path_cost(parent2);
+
+    /* the preferred parent is the head of the list while it is sorted,
+     * hysteresis avoids that it changes on small differences */
+    if (cost1 != GNRC_RPL_INFINITE_RANK && parent1 == parent1->dodag->parents) {
+        cost1 -= (cost1 > CONFIG_GNRC_RPL_MRHOF_PARENT_SWITCH_THRESHOLD)
+                 ? CONFIG_GNRC_RPL_MRHOF_PARENT_SWITCH_THRESHOLD : cost1;
+    }
+    if (cost2 != GNRC_RPL_INFINITE_RANK && parent2 == parent2->dodag->parents) {
+        cost2 -= (cost2 > CONFIG_GNRC_RPL_MRHOF_PARENT_SWITCH_THRESHOLD)
+                 ? CONFIG_GNRC_RPL_MRHOF_PARENT_SWITCH_THRESHOLD : cost2;
+    }
+
+    if (cost1 < cost2) {
+        return -1;
+    }
+    else if (cost1 > cost2) {
+        return 1;
+    }
+    return 0;
+}
+
+void update_link_metric(gnrc_rpl_parent_t *parent)
+{
+    gnrc_netif_t *netif = gnrc_netif_get_by_pid(parent->dodag->iface);
+    gnrc_ipv6_nib_nc_t nce;
+    void *state = NULL;
+    netstats_nb_t stats;
+
+    parent->link_metric = ETX_DEFAULT;
+    parent->link_metric_type = GNRC_RPL_METRIC_ETX;
+
+    if (netif == NULL) {
+        return;
+    }
+
+    while (gnrc_ipv6_nib_nc_iter(netif->pid, &state, &nce)) {
+        if (ipv6_addr_equal(&nce.ipv6, &parent->addr)) {
+            if (netstats_nb_get(&netif->netif, nce.l2addr, nce.l2addr_len,
+                                &stats)) {
+                parent->link_metric = stats.etx;
+            }
+            break;
+        }
+    }
+
+    DEBUG("RPL: MRHOF ETX of parent %u.%02u\n",
+          (unsigned)parent->link_metric / NETSTATS_NB_ETX_DIVISOR,
+          ((unsigned)parent->link_metric % NETSTATS_NB_ETX_DIVISOR) * 100 /
+          NETSTATS_NB_ETX_DIVISOR);
+}
+
+/* Not used yet */
+gnrc_rpl_dodag_t *which_dodag(gnrc_rpl_dodag_t *d1, gnrc_rpl_dodag_t *d2)
+{
+    (void)d2;
+    return d1;
+}
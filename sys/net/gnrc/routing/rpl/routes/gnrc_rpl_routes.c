@@ -0,0 +1,364 @@
+/*
+ * Copyright (C) 2021 Gunar Schorcht
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc_rpl_routes
+ * @{
+ * @file
+ * @brief       RPL downward route table
+ *
+ * @author      Gunar Schorcht <gunar@schorcht.net>
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <string.h>
+
+#include "net/gnrc/ipv6/nib/ft.h"
+#include "net/gnrc/rpl.h"
+#include "net/gnrc/rpl/routes.h"
+
+#define ENABLE_DEBUG 0
+#include "debug.h"
+
+static char addr_str[IPV6_ADDR_MAX_STR_LEN];
+
+#define NEXT_HOP_NONE   (UINT8_MAX)
+
+gnrc_rpl_routes_t gnrc_rpl_routes;
+
+static inline bool _expired(uint32_t expires, uint32_t now)
+{
+    return (int32_t)(expires - now) <= 0;
+}
+
+static int _cmp(const ipv6_addr_t *a, uint8_t a_len,
+                const ipv6_addr_t *b, uint8_t b_len)
+{
+    int res = memcmp(a, b, sizeof(*a));
+    return (res) ? res : (int)a_len - (int)b_len;
+}
+
+/* binary search, returns true if the route exists, *idx is its index or the
+ * index at which it has to be inserted */
+static bool _find(const gnrc_rpl_routes_t *table, const ipv6_addr_t *target,
+                  uint8_t prefix_len, unsigned *idx)
+{
+    unsigned lo = 0;
+    unsigned hi = table->numof;
+
+    while (lo < hi) {
+        unsigned mid = (lo + hi) / 2;
+        const gnrc_rpl_route_t *route = &table->routes[mid];
+        int res = _cmp(&route->target, route->prefix_len, target, prefix_len);
+
+        if (res == 0) {
+            *idx = mid;
+            return true;
+        }
+        if (res < 0) {
+            lo = mid + 1;
+        }
+        else {
+            hi = mid;
+        }
+    }
+    *idx = lo;
+    return false;
+}
+
+static uint8_t _next_hop_get(gnrc_rpl_routes_t *table,
+                             const ipv6_addr_t *addr, unsigned iface)
+{
+    uint8_t free = NEXT_HOP_NONE;
+
+    for (unsigned i = 0; i < CONFIG_GNRC_RPL_ROUTES_NEXT_HOPS_NUMOF; i++) {
+        gnrc_rpl_route_next_hop_t *nh = &table->next_hops[i];
+        if (nh->refs == 0) {
+            if (free == NEXT_HOP_NONE) {
+                free = i;
+            }
+        }
+        else if ((nh->iface == iface) && ipv6_addr_equal(&nh->addr, addr)) {
+            return i;
+        }
+    }
+    if (free != NEXT_HOP_NONE) {
+        table->next_hops[free].addr = *addr;
+        table->next_hops[free].iface = iface;
+    }
+    return free;
+}
+
+static void _nib_set(const gnrc_rpl_routes_t *table, gnrc_rpl_route_t *route,
+                     uint32_t lifetime, uint32_t now)
+{
+    const gnrc_rpl_route_next_hop_t *nh = &table->next_hops[route->next_hop];
+    uint16_t nib_lifetime = (lifetime > UINT16_MAX) ? UINT16_MAX : lifetime;
+
+    DEBUG("RPL: installing route %s/%u\n",
+          ipv6_addr_to_str(addr_str, &route->target, sizeof(addr_str)),
+          route->prefix_len);
+
+    gnrc_ipv6_nib_ft_del(&route->target, route->prefix_len);
+    gnrc_ipv6_nib_ft_add(&route->target, route->prefix_len, &nh->addr,
+                         nh->iface, nib_lifetime);
+    route->nib_expires = now + nib_lifetime;
+}
+
+static void _remove(gnrc_rpl_routes_t *table, unsigned idx)
+{
+    gnrc_rpl_route_t *route = &table->routes[idx];
+
+    DEBUG("RPL: removing route %s/%u\n",
+          ipv6_addr_to_str(addr_str, &route->target, sizeof(addr_str)),
+          route->prefix_len);
+
+    gnrc_ipv6_nib_ft_del(&route->target, route->prefix_len);
+    table->next_hops[route->next_hop].refs--;
+
+    table->numof--;
+    memmove(route, route + 1, (table->numof - idx) * sizeof(*route));
+}
+
+static bool _covered(const gnrc_rpl_routes_t *table, const ipv6_addr_t *target,
+                     uint8_t prefix_len)
+{
+    return (table->aggr_prefix_len > 0) &&
+           (prefix_len >= table->aggr_prefix_len) &&
+           (ipv6_addr_match_prefix(target, &table->aggr_prefix) >=
+            table->aggr_prefix_len);
+}
+
+static size_t _target_put(uint8_t *buf, const ipv6_addr_t *target,
+                          uint8_t prefix_len)
+{
+    gnrc_rpl_opt_target_t *opt = (gnrc_rpl_opt_target_t *)buf;
+    unsigned bytes = (prefix_len + 7) / 8;
+
+    opt->type = GNRC_RPL_OPT_TARGET;
+    opt->length = sizeof(opt->flags) + sizeof(opt->prefix_length) + bytes;
+    opt->flags = 0;
+    opt->prefix_length = prefix_len;
+    memcpy(&opt->target, target, bytes);
+    if (prefix_len % 8) {
+        /* bits after the prefix are reserved */
+        opt->target.u8[bytes - 1] &= 0xff << (8 - (prefix_len % 8));
+    }
+    return sizeof(gnrc_rpl_opt_t) + opt->length;
+}
+
+void gnrc_rpl_routes_init(gnrc_rpl_routes_t *table)
+{
+    memset(table, 0, sizeof(*table));
+}
+
+void gnrc_rpl_routes_clear(gnrc_rpl_routes_t *table)
+{
+    while (table->numof) {
+        _remove(table, table->numof - 1);
+    }
+    gnrc_rpl_routes_init(table);
+}
+
+unsigned gnrc_rpl_routes_update(gnrc_rpl_routes_t *table,
+                                const gnrc_rpl_routes_target_t *targets,
+                                unsigned numof, const ipv6_addr_t *next_hop,
+                                unsigned iface, uint32_t lifetime,
+                                uint32_t now)
+{
+    unsigned updated = 0;
+
+    for (unsigned i = 0; i < numof; i++) {
+        const gnrc_rpl_routes_target_t *target = &targets[i];
+        gnrc_rpl_route_t *route;
+        unsigned idx;
+        bool found = _find(table, &target->prefix, target->prefix_len, &idx);
+
+        if (lifetime == 0) {
+            /* No-Path DAO, only the child that owns the route can remove it */
+            if (found) {
+                route = &table->routes[idx];
+                const gnrc_rpl_route_next_hop_t *nh =
+                    &table->next_hops[route->next_hop];
+                if ((nh->iface == iface) &&
+                    ipv6_addr_equal(&nh->addr, next_hop)) {
+                    _remove(table, idx);
+                    updated++;
+                }
+            }
+            continue;
+        }
+
+        uint8_t nh = _next_hop_get(table, next_hop, iface);
+        if (nh == NEXT_HOP_NONE) {
+            DEBUG("RPL: no space left for next hop\n");
+            continue;
+        }
+
+        bool changed = true;
+        if (found) {
+            route = &table->routes[idx];
+            changed = (route->next_hop != nh);
+            table->next_hops[route->next_hop].refs--;
+        }
+        else {
+            if (table->numof == CONFIG_GNRC_RPL_ROUTES_NUMOF) {
+                DEBUG("RPL: no space left for route\n");
+                continue;
+            }
+            route = &table->routes[idx];
+            memmove(route + 1, route, (table->numof - idx) * sizeof(*route));
+            table->numof++;
+            route->target = target->prefix;
+            route->prefix_len = target->prefix_len;
+        }
+        route->next_hop = nh;
+        table->next_hops[nh].refs++;
+        route->expires = now + lifetime;
+
+        /* the NIB is only updated if the route changed or the NIB entry
+         * would expire soon */
+        if (changed || ((int32_t)(route->nib_expires - now) <
+                        (int32_t)(lifetime / 2))) {
+            _nib_set(table, route, lifetime, now);
+        }
+        updated++;
+    }
+
+    return updated;
+}
+
+const gnrc_rpl_route_t *gnrc_rpl_routes_lookup(const gnrc_rpl_routes_t *table,
+                                               const ipv6_addr_t *dst,
+                                               uint32_t now)
+{
+    const gnrc_rpl_route_t *best = NULL;
+    unsigned idx;
+
+    /* most routes are host routes */
+    if (_find(table, dst, IPV6_ADDR_BIT_LEN, &idx) &&
+        !_expired(table->routes[idx].expires, now)) {
+        return &table->routes[idx];
+    }
+
+    for (unsigned i = 0; i < table->numof; i++) {
+        const gnrc_rpl_route_t *route = &table->routes[i];
+        if ((route->prefix_len < IPV6_ADDR_BIT_LEN) &&
+            (!best || (route->prefix_len > best->prefix_len)) &&
+            !_expired(route->expires, now) &&
+            (ipv6_addr_match_prefix(&route->target, dst) >=
+             route->prefix_len)) {
+            best = route;
+        }
+    }
+    return best;
+}
+
+void gnrc_rpl_routes_expire(gnrc_rpl_routes_t *table, uint32_t now)
+{
+    unsigned i = 0;
+
+    while (i < table->numof) {
+        if (_expired(table->routes[i].expires, now)) {
+            _remove(table, i);
+        }
+        else {
+            i++;
+        }
+    }
+}
+
+void gnrc_rpl_routes_aggregate(gnrc_rpl_routes_t *table,
+                               const ipv6_addr_t *prefix, uint8_t prefix_len)
+{
+    if (prefix == NULL) {
+        table->aggr_prefix_len = 0;
+        return;
+    }
+    assert(prefix_len <= IPV6_ADDR_BIT_LEN);
+    ipv6_addr_init_prefix(&table->aggr_prefix, prefix, prefix_len);
+    table->aggr_prefix_len = prefix_len;
+}
+
+size_t gnrc_rpl_routes_dao_targets(const gnrc_rpl_routes_t *table,
+                                   const ipv6_addr_t *own, unsigned *pos,
+                                   uint8_t *buf, size_t len, uint32_t now)
+{
+    size_t off = 0;
+    unsigned numof = 0;
+
+    while (numof < CONFIG_GNRC_RPL_DAO_TARGETS_MAX) {
+        const ipv6_addr_t *target;
+        uint8_t prefix_len;
+
+        if (*pos == 0) {
+            (*pos)++;
+            if (table->aggr_prefix_len == 0) {
+                continue;
+            }
+            target = &table->aggr_prefix;
+            prefix_len = table->aggr_prefix_len;
+        }
+        else if (*pos == 1) {
+            (*pos)++;
+            if (_covered(table, own, IPV6_ADDR_BIT_LEN)) {
+                continue;
+            }
+            target = own;
+            prefix_len = IPV6_ADDR_BIT_LEN;
+        }
+        else if ((*pos - 2) < table->numof) {
+            const gnrc_rpl_route_t *route = &table->routes[*pos - 2];
+            (*pos)++;
+            if (_expired(route->expires, now) ||
+                _covered(table, &route->target, route->prefix_len)) {
+                continue;
+            }
+            target = &route->target;
+            prefix_len = route->prefix_len;
+        }
+        else {
+            break;
+        }
+
+        if ((off + sizeof(gnrc_rpl_opt_t) + 2 + (prefix_len + 7) / 8) > len) {
+            /* the target is encoded in the next DAO */
+            (*pos)--;
+            break;
+        }
+        off += _target_put(buf + off, target, prefix_len);
+        numof++;
+    }
+
+    return off;
+}
+
+int gnrc_rpl_routes_target_get(const gnrc_rpl_opt_target_t *opt,
+                               gnrc_rpl_routes_target_t *target)
+{
+    unsigned bytes = (opt->prefix_length + 7) / 8;
+
+    if ((opt->prefix_length > IPV6_ADDR_BIT_LEN) ||
+        (opt->length < (sizeof(opt->flags) + sizeof(opt->prefix_length) +
+                        bytes))) {
+        return -EINVAL;
+    }
+    ipv6_addr_set_unspecified(&target->prefix);
+    memcpy(&target->prefix, &opt->target, bytes);
+    if (opt->prefix_length % 8) {
+        target->prefix.u8[bytes - 1] &= 0xff << (8 - (opt->prefix_length % 8));
+    }
+    target->prefix_len = opt->prefix_length;
+
+    return 0;
+}
+
+/**
+ * @}
+ */
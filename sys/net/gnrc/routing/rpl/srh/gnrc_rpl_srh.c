@@ -28,8 +28,88 @@
 #define GNRC_RPL_SRH_COMPRE(X)      (X & 0x0F)
 #define GNRC_RPL_SRH_COMPRI(X)      ((X & 0xF0) >> 4)
 
+/* maximum number of own addresses that are compared with the addresses of
+ * the source routing header without a look-up on all interfaces */
+#define OWN_ADDRS_MAX               (CONFIG_GNRC_NETIF_IPV6_ADDRS_NUMOF + \
+                                     GNRC_NETIF_IPV6_GROUPS_NUMOF)
+
 static char addr_str[IPV6_ADDR_MAX_STR_LEN];
 
+typedef struct {
+    const ipv6_addr_t *addrs[OWN_ADDRS_MAX];    /**< own addresses */
+    uint8_t match[OWN_ADDRS_MAX];   /**< bytes in common with the destination */
+    uint8_t numof;                  /**< number of own addresses */
+    bool complete;                  /**< all own addresses are in addrs */
+} _own_addrs_t;
+
+static unsigned _match_bytes(const ipv6_addr_t *a, const ipv6_addr_t *b,
+                             unsigned max)
+{
+    unsigned i = 0;
+
+    while ((i < max) && (a->u8[i] == b->u8[i])) {
+        i++;
+    }
+    return i;
+}
+
+/* collects the own addresses that share at least min_elided bytes with the
+ * destination, only these can be in the source routing header */
+static void _own_addrs_init(_own_addrs_t *own, const ipv6_addr_t *dst,
+                            unsigned min_elided)
+{
+    gnrc_netif_t *netif = NULL;
+
+    own->numof = 0;
+    own->complete = true;
+    while ((netif = gnrc_netif_iter(netif))) {
+        for (unsigned i = 0; i < OWN_ADDRS_MAX; i++) {
+            const ipv6_addr_t *addr = (i < CONFIG_GNRC_NETIF_IPV6_ADDRS_NUMOF)
+                ? &netif->ipv6.addrs[i]
+                : &netif->ipv6.groups[i - CONFIG_GNRC_NETIF_IPV6_ADDRS_NUMOF];
+            unsigned match = _match_bytes(addr, dst, sizeof(ipv6_addr_t));
+
+            if ((match < min_elided) || ipv6_addr_is_unspecified(addr)) {
+                continue;
+            }
+            if (own->numof == OWN_ADDRS_MAX) {
+                own->complete = false;
+                return;
+            }
+            own->addrs[own->numof] = addr;
+            own->match[own->numof] = match;
+            own->numof++;
+        }
+    }
+}
+
+static bool _is_my_addr(const _own_addrs_t *own, const ipv6_addr_t *dst,
+                        const uint8_t *addr_vec_ptr, uint8_t pref_elided)
+{
+    uint8_t addr_len = sizeof(ipv6_addr_t) - pref_elided;
+
+    if (!own->complete) {
+        ipv6_addr_t addr;
+
+        memcpy(&addr, dst, pref_elided);
+        memcpy(&addr.u8[pref_elided], addr_vec_ptr, addr_len);
+        return gnrc_netif_get_by_ipv6_addr(&addr) != NULL;
+    }
+    for (unsigned i = 0; i < own->numof; i++) {
+        /* the elided prefix is the one of the destination, so only the
+         * inline bytes have to be compared, the last byte differs most
+         * likely */
+        if ((own->match[i] >= pref_elided) &&
+            (own->addrs[i]->u8[sizeof(ipv6_addr_t) - 1] ==
+             addr_vec_ptr[addr_len - 1]) &&
+            (memcmp(&own->addrs[i]->u8[pref_elided], addr_vec_ptr,
+                    addr_len) == 0)) {
+            return true;
+        }
+    }
+    return false;
+}
+
 /* checks if multiple addresses within the source routing header exist on my
  * interfaces */
 static void *_contains_multiple_of_my_addr(const ipv6_addr_t *dst,
@@ -37,23 +117,25 @@ static void *_contains_multiple_of_my_addr(const ipv6_addr_t *dst,
                                            unsigned num_addr,
                                            unsigned compri_addr_len)
 {
-    ipv6_addr_t addr;
+    _own_addrs_t own;
     uint8_t *addr_vec = (uint8_t *) (rh + 1);
     bool found = false;
     uint8_t pref_elided = GNRC_RPL_SRH_COMPRI(rh->compr);
-    uint8_t addr_len = compri_addr_len;
     uint8_t found_pos = 0;
 
-    memcpy(&addr, dst, pref_elided);
+    _own_addrs_init(&own, dst, (pref_elided < GNRC_RPL_SRH_COMPRE(rh->compr))
+                               ? pref_elided : GNRC_RPL_SRH_COMPRE(rh->compr));
+    if (own.complete && (own.numof == 0)) {
+        return NULL;
+    }
+
     for (unsigned i = 0; i < num_addr; i++) {
         uint8_t *addr_vec_ptr = &addr_vec[i * compri_addr_len];
 
         if (i == num_addr - 1) {
             pref_elided = GNRC_RPL_SRH_COMPRE(rh->compr);
-            addr_len = sizeof(ipv6_addr_t) - pref_elided;
         }
-        memcpy(&addr.u8[pref_elided], addr_vec_ptr, addr_len);
-        if (gnrc_netif_get_by_ipv6_addr(&addr) != NULL) {
+        if (_is_my_addr(&own, dst, addr_vec_ptr, pref_elided)) {
             if (found && ((i - found_pos) > 1)) {
                 DEBUG("RPL SRH: found multiple addresses that belong to me - "
                       "discard\n");
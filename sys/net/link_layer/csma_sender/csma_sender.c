@@ -22,6 +22,7 @@
 #include <errno.h>
 #include <stdbool.h>
 #include <inttypes.h>
+#include <string.h>
 
 #include "xtimer.h"
 #include "random.h"
@@ -53,15 +54,12 @@ const csma_sender_conf_t CSMA_SENDER_CONF_DEFAULT = {
 static inline uint32_t choose_backoff_period(int be,
                                              const csma_sender_conf_t *conf)
 {
-    if (be < conf->min_be) {
-        be = conf->min_be;
-    }
     if (be > conf->max_be) {
         be = conf->max_be;
     }
     uint32_t max_backoff = ((1 << be) - 1) * CONFIG_CSMA_SENDER_BACKOFF_PERIOD_UNIT;
 
-    uint32_t period = random_uint32() % max_backoff;
+    uint32_t period = max_backoff ? random_uint32() % max_backoff : 0;
     if (period < CONFIG_CSMA_SENDER_BACKOFF_PERIOD_UNIT) {
         period = CONFIG_CSMA_SENDER_BACKOFF_PERIOD_UNIT;
     }
@@ -75,6 +73,8 @@ static inline uint32_t choose_backoff_period(int be,
  *
  * @param[in] device    netdev device, needs to be already initialized
  * @param[in] iolist    pointer to the data
+ * @param[in] state     state of the adaptive CSMA/CA that records the
+ *                      result of the CCA, may be NULL
  *
  * @return              the return value of device driver's
  *                      netdev_driver_t::send() function if medium was
@@ -83,7 +83,8 @@ static inline uint32_t choose_backoff_period(int be,
  * @return              -EBUSY if radio medium was not available
  *                      to send the given data
  */
-static int send_if_cca(netdev_t *device, iolist_t *iolist)
+static int send_if_cca(netdev_t *device, iolist_t *iolist,
+                       csma_sender_adaptive_t *state)
 {
     netopt_enable_t hwfeat;
 
@@ -99,6 +100,10 @@ static int send_if_cca(netdev_t *device, iolist_t *iolist)
         return -ECANCELED;
     }
 
+    if (state) {
+        csma_sender_adaptive_cca(state, hwfeat != NETOPT_ENABLE);
+    }
+
     /* if medium is clear, send the packet and return */
     if (hwfeat == NETOPT_ENABLE) {
         DEBUG("csma: Radio medium available: sending packet.\n");
@@ -110,24 +115,25 @@ static int send_if_cca(netdev_t *device, iolist_t *iolist)
     return -EBUSY;
 }
 
-/*------------------------- "EXPORTED" FUNCTIONS -------------------------*/
-
-int csma_sender_csma_ca_send(netdev_t *dev, iolist_t *iolist,
-                             const csma_sender_conf_t *conf)
+/**
+ * @brief Check whether the transceiver does CSMA/CA by itself
+ *
+ * @param[in] dev       netdev device, needs to be already initialized
+ *
+ * @return              1 if the device does hardware CSMA/CA
+ * @return              0 if CSMA/CA has to be done in software
+ * @return              -ENODEV if @p dev is invalid
+ * @return              -ECANCELED if an internal driver error occurred
+ */
+static int hw_csma(netdev_t *dev)
 {
     netopt_enable_t hwfeat;
 
-    assert(dev);
-    /* choose default configuration if none is given */
-    if (conf == NULL) {
-        conf = &CSMA_SENDER_CONF_DEFAULT;
-    }
     /* Does the transceiver do automatic CSMA/CA when sending? */
     int res = dev->driver->get(dev,
                                NETOPT_CSMA,
                                (void *) &hwfeat,
                                sizeof(netopt_enable_t));
-    bool ok = false;
 
     switch (res) {
         case -ENODEV:
@@ -135,36 +141,44 @@ int csma_sender_csma_ca_send(netdev_t *dev, iolist_t *iolist,
             return -ENODEV;
         case -ENOTSUP:
             /* device doesn't make auto-CSMA/CA */
-            break;
+            return 0;
         case -EOVERFLOW: /* (normally impossible...*/
         case -ECANCELED:
             DEBUG("csma: !!! DEVICE DRIVER FAILURE! TRANSMISSION ABORTED!\n");
             /* internal driver error! */
             return -ECANCELED;
         default:
-            ok = (hwfeat == NETOPT_ENABLE);
-    }
-
-    if (ok) {
-        /* device does CSMA/CA all by itself: let it do its job */
-        DEBUG("csma: Network device does hardware CSMA/CA\n");
-        return dev->driver->send(dev, iolist);
+            return (hwfeat == NETOPT_ENABLE);
     }
+}
 
-    /* if we arrive here, then we must perform the CSMA/CA procedure
-       ourselves by software */
-    random_init(_xtimer_now());
+/**
+ * @brief Perform the CSMA/CA procedure by software
+ *
+ * @param[in] dev       netdev device, needs to be already initialized
+ * @param[in] iolist    pointer to the data
+ * @param[in] conf      configuration for the backoff
+ * @param[in] state     state of the adaptive CSMA/CA, NULL for the fixed
+ *                      backoff exponents of @p conf
+ *
+ * @return              see @ref csma_sender_csma_ca_send
+ */
+static int sw_csma_ca(netdev_t *dev, iolist_t *iolist,
+                      const csma_sender_conf_t *conf,
+                      csma_sender_adaptive_t *state)
+{
     DEBUG("csma: Starting software CSMA/CA....\n");
 
-    int nb = 0, be = conf->min_be;
+    int nb = 0;
+    int be = state ? csma_sender_adaptive_be(state) : conf->min_be;
 
-    while (nb <= conf->max_be) {
+    while (nb <= conf->max_backoffs) {
         /* delay for an adequate random backoff period */
         uint32_t bp = choose_backoff_period(be, conf);
         xtimer_usleep(bp);
 
         /* try to send after a CCA */
-        res = send_if_cca(dev, iolist);
+        int res = send_if_cca(dev, iolist, state);
         if (res >= 0) {
             /* TX done */
             return res;
@@ -186,9 +200,102 @@ int csma_sender_csma_ca_send(netdev_t *dev, iolist_t *iolist,
 
     /* if we arrive here, medium was never available for transmission */
     DEBUG("csma: Software CSMA/CA failure: medium never available.\n");
+    if (state) {
+        state->stats.fail++;
+    }
     return -EBUSY;
 }
 
+/* updates a moving average with a new sample */
+static uint16_t _ewma(uint16_t avg, bool sample)
+{
+    int32_t diff = (sample ? CSMA_SENDER_ADAPTIVE_RATIO_ONE : 0) - (int32_t)avg;
+
+    return avg + diff / (1 << CONFIG_CSMA_SENDER_ADAPTIVE_WEIGHT_EXP);
+}
+
+/*------------------------- "EXPORTED" FUNCTIONS -------------------------*/
+
+int csma_sender_csma_ca_send(netdev_t *dev, iolist_t *iolist,
+                             const csma_sender_conf_t *conf)
+{
+    assert(dev);
+    /* choose default configuration if none is given */
+    if (conf == NULL) {
+        conf = &CSMA_SENDER_CONF_DEFAULT;
+    }
+
+    int res = hw_csma(dev);
+    if (res < 0) {
+        return res;
+    }
+    if (res) {
+        /* device does CSMA/CA all by itself: let it do its job */
+        DEBUG("csma: Network device does hardware CSMA/CA\n");
+        return dev->driver->send(dev, iolist);
+    }
+
+    /* if we arrive here, then we must perform the CSMA/CA procedure
+       ourselves by software */
+    return sw_csma_ca(dev, iolist, conf, NULL);
+}
+
+void csma_sender_adaptive_init(csma_sender_adaptive_t *state,
+                               const csma_sender_conf_t *conf)
+{
+    memset(state, 0, sizeof(*state));
+    state->conf = conf ? conf : &CSMA_SENDER_CONF_DEFAULT;
+}
+
+int csma_sender_csma_ca_send_adaptive(netdev_t *dev, iolist_t *iolist,
+                                      csma_sender_adaptive_t *state)
+{
+    assert(dev && state);
+
+    int res = hw_csma(dev);
+    if (res < 0) {
+        return res;
+    }
+    if (res) {
+        /* device does CSMA/CA all by itself: let it do its job */
+        DEBUG("csma: Network device does hardware CSMA/CA\n");
+        return dev->driver->send(dev, iolist);
+    }
+
+    return sw_csma_ca(dev, iolist, state->conf, state);
+}
+
+uint8_t csma_sender_adaptive_be(const csma_sender_adaptive_t *state)
+{
+    unsigned min = CONFIG_CSMA_SENDER_ADAPTIVE_MIN_BE;
+    unsigned max = state->conf->max_be;
+    uint32_t load = (state->busy > state->noack) ? state->busy : state->noack;
+
+    if (min >= max) {
+        return max;
+    }
+    /* rounded linear interpolation between min and max */
+    return min + ((max - min) * load + CSMA_SENDER_ADAPTIVE_RATIO_ONE / 2) /
+                 CSMA_SENDER_ADAPTIVE_RATIO_ONE;
+}
+
+void csma_sender_adaptive_cca(csma_sender_adaptive_t *state, bool busy)
+{
+    state->stats.cca++;
+    state->stats.cca_busy += busy;
+    state->busy = _ewma(state->busy, busy);
+}
+
+void csma_sender_adaptive_tx_done(csma_sender_adaptive_t *state, bool acked)
+{
+    if (acked) {
+        state->stats.tx_acked++;
+    }
+    else {
+        state->stats.tx_noack++;
+    }
+    state->noack = _ewma(state->noack, !acked);
+}
 
 int csma_sender_cca_send(netdev_t *dev, iolist_t *iolist)
 {
@@ -226,7 +333,7 @@ int csma_sender_cca_send(netdev_t *dev, iolist_t *iolist)
 
     /* if we arrive here, we must do CCA ourselves to see if radio medium
        is clear before sending */
-    res = send_if_cca(dev, iolist);
+    res = send_if_cca(dev, iolist, NULL);
     if (res == -EBUSY) {
         DEBUG("csma: Transmission cancelled!\n");
     }
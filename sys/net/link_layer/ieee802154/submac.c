@@ -38,6 +38,17 @@ static void _tx_end(ieee802154_submac_t *submac, int status,
 
     submac->wait_for_ack = false;
     submac->tx = false;
+
+    if (submac->burst_tx) {
+        if (status == TX_STATUS_SUCCESS || status == TX_STATUS_FRAME_PENDING) {
+            submac->burst = submac->burst_more;
+        }
+        else {
+            submac->burst = false;
+            submac->burst_stats.aborted++;
+        }
+    }
+
     while (ieee802154_radio_confirm_set_trx_state(dev) == -EAGAIN) {}
     submac->cb->tx_done(submac, status, info);
 }
@@ -48,6 +59,16 @@ static inline bool _does_handle_ack(ieee802154_dev_t *dev)
            ieee802154_radio_has_irq_ack_timeout(dev);
 }
 
+static void _backoff_next(ieee802154_submac_t *submac)
+{
+    if (submac->backoff_mask + 1 < submac->be.max) {
+        submac->backoff_mask = (submac->backoff_mask << 1) | 1;
+    }
+    else {
+        submac->backoff_mask = (1 << submac->be.max) - 1;
+    }
+}
+
 static int _perform_csma_ca(ieee802154_submac_t *submac)
 {
     ieee802154_dev_t *dev = submac->dev;
@@ -66,12 +87,7 @@ static int _perform_csma_ca(ieee802154_submac_t *submac)
         while (ieee802154_radio_request_transmit(dev) == -EBUSY) {}
 
         /* Prepare for next iteration */
-        if (submac->backoff_mask + 1 < submac->be.max) {
-            submac->backoff_mask = (submac->backoff_mask << 1) | 1;
-        }
-        else {
-            submac->backoff_mask = (1 << submac->be.max) - 1;
-        }
+        _backoff_next(submac);
 
         submac->csma_retries_nb++;
     }
@@ -113,7 +129,17 @@ int ieee802154_csma_ca_transmit(ieee802154_submac_t *submac)
     }
     else {
         submac->csma_retries_nb = 0;
-        submac->backoff_mask = (1 << submac->be.min) - 1;
+        /* the previous frame of the burst was sent after a successful CCA,
+         * don't backoff as long for the following one unless it's a
+         * retransmission */
+        submac->burst_fast = submac->burst && (submac->retrans == 0);
+        if (submac->burst_fast) {
+            submac->backoff_mask = (1 << CONFIG_IEEE802154_SUBMAC_BURST_BE) - 1;
+            submac->burst_stats.fast++;
+        }
+        else {
+            submac->backoff_mask = (1 << submac->be.min) - 1;
+        }
         _perform_csma_ca(submac);
     }
 
@@ -233,7 +259,14 @@ static void _handle_tx_medium_busy(ieee802154_submac_t *submac)
         _tx_end(submac, TX_STATUS_MEDIUM_BUSY, NULL);
     }
     else {
-        /* CCA failed. Continue with the CSMA-CA algorithm */
+        /* CCA failed. Continue with the CSMA-CA algorithm, a frame of a
+         * burst continues with the backoff a regular frame has after its
+         * first failed CCA since the channel is used by others */
+        if (submac->burst_fast) {
+            submac->burst_fast = false;
+            submac->backoff_mask = (1 << submac->be.min) - 1;
+            _backoff_next(submac);
+        }
         _perform_csma_ca(submac);
     }
 }
@@ -276,7 +309,8 @@ void ieee802154_submac_tx_done_cb(ieee802154_submac_t *submac)
     }
 }
 
-int ieee802154_send(ieee802154_submac_t *submac, const iolist_t *iolist)
+static int _send(ieee802154_submac_t *submac, const iolist_t *iolist,
+                 bool burst, bool more)
 {
     ieee802154_dev_t *dev = submac->dev;
 
@@ -295,6 +329,24 @@ int ieee802154_send(ieee802154_submac_t *submac, const iolist_t *iolist)
 
     submac->tx = true;
 
+    if (burst) {
+        if (more) {
+            buf[0] |= IEEE802154_FCF_FRAME_PEND;
+        }
+        else {
+            buf[0] &= ~IEEE802154_FCF_FRAME_PEND;
+        }
+        if (!submac->burst) {
+            submac->burst_stats.bursts++;
+        }
+        submac->burst_stats.frames++;
+    }
+    else {
+        submac->burst = false;
+    }
+    submac->burst_tx = burst;
+    submac->burst_more = more;
+
     ieee802154_radio_write(dev, iolist);
     while (ieee802154_radio_confirm_set_trx_state(dev) == -EAGAIN) {}
 
@@ -305,12 +357,27 @@ int ieee802154_send(ieee802154_submac_t *submac, const iolist_t *iolist)
     return 0;
 }
 
+int ieee802154_send(ieee802154_submac_t *submac, const iolist_t *iolist)
+{
+    return _send(submac, iolist, false, false);
+}
+
+int ieee802154_send_burst(ieee802154_submac_t *submac, const iolist_t *iolist,
+                          bool more)
+{
+    return _send(submac, iolist, true, more);
+}
+
 int ieee802154_submac_init(ieee802154_submac_t *submac, const network_uint16_t *short_addr,
                            const eui64_t *ext_addr)
 {
     ieee802154_dev_t *dev = submac->dev;
 
     submac->tx = false;
+    submac->burst_tx = false;
+    submac->burst = false;
+    submac->burst_fast = false;
+    memset(&submac->burst_stats, 0, sizeof(submac->burst_stats));
     submac->state = IEEE802154_STATE_LISTEN;
 
     ieee802154_radio_request_on(dev);
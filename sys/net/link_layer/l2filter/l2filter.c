@@ -26,81 +26,184 @@
 #define ENABLE_DEBUG 0
 #include "debug.h"
 
-static inline bool match(const l2filter_t *filter,
+/* empty entries are sorted to the end of the list */
+static int _cmp(const l2filter_t *entry, const void *addr, size_t addr_len)
+{
+    if (entry->addr_len == 0) {
+        return 1;
+    }
+    if (entry->addr_len != addr_len) {
+        return (entry->addr_len < addr_len) ? -1 : 1;
+    }
+    return memcmp(entry->addr, addr, addr_len);
+}
+
+/* position of the first entry that is not less than addr */
+static unsigned _lower_bound(const l2filter_t *list,
+                             const void *addr, size_t addr_len)
+{
+    unsigned lo = 0;
+    unsigned hi = CONFIG_L2FILTER_LISTSIZE;
+
+    while (lo < hi) {
+        unsigned mid = (lo + hi) / 2;
+        if (_cmp(&list[mid], addr, addr_len) < 0) {
+            lo = mid + 1;
+        }
+        else {
+            hi = mid;
+        }
+    }
+
+    return lo;
+}
+
+static bool _find(const l2filter_t *list, const void *addr, size_t addr_len,
+                  unsigned *pos)
+{
+    *pos = _lower_bound(list, addr, addr_len);
+
+    return (*pos < CONFIG_L2FILTER_LISTSIZE) &&
+           (_cmp(&list[*pos], addr, addr_len) == 0);
+}
+
+#ifdef MODULE_L2FILTER_BLOOM
+static void _bloom_add(l2filter_list_t *list, const void *addr, size_t addr_len)
+{
+    /* a list that is initialized with zeros has no Bloom filter yet */
+    if (list->bloom.a == NULL) {
+        bloom_blocked_init(&list->bloom, list->bloom_blocks,
+                           L2FILTER_BLOOM_BLOCKS, CONFIG_L2FILTER_BLOOM_HASHES);
+    }
+    bloom_blocked_add(&list->bloom, addr, addr_len);
+}
+
+static bool _bloom_check(const l2filter_list_t *list,
                          const void *addr, size_t addr_len)
 {
-    return ((filter->addr_len == addr_len) &&
-            (memcmp(filter->addr, addr, addr_len) == 0));
+    return (list->bloom.a == NULL) ||
+           bloom_blocked_check(&list->bloom, addr, addr_len);
+}
+
+/* bits can't be removed from a Bloom filter, so it is rebuilt */
+static void _bloom_rebuild(l2filter_list_t *list)
+{
+    bloom_blocked_init(&list->bloom, list->bloom_blocks,
+                       L2FILTER_BLOOM_BLOCKS, CONFIG_L2FILTER_BLOOM_HASHES);
+    for (unsigned i = 0; (i < CONFIG_L2FILTER_LISTSIZE) &&
+                         list->entries[i].addr_len; i++) {
+        bloom_blocked_add(&list->bloom, list->entries[i].addr,
+                          list->entries[i].addr_len);
+    }
+}
+#else
+static inline void _bloom_add(l2filter_list_t *list, const void *addr,
+                              size_t addr_len)
+{
+    (void)list;
+    (void)addr;
+    (void)addr_len;
 }
 
-void l2filter_init(l2filter_t *list)
+static inline bool _bloom_check(const l2filter_list_t *list,
+                                const void *addr, size_t addr_len)
+{
+    (void)list;
+    (void)addr;
+    (void)addr_len;
+    return true;
+}
+
+static inline void _bloom_rebuild(l2filter_list_t *list)
+{
+    (void)list;
+}
+#endif
+
+void l2filter_init(l2filter_list_t *list)
 {
     assert(list);
 
     for (unsigned i = 0; i < CONFIG_L2FILTER_LISTSIZE; i++) {
-        list[i].addr_len = 0;
+        list->entries[i].addr_len = 0;
     }
+    _bloom_rebuild(list);
 }
 
-int l2filter_add(l2filter_t *list, const void *addr, size_t addr_len)
+int l2filter_add(l2filter_list_t *list, const void *addr, size_t addr_len)
 {
     assert(list && addr && (addr_len <= CONFIG_L2FILTER_ADDR_MAXLEN));
 
-    int res = -ENOMEM;
+    l2filter_t *entries = list->entries;
 
-    for (unsigned i = 0; i < CONFIG_L2FILTER_LISTSIZE; i++) {
-        if (list[i].addr_len == 0) {
-            list[i].addr_len = addr_len;
-            memcpy(list[i].addr, addr, addr_len);
-            res = 0;
-            break;
+    /* an entry with length 0 is an empty entry */
+    if (addr_len == 0) {
+        return -EINVAL;
+    }
+    /* the empty entries are at the end */
+    if (entries[CONFIG_L2FILTER_LISTSIZE - 1].addr_len != 0) {
+        return -ENOMEM;
+    }
+
+    unsigned pos = _lower_bound(entries, addr, addr_len);
+    for (unsigned i = CONFIG_L2FILTER_LISTSIZE - 1; i > pos; i--) {
+        if (entries[i - 1].addr_len) {
+            entries[i] = entries[i - 1];
         }
     }
+    entries[pos].addr_len = addr_len;
+    memcpy(entries[pos].addr, addr, addr_len);
+    _bloom_add(list, addr, addr_len);
 
-    return res;
+    return 0;
 }
 
-int l2filter_rm(l2filter_t *list, const void *addr, size_t addr_len)
+int l2filter_rm(l2filter_list_t *list, const void *addr, size_t addr_len)
 {
     assert(list && addr && (addr_len <= CONFIG_L2FILTER_ADDR_MAXLEN));
 
-    int res = -ENOENT;
+    l2filter_t *entries = list->entries;
+    unsigned pos;
 
-    for (unsigned i = 0; i < CONFIG_L2FILTER_LISTSIZE; i++) {
-        if (match(&list[i], addr, addr_len)) {
-            list[i].addr_len = 0;
-            res = 0;
-            break;
-        }
+    if (!_find(entries, addr, addr_len, &pos)) {
+        return -ENOENT;
     }
 
-    return res;
+    for (; (pos < CONFIG_L2FILTER_LISTSIZE - 1) && entries[pos + 1].addr_len;
+         pos++) {
+        entries[pos] = entries[pos + 1];
+    }
+    entries[pos].addr_len = 0;
+    _bloom_rebuild(list);
+
+    return 0;
 }
 
-bool l2filter_pass(const l2filter_t *list, const void *addr, size_t addr_len)
+bool l2filter_pass(const l2filter_list_t *list, const void *addr,
+                   size_t addr_len)
 {
     assert(list && addr && (addr_len <= CONFIG_L2FILTER_ADDR_MAXLEN));
 
+    unsigned pos;
+    bool listed = _bloom_check(list, addr, addr_len) &&
+                  _find(list->entries, addr, addr_len, &pos);
+
 #ifdef MODULE_L2FILTER_WHITELIST
-    bool res = false;
-    for (unsigned i = 0; i < CONFIG_L2FILTER_LISTSIZE; i++) {
-        if (match(&list[i], addr, addr_len)) {
-            DEBUG("[l2filter] whitelist: address match -> packet passes\n");
-            res = true;
-            break;
-        }
+    bool res = listed;
+    if (res) {
+        DEBUG("[l2filter] whitelist: address match -> packet passes\n");
+    }
+    else {
+        DEBUG("[l2filter] whitelist: no match -> packet dropped\n");
     }
-    DEBUG("[l2filter] whitelist: no match -> packet dropped\n");
 #else
-    bool res = true;
-    for (unsigned i = 0; i < CONFIG_L2FILTER_LISTSIZE; i++) {
-        if (match(&list[i], addr, addr_len)) {
-            DEBUG("[l2filter] blacklist: address match -> packet dropped\n");
-            res = false;
-            break;
-        }
+    bool res = !listed;
+    if (res) {
+        DEBUG("[l2filter] blacklist: no match -> packet passes\n");
+    }
+    else {
+        DEBUG("[l2filter] blacklist: address match -> packet dropped\n");
     }
-    DEBUG("[l2fitler] blacklist: no match -> packet passes\n");
 #endif
 
     return res;
@@ -37,20 +37,104 @@ static inline void _unlock(netif_t *dev)
     mutex_unlock(&dev->neighbors.lock);
 }
 
-/**
- * @brief Compare the freshness of two records
- *
- * @param[in] a     pointer to the first record
- * @param[in] b     pointer to the second record
- * @param[in] now   current timestamp in seconds
- *
- * @return       pointer to the least fresh record
- */
-static inline netstats_nb_t *netstats_nb_comp(const netstats_nb_t *a,
-                                              const netstats_nb_t *b,
-                                              uint16_t now)
+#define IDX_NONE    ((netstats_nb_idx_t)~0U)   /**< unused slot, end of list */
+#define HASH_MASK   (NETSTATS_NB_HASH_SIZE - 1)
+
+#if (NETSTATS_NB_HASH_SIZE & HASH_MASK) || (NETSTATS_NB_HASH_SIZE <= NETSTATS_NB_SIZE)
+#error "NETSTATS_NB_HASH_SIZE must be a power of two greater than NETSTATS_NB_SIZE"
+#endif
+
+/* FNV-1a */
+static unsigned _hash(const uint8_t *l2_addr, uint8_t len)
+{
+    uint32_t hash = 2166136261U;
+
+    while (len--) {
+        hash ^= *l2_addr++;
+        hash *= 16777619U;
+    }
+
+    return (hash ^ (hash >> 16)) & HASH_MASK;
+}
+
+/* returns the slot of the entry with the L2 address or the empty slot at
+ * which it has to be inserted, the index is never full */
+static unsigned _hash_find(const netstats_nb_table_t *tbl,
+                           const uint8_t *l2_addr, uint8_t len)
+{
+    unsigned slot = _hash(l2_addr, len);
+
+    while (tbl->hash[slot] != IDX_NONE) {
+        const netstats_nb_t *stats = &tbl->pstats[tbl->hash[slot]];
+        if (l2util_addr_equal(stats->l2_addr, stats->l2_addr_len, l2_addr, len)) {
+            break;
+        }
+        slot = (slot + 1) & HASH_MASK;
+    }
+
+    return slot;
+}
+
+/* linear probing, move the following entries of the cluster back instead of
+ * leaving a tombstone */
+static void _hash_remove(netstats_nb_table_t *tbl, unsigned slot)
+{
+    unsigned next = slot;
+
+    while (1) {
+        next = (next + 1) & HASH_MASK;
+        if (tbl->hash[next] == IDX_NONE) {
+            break;
+        }
+
+        const netstats_nb_t *stats = &tbl->pstats[tbl->hash[next]];
+        unsigned home = _hash(stats->l2_addr, stats->l2_addr_len);
+
+        /* keep the entry if its home slot lies cyclically in (slot, next] */
+        if ((slot < next) ? ((slot < home) && (home <= next))
+                          : ((slot < home) || (home <= next))) {
+            continue;
+        }
+        tbl->hash[slot] = tbl->hash[next];
+        slot = next;
+    }
+
+    tbl->hash[slot] = IDX_NONE;
+}
+
+static void _lru_unlink(netstats_nb_table_t *tbl, netstats_nb_idx_t idx)
+{
+    netstats_nb_idx_t prev = tbl->lru_prev[idx];
+    netstats_nb_idx_t next = tbl->lru_next[idx];
+
+    if (prev == IDX_NONE) {
+        tbl->lru_head = next;
+    } else {
+        tbl->lru_next[prev] = next;
+    }
+
+    if (next == IDX_NONE) {
+        tbl->lru_tail = prev;
+    } else {
+        tbl->lru_prev[next] = prev;
+    }
+}
+
+/* move an entry to the head of the LRU list */
+static void _lru_touch(netstats_nb_table_t *tbl, const netstats_nb_t *stats)
 {
-    return (netstats_nb_t *)(((now - a->last_updated) > now - b->last_updated) ? a : b);
+    netstats_nb_idx_t idx = stats - tbl->pstats;
+
+    if (tbl->lru_head == idx) {
+        return;
+    }
+
+    _lru_unlink(tbl, idx);
+
+    tbl->lru_prev[idx] = IDX_NONE;
+    tbl->lru_next[idx] = tbl->lru_head;
+    tbl->lru_prev[tbl->lru_head] = idx;
+    tbl->lru_head = idx;
 }
 
 static void half_freshness(netstats_nb_t *stats, uint16_t now_sec)
@@ -64,7 +148,7 @@ static void half_freshness(netstats_nb_t *stats, uint16_t now_sec)
     }
 }
 
-static void incr_freshness(netstats_nb_t *stats)
+static void incr_freshness(netif_t *dev, netstats_nb_t *stats)
 {
     uint16_t now = xtimer_now_usec() / US_PER_SEC;;
 
@@ -77,6 +161,8 @@ static void incr_freshness(netstats_nb_t *stats)
     }
 
     stats->last_updated = now;
+
+    _lru_touch(&dev->neighbors, stats);
 }
 
 static bool isfresh(netstats_nb_t *stats)
@@ -103,11 +189,23 @@ bool netstats_nb_isfresh(netif_t *dev, netstats_nb_t *stats)
 
 void netstats_nb_init(netif_t *dev)
 {
-    mutex_init(&dev->neighbors.lock);
+    netstats_nb_table_t *tbl = &dev->neighbors;
+
+    mutex_init(&tbl->lock);
 
     _lock(dev);
-    memset(dev->neighbors.pstats, 0, sizeof(netstats_nb_t) * NETSTATS_NB_SIZE);
-    cib_init(&dev->neighbors.stats_idx, NETSTATS_NB_QUEUE_SIZE);
+    memset(tbl->pstats, 0, sizeof(netstats_nb_t) * NETSTATS_NB_SIZE);
+    memset(tbl->hash, 0xff, sizeof(tbl->hash));
+    cib_init(&tbl->stats_idx, NETSTATS_NB_QUEUE_SIZE);
+
+    for (unsigned i = 0; i < NETSTATS_NB_SIZE; i++) {
+        tbl->lru_prev[i] = i - 1;
+        tbl->lru_next[i] = i + 1;
+    }
+    tbl->lru_prev[0] = IDX_NONE;
+    tbl->lru_next[NETSTATS_NB_SIZE - 1] = IDX_NONE;
+    tbl->lru_head = 0;
+    tbl->lru_tail = NETSTATS_NB_SIZE - 1;
     _unlock(dev);
 }
 
@@ -124,61 +222,82 @@ static void netstats_nb_create(netstats_nb_t *entry, const uint8_t *l2_addr, uin
 
 bool netstats_nb_get(netif_t *dev, const uint8_t *l2_addr, uint8_t len, netstats_nb_t *out)
 {
+    netstats_nb_table_t *tbl = &dev->neighbors;
+    bool found = false;
+
+    if (len == 0) {
+        return false;
+    }
+
     _lock(dev);
 
-    netstats_nb_t *stats = dev->neighbors.pstats;
-    bool found = false;
+    unsigned slot = _hash_find(tbl, l2_addr, len);
+    if (tbl->hash[slot] != IDX_NONE) {
+        *out = tbl->pstats[tbl->hash[slot]];
+        found = true;
+    }
 
-    for (int i = 0; i < NETSTATS_NB_SIZE; i++) {
+    _unlock(dev);
+    return found;
+}
 
-        /* Check if this is the matching entry */
-        if (l2util_addr_equal(stats[i].l2_addr, stats[i].l2_addr_len, l2_addr, len)) {
-            *out = stats[i];
-            found = true;
+unsigned netstats_nb_snapshot(netif_t *dev, netstats_nb_t *buf, unsigned numof)
+{
+    netstats_nb_table_t *tbl = &dev->neighbors;
+    unsigned count = 0;
+
+    _lock(dev);
+
+    for (netstats_nb_idx_t i = tbl->lru_head; (i != IDX_NONE) && (count < numof);
+         i = tbl->lru_next[i]) {
+        /* empty entries are at the end of the list */
+        if (tbl->pstats[i].l2_addr_len == 0) {
             break;
         }
+        buf[count++] = tbl->pstats[i];
     }
 
     _unlock(dev);
-    return found;
+    return count;
 }
 
-/* find the oldest inactive entry to replace. Empty entries are infinity old */
+/* Find the entry of the neighbor or replace the least recently updated entry
+ * that is empty or no longer fresh. */
 static netstats_nb_t *netstats_nb_get_or_create(netif_t *dev, const uint8_t *l2_addr, uint8_t len)
 {
+    netstats_nb_table_t *tbl = &dev->neighbors;
     netstats_nb_t *old_entry = NULL;
-    netstats_nb_t *stats = dev->neighbors.pstats;
-    uint16_t now = xtimer_now_usec() / US_PER_SEC;
 
-    for (int i = 0; i < NETSTATS_NB_SIZE; i++) {
+    if (len == 0) {
+        return NULL;
+    }
 
-        /* Check if this is the matching entry */
-        if (l2util_addr_equal(stats[i].l2_addr, stats[i].l2_addr_len, l2_addr, len)) {
-            return &stats[i];
-        }
+    unsigned slot = _hash_find(tbl, l2_addr, len);
+    if (tbl->hash[slot] != IDX_NONE) {
+        return &tbl->pstats[tbl->hash[slot]];
+    }
 
-        /* Entry is oldest if it is empty */
-        if (stats[i].l2_addr_len == 0) {
-            old_entry = &stats[i];
-        }
-        /* Check if the entry is expired */
-        else if (!isfresh(&stats[i])) {
-            /* Entry is oldest if it is expired */
-            if (old_entry == NULL) {
-                old_entry = &stats[i];
-            }
-            /* don't replace old entry if there are still empty ones */
-            else if (old_entry->l2_addr_len > 0) {
-                /* Check if current entry is older than current oldest entry */
-                old_entry = netstats_nb_comp(old_entry, &stats[i], now);
-            }
+    /* the list is ordered by the last update, so the first entry from the
+     * tail that is empty or not fresh is the oldest one */
+    for (netstats_nb_idx_t i = tbl->lru_tail; i != IDX_NONE; i = tbl->lru_prev[i]) {
+        if ((tbl->pstats[i].l2_addr_len == 0) || !isfresh(&tbl->pstats[i])) {
+            old_entry = &tbl->pstats[i];
+            break;
         }
     }
 
     /* if there is no matching entry,
      * create a new entry if we have an expired one */
     if (old_entry) {
+        if (old_entry->l2_addr_len) {
+            _hash_remove(tbl, _hash_find(tbl, old_entry->l2_addr,
+                                         old_entry->l2_addr_len));
+            /* the empty slot may have moved */
+            slot = _hash_find(tbl, l2_addr, len);
+        }
         netstats_nb_create(old_entry, l2_addr, len);
+        tbl->hash[slot] = old_entry - tbl->pstats;
+        _lru_touch(tbl, old_entry);
     }
 
     return old_entry;
@@ -372,7 +491,7 @@ netstats_nb_t *netstats_nb_update_tx(netif_t *dev, netstats_nb_result_t result,
     netstats_nb_update_etx(stats, result, transmissions, fresh);
     netstats_nb_incr_count_tx(stats, result);
 
-    incr_freshness(stats);
+    incr_freshness(dev, stats);
 
 out:
     _unlock(dev);
@@ -393,7 +512,7 @@ netstats_nb_t *netstats_nb_update_rx(netif_t *dev, const uint8_t *l2_addr,
         netstats_nb_update_lqi(stats, lqi, fresh);
         netstats_nb_incr_count_rx(stats);
 
-        incr_freshness(stats);
+        incr_freshness(dev, stats);
     }
 
     _unlock(dev);
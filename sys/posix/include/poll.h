@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2021 Gunar Schorcht
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @addtogroup  posix_select
+ * @{
+ *
+ * @file
+ * @brief   Input/output multiplexing with `poll()`
+ * @see     [The Open Group Base Specification Issue 7, 2018 edition,
+ *          <poll.h>](https://pubs.opengroup.org/onlinepubs/9699919799.2018edition/basedefs/poll.h.html)
+ *
+ * @author  Gunar Schorcht <gunar@schorcht.net>
+ */
+
+/* If building on native we need to use the system definitions instead */
+#ifdef CPU_NATIVE
+#pragma GCC system_header
+/* without the GCC pragma above #include_next will trigger a pedantic error */
+#include_next <poll.h>
+#else
+#ifndef POLL_H
+#define POLL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @name    Event flags for `struct pollfd`
+ * @{
+ */
+#define POLLIN      (0x0001)    /**< Data other than high-priority data may
+                                 *   be read without blocking */
+#define POLLPRI     (0x0002)    /**< High-priority data may be read without
+                                 *   blocking */
+#define POLLOUT     (0x0004)    /**< Normal data may be written without
+                                 *   blocking */
+#define POLLERR     (0x0008)    /**< An error has occurred (revents only) */
+#define POLLHUP     (0x0010)    /**< Device has been disconnected (revents
+                                 *   only) */
+#define POLLNVAL    (0x0020)    /**< Invalid fd member (revents only) */
+#define POLLRDNORM  (POLLIN)    /**< Normal data may be read without blocking */
+#define POLLRDBAND  (POLLPRI)   /**< Priority data may be read without
+                                 *   blocking */
+#define POLLWRNORM  (POLLOUT)   /**< Equivalent to POLLOUT */
+#define POLLWRBAND  (0x0040)    /**< Priority data may be written */
+/** @} */
+
+/**
+ * @brief   Type used for the number of file descriptors
+ */
+typedef unsigned int nfds_t;
+
+/**
+ * @brief   File descriptor to be polled
+ */
+struct pollfd {
+    int fd;         /**< The file descriptor to poll, ignored if negative */
+    short events;   /**< The input event flags */
+    short revents;  /**< The output event flags */
+};
+
+/**
+ * @brief   Waits for one of a set of file descriptors to become ready
+ *
+ * @param[in,out] fds   Array of file descriptors to poll
+ * @param[in] nfds      Number of elements in @p fds
+ * @param[in] timeout   Timeout in milliseconds. 0 to return immediately,
+ *                      -1 to block indefinitely.
+ *
+ * @return  number of elements in @p fds with non-zero `revents` on success,
+ *          0 if the timeout expired.
+ * @return  -1 on error, `errno` is set to indicate the error.
+ */
+int poll(struct pollfd *fds, nfds_t nfds, int timeout);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* POLL_H */
+#endif /* CPU_NATIVE */
+/** @} */
@@ -16,8 +16,12 @@
  *          - Inclusion of `<signal.h>`; no POSIX signal handling implemented
  *            in RIOT yet
  *          - `pselect()` as it uses `sigset_t` from `<signal.h>`
- *          - handling of the `writefds` and `errorfds` parameters of `select()`
  * @todo    Currently, only [sockets](@ref posix_sockets) are supported
+ *
+ * Besides `select()` this module provides `poll()` (see `<poll.h>`).
+ * Sockets report to the blocked thread which file descriptor became ready,
+ * so waking up only costs a check of the ready file descriptors, independent
+ * of the number of watched ones.
  * @{
  *
  * @file
@@ -145,15 +149,14 @@ static inline void FD_ZERO(fd_set *fdsetp)
  * @param[in,out] writefds  The set of file descriptors to be checked for being
  *                          ready to write. Indicates on output which file
  *                          descriptors are ready to write. May be NULL to check
- *                          no file descriptors.
- *                          **As only sockets are supported for now, these will
- *                          be ignored**
+ *                          no file descriptors. Datagram and connected stream
+ *                          sockets are always ready to write.
  * @param[in,out] errorfds  The set of file descriptors to be checked for being
  *                          error conditions pending. Indicates on output which
  *                          file descriptors have error conditions pending. May
  *                          be NULL to check no file descriptors.
- *                          **As only sockets are supported for now, these will
- *                          be ignored**
+ *                          **As no error conditions are tracked for sockets,
+ *                          this set will always be empty on output**
  * @param[in] timeout       Timeout for select to block until one or more of the
  *                          checked file descriptors is ready. Set timeout
  *                          to all-zero to return immediately without blocking.
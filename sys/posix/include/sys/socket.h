@@ -19,7 +19,8 @@
  *          </a>
  *
  * @todo Omitted from original specification for now:
- * * struct msghdr, struct cmesghdr, and struct linger and all related defines
+ * * struct cmesghdr, and struct linger and all related defines
+ * * ancillary data of struct msghdr (`msg_control`)
  * * getsockopt()/setsockopt() and all related defines.
  * * shutdown() and all related defines.
  * * sockatmark()
@@ -41,6 +42,7 @@
 #include <stdlib.h>
 #include <sys/types.h>
 #include <sys/uio.h>
+#include <time.h>
 
 #include "net/af.h"
 #include "sys/bytes.h"
@@ -72,6 +74,17 @@ extern "C" {
 #endif
 #endif
 
+/**
+ * @brief   Size of the buffer used by @ref sendmsg() to gather a datagram
+ *          scattered over multiple buffers
+ *
+ * Defaults to the IPv6 minimum MTU, so every datagram that can be sent
+ * without fragmentation on any link fits.
+ */
+#ifndef SOCKET_SENDMSG_BUF_SIZE
+#define SOCKET_SENDMSG_BUF_SIZE (1280)
+#endif
+
 /**
  * @brief   Maximum data length for a socket address.
  *
@@ -116,6 +129,20 @@ extern "C" {
 #define SO_TYPE         (15)    /**< Socket type. */
 /** @} */
 
+/**
+ * @name    Message flags
+ * @brief   Flags for the `flags` parameter of the send and receive functions
+ *          and for struct msghdr::msg_flags
+ * @{
+ */
+#define MSG_PEEK        (0x0002)    /**< Peeks at an incoming message
+                                     *   (not supported) */
+#define MSG_TRUNC       (0x0020)    /**< Normal data truncated */
+#define MSG_DONTWAIT    (0x0040)    /**< Non-blocking operation */
+#define MSG_WAITFORONE  (0x10000)   /**< recvmmsg(): only block for the first
+                                     *   message */
+/** @} */
+
 typedef unsigned short sa_family_t;   /**< address family type */
 
 /**
@@ -135,6 +162,26 @@ struct sockaddr_storage {
     uint8_t ss_data[SOCKADDR_MAX_DATA_LEN]; /**< Socket address */
 };
 
+/**
+ * @brief   Message header for recvmsg() and sendmsg()
+ */
+struct msghdr {
+    void *msg_name;             /**< Optional address */
+    socklen_t msg_namelen;      /**< Size of address */
+    struct iovec *msg_iov;      /**< Scatter/gather array */
+    int msg_iovlen;             /**< Members in msg_iov */
+    void *msg_control;          /**< Ancillary data (not supported) */
+    socklen_t msg_controllen;   /**< Ancillary data buffer len */
+    int msg_flags;              /**< Flags on received message */
+};
+
+/**
+ * @brief   Message header for recvmmsg() and sendmmsg()
+ */
+struct mmsghdr {
+    struct msghdr msg_hdr;      /**< Message header */
+    unsigned int msg_len;       /**< Number of bytes transmitted */
+};
 
 /**
  * @brief   Accept a new connection on a socket
@@ -331,8 +378,8 @@ int listen(int socket, int backlog);
  *                          stored.
  * @param[in] length        Specifies the length in bytes of the buffer pointed
  *                          to by the buffer argument.
- * @param[in] flags         Specifies the type of message reception. Support
- *                          for values other than 0 is not implemented yet.
+ * @param[in] flags         Specifies the type of message reception. Only
+ *                          @ref MSG_DONTWAIT is supported.
  * @param[out] address      A null pointer, or points to a sockaddr structure
  *                          in which the sending address is to be stored. The
  *                          length and format of the address depend on the
@@ -353,6 +400,49 @@ ssize_t recvfrom(int socket, void *__restrict buffer, size_t length, int flags,
                  struct sockaddr *__restrict address,
                  socklen_t *__restrict address_len);
 
+/**
+ * @brief   Receive a message from a socket into multiple buffers.
+ * @details For datagram sockets using @ref net_sock_udp, the payload is
+ *          copied directly from the stack's buffers into the buffers of
+ *          @p message->msg_iov, without an intermediate copy.
+ *
+ * @see <a href="http://pubs.opengroup.org/onlinepubs/9699919799/functions/recvmsg.html">
+ *          The Open Group Base Specification Issue 7, recvmsg
+ *      </a>
+ *
+ * @param[in] socket        Specifies the socket file descriptor.
+ * @param[in,out] message   Points to a msghdr structure, containing both the
+ *                          buffers to store the source address
+ *                          (`msg_name`, may be NULL) and the message
+ *                          (`msg_iov`). `msg_flags` is set to @ref MSG_TRUNC
+ *                          on output if the message did not fit.
+ * @param[in] flags         Specifies the type of message reception. Only
+ *                          @ref MSG_DONTWAIT is supported.
+ *
+ * @return  Upon successful completion, recvmsg() shall return the length of
+ *          the message in bytes. Otherwise, -1 shall be returned and errno set
+ *          to indicate the error.
+ */
+ssize_t recvmsg(int socket, struct msghdr *message, int flags);
+
+/**
+ * @brief   Receive multiple messages from a socket.
+ *
+ * @param[in] socket        Specifies the socket file descriptor.
+ * @param[in,out] msgvec    Array of @p vlen message headers. `msg_len` is set
+ *                          to the number of received bytes of each message.
+ * @param[in] vlen          Number of elements in @p msgvec.
+ * @param[in] flags         Flags as for @ref recvmsg(). With
+ *                          @ref MSG_WAITFORONE, only the first message is
+ *                          waited for.
+ * @param[in] timeout       Not supported, must be NULL.
+ *
+ * @return  The number of messages received on success. Otherwise, -1 shall be
+ *          returned and errno set to indicate the error.
+ */
+int recvmmsg(int socket, struct mmsghdr *msgvec, unsigned int vlen, int flags,
+             struct timespec *timeout);
+
 /**
  * @brief   Receive a message from a connected socket.
  * @details Shall receive a message from a connection-mode or
@@ -368,8 +458,8 @@ ssize_t recvfrom(int socket, void *__restrict buffer, size_t length, int flags,
  * @param[out] buffer   Points to a buffer where the message should be stored.
  * @param[in] length    Specifies the length in bytes of the buffer pointed to
  *                      by the buffer argument.
- * @param[in] flags     Specifies the type of message reception. Support for
- *                      values other than 0 is not implemented yet.
+ * @param[in] flags     Specifies the type of message reception. Only
+ *                      @ref MSG_DONTWAIT is supported.
  *
  * @return  Upon successful completion, recv() shall return the length of the
  *          message in bytes. If no messages are available to be received and
@@ -452,6 +542,46 @@ static inline ssize_t send(int socket, const void *buffer, size_t length,
     return sendto(socket, buffer, length, flags, NULL, 0);
 }
 
+/**
+ * @brief   Send a message from multiple buffers on a socket.
+ *
+ * @see <a href="http://pubs.opengroup.org/onlinepubs/9699919799/functions/sendmsg.html">
+ *          The Open Group Base Specification Issue 7, sendmsg
+ *      </a>
+ *
+ * @param[in] socket    Specifies the socket file descriptor.
+ * @param[in] message   Points to a msghdr structure, containing both the
+ *                      destination address (`msg_name`, may be NULL for
+ *                      connected sockets) and the buffers for the outgoing
+ *                      message (`msg_iov`).
+ * @param[in] flags     Specifies the type of message transmission. Support
+ *                      for values other than 0 is not implemented yet.
+ *
+ * @note    For datagram sockets, a message scattered over more than one
+ *          buffer is gathered into a static buffer of
+ *          @ref SOCKET_SENDMSG_BUF_SIZE bytes first, which is shared by all
+ *          sockets. Longer messages fail with `EMSGSIZE`.
+ *
+ * @return  Upon successful completion, sendmsg() shall return the number of
+ *          bytes sent. Otherwise, -1 shall be returned and errno set to
+ *          indicate the error.
+ */
+ssize_t sendmsg(int socket, const struct msghdr *message, int flags);
+
+/**
+ * @brief   Send multiple messages on a socket.
+ *
+ * @param[in] socket        Specifies the socket file descriptor.
+ * @param[in,out] msgvec    Array of @p vlen message headers. `msg_len` is set
+ *                          to the number of sent bytes of each message.
+ * @param[in] vlen          Number of elements in @p msgvec.
+ * @param[in] flags         Flags as for @ref sendmsg().
+ *
+ * @return  The number of messages sent on success. Otherwise, -1 shall be
+ *          returned and errno set to indicate the error.
+ */
+int sendmmsg(int socket, struct mmsghdr *msgvec, unsigned int vlen, int flags);
+
 /**
  * @brief   Create an endpoint for communication.
  * @details Shall create an unbound socket in a communications domain, and
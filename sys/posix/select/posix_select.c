@@ -13,9 +13,13 @@
  */
 
 #include <errno.h>
+#include <poll.h>
 #include <stdbool.h>
+#include <string.h>
 #include <sys/select.h>
 
+#include "irq.h"
+#include "thread.h"
 #include "thread_flags.h"
 #include "vfs.h"
 #include "xtimer.h"
@@ -23,6 +27,7 @@
 #if IS_USED(MODULE_POSIX_SOCKETS)
 extern bool posix_socket_is(int fd);
 extern unsigned posix_socket_avail(int fd);
+extern bool posix_socket_writable(int fd);
 extern void posix_socket_select(int fd);
 #else   /* MODULE_POSIX_SOCKETS */
 static inline bool posix_socket_is(int fd)
@@ -37,107 +42,278 @@ static inline unsigned posix_socket_avail(int fd)
     return 0;
 }
 
+static inline bool posix_socket_writable(int fd)
+{
+    (void)fd;
+    return false;
+}
+
 static inline void posix_socket_select(int fd)
 {
     (void)fd;
-    return 0;
 }
 #endif  /* IS_USED(MODULE_POSIX_SOCKETS) */
 
-static int _set_timeout(xtimer_t *timeout_timer, struct timeval *timeout,
-                        uint32_t offset, bool *wait)
+/**
+ * @brief   A thread blocked in select() or poll()
+ *
+ * The sockets report the file descriptors that became ready into @p ready,
+ * so after a wake-up only those have to be checked instead of all watched
+ * file descriptors.
+ */
+typedef struct _waiter {
+    struct _waiter *next;           /**< next blocked thread */
+    thread_t *thread;               /**< the blocked thread */
+    BITFIELD(ready, FD_SETSIZE);    /**< file descriptors reported ready */
+} _waiter_t;
+
+static _waiter_t *_waiters;
+
+void posix_select_notify(thread_t *thread, int fd)
 {
-    if (timeout != NULL) {
-        uint64_t t = ((uint64_t)(timeout->tv_sec * US_PER_SEC) +
-                      timeout->tv_usec);
-        /* check for potential underflow before subtracting offset */
-        if ((t == 0) || (offset > t)) {
-            *wait = false;
-            return 0;
+    unsigned state = irq_disable();
+
+    for (_waiter_t *w = _waiters; w != NULL; w = w->next) {
+        if (w->thread == thread) {
+            if ((fd >= 0) && (fd < FD_SETSIZE)) {
+                bf_set(w->ready, fd);
+            }
+            break;
+        }
+    }
+    irq_restore(state);
+    thread_flags_set(thread, POSIX_SELECT_THREAD_FLAG);
+}
+
+static void _waiter_add(_waiter_t *w)
+{
+    memset(w->ready, 0, sizeof(w->ready));
+    w->thread = thread_get_active();
+
+    unsigned state = irq_disable();
+    w->next = _waiters;
+    _waiters = w;
+    irq_restore(state);
+}
+
+static void _waiter_remove(_waiter_t *w)
+{
+    unsigned state = irq_disable();
+
+    for (_waiter_t **p = &_waiters; *p != NULL; p = &(*p)->next) {
+        if (*p == w) {
+            *p = w->next;
+            break;
+        }
+    }
+    irq_restore(state);
+}
+
+/**
+ * @brief   Pops the next file descriptor reported ready
+ *
+ * @return  the file descriptor, -1 if none is left
+ */
+static int _waiter_pop(_waiter_t *w)
+{
+    int fd = -1;
+    unsigned state = irq_disable();
+
+    for (unsigned i = 0; i < sizeof(w->ready); i++) {
+        if (w->ready[i]) {
+            /* bitfield.h uses MSB-first order within a byte */
+            fd = (i * 8) + __builtin_clz(w->ready[i]) -
+                 ((sizeof(unsigned) - 1) * 8);
+            bf_unset(w->ready, fd);
+            break;
         }
-        t -= offset;
-        if (t > UINT32_MAX) {
-            errno = EINVAL;
-            /* don't have timer set yet so go to end */
+    }
+    irq_restore(state);
+    return fd;
+}
+
+/**
+ * @brief   Get the current events of a file descriptor
+ *
+ * @return  the `POLL*` events of @p fd included in @p events plus
+ *          `POLLNVAL` if @p fd is not supported
+ */
+static short _fd_events(int fd, short events)
+{
+    short revents = 0;
+
+    if (!posix_socket_is(fd)) {
+        return POLLNVAL;
+    }
+    if ((events & POLLIN) && (posix_socket_avail(fd) > 0)) {
+        revents |= POLLIN;
+    }
+    if ((events & POLLOUT) && posix_socket_writable(fd)) {
+        revents |= POLLOUT;
+    }
+    return revents;
+}
+
+/**
+ * @brief   Blocks until one of the watched file descriptors was reported
+ *          ready or the timeout expired
+ *
+ * Timeouts that do not fit into the 32-bit xtimer are waited for in
+ * chunks.
+ *
+ * @param[in] timeout   timeout in microseconds, UINT64_MAX to block
+ *                      indefinitely
+ * @param[in] start     xtimer_now_usec64() at the beginning of the call
+ *
+ * @return  0 when woken up by a socket
+ * @return  -1 on timeout
+ */
+static int _wait(uint64_t timeout, uint64_t start)
+{
+    if (timeout == UINT64_MAX) {
+        thread_flags_wait_any(POSIX_SELECT_THREAD_FLAG);
+        return 0;
+    }
+    while (1) {
+        xtimer_t timeout_timer;
+        uint64_t elapsed = xtimer_now_usec64() - start;
+
+        if (elapsed >= timeout) {
             return -1;
         }
-        else {
-            xtimer_set_timeout_flag(timeout_timer, (uint32_t)t);
+        uint64_t t = timeout - elapsed;
+        xtimer_set_timeout_flag(&timeout_timer,
+                                (t > UINT32_MAX) ? UINT32_MAX : (uint32_t)t);
+        thread_flags_t tflags = thread_flags_wait_any(POSIX_SELECT_THREAD_FLAG |
+                                                      THREAD_FLAG_TIMEOUT);
+        xtimer_remove(&timeout_timer);
+        if (tflags & POSIX_SELECT_THREAD_FLAG) {
+            return 0;
         }
     }
-    return 0;
 }
 
 int select(int nfds, fd_set *readfds, fd_set *writefds, fd_set *errorfds,
            struct timeval *timeout)
 {
-    uint32_t start_time = xtimer_now_usec();
+    uint64_t start_time = xtimer_now_usec64();
+    uint64_t t = UINT64_MAX;
     fd_set ret_readfds;
-    xtimer_t timeout_timer;
+    fd_set ret_writefds;
+    _waiter_t waiter;
     int fds_set = 0;
-    bool wait = true;
 
     FD_ZERO(&ret_readfds);
-    /* TODO ignored writefds and errorfds for now since there is no point for
-     * them with sockets */
+    FD_ZERO(&ret_writefds);
     if ((nfds >= FD_SETSIZE) || ((unsigned)nfds >= VFS_MAX_OPEN_FILES)) {
         errno = EINVAL;
         return -1;
     }
+    if (timeout != NULL) {
+        t = ((uint64_t)timeout->tv_sec * US_PER_SEC) + timeout->tv_usec;
+    }
+    _waiter_add(&waiter);
     for (int i = 0; i < nfds; i++) {
-        if ((readfds != NULL) && FD_ISSET(i, readfds)) {
-            if (!posix_socket_is(i)) {
-                errno = EBADF;
-                return -1;
-            }
+        bool r = (readfds != NULL) && FD_ISSET(i, readfds);
+        bool w = (writefds != NULL) && FD_ISSET(i, writefds);
+        bool e = (errorfds != NULL) && FD_ISSET(i, errorfds);
+
+        if (!(r || w || e)) {
+            continue;
+        }
+        if (!posix_socket_is(i)) {
+            _waiter_remove(&waiter);
+            errno = EBADF;
+            return -1;
+        }
+        if (r) {
+            /* a message that arrives after the check below is reported to
+             * the waiter, as the socket already knows the selecting thread */
+            posix_socket_select(i);
             if (posix_socket_avail(i) > 0) {
                 FD_SET(i, &ret_readfds);
                 fds_set++;
-                wait = false;
-            }
-            else {
-                posix_socket_select(i);
             }
         }
-        if ((writefds != NULL) && FD_ISSET(i, writefds) &&
-            !posix_socket_is(i)) {
-            errno = EBADF;
-            return -1;
+        /* sends never block for connected sockets, so there is nothing to
+         * wait for */
+        if (w && posix_socket_writable(i)) {
+            FD_SET(i, &ret_writefds);
+            fds_set++;
         }
-        if ((errorfds != NULL) && FD_ISSET(i, errorfds) &&
-            !posix_socket_is(i)) {
-            errno = EBADF;
+        /* no pending error conditions are tracked for sockets, so
+         * errorfds are never reported */
+    }
+    while (fds_set == 0) {
+        int fd;
+
+        if (_wait(t, start_time) < 0) {
+            _waiter_remove(&waiter);
+            errno = EINTR;
             return -1;
         }
+        /* only visit the file descriptors that were reported */
+        while ((fd = _waiter_pop(&waiter)) >= 0) {
+            if ((fd < nfds) && (readfds != NULL) && FD_ISSET(fd, readfds) &&
+                (posix_socket_avail(fd) > 0) && !FD_ISSET(fd, &ret_readfds)) {
+                FD_SET(fd, &ret_readfds);
+                fds_set++;
+            }
+        }
     }
-    while (wait) {
-        if (_set_timeout(&timeout_timer, timeout,
-                         xtimer_now_usec() - start_time, &wait) < 0) {
-            return -1;
+    _waiter_remove(&waiter);
+    if (readfds != NULL) {
+        *readfds = ret_readfds;
+    }
+    if (writefds != NULL) {
+        *writefds = ret_writefds;
+    }
+    if (errorfds != NULL) {
+        FD_ZERO(errorfds);
+    }
+    return fds_set;
+}
+
+int poll(struct pollfd *fds, nfds_t nfds, int timeout)
+{
+    uint64_t start_time = xtimer_now_usec64();
+    uint64_t t = (timeout < 0) ? UINT64_MAX : ((uint64_t)timeout * US_PER_MS);
+    _waiter_t waiter;
+    int fds_set = 0;
+
+    if (nfds > VFS_MAX_OPEN_FILES) {
+        errno = EINVAL;
+        return -1;
+    }
+    _waiter_add(&waiter);
+    for (nfds_t i = 0; i < nfds; i++) {
+        fds[i].revents = 0;
+        if (fds[i].fd < 0) {
+            continue;
         }
-        if (!wait) {
-            errno = EINTR;
-            return -1;
+        /* see select() */
+        if ((fds[i].events & POLLIN) && posix_socket_is(fds[i].fd)) {
+            posix_socket_select(fds[i].fd);
         }
-        thread_flags_t tflags = thread_flags_wait_any(POSIX_SELECT_THREAD_FLAG |
-                                                      THREAD_FLAG_TIMEOUT);
-        if (tflags & POSIX_SELECT_THREAD_FLAG) {
-            for (int i = 0; i < nfds; i++) {
-                if (FD_ISSET(i, readfds)) {
-                    if (posix_socket_avail(i) > 0) {
-                        FD_SET(i, &ret_readfds);
+        fds[i].revents = _fd_events(fds[i].fd, fds[i].events);
+        if (fds[i].revents) {
+            fds_set++;
+        }
+    }
+    while ((fds_set == 0) && (_wait(t, start_time) == 0)) {
+        int fd;
+
+        while ((fd = _waiter_pop(&waiter)) >= 0) {
+            for (nfds_t i = 0; i < nfds; i++) {
+                if ((fds[i].fd == fd) && (fds[i].revents == 0)) {
+                    fds[i].revents = _fd_events(fd, fds[i].events);
+                    if (fds[i].revents) {
                         fds_set++;
-                        wait = false;
                     }
                 }
             }
         }
-        else if (tflags & THREAD_FLAG_TIMEOUT) {
-            errno = EINTR;
-            return -1;
-        }
-        xtimer_remove(&timeout_timer);
     }
-    *readfds = ret_readfds;
+    _waiter_remove(&waiter);
     return fds_set;
 }
@@ -46,6 +46,8 @@
 
 #include "thread.h"
 #include "thread_flags.h"
+
+extern void posix_select_notify(thread_t *thread, int fd);
 #endif
 
 /* enough to create sockets both with socket() and accept() */
@@ -372,8 +374,7 @@ static void _async_cb(void *sock, sock_async_flags_t type,
         atomic_fetch_add(&socket->available, 1);
 #if IS_USED(MODULE_POSIX_SELECT)
         if (socket->selecting_thread) {
-            thread_flags_set(socket->selecting_thread,
-                             POSIX_SELECT_THREAD_FLAG);
+            posix_select_notify(socket->selecting_thread, socket->fd);
         }
 #endif
     }
@@ -918,6 +919,19 @@ int listen(int socket, int backlog)
 #endif
 }
 
+static inline uint32_t _recv_timeout(const socket_t *s, int flags)
+{
+    if (flags & MSG_DONTWAIT) {
+        return 0;
+    }
+#ifdef POSIX_SETSOCKOPT
+    return s->recv_timeout;
+#else
+    (void)s;
+    return SOCK_NO_TIMEOUT;
+#endif
+}
+
 static ssize_t socket_recvfrom(socket_t *s, void *restrict buffer,
                                size_t length, int flags,
                                struct sockaddr *restrict address,
@@ -926,10 +940,12 @@ static ssize_t socket_recvfrom(socket_t *s, void *restrict buffer,
     int res = 0;
     struct _sock_tl_ep ep = { .port = 0 };
 
-    (void)flags;
     if (s == NULL) {
         return -ENOTSOCK;
     }
+    if (flags & MSG_PEEK) {
+        return -EOPNOTSUPP;
+    }
     if (s->sock == NULL) {  /* socket is not connected */
 #ifdef MODULE_SOCK_TCP
         if (s->type == SOCK_STREAM) {
@@ -942,11 +958,7 @@ static ssize_t socket_recvfrom(socket_t *s, void *restrict buffer,
         }
     }
 
-#ifdef POSIX_SETSOCKOPT
-    const uint32_t recv_timeout = s->recv_timeout;
-#else
-    const uint32_t recv_timeout = SOCK_NO_TIMEOUT;
-#endif
+    const uint32_t recv_timeout = _recv_timeout(s, flags);
 
     switch (s->type) {
 #ifdef MODULE_SOCK_IP
@@ -1110,6 +1122,252 @@ ssize_t sendto(int socket, const void *buffer, size_t length, int flags,
     return res;
 }
 
+static size_t _iov_len(const struct iovec *iov, int iovlen)
+{
+    size_t len = 0;
+
+    for (int i = 0; i < iovlen; i++) {
+        len += iov[i].iov_len;
+    }
+    return len;
+}
+
+#ifdef MODULE_SOCK_UDP
+/* copies the stack's buffers right into the iovecs */
+static ssize_t _udp_recvmsg(socket_t *s, struct msghdr *message, int flags,
+                            struct _sock_tl_ep *ep)
+{
+    void *data, *ctx = NULL;
+    ssize_t res, total = 0;
+    int iov_idx = 0;
+    size_t iov_off = 0;
+
+    while ((res = sock_udp_recv_buf_aux(&s->sock->udp, &data, &ctx,
+                                        _recv_timeout(s, flags), ep,
+                                        NULL)) > 0) {
+        const uint8_t *src = data;
+
+        while ((res > 0) && (iov_idx < message->msg_iovlen)) {
+            struct iovec *iov = &message->msg_iov[iov_idx];
+            size_t n = iov->iov_len - iov_off;
+
+            if ((size_t)res < n) {
+                n = res;
+            }
+            memcpy((uint8_t *)iov->iov_base + iov_off, src, n);
+            src += n;
+            res -= n;
+            total += n;
+            iov_off += n;
+            if (iov_off == iov->iov_len) {
+                iov_idx++;
+                iov_off = 0;
+            }
+        }
+        if (res > 0) {
+            /* out of buffer space, keep fetching to release the packet */
+            message->msg_flags |= MSG_TRUNC;
+        }
+    }
+    return (res < 0) ? res : total;
+}
+#endif
+
+static ssize_t socket_recvmsg(socket_t *s, struct msghdr *message, int flags)
+{
+    struct _sock_tl_ep ep = { .port = 0 };
+    ssize_t res;
+
+    if (s == NULL) {
+        return -ENOTSOCK;
+    }
+    if ((message == NULL) || (message->msg_iovlen < 0) ||
+        ((message->msg_iov == NULL) && (message->msg_iovlen > 0))) {
+        return -EINVAL;
+    }
+    message->msg_flags = 0;
+    message->msg_controllen = 0;
+#ifdef MODULE_SOCK_UDP
+    if (s->type == SOCK_DGRAM) {
+        if (flags & MSG_PEEK) {
+            return -EOPNOTSUPP;
+        }
+        /* bind implicitly */
+        if ((s->sock == NULL) && (_bind_connect(s, NULL, 0) < 0)) {
+            return -errno;
+        }
+        res = _udp_recvmsg(s, message, flags, &ep);
+        if (res >= 0) {
+#if IS_USED(MODULE_SOCK_ASYNC)
+            atomic_fetch_sub(&s->available, 1);
+#endif
+            if (message->msg_name != NULL) {
+                struct sockaddr_storage sa;
+                socklen_t sa_len = _ep_to_sockaddr(&ep, &sa);
+
+                message->msg_namelen = _addr_truncate(message->msg_name,
+                                                      message->msg_namelen,
+                                                      &sa, sa_len);
+            }
+        }
+        return res;
+    }
+#endif
+    (void)ep;
+    /* stream sockets may return less than requested, so fill the first
+     * buffer only; datagrams must not be split without a copy */
+    if (message->msg_iovlen > 1) {
+#ifdef MODULE_SOCK_TCP
+        if (s->type != SOCK_STREAM)
+#endif
+        {
+            return -EOPNOTSUPP;
+        }
+    }
+    res = socket_recvfrom(s, (message->msg_iovlen > 0)
+                             ? message->msg_iov[0].iov_base : NULL,
+                          (message->msg_iovlen > 0)
+                             ? message->msg_iov[0].iov_len : 0,
+                          flags, message->msg_name,
+                          (message->msg_name != NULL)
+                             ? &message->msg_namelen : NULL);
+    return res;
+}
+
+ssize_t recvmsg(int socket, struct msghdr *message, int flags)
+{
+    socket_t *s;
+    ssize_t res;
+
+    mutex_lock(&_socket_pool_mutex);
+    s = _get_socket(socket);
+    mutex_unlock(&_socket_pool_mutex);
+    res = socket_recvmsg(s, message, flags);
+    if (res < 0) {
+        errno = -res;
+        return -1;
+    }
+    return res;
+}
+
+int recvmmsg(int socket, struct mmsghdr *msgvec, unsigned int vlen, int flags,
+             struct timespec *timeout)
+{
+    socket_t *s;
+    unsigned int i;
+
+    if (timeout != NULL) {
+        errno = EOPNOTSUPP;
+        return -1;
+    }
+    mutex_lock(&_socket_pool_mutex);
+    s = _get_socket(socket);
+    mutex_unlock(&_socket_pool_mutex);
+    for (i = 0; i < vlen; i++) {
+        ssize_t res = socket_recvmsg(s, &msgvec[i].msg_hdr, flags);
+
+        if (res < 0) {
+            if (i == 0) {
+                errno = -res;
+                return -1;
+            }
+            /* report the error with the next call */
+            break;
+        }
+        msgvec[i].msg_len = res;
+        if (flags & MSG_WAITFORONE) {
+            flags |= MSG_DONTWAIT;
+        }
+    }
+    return i;
+}
+
+ssize_t sendmsg(int socket, const struct msghdr *message, int flags)
+{
+    socket_t *s;
+    const void *buf = NULL;
+    size_t len = 0;
+
+    if ((message == NULL) || (message->msg_iovlen < 0) ||
+        ((message->msg_iov == NULL) && (message->msg_iovlen > 0))) {
+        errno = EINVAL;
+        return -1;
+    }
+    mutex_lock(&_socket_pool_mutex);
+    s = _get_socket(socket);
+    mutex_unlock(&_socket_pool_mutex);
+    if (s == NULL) {
+        errno = ENOTSOCK;
+        return -1;
+    }
+    if (message->msg_iovlen == 1) {
+        buf = message->msg_iov[0].iov_base;
+        len = message->msg_iov[0].iov_len;
+    }
+#ifdef MODULE_SOCK_TCP
+    else if (s->type == SOCK_STREAM) {
+        /* stream sockets don't need to preserve message boundaries */
+        ssize_t total = 0;
+
+        if (message->msg_name != NULL) {
+            errno = EISCONN;
+            return -1;
+        }
+        for (int i = 0; i < message->msg_iovlen; i++) {
+            ssize_t res = socket_sendto(s, message->msg_iov[i].iov_base,
+                                        message->msg_iov[i].iov_len, flags,
+                                        NULL, 0);
+            if (res < 0) {
+                return (total > 0) ? total : res;
+            }
+            total += res;
+        }
+        return total;
+    }
+#endif
+    else if (message->msg_iovlen > 1) {
+        /* datagrams have to be sent in one piece, the stack copies the
+         * payload, so the buffer is free again when sending returned */
+        static uint8_t gather[SOCKET_SENDMSG_BUF_SIZE];
+        static mutex_t gather_lock = MUTEX_INIT;
+        ssize_t res;
+
+        len = _iov_len(message->msg_iov, message->msg_iovlen);
+        if (len > sizeof(gather)) {
+            errno = EMSGSIZE;
+            return -1;
+        }
+        mutex_lock(&gather_lock);
+        for (int i = 0, off = 0; i < message->msg_iovlen; i++) {
+            memcpy(&gather[off], message->msg_iov[i].iov_base,
+                   message->msg_iov[i].iov_len);
+            off += message->msg_iov[i].iov_len;
+        }
+        res = socket_sendto(s, gather, len, flags, message->msg_name,
+                            message->msg_namelen);
+        mutex_unlock(&gather_lock);
+        return res;
+    }
+    return socket_sendto(s, buf, len, flags, message->msg_name,
+                         message->msg_namelen);
+}
+
+int sendmmsg(int socket, struct mmsghdr *msgvec, unsigned int vlen, int flags)
+{
+    unsigned int i;
+
+    for (i = 0; i < vlen; i++) {
+        ssize_t res = sendmsg(socket, &msgvec[i].msg_hdr, flags);
+
+        if (res < 0) {
+            /* report the error with the next call */
+            return (i == 0) ? -1 : (int)i;
+        }
+        msgvec[i].msg_len = res;
+    }
+    return i;
+}
+
 /*
  * This is a partial implementation of setsockopt for changing the receive
  * timeout value of a socket.
@@ -1183,6 +1441,25 @@ unsigned posix_socket_avail(int fd)
 #endif
 }
 
+bool posix_socket_writable(int fd)
+{
+    socket_t *socket = _get_socket(fd);
+
+    if (socket == NULL) {
+        return false;
+    }
+    switch (socket->type) {
+#ifdef MODULE_SOCK_TCP
+        case SOCK_STREAM:
+            /* only connected sockets can be written to */
+            return (socket->sock != NULL) && (socket->queue_array == NULL);
+#endif
+        default:
+            /* datagrams are handed to the stack without blocking */
+            return true;
+    }
+}
+
 int posix_socket_select(int fd)
 {
 #if IS_USED(MODULE_POSIX_SELECT)
@@ -230,6 +230,7 @@ int _stats(void)
     printf("DAO-ACK   #bytes: %10" PRIu32 " / %-10" PRIu32 "  %10" PRIu32 " / %-10" PRIu32 "\n",
            gnrc_rpl_netstats.dao_ack_rx_ucast_bytes, gnrc_rpl_netstats.dao_ack_tx_ucast_bytes,
            gnrc_rpl_netstats.dao_ack_rx_mcast_bytes, gnrc_rpl_netstats.dao_ack_tx_mcast_bytes);
+    printf("Parent switches:  %10" PRIu32 "\n", gnrc_rpl_netstats.parent_switches);
     return 0;
 }
 #endif
@@ -0,0 +1,279 @@
+/*
+ * Copyright (C) 2021 Gunar Schorcht
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test application for the blocked and the counting Bloom filter
+ *
+ * The filters are sized for a target false positive rate with the sizing
+ * helpers and the measured false positive rate is compared with the target.
+ * The benchmark compares the lookups per second of the classic filter with
+ * k hash functions, the blocked and the counting filter of the same size.
+ *
+ * @author      Gunar Schorcht <gunar@schorcht.net>
+ * @}
+ */
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "bloom.h"
+#include "fmt.h"
+#include "hashes.h"
+#include "timex.h"
+#include "ztimer.h"
+
+#include "test_utils/expect.h"
+
+#define ELEMENTS            (1000U)
+#define QUERIES             (100000UL)
+#define FP_INV_MAX          (1000U)
+#define KEY_WORDS_MAX       (50U)
+#define HASHES_MAX          (8U)
+
+/* sized for ELEMENTS with the lowest false positive rate */
+#define BITS_MAX            (16 * ELEMENTS)
+#define BLOCKS_MAX          (2 * BITS_MAX / (CONFIG_BLOOM_BLOCKED_BLOCK_SIZE * 8))
+
+static uint8_t _bits[BITS_MAX / 8];
+static uint8_t _blocks[BLOOM_BLOCKED_BYTES(BLOCKS_MAX)]
+    __attribute__((aligned(CONFIG_BLOOM_BLOCKED_BLOCK_SIZE)));
+static uint8_t _counters[BLOOM_COUNTING_BYTES(BITS_MAX)];
+
+static bloom_t _classic;
+static bloom_blocked_t _blocked;
+static bloom_counting_t _counting;
+
+static hashfp_t _hashes[HASHES_MAX] = {
+    (hashfp_t)fnv_hash, (hashfp_t)sax_hash, (hashfp_t)sdbm_hash,
+    (hashfp_t)djb2_hash, (hashfp_t)kr_hash, (hashfp_t)dek_hash,
+    (hashfp_t)rotating_hash, (hashfp_t)one_at_a_time_hash,
+};
+
+static uint32_t _key[KEY_WORDS_MAX];
+static uint32_t _rand_state;
+
+static uint32_t _rand(void)
+{
+    /* xorshift32 */
+    _rand_state ^= _rand_state << 13;
+    _rand_state ^= _rand_state >> 17;
+    _rand_state ^= _rand_state << 5;
+    return _rand_state;
+}
+
+/* elements and non-elements differ in the first word */
+static const uint8_t *_key_of(uint32_t idx, bool element, unsigned words)
+{
+    _rand_state = idx * 2654435761U + 1;
+    for (unsigned i = 0; i < words; i++) {
+        _key[i] = _rand();
+    }
+    _key[0] = element ? idx : (idx | 0x80000000UL);
+    return (uint8_t *)_key;
+}
+
+static void _print_fp(const char *name, uint32_t fps)
+{
+    print_str(name);
+    print_str(" false positives: ");
+    print_u32_dec(fps);
+    print_str(" of ");
+    print_u32_dec(QUERIES);
+    print_str("\n");
+}
+
+static void test_sizing(void)
+{
+    /* m = 1000 * log2(100) / ln(2) = 9585, k = log2(100) = 6.6 */
+    size_t bits = bloom_calc_bits(ELEMENTS, 100);
+    expect((bits >= 9560) && (bits <= 9610) && ((bits % 8) == 0));
+    expect(bloom_calc_hashes(100) == 7);
+    expect(bloom_calc_hashes(1000) == 10);
+    expect(bloom_calc_hashes(2) == 1);
+    expect(bloom_calc_hashes(0) == 1);
+    expect(bloom_calc_bits(0, 100) == 8);
+    expect(bloom_calc_bits(ELEMENTS, FP_INV_MAX) <= BITS_MAX);
+    expect(bloom_blocked_calc_blocks(ELEMENTS, FP_INV_MAX) <= BLOCKS_MAX);
+    expect(bloom_blocked_calc_blocks(1, 2) == 1);
+
+    puts("sizing: OK");
+}
+
+static void test_fp_rate(uint32_t fp_inv)
+{
+    size_t bits = bloom_calc_bits(ELEMENTS, fp_inv);
+    size_t k = bloom_calc_hashes(fp_inv);
+    uint32_t fps[3] = { 0 };
+
+    memset(_bits, 0, sizeof(_bits));
+    bloom_init(&_classic, bits, _bits, _hashes, k > HASHES_MAX ? HASHES_MAX : k);
+    bloom_blocked_init(&_blocked, _blocks,
+                       bloom_blocked_calc_blocks(ELEMENTS, fp_inv), k);
+    bloom_counting_init(&_counting, _counters,
+                        bloom_counting_calc_counters(ELEMENTS, fp_inv), k);
+
+    for (uint32_t i = 0; i < ELEMENTS; i++) {
+        const uint8_t *key = _key_of(i, true, 4);
+        bloom_add(&_classic, key, 16);
+        bloom_blocked_add(&_blocked, key, 16);
+        bloom_counting_add(&_counting, key, 16);
+    }
+    /* no false negatives */
+    for (uint32_t i = 0; i < ELEMENTS; i++) {
+        const uint8_t *key = _key_of(i, true, 4);
+        expect(bloom_check(&_classic, key, 16));
+        expect(bloom_blocked_check(&_blocked, key, 16));
+        expect(bloom_counting_check(&_counting, key, 16));
+    }
+    for (uint32_t i = 0; i < QUERIES; i++) {
+        const uint8_t *key = _key_of(i, false, 4);
+        fps[0] += bloom_check(&_classic, key, 16);
+        fps[1] += bloom_blocked_check(&_blocked, key, 16);
+        fps[2] += bloom_counting_check(&_counting, key, 16);
+    }
+
+    print_str("target 1/");
+    print_u32_dec(fp_inv);
+    print_str(", m ");
+    print_u32_dec(bits);
+    print_str(", k ");
+    print_u32_dec(k);
+    print_str("\n");
+    _print_fp("classic", fps[0]);
+    _print_fp("blocked", fps[1]);
+    _print_fp("counting", fps[2]);
+
+    /* within 50 % of the target */
+    expect(fps[1] * fp_inv <= QUERIES + QUERIES / 2);
+    expect(fps[2] * fp_inv <= QUERIES + QUERIES / 2);
+}
+
+static void test_counting_remove(void)
+{
+    size_t m = bloom_counting_calc_counters(ELEMENTS, 100);
+    uint32_t fps = 0;
+
+    bloom_counting_init(&_counting, _counters, m, bloom_calc_hashes(100));
+
+    for (uint32_t i = 0; i < ELEMENTS; i++) {
+        bloom_counting_add(&_counting, _key_of(i, true, 4), 16);
+    }
+    for (uint32_t i = 0; i < ELEMENTS; i += 2) {
+        expect(bloom_counting_remove(&_counting, _key_of(i, true, 4), 16) == 0);
+    }
+    for (uint32_t i = 0; i < ELEMENTS; i++) {
+        bool in = bloom_counting_check(&_counting, _key_of(i, true, 4), 16);
+        if (i % 2) {
+            expect(in);
+        }
+        else {
+            fps += in;
+        }
+    }
+    /* half the elements are left, so the removed ones are rarely found */
+    expect(fps < ELEMENTS / 2 / 50);
+
+    /* an element that was never added can't be removed */
+    expect(bloom_counting_remove(&_counting, _key_of(QUERIES, false, 4), 16)
+           == -ENOENT);
+
+    /* all elements removed, all counters are zero again */
+    for (uint32_t i = 1; i < ELEMENTS; i += 2) {
+        expect(bloom_counting_remove(&_counting, _key_of(i, true, 4), 16) == 0);
+    }
+    for (unsigned i = 0; i < BLOOM_COUNTING_BYTES(m); i++) {
+        expect(_counters[i] == 0);
+    }
+
+    puts("counting remove: OK");
+}
+
+static void _print_rate(const char *name, uint32_t usec)
+{
+    print_str(name);
+    print_str(": ");
+    print_u64_dec((uint64_t)QUERIES * US_PER_SEC / (usec ? usec : 1));
+    print_str(" lookups/s\n");
+}
+
+static void bench(unsigned words)
+{
+    size_t bits = bloom_calc_bits(ELEMENTS, 100);
+    size_t k = bloom_calc_hashes(100);
+    size_t len = words * sizeof(uint32_t);
+    uint32_t start;
+    unsigned in[3] = { 0 };
+
+    memset(_bits, 0, sizeof(_bits));
+    bloom_init(&_classic, bits, _bits, _hashes, k);
+    /* the same size for all filters */
+    bloom_blocked_init(&_blocked, _blocks,
+                       bits / (CONFIG_BLOOM_BLOCKED_BLOCK_SIZE * 8), k);
+    bloom_counting_init(&_counting, _counters, bits, k);
+
+    for (uint32_t i = 0; i < ELEMENTS; i++) {
+        const uint8_t *key = _key_of(i, true, words);
+        bloom_add(&_classic, key, len);
+        bloom_blocked_add(&_blocked, key, len);
+        bloom_counting_add(&_counting, key, len);
+    }
+
+    /* the same keys are checked repeatedly, half of them are elements */
+    static uint32_t keys[16][KEY_WORDS_MAX];
+    for (unsigned i = 0; i < 16; i++) {
+        memcpy(keys[i], _key_of(i * 7, i % 2, words), len);
+    }
+
+    print_u32_dec(len);
+    print_str(" byte keys\n");
+
+    start = ztimer_now(ZTIMER_USEC);
+    for (unsigned long i = 0; i < QUERIES; i++) {
+        in[0] += bloom_check(&_classic, (uint8_t *)keys[i % 16], len);
+    }
+    _print_rate("classic", ztimer_now(ZTIMER_USEC) - start);
+
+    start = ztimer_now(ZTIMER_USEC);
+    for (unsigned long i = 0; i < QUERIES; i++) {
+        in[1] += bloom_blocked_check(&_blocked, (uint8_t *)keys[i % 16], len);
+    }
+    _print_rate("blocked", ztimer_now(ZTIMER_USEC) - start);
+
+    start = ztimer_now(ZTIMER_USEC);
+    for (unsigned long i = 0; i < QUERIES; i++) {
+        in[2] += bloom_counting_check(&_counting, (uint8_t *)keys[i % 16], len);
+    }
+    _print_rate("counting", ztimer_now(ZTIMER_USEC) - start);
+
+    for (unsigned i = 0; i < 3; i++) {
+        expect(in[i] >= QUERIES / 2);
+    }
+}
+
+int main(void)
+{
+    test_sizing();
+
+    test_fp_rate(10);
+    test_fp_rate(100);
+    test_fp_rate(FP_INV_MAX);
+    puts("fp rate: OK");
+
+    test_counting_remove();
+
+    bench(2);
+    bench(KEY_WORDS_MAX);
+
+    puts("SUCCESS");
+    return 0;
+}
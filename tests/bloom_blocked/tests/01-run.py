@@ -0,0 +1,29 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2021 Gunar Schorcht
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    child.expect_exact("sizing: OK")
+    for fp_inv in (10, 100, 1000):
+        child.expect(r"target 1/{}, m \d+, k \d+".format(fp_inv))
+        for name in ("classic", "blocked", "counting"):
+            child.expect(r"{} false positives: \d+ of 100000".format(name))
+    child.expect_exact("fp rate: OK")
+    child.expect_exact("counting remove: OK")
+    for size in (8, 200):
+        child.expect_exact("{} byte keys".format(size))
+        for name in ("classic", "blocked", "counting"):
+            child.expect(r"{}: \d+ lookups/s".format(name))
+    child.expect_exact("SUCCESS")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc, timeout=120))
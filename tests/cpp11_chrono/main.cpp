@@ -0,0 +1,161 @@
+/*
+ * Copyright (C) 2021 Hamburg University of Applied Sciences (HAW)
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup tests
+ * @{
+ *
+ * @file
+ * @brief test ztimer based clocks and timed waits of cpp11-compat
+ *
+ * Besides checking the results, the test prints how late each timed wait
+ * returns, which is the figure to compare between boards and timer backends.
+ *
+ * @}
+ */
+
+#include <cstdio>
+#include <ctime>
+#include <chrono>
+
+#include "riot/mutex.hpp"
+#include "riot/chrono.hpp"
+#include "riot/thread.hpp"
+#include "riot/condition_variable.hpp"
+
+#include "test_utils/expect.h"
+
+using namespace std;
+using namespace riot;
+
+static constexpr chrono::milliseconds timeout{20};
+static constexpr int rounds = 5;
+
+static void print_latency(const char *what, steady_clock::duration late)
+{
+  printf("%s: woke up %ld us late\n", what, static_cast<long>(late.count()));
+}
+
+int main()
+{
+  puts("\n************ C++ chrono test ***********");
+
+  puts("Testing steady_clock ...");
+  {
+    auto last = steady_clock::now();
+    for (int i = 0; i < 1000; ++i) {
+      auto now = steady_clock::now();
+      expect(now >= last);
+      last = now;
+    }
+  }
+  puts("Done\n");
+
+  puts("Testing system_clock ...");
+  {
+    system_clock::set(system_clock::from_time_t(1600000000));
+    time_t t = system_clock::to_time_t(system_clock::now());
+    expect(t >= 1600000000 && t < 1600000002);
+  }
+  puts("Done\n");
+
+  puts("Testing sleep_for latency ...");
+  {
+    steady_clock::duration worst{0};
+    for (int i = 0; i < rounds; ++i) {
+      auto start = steady_clock::now();
+      this_thread::sleep_for(timeout);
+      auto late = steady_clock::now() - start - timeout;
+      expect(late >= steady_clock::duration::zero());
+      worst = max(worst, late);
+    }
+    print_latency("sleep_for", worst);
+  }
+  puts("Done\n");
+
+  puts("Testing sleep_until latency ...");
+  {
+    steady_clock::duration worst{0};
+    for (int i = 0; i < rounds; ++i) {
+      auto deadline = steady_clock::now() + timeout;
+      this_thread::sleep_until(deadline);
+      auto late = steady_clock::now() - deadline;
+      expect(late >= steady_clock::duration::zero());
+      worst = max(worst, late);
+    }
+    print_latency("sleep_until", worst);
+  }
+  puts("Done\n");
+
+  puts("Testing condition_variable::wait_for latency ...");
+  {
+    mutex m;
+    condition_variable cv;
+    steady_clock::duration worst{0};
+    for (int i = 0; i < rounds; ++i) {
+      unique_lock<mutex> lk(m);
+      auto start = steady_clock::now();
+      bool res = cv.wait_for(lk, timeout, [] { return false; });
+      auto late = steady_clock::now() - start - timeout;
+      expect(!res);
+      expect(late >= steady_clock::duration::zero());
+      worst = max(worst, late);
+    }
+    print_latency("wait_for", worst);
+    unique_lock<mutex> lk(m);
+    expect(cv.wait_for(lk, chrono::seconds(-1)) == cv_status::timeout);
+  }
+  puts("Done\n");
+
+  puts("Testing condition_variable::wait_until notification ...");
+  {
+    mutex m;
+    condition_variable cv;
+    bool ready = false;
+    thread t([&] {
+      this_thread::sleep_for(chrono::milliseconds(5));
+      lock_guard<mutex> lk(m);
+      ready = true;
+      cv.notify_one();
+    });
+    unique_lock<mutex> lk(m);
+    expect(cv.wait_until(lk, steady_clock::now() + chrono::seconds(1),
+                         [&] { return ready; }));
+    lk.unlock();
+    t.join();
+  }
+  puts("Done\n");
+
+  puts("Testing mutex::try_lock_for latency ...");
+  {
+    mutex m;
+    m.lock();
+    thread t([&] {
+      steady_clock::duration worst{0};
+      for (int i = 0; i < rounds; ++i) {
+        auto start = steady_clock::now();
+        expect(!m.try_lock_for(timeout));
+        auto late = steady_clock::now() - start - timeout;
+        expect(late >= steady_clock::duration::zero());
+        worst = max(worst, late);
+      }
+      print_latency("try_lock_for", worst);
+      expect(!m.try_lock_until(steady_clock::now()));
+    });
+    t.join();
+    m.unlock();
+    expect(m.try_lock_for(timeout));
+    m.unlock();
+  }
+  puts("Done\n");
+
+  puts("Bye, bye.");
+  puts("******************************************");
+
+  return 0;
+}
@@ -0,0 +1,31 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2021 Hamburg University of Applied Sciences (HAW)
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    child.expect_exact("************ C++ chrono test ***********")
+    child.expect_exact("Testing steady_clock ...")
+    child.expect_exact("Done")
+    child.expect_exact("Testing system_clock ...")
+    child.expect_exact("Done")
+    for name in ("sleep_for", "sleep_until", "wait_for"):
+        child.expect(r"{}: woke up (\d+) us late".format(name))
+        child.expect_exact("Done")
+    child.expect_exact("Testing condition_variable::wait_until notification ...")
+    child.expect_exact("Done")
+    child.expect(r"try_lock_for: woke up (\d+) us late")
+    child.expect_exact("Done")
+    child.expect_exact("Bye, bye.")
+    child.expect_exact("******************************************")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
@@ -22,6 +22,8 @@
 #include <cstdio>
 #include <system_error>
 
+#include "xtimer.h"
+
 #include "riot/mutex.hpp"
 #include "riot/chrono.hpp"
 #include "riot/thread.hpp"
@@ -0,0 +1,136 @@
+/*
+ * Copyright (C) 2021 Hamburg University of Applied Sciences (HAW)
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup tests
+ * @{
+ *
+ * @file
+ * @brief test future, promise and thread pool
+ *
+ * @}
+ */
+
+#include <cstdio>
+#include <cinttypes>
+#include <stdexcept>
+
+#include "riot/future.hpp"
+#include "riot/thread_pool.hpp"
+
+#include "xtimer.h"
+#include "test_utils/expect.h"
+
+using std::logic_error;
+using std::runtime_error;
+using namespace riot;
+
+static constexpr unsigned num_tasks = 1000;
+
+int main() {
+  puts("\n************ C++ thread pool test ***********");
+
+  puts("Promise and future ...");
+  {
+    promise<int> p;
+    auto f = p.get_future();
+    expect(f.valid());
+    expect(!f.is_ready());
+    p.set_value(42);
+    expect(f.is_ready());
+    expect(f.get() == 42);
+    expect(!f.valid());
+  }
+  puts("Done\n");
+
+  puts("Broken promise ...");
+  {
+    future<void> f;
+    {
+      promise<void> p;
+      f = p.get_future();
+    }
+    bool caught = false;
+    try {
+      f.get();
+    }
+    catch (const logic_error&) {
+      caught = true;
+    }
+    expect(caught);
+  }
+  puts("Done\n");
+
+  thread_pool<2, 8> pool;
+
+  puts("Submitting tasks ...");
+  {
+    auto f1 = async(pool, [](int x) { return x * x; }, 7);
+    auto f2 = pool.submit([] { /* nop */ });
+    expect(f1.get() == 49);
+    f2.get();
+  }
+  puts("Done\n");
+
+  puts("Continuations ...");
+  {
+    auto f = async(pool, [] { return 20; })
+               .then([](int x) { return x + 1; })
+               .then([](int x) { return x * 2; });
+    expect(f.get() == 42);
+  }
+  puts("Done\n");
+
+  puts("Exceptions ...");
+  {
+    auto f = async(pool, []() -> int { throw runtime_error("fail"); })
+               .then([](int x) { return x + 1; });
+    bool caught = false;
+    try {
+      f.get();
+    }
+    catch (const runtime_error&) {
+      caught = true;
+    }
+    expect(caught);
+  }
+  puts("Done\n");
+
+  puts("Detached async ...");
+  {
+    auto f = async([](int a, int b) { return a + b; }, 1, 2);
+    expect(f.get() == 3);
+  }
+  puts("Done\n");
+
+  puts("Throughput ...");
+  {
+    unsigned counter = 0;
+    mutex mtx;
+    condition_variable done;
+    uint32_t start = xtimer_now_usec();
+    for (unsigned i = 0; i < num_tasks; i++) {
+      pool.post([&] {
+        lock_guard<mutex> lk(mtx);
+        if (++counter == num_tasks) {
+          done.notify_one();
+        }
+      });
+    }
+    unique_lock<mutex> lk(mtx);
+    done.wait(lk, [&] { return counter == num_tasks; });
+    uint32_t elapsed = xtimer_now_usec() - start;
+    printf("%u tasks in %" PRIu32 " us\n", num_tasks, elapsed);
+  }
+  puts("Done\n");
+
+  puts("Bye, bye.");
+  puts("******************************************");
+
+  return 0;
+}
@@ -0,0 +1,238 @@
+/*
+ * Copyright (C) 2021 Hamburg University of Applied Sciences (HAW)
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup tests
+ * @{
+ *
+ * @file
+ * @brief test fixed capacity containers and pool allocators
+ *
+ * @}
+ */
+
+#include <cstdio>
+#include <cstdint>
+#include <algorithm>
+#include <list>
+#include <new>
+#include <numeric>
+#include <unordered_map>
+#include <vector>
+
+#include "riot/arena_allocator.hpp"
+#include "riot/flat_map.hpp"
+#include "riot/intrusive_hash_map.hpp"
+#include "riot/intrusive_list.hpp"
+#include "riot/memarray_allocator.hpp"
+#include "riot/ring_buffer.hpp"
+#include "riot/static_vector.hpp"
+
+#include "ztimer.h"
+#include "test_utils/expect.h"
+
+using namespace std;
+using namespace riot;
+
+static constexpr unsigned num_elems = 64;
+static constexpr unsigned num_rounds = 100;
+
+struct node : intrusive_list_node, intrusive_hash_node {
+  explicit node(unsigned k = 0) : key{k} {}
+  unsigned key;
+};
+
+static void test_static_vector() {
+  static_vector<int, 8> v{3, 1, 2};
+  expect(v.size() == 3);
+  sort(v.begin(), v.end());
+  expect(v == (static_vector<int, 8>{1, 2, 3}));
+  v.insert(v.begin(), 0);
+  v.erase(v.begin() + 2);
+  expect(v == (static_vector<int, 8>{0, 1, 3}));
+  while (!v.full()) {
+    v.push_back(42);
+  }
+  expect(v.size() == v.capacity());
+  expect(count(v.begin(), v.end(), 42) == 5);
+  v.clear();
+  expect(v.empty());
+}
+
+static void test_ring_buffer() {
+  ring_buffer<int, 4> rb;
+  int value;
+  expect(!rb.pop(value));
+  for (int i = 0; i < 4; i++) {
+    expect(rb.push(i));
+  }
+  expect(!rb.push(4));
+  for (int round = 0; round < 10; round++) {
+    expect(rb.pop(value));
+    expect(value == round);
+    expect(rb.push(round + 4));
+  }
+  expect(rb.size() == 4);
+  expect(rb[3] == 13);
+}
+
+static void test_intrusive() {
+  node nodes[8];
+  intrusive_list<node> list;
+  intrusive_hash_map<node, unsigned, &node::key, 4> map;
+
+  for (unsigned i = 0; i < 8; i++) {
+    nodes[i].key = i * 3;
+    list.push_back(nodes[i]);
+    expect(map.insert(nodes[i]));
+  }
+  expect(!map.insert(nodes[0]));
+  expect(list.size() == 8);
+  expect(map.size() == 8);
+  expect(map.find(9) == &nodes[3]);
+  expect(map.find(10) == nullptr);
+  list.remove(nodes[3]);
+  expect(map.erase(9) == &nodes[3]);
+  expect(map.find(9) == nullptr);
+  unsigned sum = 0;
+  for (auto& n : list) {
+    sum += n.key;
+  }
+  expect(sum == (0 + 3 + 6 + 12 + 15 + 18 + 21));
+  expect(list.pop_front().key == 0);
+  expect(list.front().key == 3);
+}
+
+static void test_flat_map() {
+  flat_map<unsigned, int, 8> map;
+  expect(map.insert({5, 50}).second);
+  expect(map.insert({1, 10}).second);
+  expect(!map.insert({5, 0}).second);
+  map[3] = 30;
+  expect(map.size() == 3);
+  expect(is_sorted(map.begin(), map.end()));
+  expect(map.find(3)->second == 30);
+  expect(!map.contains(4));
+  expect(map.erase(1u) == 1);
+  expect(map.begin()->first == 3);
+}
+
+static void test_allocators() {
+  memarray_pool<32, 8> pool;
+  {
+    list<int, memarray_allocator<int>> l{memarray_allocator<int>{pool}};
+    for (int i = 0; i < 8; i++) {
+      l.push_back(i);
+    }
+    expect(pool.available() == 0);
+    bool caught = false;
+    try {
+      l.push_back(8);
+    }
+    catch (const bad_alloc&) {
+      caught = true;
+    }
+    expect(caught);
+    expect(accumulate(l.begin(), l.end(), 0) == 28);
+  }
+  expect(pool.available() == 8);
+
+  arena<256> a;
+  {
+    vector<int, arena_allocator<int>> v{arena_allocator<int>{a}};
+    v.reserve(16);
+    for (int i = 0; i < 16; i++) {
+      v.push_back(i);
+    }
+    expect(a.used() >= 16 * sizeof(int));
+  }
+  expect(a.used() == 0);
+}
+
+template <class F>
+static uint32_t measure(F&& f) {
+  uint32_t start = ztimer_now(ZTIMER_USEC);
+  for (unsigned round = 0; round < num_rounds; round++) {
+    f();
+  }
+  return ztimer_now(ZTIMER_USEC) - start;
+}
+
+static void benchmark() {
+  uint32_t t_std = measure([] {
+    vector<unsigned> v;
+    for (unsigned i = 0; i < num_elems; i++) {
+      v.push_back(i);
+    }
+  });
+  uint32_t t_riot = measure([] {
+    static_vector<unsigned, num_elems> v;
+    for (unsigned i = 0; i < num_elems; i++) {
+      v.push_back(i);
+    }
+  });
+  printf("push_back: std::vector %" PRIu32 " us, static_vector %" PRIu32
+         " us\n", t_std, t_riot);
+
+  static node nodes[num_elems];
+  t_std = measure([] {
+    unordered_map<unsigned, node *> m;
+    for (unsigned i = 0; i < num_elems; i++) {
+      m[i] = &nodes[i];
+    }
+    for (unsigned i = 0; i < num_elems; i++) {
+      expect(m.find(i) != m.end());
+    }
+  });
+  t_riot = measure([] {
+    intrusive_hash_map<node, unsigned, &node::key, num_elems> m;
+    for (unsigned i = 0; i < num_elems; i++) {
+      nodes[i].key = i;
+      m.insert(nodes[i]);
+    }
+    for (unsigned i = 0; i < num_elems; i++) {
+      expect(m.find(i) != nullptr);
+    }
+    m.clear();
+  });
+  printf("insert+find: std::unordered_map %" PRIu32
+         " us, intrusive_hash_map %" PRIu32 " us\n", t_std, t_riot);
+}
+
+int main() {
+  puts("\n************ C++ containers test ***********");
+
+  puts("static_vector ...");
+  test_static_vector();
+  puts("Done\n");
+
+  puts("ring_buffer ...");
+  test_ring_buffer();
+  puts("Done\n");
+
+  puts("intrusive_list and intrusive_hash_map ...");
+  test_intrusive();
+  puts("Done\n");
+
+  puts("flat_map ...");
+  test_flat_map();
+  puts("Done\n");
+
+  puts("Allocators ...");
+  test_allocators();
+  puts("Done\n");
+
+  puts("Benchmark ...");
+  benchmark();
+  puts("Done\n");
+
+  puts("Bye, bye.");
+  puts("******************************************");
+
+  return 0;
+}
@@ -0,0 +1,30 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2021 Hamburg University of Applied Sciences (HAW)
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    child.expect_exact("************ C++ containers test ***********")
+    for name in ("static_vector", "ring_buffer",
+                 "intrusive_list and intrusive_hash_map", "flat_map",
+                 "Allocators"):
+        child.expect_exact("{} ...".format(name))
+        child.expect_exact("Done")
+    child.expect_exact("Benchmark ...")
+    child.expect(r"push_back: std::vector \d+ us, static_vector \d+ us")
+    child.expect(r"insert\+find: std::unordered_map \d+ us, "
+                 r"intrusive_hash_map \d+ us")
+    child.expect_exact("Done")
+    child.expect_exact("Bye, bye.")
+    child.expect_exact("******************************************")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
@@ -0,0 +1,208 @@
+/*
+ * Copyright (C) 2021 Hamburg University of Applied Sciences (HAW)
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup tests
+ * @{
+ *
+ * @file
+ * @brief test C++20 coroutine tasks
+ *
+ * @}
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+
+#include "riot/coro.hpp"
+
+#include "thread.h"
+#include "ztimer.h"
+#include "net/ipv6/addr.h"
+#include "test_utils/expect.h"
+
+using namespace std;
+using namespace riot::coro;
+
+static constexpr unsigned num_tasks = 100;
+static constexpr uint16_t test_port = 38664U;
+
+/* count the heap used by coroutine frames */
+static size_t heap_used;
+
+void *operator new(size_t size) {
+  size_t *p = static_cast<size_t *>(malloc(size + sizeof(size_t)));
+  if (!p) {
+    throw bad_alloc();
+  }
+  *p = size;
+  heap_used += size;
+  return p + 1;
+}
+
+void operator delete(void *ptr) noexcept {
+  if (ptr) {
+    size_t *p = static_cast<size_t *>(ptr) - 1;
+    heap_used -= *p;
+    free(p);
+  }
+}
+
+void operator delete(void *ptr, size_t) noexcept {
+  operator delete(ptr);
+}
+
+static task<int> add(int a, int b) {
+  co_return a + b;
+}
+
+static task<> chain(int& out) {
+  out = co_await add(1, 2) + co_await add(3, 4);
+}
+
+static task<> sleeper(unsigned ms, unsigned *order, unsigned& pos) {
+  co_await sleep_for(ZTIMER_MSEC, ms);
+  order[pos++] = ms;
+}
+
+static task<> locker(mutex& m, bool& inside, unsigned& count) {
+  for (unsigned i = 0; i < 10; i++) {
+    co_await m.lock();
+    expect(!inside);
+    inside = true;
+    co_await yield();
+    count++;
+    inside = false;
+    m.unlock();
+  }
+}
+
+static task<int> thrower() {
+  throw runtime_error("fail");
+  co_return 0;
+}
+
+static task<> catcher(bool& caught) {
+  try {
+    co_await thrower();
+  }
+  catch (const runtime_error&) {
+    caught = true;
+  }
+}
+
+static task<> udp_receiver(sock_udp_t *sock, char *buf, size_t len,
+                           ssize_t& res) {
+  res = co_await udp_recv(sock, buf, len);
+}
+
+static task<> udp_sender(sock_udp_t *sock, const sock_udp_ep_t *remote) {
+  co_await sleep_for(ZTIMER_MSEC, 10);
+  ssize_t res = co_await udp_send(sock, "Hello!", sizeof("Hello!"), remote);
+  expect(res == sizeof("Hello!"));
+}
+
+static task<> idle(unsigned ms) {
+  co_await sleep_for(ZTIMER_MSEC, ms);
+}
+
+int main() {
+  puts("\n************ C++ coroutine test ***********");
+
+  executor ex;
+
+  puts("Awaiting tasks ...");
+  {
+    int out = 0;
+    ex.spawn(chain(out));
+    ex.run();
+    expect(out == 10);
+  }
+  puts("Done\n");
+
+  puts("Sleeping ...");
+  {
+    unsigned order[3];
+    unsigned pos = 0;
+    ex.spawn(sleeper(30, order, pos));
+    ex.spawn(sleeper(10, order, pos));
+    ex.spawn(sleeper(20, order, pos));
+    ex.run();
+    expect(pos == 3);
+    expect((order[0] == 10) && (order[1] == 20) && (order[2] == 30));
+  }
+  puts("Done\n");
+
+  puts("Mutex ...");
+  {
+    mutex m;
+    bool inside = false;
+    unsigned count = 0;
+    ex.spawn(locker(m, inside, count));
+    ex.spawn(locker(m, inside, count));
+    ex.spawn(locker(m, inside, count));
+    ex.run();
+    expect(count == 30);
+  }
+  puts("Done\n");
+
+  puts("Exceptions ...");
+  {
+    bool caught = false;
+    ex.spawn(catcher(caught));
+    ex.run();
+    expect(caught);
+  }
+  puts("Done\n");
+
+  puts("UDP ...");
+  {
+    sock_udp_t rx, tx;
+    sock_udp_ep_t local = SOCK_IPV6_EP_ANY;
+    sock_udp_ep_t remote = SOCK_IPV6_EP_ANY;
+    char buf[16];
+    ssize_t res = 0;
+
+    local.port = test_port;
+    expect(sock_udp_create(&rx, &local, NULL, 0) == 0);
+    expect(sock_udp_create(&tx, NULL, NULL, 0) == 0);
+    ipv6_addr_set_loopback(reinterpret_cast<ipv6_addr_t *>(remote.addr.ipv6));
+    remote.port = test_port;
+
+    ex.spawn(udp_receiver(&rx, buf, sizeof(buf), res));
+    ex.spawn(udp_sender(&tx, &remote));
+    ex.run();
+    expect(res == sizeof("Hello!"));
+    expect(strcmp(buf, "Hello!") == 0);
+    sock_udp_close(&tx);
+    sock_udp_close(&rx);
+  }
+  puts("Done\n");
+
+  puts("RAM per concurrent task ...");
+  {
+    size_t before = heap_used;
+    for (unsigned i = 0; i < num_tasks; i++) {
+      ex.spawn(idle(10));
+    }
+    size_t per_task = (heap_used - before) / num_tasks;
+    ex.run();
+    expect(heap_used == before);
+    printf("coroutine: %u bytes, thread: %u bytes\n", (unsigned)per_task,
+           (unsigned)(THREAD_STACKSIZE_DEFAULT + sizeof(thread_t)));
+  }
+  puts("Done\n");
+
+  puts("Bye, bye.");
+  puts("******************************************");
+
+  return 0;
+}
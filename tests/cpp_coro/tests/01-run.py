@@ -0,0 +1,36 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2021 Hamburg University of Applied Sciences (HAW)
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    child.expect_exact("************ C++ coroutine test ***********")
+    child.expect_exact("Awaiting tasks ...")
+    child.expect_exact("Done")
+    child.expect_exact("Sleeping ...")
+    child.expect_exact("Done")
+    child.expect_exact("Mutex ...")
+    child.expect_exact("Done")
+    child.expect_exact("Exceptions ...")
+    child.expect_exact("Done")
+    child.expect_exact("UDP ...")
+    child.expect_exact("Done")
+    child.expect_exact("RAM per concurrent task ...")
+    child.expect(r"coroutine: (\d+) bytes, thread: (\d+) bytes")
+    coro = int(child.match.group(1))
+    thread = int(child.match.group(2))
+    assert coro < thread
+    child.expect_exact("Done")
+    child.expect_exact("Bye, bye.")
+    child.expect_exact("******************************************")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
@@ -0,0 +1,339 @@
+/*
+ * Copyright (C) 2021 Gunar Schorcht
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Tests and simulation of the adaptive CSMA/CA
+ *
+ * The CSMA/CA helper runs in virtual time: xtimer is mapped to ztimer and
+ * the microsecond clock is a mock clock that the main thread advances
+ * whenever all senders sleep.
+ *
+ * The tests send frames with a mock netdev whose CCAs find the channel busy
+ * as configured and check the channel statistics and the backoff exponents.
+ *
+ * The simulation lets N saturated sender threads contend for an in-memory
+ * channel. Each sender has its own mock netdev and sends its frames with
+ * csma_sender_csma_ca_send(), i.e. with the fixed backoff exponents of the
+ * default configuration, or with csma_sender_csma_ca_send_adaptive(). Frames
+ * that collide are not acknowledged and are retransmitted up to three times.
+ * The throughput, the mean latency of the delivered frames, the share of
+ * lost frames and the share of busy CCAs are printed for both policies.
+ *
+ * @author      Gunar Schorcht <gunar@schorcht.net>
+ * @}
+ */
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "fmt.h"
+#include "net/csma_sender.h"
+#include "net/netdev.h"
+#include "random.h"
+#include "thread.h"
+#include "timex.h"
+#include "ztimer.h"
+#include "ztimer/mock.h"
+
+#include "test_utils/expect.h"
+
+#define SIM_SENDERS_MAX     (20U)
+#define SIM_DURATION_US     (20UL * US_PER_SEC)
+#define SIM_SEED            (0x20210807)
+
+#define AIRTIME_US          ((127U + 6U) * 32U)
+#define CCA_US              (128U)
+#define TURNAROUND_US       (192U)
+#define ACK_US              (TURNAROUND_US + (5U + 6U) * 32U)
+#define ACK_TIMEOUT_US      (864U)
+#define RETRANS_MAX         (3U)
+
+typedef struct {
+    netdev_t netdev;
+    csma_sender_adaptive_t csma;
+    uint32_t tx_start;      /**< start of the last transmission */
+    uint32_t tx_end;        /**< end of the last transmission */
+    uint32_t cca;           /**< number of CCAs */
+    uint32_t cca_busy;      /**< number of CCAs that found the channel busy */
+    bool collided;          /**< the last transmission collided */
+} _sender_t;
+
+typedef struct {
+    uint32_t delivered;
+    uint32_t lost;
+    uint64_t latency;
+    uint32_t cca;
+    uint32_t cca_busy;
+} _sim_result_t;
+
+static ztimer_mock_t _clock;
+ztimer_clock_t *const ZTIMER_USEC = &_clock.super;
+
+static _sender_t _senders[SIM_SENDERS_MAX];
+static char _stacks[SIM_SENDERS_MAX][THREAD_STACKSIZE_DEFAULT];
+static unsigned _senders_numof;
+static unsigned _running;
+
+static unsigned _busy_ccas;     /**< number of following CCAs that fail */
+static unsigned _sent;
+
+static uint8_t _frame[127];
+static bool _adaptive;
+static uint32_t _sim_start;
+static _sim_result_t _res;
+
+static bool _channel_busy(const _sender_t *s, uint32_t now)
+{
+    if (_busy_ccas) {
+        _busy_ccas--;
+        return true;
+    }
+    for (unsigned i = 0; i < _senders_numof; i++) {
+        const _sender_t *o = &_senders[i];
+        if ((o != s) && (o->tx_start < now + CCA_US) && (o->tx_end > now)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static int _get(netdev_t *dev, netopt_t opt, void *value, size_t max_len)
+{
+    _sender_t *s = container_of(dev, _sender_t, netdev);
+    (void)max_len;
+
+    switch (opt) {
+    case NETOPT_CSMA:
+        return -ENOTSUP;
+    case NETOPT_IS_CHANNEL_CLR: {
+        bool busy = _channel_busy(s, ztimer_now(ZTIMER_USEC));
+        s->cca++;
+        s->cca_busy += busy;
+        *((netopt_enable_t *)value) = busy ? NETOPT_DISABLE : NETOPT_ENABLE;
+        return sizeof(netopt_enable_t);
+    }
+    default:
+        return -ENOTSUP;
+    }
+}
+
+static int _send(netdev_t *dev, const iolist_t *iolist)
+{
+    _sender_t *s = container_of(dev, _sender_t, netdev);
+
+    /* the transmission starts after the CCA and the turnaround */
+    s->tx_start = ztimer_now(ZTIMER_USEC) + CCA_US + TURNAROUND_US;
+    s->tx_end = s->tx_start + AIRTIME_US;
+    s->collided = false;
+    for (unsigned i = 0; i < _senders_numof; i++) {
+        _sender_t *o = &_senders[i];
+        if ((o != s) && (o->tx_start < s->tx_end) && (o->tx_end > s->tx_start)) {
+            o->collided = true;
+            s->collided = true;
+        }
+    }
+    _sent++;
+    return iolist_size(iolist);
+}
+
+static const netdev_driver_t _driver = {
+    .get = _get,
+    .send = _send,
+};
+
+static void _init_senders(unsigned n)
+{
+    memset(_senders, 0, sizeof(_senders));
+    for (unsigned i = 0; i < n; i++) {
+        _senders[i].netdev.driver = &_driver;
+        csma_sender_adaptive_init(&_senders[i].csma, NULL);
+    }
+    _senders_numof = n;
+}
+
+/* runs the sender threads until all of them returned, the virtual time
+ * is advanced to the next timer whenever all of them sleep */
+static void _run(thread_task_func_t func)
+{
+    _running = _senders_numof;
+    for (unsigned i = 0; i < _senders_numof; i++) {
+        thread_create(_stacks[i], sizeof(_stacks[i]), THREAD_PRIORITY_MAIN - 1,
+                      0, func, &_senders[i], "sender");
+    }
+
+    while (_running) {
+        expect(_clock.armed);
+        ztimer_mock_advance(&_clock, _clock.target);
+    }
+}
+
+static void *_test_stats(void *arg)
+{
+    _sender_t *s = arg;
+    iolist_t iol = { .iol_base = _frame, .iol_len = 16 };
+    csma_sender_adaptive_t *state = &s->csma;
+    const csma_sender_conf_t *conf = &CSMA_SENDER_CONF_DEFAULT;
+
+    expect(csma_sender_adaptive_be(state) == CONFIG_CSMA_SENDER_ADAPTIVE_MIN_BE);
+    expect(csma_sender_busy_ratio(state) == 0);
+
+    /* two busy CCAs, then the frame is sent */
+    _busy_ccas = 2;
+    expect(csma_sender_csma_ca_send_adaptive(&s->netdev, &iol, state) == 16);
+    expect((_sent == 1) && (state->stats.cca == 3) && (state->stats.cca_busy == 2));
+    expect(csma_sender_busy_ratio(state) == 666);
+
+    /* the channel is never free */
+    _busy_ccas = conf->max_backoffs + 1;
+    expect(csma_sender_csma_ca_send_adaptive(&s->netdev, &iol, state) == -EBUSY);
+    expect((_sent == 1) && (state->stats.fail == 1));
+    expect(state->stats.cca == 3U + conf->max_backoffs + 1);
+
+    /* the backoff exponent follows the busy CCAs */
+    for (unsigned i = 0; i < 64; i++) {
+        csma_sender_adaptive_cca(state, true);
+    }
+    expect(csma_sender_adaptive_be(state) == conf->max_be);
+    for (unsigned i = 0; i < 64; i++) {
+        csma_sender_adaptive_cca(state, false);
+    }
+    expect(csma_sender_adaptive_be(state) == CONFIG_CSMA_SENDER_ADAPTIVE_MIN_BE);
+
+    /* ... and the ACK losses */
+    for (unsigned i = 0; i < 64; i++) {
+        csma_sender_adaptive_tx_done(state, false);
+    }
+    expect(csma_sender_adaptive_be(state) == conf->max_be);
+    for (unsigned i = 0; i < 64; i++) {
+        csma_sender_adaptive_tx_done(state, true);
+    }
+    expect(csma_sender_adaptive_be(state) == CONFIG_CSMA_SENDER_ADAPTIVE_MIN_BE);
+    expect((state->stats.tx_acked == 64) && (state->stats.tx_noack == 64));
+
+    /* the fixed CSMA/CA gives up after the same number of CCAs */
+    _busy_ccas = conf->max_backoffs + 1;
+    expect(csma_sender_csma_ca_send(&s->netdev, &iol, NULL) == -EBUSY);
+    expect(_busy_ccas == 0);
+
+    _running--;
+    return NULL;
+}
+
+static void test_stats(void)
+{
+    _init_senders(1);
+    _run(_test_stats);
+
+    puts("stats: OK");
+}
+
+/* a saturated sender, the next frame is queued when the last one was
+ * acknowledged or dropped */
+static void *_sim_sender(void *arg)
+{
+    _sender_t *s = arg;
+    iolist_t iol = { .iol_base = _frame, .iol_len = sizeof(_frame) };
+
+    while (ztimer_now(ZTIMER_USEC) - _sim_start < SIM_DURATION_US) {
+        uint32_t queued = ztimer_now(ZTIMER_USEC);
+
+        for (unsigned retrans = 0; ; retrans++) {
+            int res = _adaptive
+                      ? csma_sender_csma_ca_send_adaptive(&s->netdev, &iol,
+                                                          &s->csma)
+                      : csma_sender_csma_ca_send(&s->netdev, &iol, NULL);
+            if (res < 0) {
+                /* the channel was never clear */
+                _res.lost++;
+                break;
+            }
+
+            ztimer_sleep(ZTIMER_USEC, s->tx_end - ztimer_now(ZTIMER_USEC));
+            if (_adaptive) {
+                csma_sender_adaptive_tx_done(&s->csma, !s->collided);
+            }
+            if (!s->collided) {
+                ztimer_sleep(ZTIMER_USEC, ACK_US);
+                _res.delivered++;
+                _res.latency += ztimer_now(ZTIMER_USEC) - queued;
+                break;
+            }
+
+            ztimer_sleep(ZTIMER_USEC, ACK_TIMEOUT_US);
+            if (retrans == RETRANS_MAX) {
+                _res.lost++;
+                break;
+            }
+        }
+    }
+
+    _running--;
+    return NULL;
+}
+
+static void _sim(unsigned n, bool adaptive, _sim_result_t *res)
+{
+    memset(&_res, 0, sizeof(_res));
+    random_init(SIM_SEED);
+    _adaptive = adaptive;
+    _sim_start = ztimer_now(ZTIMER_USEC);
+
+    _init_senders(n);
+    _run(_sim_sender);
+
+    for (unsigned i = 0; i < n; i++) {
+        _res.cca += _senders[i].cca;
+        _res.cca_busy += _senders[i].cca_busy;
+    }
+    *res = _res;
+
+    print_str(adaptive ? "adaptive" : "fixed");
+    print_str(", ");
+    print_u32_dec(n);
+    print_str(" senders: ");
+    print_u32_dec(res->delivered / (SIM_DURATION_US / US_PER_SEC));
+    print_str(" frames/s, ");
+    print_u32_dec(res->delivered ? res->latency / res->delivered : 0);
+    print_str(" us latency, ");
+    print_u32_dec((uint64_t)res->lost * 1000 / (res->delivered + res->lost));
+    print_str(" permille lost, ");
+    print_u32_dec((uint64_t)res->cca_busy * 1000 / res->cca);
+    print_str(" permille busy\n");
+}
+
+static void test_sim(unsigned n)
+{
+    _sim_result_t fixed, adaptive;
+
+    _sim(n, false, &fixed);
+    _sim(n, true, &adaptive);
+
+    /* within 5 % of the throughput of the fixed policy */
+    expect(adaptive.delivered >= fixed.delivered - fixed.delivered / 20);
+}
+
+int main(void)
+{
+    ztimer_mock_init(&_clock, 32);
+
+    test_stats();
+
+    test_sim(1);
+    test_sim(2);
+    test_sim(5);
+    test_sim(10);
+    test_sim(20);
+
+    puts("SUCCESS");
+    return 0;
+}
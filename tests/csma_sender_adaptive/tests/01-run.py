@@ -0,0 +1,24 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2021 Gunar Schorcht
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    child.expect_exact("stats: OK")
+    for senders in (1, 2, 5, 10, 20):
+        for policy in ("fixed", "adaptive"):
+            child.expect(r"{}, {} senders: \d+ frames/s, \d+ us latency, "
+                         r"\d+ permille lost, \d+ permille busy"
+                         .format(policy, senders))
+    child.expect_exact("SUCCESS")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc, timeout=60))
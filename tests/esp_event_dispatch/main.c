@@ -0,0 +1,226 @@
+/*
+ * Copyright (C) 2021 Gunar Schorcht
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test of the dispatcher for ESP system events
+ *
+ * The dispatcher in cpu/esp_common/event_dispatch is fed with synthetic
+ * events. Deferred handlers are executed by calling the events of the
+ * event queue from the main thread.
+ *
+ * @author      Gunar Schorcht <gunar@schorcht.net>
+ * @}
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "esp_event_dispatch.h"
+#include "event.h"
+#include "kernel_defines.h"
+
+#include "test_utils/expect.h"
+
+#define EVENT_A     (1)
+#define EVENT_B     (7)
+
+typedef struct {
+    uint8_t data[16];
+} info_t;
+
+typedef struct {
+    uintptr_t tag;
+    unsigned id;
+    uint8_t data;
+} call_t;
+
+static event_queue_t _queue;
+static call_t _calls[16];
+static unsigned _calls_numof;
+
+static void _handler(esp_event_sub_t *sub, unsigned id, const void *info)
+{
+    const info_t *event_info = info;
+
+    expect(_calls_numof < ARRAY_SIZE(_calls));
+    _calls[_calls_numof].tag = (uintptr_t)sub->arg;
+    _calls[_calls_numof].id = id;
+    _calls[_calls_numof].data = event_info->data[0];
+    _calls_numof++;
+}
+
+static esp_event_sub_t _urgent_a1 = {
+    .id = EVENT_A, .handler = _handler, .arg = (void *)1
+};
+static esp_event_sub_t _urgent_a2 = {
+    .id = EVENT_A, .handler = _handler, .arg = (void *)2
+};
+static esp_event_sub_t _deferred_a = {
+    .id = EVENT_A, .handler = _handler, .arg = (void *)3, .deferred = true
+};
+static esp_event_sub_t _urgent_b = {
+    .id = EVENT_B, .handler = _handler, .arg = (void *)4
+};
+
+static void _dispatch(unsigned id, uint8_t data)
+{
+    info_t info = { .data = { data } };
+
+    esp_event_dispatch(id, &info, sizeof(info));
+    /* the dispatcher has to copy the info for deferred handlers */
+    memset(&info, 0, sizeof(info));
+}
+
+static unsigned _process_deferred(void)
+{
+    unsigned n = 0;
+    event_t *event;
+
+    while ((event = event_get(&_queue))) {
+        event->handler(event);
+        n++;
+    }
+    return n;
+}
+
+static void _test_subscriptions(void)
+{
+    puts("Testing subscriptions ...");
+
+    expect(esp_event_subscribe(&_urgent_a1) == 0);
+    expect(esp_event_subscribe(&_urgent_a2) == 0);
+    expect(esp_event_subscribe(&_urgent_b) == 0);
+
+    /* only the handlers of the event ID are called in subscription order */
+    _calls_numof = 0;
+    _dispatch(EVENT_A, 10);
+    expect(_calls_numof == 2);
+    expect(_calls[0].tag == 1 && _calls[0].id == EVENT_A);
+    expect(_calls[1].tag == 2 && _calls[1].data == 10);
+
+    _calls_numof = 0;
+    _dispatch(EVENT_B, 11);
+    expect(_calls_numof == 1);
+    expect(_calls[0].tag == 4 && _calls[0].id == EVENT_B);
+
+    /* events without subscriptions are ignored */
+    _calls_numof = 0;
+    _dispatch(EVENT_A + 1, 12);
+    expect(_calls_numof == 0);
+
+    expect(esp_event_unsubscribe(&_urgent_a1) == 0);
+    expect(esp_event_unsubscribe(&_urgent_a1) == -ENOENT);
+    _dispatch(EVENT_A, 13);
+    expect(_calls_numof == 1 && _calls[0].tag == 2);
+
+    esp_event_sub_t invalid = {
+        .id = ESP_EVENT_ID_NUMOF, .handler = _handler
+    };
+    expect(esp_event_subscribe(&invalid) == -EINVAL);
+
+    puts("Done");
+}
+
+static void _test_deferred(void)
+{
+    puts("Testing deferred handlers ...");
+
+    expect(esp_event_subscribe(&_deferred_a) == 0);
+
+    /* the urgent handler is called at once, the deferred one later */
+    _calls_numof = 0;
+    _dispatch(EVENT_A, 20);
+    expect(_calls_numof == 1 && _calls[0].tag == 2);
+    expect(_process_deferred() == 1);
+    expect(_calls_numof == 2);
+    expect(_calls[1].tag == 3 && _calls[1].id == EVENT_A);
+    expect(_calls[1].data == 20);
+
+    /* the events are handled in the order in which they were dispatched */
+    _calls_numof = 0;
+    _dispatch(EVENT_A, 21);
+    _dispatch(EVENT_A, 22);
+    expect(_calls_numof == 2);
+    expect(_process_deferred() == 2);
+    expect(_calls_numof == 4);
+    expect(_calls[2].tag == 3 && _calls[2].data == 21);
+    expect(_calls[3].tag == 3 && _calls[3].data == 22);
+
+    puts("Done");
+}
+
+static void _test_overflow(void)
+{
+    puts("Testing overflow ...");
+
+    /* if all slots are in use, the deferred handler is called directly */
+    _calls_numof = 0;
+    for (unsigned i = 0; i < ESP_EVENT_DEFER_NUMOF + 1; i++) {
+        _dispatch(EVENT_A, 30 + i);
+    }
+    expect(_calls_numof == ESP_EVENT_DEFER_NUMOF + 2);
+    expect(_calls[_calls_numof - 1].tag == 3);
+    expect(_calls[_calls_numof - 1].data == 30 + ESP_EVENT_DEFER_NUMOF);
+
+    expect(_process_deferred() == ESP_EVENT_DEFER_NUMOF);
+    expect(_calls_numof == 2 * ESP_EVENT_DEFER_NUMOF + 2);
+    expect(_calls[_calls_numof - 1].data == 30 + ESP_EVENT_DEFER_NUMOF - 1);
+
+    /* the slots are free again */
+    _calls_numof = 0;
+    _dispatch(EVENT_A, 40);
+    expect(_calls_numof == 1);
+    expect(_process_deferred() == 1);
+
+    puts("Done");
+}
+
+static void _test_stats(void)
+{
+    esp_event_stats_t stats;
+
+    puts("Testing statistics ...");
+
+    esp_event_dispatch_get_stats(EVENT_A, &stats);
+    printf("event %u: count=%" PRIu32 " deferred=%" PRIu32
+           " overflows=%" PRIu32 " latency max=%" PRIu32 " us\n",
+           EVENT_A, stats.count, stats.deferred, stats.overflows,
+           stats.latency_max);
+    expect(stats.count == 7 + ESP_EVENT_DEFER_NUMOF);
+    expect(stats.deferred == 4 + ESP_EVENT_DEFER_NUMOF);
+    expect(stats.overflows == 1);
+    expect(stats.latency_sum >= stats.latency_max);
+
+    esp_event_dispatch_get_stats(EVENT_B, &stats);
+    expect(stats.count == 1 && stats.deferred == 0 && stats.overflows == 0);
+
+    esp_event_dispatch_get_stats(EVENT_A + 1, &stats);
+    expect(stats.count == 1 && stats.latency_max <= stats.latency_sum);
+
+    puts("Done");
+}
+
+int main(void)
+{
+    event_queue_init(&_queue);
+    esp_event_dispatch_init(&_queue);
+
+    _test_subscriptions();
+    _test_deferred();
+    _test_overflow();
+    _test_stats();
+
+    puts("SUCCESS");
+    return 0;
+}
@@ -0,0 +1,36 @@
+/*
+ * Copyright (C) 2021 Gunar Schorcht
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Native replacement of the ESP SDK memory attributes
+ *
+ * @author      Gunar Schorcht <gunar@schorcht.net>
+ */
+
+#ifndef ESP_ATTR_H
+#define ESP_ATTR_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Code is placed in IRAM on the ESP SoCs, there is no IRAM on native
+ */
+#define IRAM_ATTR
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ESP_ATTR_H */
+/** @} */
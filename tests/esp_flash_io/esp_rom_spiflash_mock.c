@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2021 Gunar Schorcht
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Emulation of the ESP32 ROM SPI flash functions
+ *
+ * Besides emulating the flash, the ROM functions check the constraints of
+ * the real ones: they are only called with the flash cache disabled, with
+ * word aligned addresses, buffers and lengths, and never with buffers in
+ * SPI RAM.
+ *
+ * @author      Gunar Schorcht <gunar@schorcht.net>
+ * @}
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "irq.h"
+#include "rom/spi_flash.h"
+
+#include "esp_flash_io.h"
+
+uint8_t mock_ext_ram[MOCK_EXT_RAM_SIZE];
+unsigned mock_rom_calls;
+
+static uint32_t _flash[MOCK_FLASH_SIZE >> 2];
+static bool _cache_disabled;
+static bool _fail;
+
+static void _check(uint32_t addr, const void *buf, int32_t len)
+{
+    const uint8_t *ptr = buf;
+
+    if (!_cache_disabled) {
+        puts("ROM function called with enabled flash cache");
+        abort();
+    }
+    if ((addr & 0x3) || ((uintptr_t)buf & 0x3) || (len & 0x3) || (len <= 0) ||
+        (addr + len > MOCK_FLASH_SIZE)) {
+        printf("ROM function called with addr=%08x buf=%p len=%d\n",
+               (unsigned)addr, buf, (int)len);
+        abort();
+    }
+    if ((ptr + len > mock_ext_ram) &&
+        (ptr < mock_ext_ram + MOCK_EXT_RAM_SIZE)) {
+        puts("ROM function called with buffer in SPI RAM");
+        abort();
+    }
+    mock_rom_calls++;
+}
+
+esp_rom_spiflash_result_t esp_rom_spiflash_read(uint32_t src_addr,
+                                                uint32_t *dest, int32_t len)
+{
+    _check(src_addr, dest, len);
+    if (_fail) {
+        return ESP_ROM_SPIFLASH_RESULT_ERR;
+    }
+    memcpy(dest, &_flash[src_addr >> 2], len);
+    return ESP_ROM_SPIFLASH_RESULT_OK;
+}
+
+esp_rom_spiflash_result_t esp_rom_spiflash_write(uint32_t dest_addr,
+                                                 const uint32_t *src,
+                                                 int32_t len)
+{
+    _check(dest_addr, src, len);
+    if (_fail) {
+        return ESP_ROM_SPIFLASH_RESULT_ERR;
+    }
+    for (int32_t i = 0; i < (len >> 2); i++) {
+        /* NOR flash can only clear bits */
+        _flash[(dest_addr >> 2) + i] &= src[i];
+    }
+    return ESP_ROM_SPIFLASH_RESULT_OK;
+}
+
+void mock_flash_erase(uint32_t addr, uint32_t len)
+{
+    memset((uint8_t *)_flash + addr, 0xff, len);
+}
+
+const uint8_t *mock_flash_data(void)
+{
+    return (const uint8_t *)_flash;
+}
+
+void mock_flash_fail(bool fail)
+{
+    _fail = fail;
+}
+
+unsigned esp_flash_io_enter(void)
+{
+    unsigned state = irq_disable();
+    _cache_disabled = true;
+    return state;
+}
+
+void esp_flash_io_exit(unsigned state)
+{
+    _cache_disabled = false;
+    irq_restore(state);
+}
+
+bool esp_flash_io_is_internal(const void *ptr, size_t len)
+{
+    const uint8_t *p = ptr;
+    return (p + len <= mock_ext_ram) || (p >= mock_ext_ram + MOCK_EXT_RAM_SIZE);
+}
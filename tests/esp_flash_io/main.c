@@ -0,0 +1,220 @@
+/*
+ * Copyright (C) 2021 Gunar Schorcht
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test of the chunked SPI flash access with read cache
+ *
+ * Module `esp_flash_io` is driven against an emulation of the ESP32 ROM
+ * SPI flash functions, the same way the MTD driver of the ESP SoCs does.
+ * Reads and writes are tested with all alignments of flash addresses and
+ * buffers, with buffers in internal RAM and in emulated SPI RAM. The number
+ * of ROM function calls shows the effect of the direct path and the cache.
+ *
+ * @author      Gunar Schorcht <gunar@schorcht.net>
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "esp_flash_io.h"
+#include "kernel_defines.h"
+#include "rom/spi_flash.h"
+
+#include "test_utils/expect.h"
+
+#define SECTOR_SIZE     (4096U)
+#define WRITE_REGION    (0x8000U)
+#define WRITE_SIZE      (0x8000U)
+
+static const size_t _lens[] = {
+    0, 1, 2, 3, 4, 5, 7, 8, 63, 64, 65, 255, 256, 257, 4095, 4096, 4097, 5000
+};
+
+static uint8_t _buf[2 * SECTOR_SIZE + 8];
+static uint8_t _expected[WRITE_SIZE];
+
+static void _init_flash(void)
+{
+    /* write a pattern to the whole flash in aligned pieces */
+    mock_flash_erase(0, MOCK_FLASH_SIZE);
+    esp_flash_io_invalidate(0, MOCK_FLASH_SIZE);
+
+    for (uint32_t addr = 0; addr < MOCK_FLASH_SIZE; addr += SECTOR_SIZE) {
+        for (unsigned i = 0; i < SECTOR_SIZE; i++) {
+            _buf[i] = (addr + i) * 7 + ((addr + i) >> 8);
+        }
+        expect(esp_flash_io_write(addr, _buf, SECTOR_SIZE) ==
+               ESP_ROM_SPIFLASH_RESULT_OK);
+        expect(memcmp(mock_flash_data() + addr, _buf, SECTOR_SIZE) == 0);
+    }
+}
+
+static void _test_read(uint8_t *buf)
+{
+    for (unsigned i = 0; i < ARRAY_SIZE(_lens); i++) {
+        for (unsigned addr_off = 0; addr_off < 4; addr_off++) {
+            for (unsigned buf_off = 0; buf_off < 4; buf_off++) {
+                uint32_t addr = 0x3000 - 64 + addr_off;
+                memset(buf, 0, _lens[i] + 8);
+                expect(esp_flash_io_read(addr, buf + buf_off, _lens[i]) ==
+                       ESP_ROM_SPIFLASH_RESULT_OK);
+                expect(memcmp(buf + buf_off, mock_flash_data() + addr,
+                              _lens[i]) == 0);
+                /* nothing was written behind the buffer */
+                expect(buf[buf_off + _lens[i]] == 0);
+            }
+        }
+    }
+}
+
+static void _test_write(uint8_t *buf)
+{
+    uint32_t addr = WRITE_REGION;
+    unsigned n = 0;
+
+    mock_flash_erase(WRITE_REGION, WRITE_SIZE);
+    esp_flash_io_invalidate(WRITE_REGION, WRITE_SIZE);
+    memset(_expected, 0xff, sizeof(_expected));
+
+    for (unsigned i = 0; i < ARRAY_SIZE(_lens); i++) {
+        for (unsigned buf_off = 0; buf_off < 4; buf_off++) {
+            size_t len = _lens[i];
+            if (addr + len > WRITE_REGION + WRITE_SIZE) {
+                break;
+            }
+            for (unsigned j = 0; j < len; j++) {
+                buf[buf_off + j] = n++;
+            }
+            expect(esp_flash_io_write(addr, buf + buf_off, len) ==
+                   ESP_ROM_SPIFLASH_RESULT_OK);
+            memcpy(&_expected[addr - WRITE_REGION], buf + buf_off, len);
+            /* the gap of 1 byte changes the alignment of the next write */
+            addr += len + 1;
+        }
+    }
+    expect(memcmp(mock_flash_data() + WRITE_REGION, _expected,
+                  WRITE_SIZE) == 0);
+
+    /* read back through the cache */
+    for (uint32_t off = 0; off < WRITE_SIZE; off += 1000) {
+        size_t len = (off + 1000 < WRITE_SIZE) ? 1000 : WRITE_SIZE - off;
+        expect(esp_flash_io_read(WRITE_REGION + off, buf, len) ==
+               ESP_ROM_SPIFLASH_RESULT_OK);
+        expect(memcmp(buf, &_expected[off], len) == 0);
+    }
+}
+
+static void _test_cache(void)
+{
+    esp_flash_io_stats_t stats;
+    uint8_t data[16];
+
+    puts("Testing cache ...");
+
+    esp_flash_io_invalidate(0, MOCK_FLASH_SIZE);
+    esp_flash_io_reset_stats();
+
+    /* the first read fills the line, the second one is served from it */
+    mock_rom_calls = 0;
+    expect(esp_flash_io_read(0x0100, data, 16) == ESP_ROM_SPIFLASH_RESULT_OK);
+    expect(mock_rom_calls == SECTOR_SIZE / ESP_FLASH_IO_CHUNK_SIZE);
+    expect(esp_flash_io_read(0x0200, data, 16) == ESP_ROM_SPIFLASH_RESULT_OK);
+    expect(mock_rom_calls == SECTOR_SIZE / ESP_FLASH_IO_CHUNK_SIZE);
+    expect(memcmp(data, mock_flash_data() + 0x0200, 16) == 0);
+
+    /* a read across the line boundary uses both lines */
+    expect(esp_flash_io_read(0x0ffc, data, 8) == ESP_ROM_SPIFLASH_RESULT_OK);
+    expect(memcmp(data, mock_flash_data() + 0x0ffc, 8) == 0);
+
+    esp_flash_io_get_stats(&stats);
+    expect(stats.reads == 3);
+    expect(stats.cache_misses == 2 && stats.cache_hits == 2);
+
+    /* writes invalidate the affected line only */
+    expect(esp_flash_io_write(0x1010, "\x0f\x0f\x0f\x0f", 4) ==
+           ESP_ROM_SPIFLASH_RESULT_OK);
+    esp_flash_io_get_stats(&stats);
+    expect(stats.invalidations == 1);
+    mock_rom_calls = 0;
+    expect(esp_flash_io_read(0x0100, data, 16) == ESP_ROM_SPIFLASH_RESULT_OK);
+    expect(mock_rom_calls == 0);
+    expect(esp_flash_io_read(0x1010, data, 4) == ESP_ROM_SPIFLASH_RESULT_OK);
+    expect(mock_rom_calls > 0);
+    expect(memcmp(data, mock_flash_data() + 0x1010, 4) == 0);
+
+    /* erased lines have to be invalidated */
+    mock_flash_erase(0, SECTOR_SIZE);
+    esp_flash_io_invalidate(0, SECTOR_SIZE);
+    expect(esp_flash_io_read(0x0100, data, 16) == ESP_ROM_SPIFLASH_RESULT_OK);
+    expect(data[0] == 0xff && data[15] == 0xff);
+
+    /* a line is not used if filling it failed */
+    esp_flash_io_invalidate(0, MOCK_FLASH_SIZE);
+    mock_flash_fail(true);
+    expect(esp_flash_io_read(0x2000, data, 16) != ESP_ROM_SPIFLASH_RESULT_OK);
+    mock_flash_fail(false);
+    expect(esp_flash_io_read(0x2000, data, 16) == ESP_ROM_SPIFLASH_RESULT_OK);
+    expect(memcmp(data, mock_flash_data() + 0x2000, 16) == 0);
+
+    puts("Done");
+}
+
+static void _bench(void)
+{
+    esp_flash_io_stats_t stats;
+    uint8_t data[32];
+
+    _init_flash();
+
+    esp_flash_io_reset_stats();
+    mock_rom_calls = 0;
+    for (unsigned i = 0; i < 1000; i++) {
+        esp_flash_io_read((i * 32) % SECTOR_SIZE, data, sizeof(data));
+    }
+    esp_flash_io_get_stats(&stats);
+    printf("Reading 1.000 x 32 bytes: %u ROM calls, %u cache hits\n",
+           mock_rom_calls, (unsigned)stats.cache_hits);
+
+    mock_rom_calls = 0;
+    for (uint32_t addr = 0; addr < MOCK_FLASH_SIZE; addr += 2 * SECTOR_SIZE) {
+        esp_flash_io_read(addr, _buf, 2 * SECTOR_SIZE);
+    }
+    printf("Reading 64 kByte to internal RAM: %u ROM calls\n", mock_rom_calls);
+
+    mock_rom_calls = 0;
+    for (uint32_t addr = 0; addr < MOCK_FLASH_SIZE; addr += 2 * SECTOR_SIZE) {
+        esp_flash_io_read(addr, mock_ext_ram, 2 * SECTOR_SIZE);
+    }
+    printf("Reading 64 kByte to SPI RAM: %u ROM calls\n", mock_rom_calls);
+}
+
+int main(void)
+{
+    _init_flash();
+
+    puts("Testing read ...");
+    _test_read(_buf);
+    _test_read(mock_ext_ram);
+    puts("Done");
+
+    puts("Testing write ...");
+    _test_write(_buf);
+    _test_write(mock_ext_ram);
+    puts("Done");
+
+    _test_cache();
+    _bench();
+
+    puts("SUCCESS");
+    return 0;
+}
@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2021 Gunar Schorcht
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Emulation of the ESP32 ROM SPI flash functions
+ *
+ * Only the part of the ESP-IDF interface used by module `esp_flash_io` is
+ * emulated. The flash is emulated in RAM with the semantics of NOR flash,
+ * i.e. writing can only clear bits.
+ *
+ * @author      Gunar Schorcht <gunar@schorcht.net>
+ */
+
+#ifndef ROM_SPI_FLASH_H
+#define ROM_SPI_FLASH_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ESP_ROM_SPIFLASH_BUFF_BYTE_WRITE_NUM    32
+#define ESP_ROM_SPIFLASH_BUFF_BYTE_READ_NUM     64
+
+typedef enum {
+    ESP_ROM_SPIFLASH_RESULT_OK,
+    ESP_ROM_SPIFLASH_RESULT_ERR,
+    ESP_ROM_SPIFLASH_RESULT_TIMEOUT
+} esp_rom_spiflash_result_t;
+
+esp_rom_spiflash_result_t esp_rom_spiflash_read(uint32_t src_addr,
+                                                uint32_t *dest, int32_t len);
+
+esp_rom_spiflash_result_t esp_rom_spiflash_write(uint32_t dest_addr,
+                                                 const uint32_t *src,
+                                                 int32_t len);
+
+/**
+ * @name    Control of the emulation
+ * @{
+ */
+#define MOCK_FLASH_SIZE     (64 * 1024U)    /**< size of the flash */
+#define MOCK_EXT_RAM_SIZE   (8 * 1024U)     /**< size of the SPI RAM */
+
+/**
+ * @brief   Emulated SPI RAM, it must not be accessed by the ROM functions
+ */
+extern uint8_t mock_ext_ram[MOCK_EXT_RAM_SIZE];
+
+/**
+ * @brief   Number of calls of the ROM functions
+ */
+extern unsigned mock_rom_calls;
+
+/**
+ * @brief   Erase a region of the flash, bypassing module `esp_flash_io`
+ */
+void mock_flash_erase(uint32_t addr, uint32_t len);
+
+/**
+ * @brief   Content of the flash
+ */
+const uint8_t *mock_flash_data(void);
+
+/**
+ * @brief   Let all further ROM function calls fail or succeed
+ */
+void mock_flash_fail(bool fail);
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ROM_SPI_FLASH_H */
+/** @} */
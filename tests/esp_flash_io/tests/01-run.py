@@ -0,0 +1,27 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2021 Gunar Schorcht
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    child.expect_exact("Testing read ...")
+    child.expect_exact("Done")
+    child.expect_exact("Testing write ...")
+    child.expect_exact("Done")
+    child.expect_exact("Testing cache ...")
+    child.expect_exact("Done")
+    child.expect_exact("Reading 1.000 x 32 bytes: 16 ROM calls, 999 cache hits")
+    child.expect_exact("Reading 64 kByte to internal RAM: 256 ROM calls")
+    child.expect_exact("Reading 64 kByte to SPI RAM: 1024 ROM calls")
+    child.expect_exact("SUCCESS")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
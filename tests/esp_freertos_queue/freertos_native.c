@@ -0,0 +1,47 @@
+/*
+ * Copyright (C) 2021 Gunar Schorcht
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Critical sections of the FreeRTOS adaption layer for native
+ *
+ * On the ESP SoCs, they are implemented in cpu/esp_common/freertos/task.c
+ * using the thread extensions of the ESP CPUs. Only the interrupt level
+ * has to be saved here, as no thread yields inside a critical section.
+ *
+ * @author      Gunar Schorcht <gunar@schorcht.net>
+ * @}
+ */
+
+#include "irq.h"
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+static unsigned _nesting;
+static unsigned _state;
+
+void vTaskEnterCritical(portMUX_TYPE *mux)
+{
+    (void)mux;
+    unsigned state = irq_disable();
+    if (_nesting++ == 0) {
+        _state = state;
+    }
+}
+
+void vTaskExitCritical(portMUX_TYPE *mux)
+{
+    (void)mux;
+    if (--_nesting == 0) {
+        irq_restore(_state);
+    }
+}
@@ -0,0 +1,33 @@
+/*
+ * Copyright (C) 2021 Gunar Schorcht
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Empty native replacement of the ESP system call header
+ *
+ * @author      Gunar Schorcht <gunar@schorcht.net>
+ */
+
+#ifndef SYSCALLS_H
+#define SYSCALLS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* the queue does not use any ESP system call on native */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SYSCALLS_H */
+/** @} */
@@ -0,0 +1,211 @@
+/*
+ * Copyright (C) 2021 Gunar Schorcht
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test and benchmark of the queue of the ESP FreeRTOS adaption
+ *              layer
+ *
+ * The queue in cpu/esp_common/freertos/queue.c is used by the ESP WiFi and
+ * BT binary blobs. It only depends on RIOT threads and the scheduler, so it
+ * is tested on native.
+ *
+ * @author      Gunar Schorcht <gunar@schorcht.net>
+ * @}
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include "fmt.h"
+#include "thread.h"
+#include "timex.h"
+#include "xtimer.h"
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+
+#include "test_utils/expect.h"
+
+#define BENCH_OPS   (100000UL)
+
+typedef struct {
+    uint32_t a;
+    uint16_t b;
+    uint8_t c[5];
+} item_t;
+
+static char _stack[THREAD_STACKSIZE_DEFAULT];
+
+static void _test_pointer_items(void)
+{
+    int values[5];
+    int *ptr;
+
+    puts("Testing pointer items ...");
+
+    QueueHandle_t queue = xQueueCreate(4, sizeof(int *));
+    expect(queue != NULL);
+    expect(xQueueReceive(queue, &ptr, 0) == errQUEUE_EMPTY);
+
+    /* wrap around a few times */
+    for (unsigned n = 0; n < 3; n++) {
+        for (unsigned i = 0; i < 4; i++) {
+            ptr = &values[i];
+            expect(xQueueSend(queue, &ptr, 0) == pdPASS);
+        }
+        ptr = &values[4];
+        expect(xQueueSend(queue, &ptr, 0) == errQUEUE_FULL);
+        expect(uxQueueMessagesWaiting(queue) == 4);
+
+        for (unsigned i = 0; i < 4; i++) {
+            expect(xQueueReceive(queue, &ptr, 0) == pdPASS);
+            expect(ptr == &values[i]);
+        }
+        expect(xQueueReceive(queue, &ptr, 0) == errQUEUE_EMPTY);
+    }
+
+    vQueueDelete(queue);
+    puts("Done");
+}
+
+static void _test_struct_items(void)
+{
+    item_t in = { .a = 0x12345678, .b = 0xabcd, .c = { 1, 2, 3, 4, 5 } };
+    item_t out;
+
+    puts("Testing struct items ...");
+
+    /* length is not a power of two */
+    QueueHandle_t queue = xQueueCreate(3, sizeof(item_t));
+    expect(queue != NULL);
+
+    for (unsigned i = 0; i < 10; i++) {
+        in.a = i;
+        expect(xQueueSend(queue, &in, 0) == pdPASS);
+        expect(xQueueGenericReceive(queue, &out, 0, pdTRUE) == pdPASS);
+        expect(uxQueueMessagesWaiting(queue) == 1);
+        expect(xQueueReceive(queue, &out, 0) == pdPASS);
+        expect(out.a == i && out.b == in.b && out.c[4] == in.c[4]);
+    }
+
+    /* front insertion has to wrap at index 0 */
+    in.a = 1;
+    expect(xQueueGenericSend(queue, &in, 0, queueSEND_TO_BACK) == pdPASS);
+    in.a = 0;
+    expect(xQueueGenericSend(queue, &in, 0, queueSEND_TO_FRONT) == pdPASS);
+    in.a = 2;
+    expect(xQueueGenericSend(queue, &in, 0, queueSEND_TO_BACK) == pdPASS);
+    expect(xQueueGenericSend(queue, &in, 0, queueSEND_TO_FRONT) == errQUEUE_FULL);
+    for (unsigned i = 0; i < 3; i++) {
+        expect(xQueueReceive(queue, &out, 0) == pdPASS);
+        expect(out.a == i);
+    }
+    vQueueDelete(queue);
+
+    /* overwriting a mailbox */
+    queue = xQueueCreate(1, sizeof(item_t));
+    for (unsigned i = 0; i < 3; i++) {
+        in.a = i;
+        expect(xQueueGenericSend(queue, &in, 0, queueOVERWRITE) == pdPASS);
+    }
+    expect(uxQueueMessagesWaiting(queue) == 1);
+    expect(xQueueReceive(queue, &out, 0) == pdPASS);
+    expect(out.a == 2);
+    vQueueDelete(queue);
+
+    /* counting semaphores are queues with items of size 0 */
+    queue = xQueueCreateCountingSemaphore(5, 2);
+    expect(uxQueueMessagesWaiting(queue) == 2);
+    expect(xQueueReceive(queue, NULL, 0) == pdPASS);
+    expect(xQueueReceive(queue, NULL, 0) == pdPASS);
+    expect(xQueueReceive(queue, NULL, 0) == errQUEUE_EMPTY);
+    vQueueDelete(queue);
+
+    puts("Done");
+}
+
+static void *_receiver(void *arg)
+{
+    QueueHandle_t queue = arg;
+    uint32_t value;
+
+    while (1) {
+        xQueueReceive(queue, &value, portMAX_DELAY);
+        if (value == UINT32_MAX) {
+            break;
+        }
+    }
+    return NULL;
+}
+
+static void _test_blocking(void)
+{
+    uint32_t waits;
+    uint32_t wakeups;
+
+    puts("Testing waits and wakeups ...");
+
+    QueueHandle_t queue = xQueueCreate(2, sizeof(uint32_t));
+    vQueueGetStats(queue, &waits, &wakeups);
+    expect(waits == 0 && wakeups == 0);
+
+    /* the receiver has a higher priority and waits for the queue at once */
+    thread_create(_stack, sizeof(_stack), THREAD_PRIORITY_MAIN - 1,
+                  THREAD_CREATE_STACKTEST, _receiver, queue, "receiver");
+
+    for (uint32_t i = 0; i < 10; i++) {
+        expect(xQueueSend(queue, &i, portMAX_DELAY) == pdPASS);
+        /* the receiver took the item before we got back */
+        expect(uxQueueMessagesWaiting(queue) == 0);
+    }
+    uint32_t last = UINT32_MAX;
+    expect(xQueueSend(queue, &last, portMAX_DELAY) == pdPASS);
+
+    vQueueGetStats(queue, &waits, &wakeups);
+    expect(waits == 11 && wakeups == 11);
+
+    vQueueDelete(queue);
+    puts("Done");
+}
+
+static void _bench(const char *name, UBaseType_t len, UBaseType_t size)
+{
+    item_t item = { 0 };
+    QueueHandle_t queue = xQueueCreate(len, size);
+
+    uint32_t start = xtimer_now_usec();
+    for (unsigned long i = 0; i < BENCH_OPS; i++) {
+        xQueueSend(queue, &item, 0);
+        xQueueReceive(queue, &item, 0);
+    }
+    uint32_t time = xtimer_now_usec() - start;
+
+    vQueueDelete(queue);
+
+    print_str(name);
+    print_str(": ");
+    print_u32_dec((uint64_t)BENCH_OPS * 2 * US_PER_SEC / (time ? time : 1));
+    print_str(" ops/s\n");
+}
+
+int main(void)
+{
+    _test_pointer_items();
+    _test_struct_items();
+    _test_blocking();
+
+    _bench("Queue of 8 pointers", 8, sizeof(void *));
+    _bench("Queue of 5 structs", 5, sizeof(item_t));
+
+    puts("SUCCESS");
+    return 0;
+}
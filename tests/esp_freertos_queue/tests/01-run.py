@@ -0,0 +1,26 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2021 Gunar Schorcht
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    child.expect_exact("Testing pointer items ...")
+    child.expect_exact("Done")
+    child.expect_exact("Testing struct items ...")
+    child.expect_exact("Done")
+    child.expect_exact("Testing waits and wakeups ...")
+    child.expect_exact("Done")
+    child.expect(r"Queue of 8 pointers: [0-9]+ ops/s\r\n")
+    child.expect(r"Queue of 5 structs: [0-9]+ ops/s\r\n")
+    child.expect_exact("SUCCESS")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
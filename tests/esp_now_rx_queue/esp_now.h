@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2021 Gunar Schorcht
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Stub of the send and receive callback interface of the
+ *              ESP-NOW library
+ *
+ * Frames sent with esp_now_send() are looped back to the registered receive
+ * callback with the address of the stub as source, followed by the send
+ * callback, like the library does from the context of its `wifi` thread.
+ *
+ * @author      Gunar Schorcht <gunar@schorcht.net>
+ */
+
+#ifndef ESP_NOW_H
+#define ESP_NOW_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef int esp_err_t;                  /**< ESP-IDF error type */
+
+#define ESP_OK      (0)                 /**< ESP-IDF success code */
+#define ESP_FAIL    (-1)                /**< ESP-IDF generic failure code */
+
+/**
+ * @brief   Status of a sent frame
+ */
+typedef enum {
+    ESP_NOW_SEND_SUCCESS = 0,           /**< frame was acknowledged */
+    ESP_NOW_SEND_FAIL,                  /**< frame was not acknowledged */
+} esp_now_send_status_t;
+
+/**
+ * @brief   Receive callback
+ */
+typedef void (*esp_now_recv_cb_t)(const uint8_t *mac, const uint8_t *data,
+                                  int len);
+
+/**
+ * @brief   Send callback
+ */
+typedef void (*esp_now_send_cb_t)(const uint8_t *mac,
+                                  esp_now_send_status_t status);
+
+/**
+ * @brief   Register the receive callback
+ */
+esp_err_t esp_now_register_recv_cb(esp_now_recv_cb_t cb);
+
+/**
+ * @brief   Register the send callback
+ */
+esp_err_t esp_now_register_send_cb(esp_now_send_cb_t cb);
+
+/**
+ * @brief   Send a frame, which the stub loops back
+ */
+esp_err_t esp_now_send(const uint8_t *peer_addr, const uint8_t *data,
+                       size_t len);
+
+/**
+ * @brief   Let the stub receive a frame from @p mac
+ */
+void esp_now_stub_rx(const uint8_t *mac, const uint8_t *data, int len);
+
+/**
+ * @brief   Address the stub uses as source of looped back frames
+ */
+extern const uint8_t esp_now_stub_mac[6];
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ESP_NOW_H */
+/** @} */
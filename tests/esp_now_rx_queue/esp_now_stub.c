@@ -0,0 +1,60 @@
+/*
+ * Copyright (C) 2021 Gunar Schorcht
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Stub of the send and receive callback interface of the
+ *              ESP-NOW library
+ *
+ * @author      Gunar Schorcht <gunar@schorcht.net>
+ * @}
+ */
+
+#include <stddef.h>
+
+#include "esp_now.h"
+
+const uint8_t esp_now_stub_mac[6] = { 0x82, 0x73, 0x79, 0x84, 0x79, 0x83 };
+
+static esp_now_recv_cb_t _recv_cb;
+static esp_now_send_cb_t _send_cb;
+
+esp_err_t esp_now_register_recv_cb(esp_now_recv_cb_t cb)
+{
+    _recv_cb = cb;
+    return ESP_OK;
+}
+
+esp_err_t esp_now_register_send_cb(esp_now_send_cb_t cb)
+{
+    _send_cb = cb;
+    return ESP_OK;
+}
+
+esp_err_t esp_now_send(const uint8_t *peer_addr, const uint8_t *data,
+                       size_t len)
+{
+    if (len > 250) {
+        return ESP_FAIL;
+    }
+    esp_now_stub_rx(esp_now_stub_mac, data, len);
+    if (_send_cb) {
+        _send_cb(peer_addr ? peer_addr : esp_now_stub_mac, ESP_NOW_SEND_SUCCESS);
+    }
+    return ESP_OK;
+}
+
+void esp_now_stub_rx(const uint8_t *mac, const uint8_t *data, int len)
+{
+    if (_recv_cb) {
+        _recv_cb(mac, data, len);
+    }
+}
@@ -0,0 +1,223 @@
+/*
+ * Copyright (C) 2021 Gunar Schorcht
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test of the ESP-NOW RX frame queue and peer table
+ *
+ * The queue is filled through a stub of the ESP-NOW library callbacks and
+ * drained in batches the way the `esp_now` netdev driver delivers frames to
+ * `gnrc_netif`.
+ *
+ * @author      Gunar Schorcht <gunar@schorcht.net>
+ * @}
+ */
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "esp_now.h"
+#include "esp_now_rx_queue.h"
+
+#include "test_utils/expect.h"
+
+static esp_now_rx_queue_t _queue;
+static esp_now_peer_table_t _peers;
+
+static unsigned _isr_events;
+static unsigned _send_done;
+
+static uint8_t _frame[ESP_NOW_RX_FRAME_MAX_LEN];
+static uint8_t _netif_buf[ESP_NOW_RX_ADDR_LEN + ESP_NOW_RX_FRAME_MAX_LEN];
+
+static const uint8_t _mac_a[] = { 0x24, 0x0a, 0xc4, 0x01, 0x02, 0x03 };
+static const uint8_t _mac_b[] = { 0x24, 0x0a, 0xc4, 0x01, 0x02, 0x04 };
+static const uint8_t _mac_c[] = { 0x24, 0x0a, 0xc4, 0x99, 0x98, 0x97 };
+
+/* receive callback of the driver */
+static void _recv_cb(const uint8_t *mac, const uint8_t *data, int len)
+{
+    if (esp_now_rx_queue_put(&_queue, &_peers, mac, data, len)) {
+        _isr_events++;
+    }
+}
+
+static void _send_cb(const uint8_t *mac, esp_now_send_status_t status)
+{
+    (void)mac;
+    expect(status == ESP_NOW_SEND_SUCCESS);
+    _send_done++;
+}
+
+/* the driver's isr, delivers all queued frames to the netif in one go */
+static unsigned _isr(const uint8_t *expected_mac)
+{
+    unsigned delivered = 0;
+
+    _isr_events--;
+    for (unsigned n = esp_now_rx_queue_pending(&_queue); n; n--) {
+        int size = esp_now_rx_queue_recv(&_queue, NULL, 0);
+        expect(size > ESP_NOW_RX_ADDR_LEN);
+        expect(esp_now_rx_queue_recv(&_queue, _netif_buf,
+                                     sizeof(_netif_buf)) == size);
+        if (expected_mac) {
+            expect(memcmp(_netif_buf, expected_mac, ESP_NOW_RX_ADDR_LEN) == 0);
+        }
+        delivered++;
+    }
+    return delivered;
+}
+
+static void _rx(const uint8_t *mac, uint8_t tag, int len)
+{
+    memset(_frame, tag, len);
+    esp_now_stub_rx(mac, _frame, len);
+}
+
+static void test_burst(void)
+{
+    puts("Testing burst ...");
+
+    esp_now_rx_queue_init(&_queue);
+    esp_now_peer_table_init(&_peers);
+    expect(esp_now_peer_add(&_peers, _mac_a));
+    expect(esp_now_peer_add(&_peers, _mac_b));
+
+    /* a burst larger than the queue, the netif thread does not get to run */
+    for (unsigned i = 0; i < ESP_NOW_RX_QUEUE_LEN; i++) {
+        _rx(_mac_a, i, 10 + i);
+    }
+    _rx(_mac_a, 0xa0, 10);
+    _rx(_mac_b, 0xb0, 10);
+    _rx(_mac_b, 0xb1, 10);
+    _rx(_mac_c, 0xc0, 10);
+
+    expect(esp_now_rx_queue_pending(&_queue) == ESP_NOW_RX_QUEUE_LEN);
+    expect(_queue.dropped == 4);
+    expect(esp_now_peer_find(&_peers, _mac_a)->rx_dropped == 1);
+    expect(esp_now_peer_find(&_peers, _mac_b)->rx_dropped == 2);
+    /* unknown senders are only counted in total */
+    expect(esp_now_peer_find(&_peers, _mac_c) == NULL);
+
+    /* the first event delivers the whole burst in order */
+    expect(_isr_events == ESP_NOW_RX_QUEUE_LEN);
+    uint8_t tail = _queue.tail;
+    expect(_isr(_mac_a) == ESP_NOW_RX_QUEUE_LEN);
+    expect((uint8_t)(_queue.tail - tail) == ESP_NOW_RX_QUEUE_LEN);
+    expect(_netif_buf[ESP_NOW_RX_ADDR_LEN] == ESP_NOW_RX_QUEUE_LEN - 1);
+
+    /* the remaining events find the queue empty */
+    while (_isr_events) {
+        expect(_isr(NULL) == 0);
+    }
+
+    puts("Done");
+}
+
+static void test_recv(void)
+{
+    puts("Testing recv ...");
+
+    esp_now_rx_queue_init(&_queue);
+
+    _rx(_mac_a, 1, 100);
+    _rx(_mac_b, 2, 0);
+    _rx(_mac_a, 3, ESP_NOW_RX_FRAME_MAX_LEN);
+    _rx(_mac_b, 4, 50);
+
+    expect(esp_now_rx_queue_recv(&_queue, NULL, 0) == ESP_NOW_RX_ADDR_LEN + 100);
+    expect(esp_now_rx_queue_pending(&_queue) == 4);
+
+    expect(esp_now_rx_queue_recv(&_queue, _netif_buf, sizeof(_netif_buf)) ==
+           ESP_NOW_RX_ADDR_LEN + 100);
+    expect(memcmp(_netif_buf, _mac_a, ESP_NOW_RX_ADDR_LEN) == 0);
+    expect(_netif_buf[ESP_NOW_RX_ADDR_LEN + 99] == 1);
+
+    /* frames without data carry the source address only */
+    expect(esp_now_rx_queue_recv(&_queue, _netif_buf, sizeof(_netif_buf)) ==
+           ESP_NOW_RX_ADDR_LEN);
+    expect(memcmp(_netif_buf, _mac_b, ESP_NOW_RX_ADDR_LEN) == 0);
+
+    /* too small buffer drops the frame */
+    expect(esp_now_rx_queue_recv(&_queue, _netif_buf, 100) == -ENOBUFS);
+
+    /* dropping without buffer */
+    expect(esp_now_rx_queue_recv(&_queue, NULL, 1) == ESP_NOW_RX_ADDR_LEN + 50);
+    expect(esp_now_rx_queue_recv(&_queue, _netif_buf, sizeof(_netif_buf)) == 0);
+
+    _isr_events = 0;
+    puts("Done");
+}
+
+static void test_loopback(void)
+{
+    puts("Testing send and receive callbacks ...");
+
+    esp_now_rx_queue_init(&_queue);
+
+    static const uint8_t msg[] = "hello mesh";
+    expect(esp_now_send(_mac_a, msg, sizeof(msg)) == ESP_OK);
+    expect(esp_now_send(NULL, msg, sizeof(msg)) == ESP_OK);
+    expect(_send_done == 2);
+    expect(_isr_events == 2);
+
+    expect(_isr(esp_now_stub_mac) == 2);
+    expect(memcmp(_netif_buf + ESP_NOW_RX_ADDR_LEN, msg, sizeof(msg)) == 0);
+    expect(_isr(NULL) == 0);
+
+    puts("Done");
+}
+
+static void test_peers(void)
+{
+    puts("Testing peer table ...");
+
+    esp_now_peer_table_init(&_peers);
+
+    uint8_t mac[ESP_NOW_RX_ADDR_LEN] = { 0x24, 0x0a, 0xc4, 0x00, 0x00, 0x00 };
+
+    for (unsigned i = 0; i < ESP_NOW_PEER_TABLE_SIZE; i++) {
+        mac[5] = i;
+        esp_now_peer_t *peer = esp_now_peer_add(&_peers, mac);
+        expect(peer != NULL);
+        /* adding again gives the same entry */
+        expect(esp_now_peer_add(&_peers, mac) == peer);
+    }
+    expect(_peers.numof == ESP_NOW_PEER_TABLE_SIZE);
+
+    mac[5] = ESP_NOW_PEER_TABLE_SIZE;
+    expect(esp_now_peer_add(&_peers, mac) == NULL);
+    expect(esp_now_peer_find(&_peers, mac) == NULL);
+
+    for (unsigned i = 0; i < ESP_NOW_PEER_TABLE_SIZE; i++) {
+        mac[5] = i;
+        esp_now_peer_t *peer = esp_now_peer_find(&_peers, mac);
+        expect(peer != NULL);
+        expect(memcmp(peer->mac, mac, ESP_NOW_RX_ADDR_LEN) == 0);
+    }
+
+    puts("Done");
+}
+
+int main(void)
+{
+    esp_now_register_recv_cb(_recv_cb);
+    esp_now_register_send_cb(_send_cb);
+
+    test_burst();
+    test_recv();
+    test_loopback();
+    test_peers();
+
+    puts("SUCCESS");
+    return 0;
+}
@@ -0,0 +1,26 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2021 Gunar Schorcht
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    child.expect_exact("Testing burst ...")
+    child.expect_exact("Done")
+    child.expect_exact("Testing recv ...")
+    child.expect_exact("Done")
+    child.expect_exact("Testing send and receive callbacks ...")
+    child.expect_exact("Done")
+    child.expect_exact("Testing peer table ...")
+    child.expect_exact("Done")
+    child.expect_exact("SUCCESS")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
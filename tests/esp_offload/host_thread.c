@@ -0,0 +1,63 @@
+/*
+ * Copyright (C) 2021 Gunar Schorcht
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Host thread that emulates the APP cpu
+ *
+ * The host thread runs in parallel to the RIOT process, like the APP cpu
+ * runs in parallel to the PRO cpu. It must not call any RIOT function.
+ *
+ * `pthread.h` can't be included, since it includes `sched.h` which would
+ * be the header of the RIOT kernel. Therefore the functions of the host
+ * are declared here.
+ *
+ * @author      Gunar Schorcht <gunar@schorcht.net>
+ * @}
+ */
+
+#include <signal.h>
+
+#include "host_thread.h"
+
+typedef unsigned long host_pthread_t;
+
+extern int pthread_create(host_pthread_t *thread, const void *attr,
+                          void *(*func)(void *), void *arg);
+extern int pthread_join(host_pthread_t thread, void **res);
+extern int sched_yield(void);
+
+static host_pthread_t _thread;
+
+int host_thread_start(void *(*func)(void *), void *arg)
+{
+    sigset_t all;
+    sigset_t old;
+
+    /* the signals used by native for interrupts have to be handled by the
+     * RIOT process, the host thread inherits the blocked signals */
+    sigfillset(&all);
+    pthread_sigmask(SIG_SETMASK, &all, &old);
+    int res = pthread_create(&_thread, NULL, func, arg);
+    pthread_sigmask(SIG_SETMASK, &old, NULL);
+
+    return res;
+}
+
+void host_thread_join(void)
+{
+    pthread_join(_thread, NULL);
+}
+
+void host_thread_yield(void)
+{
+    sched_yield();
+}
@@ -0,0 +1,48 @@
+/*
+ * Copyright (C) 2021 Gunar Schorcht
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Host thread that emulates the APP cpu
+ *
+ * @author      Gunar Schorcht <gunar@schorcht.net>
+ */
+
+#ifndef HOST_THREAD_H
+#define HOST_THREAD_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Start the host thread
+ *
+ * @return  0 on success
+ */
+int host_thread_start(void *(*func)(void *), void *arg);
+
+/**
+ * @brief   Wait for the host thread to terminate
+ */
+void host_thread_join(void);
+
+/**
+ * @brief   Yield the host thread
+ */
+void host_thread_yield(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HOST_THREAD_H */
+/** @} */
@@ -0,0 +1,239 @@
+/*
+ * Copyright (C) 2021 Gunar Schorcht
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Stress test of the job offloading to the APP cpu of the ESP32
+ *
+ * The executor of the APP cpu runs in a second host thread, so that the
+ * rings are really accessed in parallel. The completions are handled by
+ * polling instead of the interrupt of the PRO cpu.
+ *
+ * @author      Gunar Schorcht <gunar@schorcht.net>
+ * @}
+ */
+
+#include <errno.h>
+#include <stdio.h>
+
+#include "fmt.h"
+#include "thread.h"
+#include "timex.h"
+#include "xtimer.h"
+
+#include "esp_offload.h"
+#include "host_thread.h"
+
+#include "test_utils/expect.h"
+
+#define JOBS_NUMOF  (10000UL)
+
+typedef struct {
+    uint32_t seq;
+    uint32_t result;
+} work_t;
+
+static esp_offload_job_t _jobs[ESP_OFFLOAD_RING_SIZE];
+static work_t _work[ESP_OFFLOAD_RING_SIZE];
+static bool _busy[ESP_OFFLOAD_RING_SIZE];
+
+static uint32_t _completed;
+static uint32_t _next_seq;
+static uint32_t _notified;
+static uint32_t _stop;
+
+static char _stack[THREAD_STACKSIZE_DEFAULT];
+
+void esp_offload_notify_pro(void)
+{
+    __atomic_fetch_add(&_notified, 1, __ATOMIC_RELAXED);
+}
+
+void esp_offload_idle(void)
+{
+    host_thread_yield();
+}
+
+static void *_app_cpu(void *arg)
+{
+    (void)arg;
+
+    while (!__atomic_load_n(&_stop, __ATOMIC_ACQUIRE)) {
+        if (!esp_offload_executor_poll()) {
+            esp_offload_idle();
+        }
+    }
+    return NULL;
+}
+
+static uint32_t _hash(uint32_t x)
+{
+    for (unsigned i = 0; i < 16; i++) {
+        x = (x ^ (x >> 15)) * 0x2c1b3c6dU;
+    }
+    return x;
+}
+
+static void _work_func(void *arg)
+{
+    work_t *work = arg;
+    work->result = _hash(work->seq);
+}
+
+static void _work_done(esp_offload_job_t *job)
+{
+    work_t *work = job->arg;
+
+    /* there is only one executor, so jobs are completed in order */
+    expect(work->seq == _completed);
+    expect(work->result == _hash(work->seq));
+    _completed++;
+    _busy[(uintptr_t)job->ctx] = false;
+}
+
+static void _test_ring(void)
+{
+    esp_offload_ring_t ring = { 0 };
+
+    puts("Testing ring ...");
+
+    expect(esp_offload_ring_get(&ring) == NULL);
+
+    /* wrap around a few times */
+    for (unsigned n = 0; n < 3; n++) {
+        for (unsigned i = 0; i < ESP_OFFLOAD_RING_SIZE; i++) {
+            expect(esp_offload_ring_put(&ring, &_jobs[i]));
+        }
+        expect(!esp_offload_ring_put(&ring, &_jobs[0]));
+        for (unsigned i = 0; i < ESP_OFFLOAD_RING_SIZE; i++) {
+            expect(esp_offload_ring_get(&ring) == &_jobs[i]);
+        }
+        expect(esp_offload_ring_get(&ring) == NULL);
+    }
+
+    /* the counters overflow */
+    ring.head = ring.tail = UINT32_MAX - 1;
+    for (unsigned i = 0; i < 4; i++) {
+        expect(esp_offload_ring_put(&ring, &_jobs[0]));
+        expect(esp_offload_ring_get(&ring) == &_jobs[0]);
+    }
+
+    puts("Done");
+}
+
+static bool _submit_next(void)
+{
+    for (unsigned i = 0; i < ESP_OFFLOAD_RING_SIZE; i++) {
+        if (!_busy[i]) {
+            _work[i].seq = _next_seq;
+            _jobs[i].func = _work_func;
+            _jobs[i].arg = &_work[i];
+            _jobs[i].done = _work_done;
+            _jobs[i].ctx = (void *)(uintptr_t)i;
+            expect(esp_offload_submit(&_jobs[i]) == 0);
+            _busy[i] = true;
+            _next_seq++;
+            return true;
+        }
+    }
+    return false;
+}
+
+static void _test_executor(void)
+{
+    esp_offload_stats_t stats;
+    esp_offload_job_t job = { .func = _work_func, .arg = &_work[0] };
+    bool rejected = false;
+
+    puts("Testing executor ...");
+
+    uint32_t start = xtimer_now_usec();
+    while (_next_seq < JOBS_NUMOF) {
+        if (!_submit_next()) {
+            /* all jobs are in flight, another one is rejected */
+            if (!rejected) {
+                expect(esp_offload_submit(&job) == -ENOBUFS);
+                rejected = true;
+            }
+            esp_offload_complete();
+        }
+    }
+    while (_completed < JOBS_NUMOF) {
+        esp_offload_complete();
+    }
+    uint32_t time = xtimer_now_usec() - start;
+
+    esp_offload_get_stats(&stats);
+    expect(stats.submitted == JOBS_NUMOF);
+    expect(stats.completed == JOBS_NUMOF);
+    expect(stats.rejected == 1);
+    expect(__atomic_load_n(&_notified, __ATOMIC_RELAXED) == JOBS_NUMOF);
+
+    puts("Done");
+
+    print_str("Offloaded ");
+    print_u32_dec(JOBS_NUMOF);
+    print_str(" jobs: ");
+    print_u32_dec((uint64_t)JOBS_NUMOF * US_PER_SEC / (time ? time : 1));
+    print_str(" jobs/s\n");
+}
+
+static void *_completer(void *arg)
+{
+    (void)arg;
+
+    /* replaces the interrupt of the PRO cpu */
+    while (!__atomic_load_n(&_stop, __ATOMIC_ACQUIRE)) {
+        esp_offload_complete();
+        thread_yield();
+    }
+    return NULL;
+}
+
+static void _test_run(void)
+{
+    esp_offload_stats_t stats;
+    work_t work;
+
+    puts("Testing run ...");
+
+    /* the completer has a lower priority and runs while main waits */
+    thread_create(_stack, sizeof(_stack), THREAD_PRIORITY_MAIN + 1,
+                  THREAD_CREATE_STACKTEST, _completer, NULL, "completer");
+
+    for (unsigned i = 0; i < 100; i++) {
+        work.seq = i;
+        expect(esp_offload_run(_work_func, &work) == 0);
+        expect(work.result == _hash(i));
+    }
+
+    esp_offload_get_stats(&stats);
+    expect(stats.submitted == JOBS_NUMOF + 100);
+    expect(stats.completed == JOBS_NUMOF + 100);
+
+    puts("Done");
+}
+
+int main(void)
+{
+    _test_ring();
+
+    expect(host_thread_start(_app_cpu, NULL) == 0);
+
+    _test_executor();
+    _test_run();
+
+    __atomic_store_n(&_stop, 1, __ATOMIC_RELEASE);
+    host_thread_join();
+
+    puts("SUCCESS");
+    return 0;
+}
@@ -0,0 +1,25 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2021 Gunar Schorcht
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    child.expect_exact("Testing ring ...")
+    child.expect_exact("Done")
+    child.expect_exact("Testing executor ...")
+    child.expect_exact("Done")
+    child.expect(r"Offloaded \d+ jobs: \d+ jobs/s")
+    child.expect_exact("Testing run ...")
+    child.expect_exact("Done")
+    child.expect_exact("SUCCESS")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc, timeout=60))
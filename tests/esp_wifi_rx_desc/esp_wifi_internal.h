@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2021 Gunar Schorcht
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Mock of the `esp_wifi_internal_*` interface of the ESP WiFi
+ *              driver libraries
+ *
+ * The mock owns a fixed number of RX buffers like the vendor driver does.
+ * A received frame occupies one of them until it is released with
+ * esp_wifi_internal_free_rx_buffer().
+ *
+ * @author      Gunar Schorcht <gunar@schorcht.net>
+ */
+
+#ifndef ESP_WIFI_INTERNAL_H
+#define ESP_WIFI_INTERNAL_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Number of RX buffers of the mocked WiFi driver
+ */
+#define ESP_WIFI_MOCK_RX_BUF_NUMOF  (10)
+
+/**
+ * @brief   Size of an RX buffer of the mocked WiFi driver
+ */
+#define ESP_WIFI_MOCK_RX_BUF_SIZE   (1600)
+
+typedef int esp_err_t;                  /**< ESP-IDF error type */
+
+#define ESP_OK      (0)                 /**< ESP-IDF success code */
+#define ESP_FAIL    (-1)                /**< ESP-IDF generic failure code */
+
+/**
+ * @brief   WiFi interfaces
+ */
+typedef enum {
+    ESP_IF_WIFI_STA = 0,                /**< station interface */
+    ESP_IF_WIFI_AP,                     /**< soft-AP interface */
+} wifi_interface_t;
+
+/**
+ * @brief   WiFi RX callback
+ */
+typedef esp_err_t (*wifi_rxcb_t)(void *buffer, uint16_t len, void *eb);
+
+/**
+ * @brief   Free an RX buffer of the WiFi driver
+ */
+void esp_wifi_internal_free_rx_buffer(void *buffer);
+
+/**
+ * @brief   Set the RX callback of an interface, NULL removes it
+ */
+esp_err_t esp_wifi_internal_reg_rxcb(wifi_interface_t ifx, wifi_rxcb_t fn);
+
+/**
+ * @brief   Let the mocked WiFi driver receive a frame on @p ifx
+ *
+ * The frame is copied into a free RX buffer, which is passed to the RX
+ * callback.
+ *
+ * @return  true if the frame was passed to the RX callback
+ * @return  false if there is no callback or no free RX buffer, i.e. the
+ *          frame was dropped by the WiFi driver
+ */
+bool esp_wifi_mock_rx(wifi_interface_t ifx, const void *frame, uint16_t len);
+
+/**
+ * @brief   Number of RX buffers currently held by the callback's user
+ */
+unsigned esp_wifi_mock_rx_buf_used(void);
+
+/**
+ * @brief   Number of frames dropped by the mocked WiFi driver for lack of
+ *          RX buffers
+ */
+unsigned esp_wifi_mock_rx_dropped(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ESP_WIFI_INTERNAL_H */
+/** @} */
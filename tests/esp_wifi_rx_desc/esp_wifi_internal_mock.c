@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2021 Gunar Schorcht
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Mock of the `esp_wifi_internal_*` interface of the ESP WiFi
+ *              driver libraries
+ *
+ * @author      Gunar Schorcht <gunar@schorcht.net>
+ * @}
+ */
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "esp_wifi_internal.h"
+
+typedef struct {
+    uint8_t data[ESP_WIFI_MOCK_RX_BUF_SIZE];
+    bool used;
+} _rx_buf_t;
+
+static _rx_buf_t _rx_bufs[ESP_WIFI_MOCK_RX_BUF_NUMOF];
+static wifi_rxcb_t _rx_cbs[ESP_IF_WIFI_AP + 1];
+static unsigned _rx_used;
+static unsigned _rx_dropped;
+
+void esp_wifi_internal_free_rx_buffer(void *buffer)
+{
+    _rx_buf_t *rx_buf = buffer;
+
+    /* freeing a buffer twice or a foreign one is a bug of the caller */
+    if ((rx_buf < _rx_bufs) || (rx_buf >= _rx_bufs + ESP_WIFI_MOCK_RX_BUF_NUMOF) ||
+        !rx_buf->used) {
+        abort();
+    }
+    rx_buf->used = false;
+    _rx_used--;
+}
+
+esp_err_t esp_wifi_internal_reg_rxcb(wifi_interface_t ifx, wifi_rxcb_t fn)
+{
+    if (ifx > ESP_IF_WIFI_AP) {
+        return ESP_FAIL;
+    }
+    _rx_cbs[ifx] = fn;
+    return ESP_OK;
+}
+
+bool esp_wifi_mock_rx(wifi_interface_t ifx, const void *frame, uint16_t len)
+{
+    assert(ifx <= ESP_IF_WIFI_AP);
+    assert(len <= ESP_WIFI_MOCK_RX_BUF_SIZE);
+
+    if (!_rx_cbs[ifx]) {
+        return false;
+    }
+
+    for (unsigned i = 0; i < ESP_WIFI_MOCK_RX_BUF_NUMOF; i++) {
+        _rx_buf_t *rx_buf = &_rx_bufs[i];
+        if (!rx_buf->used) {
+            rx_buf->used = true;
+            _rx_used++;
+            memcpy(rx_buf->data, frame, len);
+            /* the data is at the start of the buffer, so eb == buffer */
+            _rx_cbs[ifx](rx_buf->data, len, rx_buf);
+            return true;
+        }
+    }
+    _rx_dropped++;
+    return false;
+}
+
+unsigned esp_wifi_mock_rx_buf_used(void)
+{
+    return _rx_used;
+}
+
+unsigned esp_wifi_mock_rx_dropped(void)
+{
+    return _rx_dropped;
+}
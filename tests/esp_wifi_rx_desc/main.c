@@ -0,0 +1,212 @@
+/*
+ * Copyright (C) 2021 Gunar Schorcht
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test and benchmark of the ESP WiFi zero-copy RX path
+ *
+ * The descriptor ring of module `esp_wifi_rx_desc` is driven through a mock
+ * of the `esp_wifi_internal_*` interface, the same way the `esp_wifi` netdev
+ * driver does on the ESP SoCs. For comparison, the benchmark also runs the
+ * ring buffer based path the driver uses without the module.
+ *
+ * @author      Gunar Schorcht <gunar@schorcht.net>
+ * @}
+ */
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "esp_wifi_internal.h"
+#include "esp_wifi_rx_desc.h"
+#include "fmt.h"
+#include "net/ethernet.h"
+#include "ringbuffer.h"
+#include "xtimer.h"
+
+#include "test_utils/expect.h"
+
+#define BENCH_FRAMES    (1000U)
+#define BENCH_LEN       (1500U)
+
+static esp_wifi_rx_desc_ring_t _ring;
+
+static uint8_t _rx_mem[ETHERNET_MAX_LEN << 1];
+static ringbuffer_t _rx_rb;
+
+static uint8_t _frame[ETHERNET_MAX_LEN];
+static uint8_t _netif_buf[ETHERNET_MAX_LEN];
+
+/* RX callback of the driver with module esp_wifi_rx_desc */
+static esp_err_t _rx_cb_desc(void *buffer, uint16_t len, void *eb)
+{
+    esp_wifi_rx_desc_put(&_ring, buffer, len, eb);
+    return ESP_OK;
+}
+
+/* RX callback of the driver without module esp_wifi_rx_desc */
+static esp_err_t _rx_cb_copy(void *buffer, uint16_t len, void *eb)
+{
+    if (ringbuffer_get_free(&_rx_rb) >= len + sizeof(uint16_t)) {
+        ringbuffer_add(&_rx_rb, (char *)&len, sizeof(uint16_t));
+        ringbuffer_add(&_rx_rb, buffer, len);
+    }
+    esp_wifi_internal_free_rx_buffer(eb);
+    return ESP_OK;
+}
+
+/* netdev recv of the driver without module esp_wifi_rx_desc */
+static int _recv_copy(void *buf, size_t len)
+{
+    uint16_t size;
+
+    if (ringbuffer_peek(&_rx_rb, (char *)&size, sizeof(uint16_t)) < sizeof(uint16_t)) {
+        return 0;
+    }
+    if (len < size) {
+        ringbuffer_remove(&_rx_rb, sizeof(uint16_t) + size);
+        return -ENOBUFS;
+    }
+    ringbuffer_remove(&_rx_rb, sizeof(uint16_t));
+    ringbuffer_get(&_rx_rb, buf, size);
+    return size;
+}
+
+static void _rx(uint16_t len, uint8_t tag)
+{
+    memset(_frame, tag, len);
+    expect(esp_wifi_mock_rx(ESP_IF_WIFI_STA, _frame, len));
+}
+
+static void test_recv(void)
+{
+    puts("Testing recv ...");
+
+    esp_wifi_rx_desc_init(&_ring);
+    esp_wifi_internal_reg_rxcb(ESP_IF_WIFI_STA, _rx_cb_desc);
+
+    _rx(100, 1);
+    _rx(200, 2);
+    _rx(300, 3);
+    _rx(400, 4);
+    expect(esp_wifi_rx_desc_pending(&_ring) == 4);
+    /* the frames still live in the buffers of the WiFi driver */
+    expect(esp_wifi_mock_rx_buf_used() == 4);
+
+    /* size query leaves the frame in place */
+    expect(esp_wifi_rx_desc_recv(&_ring, NULL, 0) == 100);
+    expect(esp_wifi_mock_rx_buf_used() == 4);
+
+    /* reading copies the frame and releases the driver buffer */
+    memset(_netif_buf, 0, sizeof(_netif_buf));
+    expect(esp_wifi_rx_desc_recv(&_ring, _netif_buf, sizeof(_netif_buf)) == 100);
+    expect(_netif_buf[0] == 1 && _netif_buf[99] == 1 && _netif_buf[100] == 0);
+    expect(esp_wifi_mock_rx_buf_used() == 3);
+
+    /* dropping without buffer */
+    expect(esp_wifi_rx_desc_recv(&_ring, NULL, 1) == 200);
+    expect(esp_wifi_mock_rx_buf_used() == 2);
+
+    /* dropping because the buffer is too small */
+    expect(esp_wifi_rx_desc_recv(&_ring, _netif_buf, 299) == -ENOBUFS);
+    expect(esp_wifi_mock_rx_buf_used() == 1);
+
+    expect(esp_wifi_rx_desc_recv(&_ring, _netif_buf, sizeof(_netif_buf)) == 400);
+    expect(_netif_buf[399] == 4);
+    expect(esp_wifi_rx_desc_recv(&_ring, _netif_buf, sizeof(_netif_buf)) == 0);
+    expect(esp_wifi_mock_rx_buf_used() == 0);
+    expect(_ring.dropped == 0);
+
+    puts("Done");
+}
+
+static void test_full(void)
+{
+    puts("Testing full ring ...");
+
+    esp_wifi_rx_desc_init(&_ring);
+    esp_wifi_internal_reg_rxcb(ESP_IF_WIFI_STA, _rx_cb_desc);
+
+    /* the ring is smaller than the number of driver buffers, the frames that
+     * do not fit are dropped and their buffers are released at once */
+    for (unsigned i = 0; i < ESP_WIFI_RX_DESC_NUMOF + 2; i++) {
+        _rx(64, i);
+    }
+    expect(esp_wifi_rx_desc_pending(&_ring) == ESP_WIFI_RX_DESC_NUMOF);
+    expect(esp_wifi_mock_rx_buf_used() == ESP_WIFI_RX_DESC_NUMOF);
+    expect(_ring.dropped == 2);
+
+    /* the oldest frames are kept */
+    expect(esp_wifi_rx_desc_recv(&_ring, _netif_buf, sizeof(_netif_buf)) == 64);
+    expect(_netif_buf[0] == 0);
+
+    /* wrap around */
+    _rx(64, 0xaa);
+    expect(esp_wifi_rx_desc_pending(&_ring) == ESP_WIFI_RX_DESC_NUMOF);
+    for (unsigned i = 1; i < ESP_WIFI_RX_DESC_NUMOF; i++) {
+        expect(esp_wifi_rx_desc_recv(&_ring, _netif_buf, sizeof(_netif_buf)) == 64);
+        expect(_netif_buf[0] == i);
+    }
+    expect(esp_wifi_rx_desc_recv(&_ring, _netif_buf, sizeof(_netif_buf)) == 64);
+    expect(_netif_buf[0] == 0xaa);
+
+    /* flushing releases all driver buffers */
+    _rx(64, 1);
+    _rx(64, 2);
+    esp_wifi_rx_desc_flush(&_ring);
+    expect(esp_wifi_rx_desc_pending(&_ring) == 0);
+    expect(esp_wifi_mock_rx_buf_used() == 0);
+    expect(esp_wifi_mock_rx_dropped() == 0);
+
+    puts("Done");
+}
+
+static uint32_t _bench(wifi_rxcb_t cb, int (*recv)(void *, size_t))
+{
+    esp_wifi_internal_reg_rxcb(ESP_IF_WIFI_STA, cb);
+
+    uint32_t start = xtimer_now_usec();
+    for (unsigned i = 0; i < BENCH_FRAMES; i++) {
+        esp_wifi_mock_rx(ESP_IF_WIFI_STA, _frame, BENCH_LEN);
+        recv(_netif_buf, sizeof(_netif_buf));
+    }
+    return xtimer_now_usec() - start;
+}
+
+static int _recv_desc(void *buf, size_t len)
+{
+    return esp_wifi_rx_desc_recv(&_ring, buf, len);
+}
+
+int main(void)
+{
+    test_recv();
+    test_full();
+
+    esp_wifi_rx_desc_init(&_ring);
+    ringbuffer_init(&_rx_rb, (char *)_rx_mem, sizeof(_rx_mem));
+    memset(_frame, 0x55, sizeof(_frame));
+
+    print_str("Receiving 1.000 x 1500 bytes, ring buffer: ");
+    print_u32_dec(_bench(_rx_cb_copy, _recv_copy));
+    print_str(" us\n");
+
+    print_str("Receiving 1.000 x 1500 bytes, descriptors: ");
+    print_u32_dec(_bench(_rx_cb_desc, _recv_desc));
+    print_str(" us\n");
+
+    expect(esp_wifi_mock_rx_buf_used() == 0);
+    expect(esp_wifi_mock_rx_dropped() == 0);
+
+    puts("SUCCESS");
+    return 0;
+}
@@ -0,0 +1,320 @@
+/*
+ * Copyright (C) 2021 Gunar Schorcht
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Comparison of the RPL objective functions OF0 and MRHOF
+ *
+ * The nodes of a grid are simulated in one process. Neighbors are nodes
+ * within a distance of two grid steps. The loss rate of a link grows with
+ * its length from LINK_LOSS_NEAR to LINK_LOSS_FAR percent. Each node selects
+ * its parents with the objective function from the Ranks of its neighbors
+ * and sends packets to the root along the preferred parents. The ETX of the
+ * links is estimated by `netstats_neighbor` from the simulated transmissions.
+ *
+ * @author      Gunar Schorcht <gunar@schorcht.net>
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "fmt.h"
+#include "net/gnrc/rpl.h"
+#include "net/gnrc/rpl/of_manager.h"
+#include "net/netif.h"
+#include "net/netstats/neighbor.h"
+#include "utlist.h"
+
+#include "test_utils/expect.h"
+
+#ifndef GRID_SIZE
+#define GRID_SIZE           (6U)
+#endif
+#ifndef LINK_LOSS_NEAR
+#define LINK_LOSS_NEAR      (5U)        /**< loss of the shortest links in % */
+#endif
+#ifndef LINK_LOSS_FAR
+#define LINK_LOSS_FAR       (60U)       /**< loss of the longest links in % */
+#endif
+
+#define NODES_NUMOF         (GRID_SIZE * GRID_SIZE)
+#define RANGE2              (8U)        /**< squared range, two diagonal steps */
+#define PARENTS_NUMOF       (8U)
+#define TX_ATTEMPTS         (4U)        /**< one transmission and 3 retries */
+#define HOPS_MAX            (32U)
+#define ROUNDS              (100U)
+#define WARMUP_ROUNDS       (20U)
+#define PKTS_PER_ROUND      (4U)
+
+typedef struct {
+    gnrc_rpl_instance_t inst;
+    gnrc_rpl_parent_t parents[PARENTS_NUMOF];
+    netif_t netif;
+    uint8_t loss[NODES_NUMOF];          /**< loss to each node in %, 0 if none */
+} node_t;
+
+typedef struct {
+    uint32_t sent;
+    uint32_t delivered;
+    uint32_t transmissions;
+    uint32_t switches;
+    uint32_t path_etx;                  /**< mean path ETX * 100 at the end */
+} result_t;
+
+static node_t _nodes[NODES_NUMOF];
+static uint32_t _rand_state;
+
+static uint32_t _rand(void)
+{
+    /* xorshift32, the same sequence for both objective functions */
+    _rand_state ^= _rand_state << 13;
+    _rand_state ^= _rand_state >> 17;
+    _rand_state ^= _rand_state << 5;
+    return _rand_state;
+}
+
+static unsigned _idx(const gnrc_rpl_parent_t *parent)
+{
+    return byteorder_ntohs(parent->addr.u16[7]);
+}
+
+static uint16_t _l2addr(unsigned node)
+{
+    return node + 1;
+}
+
+static void _init(gnrc_rpl_of_t *of)
+{
+    _rand_state = 0x20210801;
+
+    memset(_nodes, 0, sizeof(_nodes));
+    for (unsigned i = 0; i < NODES_NUMOF; i++) {
+        node_t *node = &_nodes[i];
+        node->inst.of = of;
+        node->inst.min_hop_rank_inc = CONFIG_GNRC_RPL_DEFAULT_MIN_HOP_RANK_INCREASE;
+        node->inst.dodag.instance = &node->inst;
+        node->inst.dodag.my_rank = (i == 0) ? GNRC_RPL_ROOT_RANK
+                                            : GNRC_RPL_INFINITE_RANK;
+        netstats_nb_init(&node->netif);
+
+        for (unsigned j = 0; j < NODES_NUMOF; j++) {
+            int dx = (int)(i % GRID_SIZE) - (int)(j % GRID_SIZE);
+            int dy = (int)(i / GRID_SIZE) - (int)(j / GRID_SIZE);
+            unsigned d2 = dx * dx + dy * dy;
+            if ((i == j) || (d2 > RANGE2)) {
+                continue;
+            }
+            /* symmetric links, the loss grows with the distance */
+            node->loss[j] = LINK_LOSS_NEAR +
+                            (LINK_LOSS_FAR - LINK_LOSS_NEAR) * (d2 - 1) / (RANGE2 - 1);
+        }
+    }
+}
+
+static void _link_metric(node_t *node, gnrc_rpl_parent_t *parent)
+{
+    uint16_t l2addr = _l2addr(_idx(parent));
+    netstats_nb_t stats;
+
+    /* the same as gnrc_rpl_mrhof does with the address from the NIB */
+    parent->link_metric = NETSTATS_NB_ETX_INIT * NETSTATS_NB_ETX_DIVISOR;
+    parent->link_metric_type = GNRC_RPL_METRIC_ETX;
+    if (netstats_nb_get(&node->netif, (uint8_t *)&l2addr, sizeof(l2addr),
+                        &stats)) {
+        parent->link_metric = stats.etx;
+    }
+}
+
+static gnrc_rpl_parent_t *_parent_get(node_t *node, unsigned idx)
+{
+    gnrc_rpl_dodag_t *dodag = &node->inst.dodag;
+    gnrc_rpl_parent_t *parent;
+
+    LL_FOREACH(dodag->parents, parent) {
+        if (_idx(parent) == idx) {
+            return parent;
+        }
+    }
+    for (unsigned i = 0; i < PARENTS_NUMOF; i++) {
+        parent = &node->parents[i];
+        if (parent->dodag == NULL) {
+            parent->dodag = dodag;
+            parent->addr.u16[7] = byteorder_htons(idx);
+            LL_APPEND(dodag->parents, parent);
+            return parent;
+        }
+    }
+    return NULL;
+}
+
+/* receives the DIOs of the neighbors and selects the parents as
+ * gnrc_rpl_parent_update() does, returns true if the preferred parent changed */
+static bool _receive_dios(unsigned i)
+{
+    node_t *node = &_nodes[i];
+    gnrc_rpl_dodag_t *dodag = &node->inst.dodag;
+    uint16_t mhri = node->inst.min_hop_rank_inc;
+    gnrc_rpl_parent_t *old_best = dodag->parents;
+    gnrc_rpl_parent_t *elt, *tmp;
+
+    for (unsigned j = 0; j < NODES_NUMOF; j++) {
+        uint16_t rank = _nodes[j].inst.dodag.my_rank;
+        if ((node->loss[j] == 0) || (rank == GNRC_RPL_INFINITE_RANK) ||
+            (DAGRANK(rank, mhri) >= DAGRANK(dodag->my_rank, mhri))) {
+            continue;
+        }
+        gnrc_rpl_parent_t *parent = _parent_get(node, j);
+        if (parent) {
+            parent->rank = rank;
+        }
+    }
+    if (dodag->parents == NULL) {
+        return false;
+    }
+
+    LL_FOREACH(dodag->parents, elt) {
+        _link_metric(node, elt);
+    }
+    gnrc_rpl_parent_t *new_best = dodag->parents;
+    LL_SORT(new_best, node->inst.of->parent_cmp);
+    dodag->parents = new_best;
+
+    dodag->my_rank = node->inst.of->calc_rank(dodag, 0);
+    LL_FOREACH_SAFE(dodag->parents, elt, tmp) {
+        if (DAGRANK(dodag->my_rank, mhri) <= DAGRANK(elt->rank, mhri)) {
+            LL_DELETE(dodag->parents, elt);
+            elt->dodag = NULL;
+        }
+    }
+
+    return (old_best != NULL) && (old_best != new_best);
+}
+
+/* sends a packet hop by hop to the root */
+static void _send(unsigned i, result_t *res)
+{
+    for (unsigned hops = 0; (i != 0) && (hops < HOPS_MAX); hops++) {
+        node_t *node = &_nodes[i];
+        gnrc_rpl_parent_t *parent = node->inst.dodag.parents;
+
+        if (parent == NULL) {
+            return;
+        }
+
+        unsigned next = _idx(parent);
+        uint16_t l2addr = _l2addr(next);
+        unsigned attempts = 0;
+        bool success = false;
+
+        while (!success && (attempts < TX_ATTEMPTS)) {
+            attempts++;
+            success = (_rand() % 100) >= node->loss[next];
+        }
+        res->transmissions += attempts;
+
+        netstats_nb_record(&node->netif, (uint8_t *)&l2addr, sizeof(l2addr));
+        netstats_nb_update_tx(&node->netif, success ? NETSTATS_NB_SUCCESS
+                                                    : NETSTATS_NB_NOACK,
+                              attempts);
+        if (!success) {
+            return;
+        }
+        i = next;
+    }
+    if (i == 0) {
+        res->delivered++;
+    }
+}
+
+/* expected number of transmissions from all nodes to the root * 100 */
+static uint32_t _path_etx(void)
+{
+    uint32_t sum = 0;
+
+    for (unsigned i = 1; i < NODES_NUMOF; i++) {
+        unsigned node = i;
+        for (unsigned hops = 0; node != 0; hops++) {
+            gnrc_rpl_parent_t *parent = _nodes[node].inst.dodag.parents;
+            expect(parent && (hops < HOPS_MAX));
+            unsigned next = _idx(parent);
+            sum += 10000 / (100 - _nodes[node].loss[next]);
+            node = next;
+        }
+    }
+    return sum / (NODES_NUMOF - 1);
+}
+
+static void _simulate(uint16_t ocp, result_t *res)
+{
+    gnrc_rpl_of_t *of = gnrc_rpl_get_of_for_ocp(ocp);
+
+    expect(of && (of->ocp == ocp));
+    _init(of);
+    memset(res, 0, sizeof(*res));
+
+    for (unsigned round = 0; round < ROUNDS; round++) {
+        if (round == WARMUP_ROUNDS) {
+            memset(res, 0, sizeof(*res));
+        }
+        for (unsigned i = 1; i < NODES_NUMOF; i++) {
+            res->switches += _receive_dios(i);
+        }
+        for (unsigned i = 1; i < NODES_NUMOF; i++) {
+            for (unsigned j = 0; j < PKTS_PER_ROUND; j++) {
+                res->sent++;
+                _send(i, res);
+            }
+        }
+    }
+    res->path_etx = _path_etx();
+}
+
+static void _print_fix(uint32_t val)
+{
+    print_u32_dec(val / 100);
+    print_str(".");
+    print_u32_dec((val % 100) / 10);
+    print_u32_dec(val % 10);
+}
+
+static void _print(const char *name, const result_t *res)
+{
+    print_str(name);
+    print_str(": delivery ");
+    _print_fix(res->delivered * 10000 / res->sent);
+    print_str(" %, path ETX ");
+    _print_fix(res->path_etx);
+    print_str(", TX per packet ");
+    _print_fix(res->transmissions * 100 / res->sent);
+    print_str(", parent switches ");
+    print_u32_dec(res->switches);
+    print_str("\n");
+}
+
+int main(void)
+{
+    result_t of0;
+    result_t mrhof;
+
+    gnrc_rpl_of_manager_init();
+
+    _simulate(GNRC_RPL_OCP_OF0, &of0);
+    _print("OF0", &of0);
+    _simulate(GNRC_RPL_OCP_MRHOF, &mrhof);
+    _print("MRHOF", &mrhof);
+
+    expect(mrhof.path_etx < of0.path_etx);
+    expect(mrhof.delivered * of0.sent >= of0.delivered * mrhof.sent);
+
+    puts("SUCCESS");
+    return 0;
+}
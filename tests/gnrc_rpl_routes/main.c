@@ -0,0 +1,532 @@
+/*
+ * Copyright (C) 2021 Gunar Schorcht
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test of the RPL downward route table
+ *
+ * Besides the unit tests of the route table, the DAO traffic of a storing
+ * mode DODAG is simulated in one process. Each node has its own route table
+ * and the DAOs are passed from the children to the parents. The traffic of
+ * the aggregated DAOs is compared with the traffic of the former DAOs with
+ * one transit option per target.
+ *
+ * @author      Gunar Schorcht <gunar@schorcht.net>
+ * @}
+ */
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "fmt.h"
+#include "net/gnrc/ipv6/nib/ft.h"
+#include "net/gnrc/rpl.h"
+#include "net/gnrc/rpl/routes.h"
+#include "net/icmpv6.h"
+#include "ztimer.h"
+
+#include "test_utils/expect.h"
+
+#define NODES_MAX       (200U)
+#define FANOUT          (4U)
+#define ROUNDS          (10U)
+#define ROUND_TIME      (60U)       /* DAOs are refreshed once per minute */
+#define LIFETIME        (300U)      /* default lifetime of 5 * 60 s */
+#define IFACE           (6U)
+
+/* sizes of the DAO without targets and of the former per target options */
+#define DAO_HDR_LEN     (sizeof(icmpv6_hdr_t) + sizeof(gnrc_rpl_dao_t))
+#define TRANSIT_LEN     (sizeof(gnrc_rpl_opt_transit_t))
+#define TARGET_LEN      (sizeof(gnrc_rpl_opt_target_t))
+
+enum {
+    MODE_LEGACY,
+    MODE_AGGREGATED,
+    MODE_PREFIX,
+    MODE_NUMOF,
+};
+
+static gnrc_rpl_routes_t _tables[NODES_MAX + 1];
+static ipv6_addr_t _addrs[NODES_MAX + 1];
+static uint8_t _buf[CONFIG_GNRC_RPL_DAO_TARGETS_MAX * TARGET_LEN];
+
+static unsigned _nib_ops;
+static bool _at_root = true;    /* only the NIB operations at root count */
+
+int gnrc_ipv6_nib_ft_add(const ipv6_addr_t *dst, unsigned dst_len,
+                         const ipv6_addr_t *next_hop, unsigned iface,
+                         uint16_t lifetime)
+{
+    (void)dst;
+    (void)dst_len;
+    (void)next_hop;
+    (void)iface;
+    (void)lifetime;
+    _nib_ops += _at_root;
+    return 0;
+}
+
+void gnrc_ipv6_nib_ft_del(const ipv6_addr_t *dst, unsigned dst_len)
+{
+    (void)dst;
+    (void)dst_len;
+    _nib_ops += _at_root;
+}
+
+static void _addr_init(ipv6_addr_t *addr, uint16_t subnet, uint16_t host)
+{
+    ipv6_addr_from_str(addr, "2001:db8::");
+    addr->u16[3] = byteorder_htons(subnet);
+    addr->u16[7] = byteorder_htons(host);
+}
+
+static gnrc_rpl_routes_target_t _target(const ipv6_addr_t *addr, uint8_t len)
+{
+    gnrc_rpl_routes_target_t target = { .prefix = *addr, .prefix_len = len };
+    return target;
+}
+
+static void _test_update(void)
+{
+    gnrc_rpl_routes_t *table = &_tables[0];
+    gnrc_rpl_routes_target_t targets[3];
+    ipv6_addr_t child1, child2, addr;
+
+    puts("Testing update ...");
+
+    gnrc_rpl_routes_init(table);
+    _addr_init(&child1, 0, 1);
+    _addr_init(&child2, 0, 2);
+    _addr_init(&addr, 0, 3);
+    targets[0] = _target(&addr, 128);
+    _addr_init(&addr, 0, 4);
+    targets[1] = _target(&addr, 128);
+    _addr_init(&addr, 1, 0);
+    targets[2] = _target(&addr, 64);
+
+    _nib_ops = 0;
+    expect(gnrc_rpl_routes_update(table, targets, 3, &child1, IFACE, LIFETIME,
+                                  0) == 3);
+    expect(table->numof == 3);
+    expect(_nib_ops == 6);
+    expect(table->next_hops[table->routes[0].next_hop].refs == 3);
+
+    /* the NIB is only updated when more than half of the lifetime is over */
+    expect(gnrc_rpl_routes_update(table, targets, 3, &child1, IFACE, LIFETIME,
+                                  LIFETIME / 4) == 3);
+    expect(_nib_ops == 6);
+    expect(gnrc_rpl_routes_update(table, targets, 3, &child1, IFACE, LIFETIME,
+                                  LIFETIME * 3 / 4) == 3);
+    expect(_nib_ops == 12);
+
+    /* a new next hop is always installed */
+    expect(gnrc_rpl_routes_update(table, &targets[1], 1, &child2, IFACE,
+                                  LIFETIME, LIFETIME) == 1);
+    expect(_nib_ops == 14);
+
+    /* host routes are preferred to prefix routes */
+    const gnrc_rpl_route_t *route = gnrc_rpl_routes_lookup(table,
+                                                           &targets[1].prefix,
+                                                           LIFETIME);
+    expect(route && (route->prefix_len == 128));
+    expect(ipv6_addr_equal(&table->next_hops[route->next_hop].addr, &child2));
+    _addr_init(&addr, 1, 42);
+    route = gnrc_rpl_routes_lookup(table, &addr, LIFETIME);
+    expect(route && (route->prefix_len == 64));
+    _addr_init(&addr, 2, 42);
+    expect(gnrc_rpl_routes_lookup(table, &addr, LIFETIME) == NULL);
+
+    puts("Done");
+}
+
+static void _test_no_path(void)
+{
+    gnrc_rpl_routes_t *table = &_tables[0];
+    gnrc_rpl_routes_target_t target;
+    ipv6_addr_t child1, child2, addr;
+
+    puts("Testing No-Path ...");
+
+    gnrc_rpl_routes_init(table);
+    _addr_init(&child1, 0, 1);
+    _addr_init(&child2, 0, 2);
+    _addr_init(&addr, 0, 3);
+    target = _target(&addr, 128);
+
+    expect(gnrc_rpl_routes_update(table, &target, 1, &child1, IFACE, LIFETIME,
+                                  0) == 1);
+    /* only the child that owns the route can remove it */
+    expect(gnrc_rpl_routes_update(table, &target, 1, &child2, IFACE, 0,
+                                  0) == 0);
+    expect(table->numof == 1);
+    expect(gnrc_rpl_routes_update(table, &target, 1, &child1, IFACE, 0,
+                                  0) == 1);
+    expect(table->numof == 0);
+    expect(table->next_hops[0].refs == 0);
+
+    puts("Done");
+}
+
+static void _test_expiry(void)
+{
+    gnrc_rpl_routes_t *table = &_tables[0];
+    gnrc_rpl_routes_target_t targets[2];
+    ipv6_addr_t child, addr;
+
+    puts("Testing expiry ...");
+
+    gnrc_rpl_routes_init(table);
+    _addr_init(&child, 0, 1);
+    _addr_init(&addr, 0, 2);
+    targets[0] = _target(&addr, 128);
+    _addr_init(&addr, 0, 3);
+    targets[1] = _target(&addr, 128);
+
+    expect(gnrc_rpl_routes_update(table, &targets[0], 1, &child, IFACE, 10,
+                                  0) == 1);
+    expect(gnrc_rpl_routes_update(table, &targets[1], 1, &child, IFACE, 20,
+                                  0) == 1);
+    expect(gnrc_rpl_routes_lookup(table, &targets[0].prefix, 10) == NULL);
+    expect(gnrc_rpl_routes_lookup(table, &targets[1].prefix, 10) != NULL);
+
+    _nib_ops = 0;
+    gnrc_rpl_routes_expire(table, 10);
+    expect(table->numof == 1);
+    expect(_nib_ops == 1);
+    gnrc_rpl_routes_expire(table, 20);
+    expect(table->numof == 0);
+
+    puts("Done");
+}
+
+static void _test_clear(void)
+{
+    gnrc_rpl_routes_t *table = &_tables[0];
+    gnrc_rpl_routes_target_t targets[2];
+    ipv6_addr_t child, addr;
+
+    puts("Testing clear ...");
+
+    gnrc_rpl_routes_init(table);
+    _addr_init(&child, 0, 1);
+    _addr_init(&addr, 0, 2);
+    targets[0] = _target(&addr, 128);
+    _addr_init(&addr, 1, 0);
+    targets[1] = _target(&addr, 64);
+    gnrc_rpl_routes_aggregate(table, &addr, 48);
+
+    expect(gnrc_rpl_routes_update(table, targets, 2, &child, IFACE, LIFETIME,
+                                  0) == 2);
+
+    /* the routes are removed from the NIB as well */
+    _nib_ops = 0;
+    gnrc_rpl_routes_clear(table);
+    expect(_nib_ops == 2);
+    expect(table->numof == 0);
+    expect(table->next_hops[0].refs == 0);
+    expect(table->aggr_prefix_len == 0);
+    expect(gnrc_rpl_routes_lookup(table, &targets[0].prefix, 0) == NULL);
+
+    puts("Done");
+}
+
+static void _test_targets(void)
+{
+    gnrc_rpl_routes_t *table = &_tables[0];
+    gnrc_rpl_routes_target_t targets[CONFIG_GNRC_RPL_DAO_TARGETS_MAX * 2];
+    gnrc_rpl_routes_target_t target;
+    ipv6_addr_t own, child;
+
+    puts("Testing targets ...");
+
+    gnrc_rpl_routes_init(table);
+    _addr_init(&own, 0, 1);
+    _addr_init(&child, 0, 2);
+    for (unsigned i = 0; i < ARRAY_SIZE(targets); i++) {
+        _addr_init(&targets[i].prefix, 0, 0x100 + i);
+        targets[i].prefix_len = 128;
+    }
+    /* prefixes are encoded with the minimal length */
+    _addr_init(&targets[0].prefix, 0x0180, 0);
+    targets[0].prefix_len = 57;
+    expect(gnrc_rpl_routes_update(table, targets, ARRAY_SIZE(targets), &child,
+                                  IFACE, LIFETIME, 0) == ARRAY_SIZE(targets));
+
+    unsigned pos = 0;
+    unsigned numof = 0;
+    size_t len;
+    bool own_found = false;
+
+    while ((len = gnrc_rpl_routes_dao_targets(table, &own, &pos, _buf,
+                                              sizeof(_buf), 0))) {
+        unsigned in_dao = 0;
+
+        for (size_t off = 0; off < len; in_dao++) {
+            gnrc_rpl_opt_target_t *opt = (gnrc_rpl_opt_target_t *)&_buf[off];
+            expect(opt->type == GNRC_RPL_OPT_TARGET);
+            expect(gnrc_rpl_routes_target_get(opt, &target) == 0);
+            if (target.prefix_len == 57) {
+                expect(opt->length == 2 + 8);
+                expect(target.prefix.u8[7] == 0x80);
+            }
+            if (ipv6_addr_equal(&target.prefix, &own)) {
+                own_found = true;
+            }
+            else {
+                expect(gnrc_rpl_routes_lookup(table, &target.prefix, 0));
+            }
+            off += sizeof(gnrc_rpl_opt_t) + opt->length;
+            numof++;
+        }
+        expect(in_dao <= CONFIG_GNRC_RPL_DAO_TARGETS_MAX);
+    }
+    expect(own_found);
+    expect(numof == ARRAY_SIZE(targets) + 1);
+
+    /* malformed options are rejected */
+    gnrc_rpl_opt_target_t *opt = (gnrc_rpl_opt_target_t *)_buf;
+    opt->prefix_length = 64;
+    opt->length = 2 + 7;
+    expect(gnrc_rpl_routes_target_get(opt, &target) == -EINVAL);
+    opt->prefix_length = 129;
+    opt->length = 2 + 16;
+    expect(gnrc_rpl_routes_target_get(opt, &target) == -EINVAL);
+
+    puts("Done");
+}
+
+static void _test_aggregation(void)
+{
+    gnrc_rpl_routes_t *table = &_tables[0];
+    gnrc_rpl_routes_target_t targets[2];
+    ipv6_addr_t own, child, prefix;
+
+    puts("Testing aggregation ...");
+
+    gnrc_rpl_routes_init(table);
+    _addr_init(&own, 1, 1);
+    _addr_init(&child, 1, 2);
+    _addr_init(&prefix, 1, 0);
+    targets[0] = _target(&child, 128);
+    _addr_init(&targets[1].prefix, 2, 3);
+    targets[1].prefix_len = 128;
+    expect(gnrc_rpl_routes_update(table, targets, 2, &child, IFACE, LIFETIME,
+                                  0) == 2);
+    gnrc_rpl_routes_aggregate(table, &prefix, 64);
+
+    /* the prefix and the target that is not covered by it */
+    unsigned pos = 0;
+    size_t len = gnrc_rpl_routes_dao_targets(table, &own, &pos, _buf,
+                                             sizeof(_buf), 0);
+    expect(len == (2 + 2 + 8) + (2 + 2 + 16));
+    expect(gnrc_rpl_routes_target_get((gnrc_rpl_opt_target_t *)_buf,
+                                      &targets[0]) == 0);
+    expect(targets[0].prefix_len == 64);
+    expect(ipv6_addr_equal(&targets[0].prefix, &prefix));
+    expect(gnrc_rpl_routes_target_get((gnrc_rpl_opt_target_t *)&_buf[12],
+                                      &targets[0]) == 0);
+    expect(ipv6_addr_equal(&targets[0].prefix, &targets[1].prefix));
+    expect(gnrc_rpl_routes_dao_targets(table, &own, &pos, _buf, sizeof(_buf),
+                                       0) == 0);
+
+    puts("Done");
+}
+
+static unsigned _parent(unsigned node)
+{
+    return (node - 1) / FANOUT;
+}
+
+static unsigned _subtree(unsigned node)
+{
+    while (_parent(node) != 0) {
+        node = _parent(node);
+    }
+    return node;
+}
+
+/* sends the DAOs of a node to its parent, returns the number of bytes */
+static uint32_t _send_daos(unsigned node, int mode, uint32_t now)
+{
+    gnrc_rpl_routes_t *table = &_tables[node];
+    gnrc_rpl_routes_t *parent = &_tables[_parent(node)];
+    gnrc_rpl_routes_target_t targets[CONFIG_GNRC_RPL_DAO_TARGETS_MAX];
+    uint32_t bytes = 0;
+
+    _at_root = (parent == &_tables[0]) && (mode != MODE_LEGACY);
+
+    if (mode == MODE_LEGACY) {
+        /* all routes and the own address in one DAO, each route with its
+         * own transit option, each target with the full address */
+        unsigned numof = 0;
+        targets[0] = _target(&_addrs[node], 128);
+        gnrc_rpl_routes_update(parent, targets, 1, &_addrs[node], IFACE,
+                               LIFETIME, now);
+        for (unsigned i = 0; i < table->numof; i++) {
+            const gnrc_rpl_route_t *route = &table->routes[i];
+            targets[0] = _target(&route->target, route->prefix_len);
+            gnrc_rpl_routes_update(parent, targets, 1, &_addrs[node], IFACE,
+                                   LIFETIME, now);
+            numof++;
+        }
+        if (parent == &_tables[0]) {
+            /* the targets were added to the NIB for the target and for the
+             * transit option with a delete before each add */
+            _nib_ops += (numof + 1) * 4;
+        }
+        return DAO_HDR_LEN + TARGET_LEN + numof * (TRANSIT_LEN + TARGET_LEN);
+    }
+
+    unsigned pos = 0;
+    size_t len;
+
+    while ((len = gnrc_rpl_routes_dao_targets(table, &_addrs[node], &pos, _buf,
+                                              sizeof(_buf), now))) {
+        unsigned numof = 0;
+
+        bytes += DAO_HDR_LEN + TRANSIT_LEN + len;
+        for (size_t off = 0; off < len; numof++) {
+            gnrc_rpl_opt_target_t *opt = (gnrc_rpl_opt_target_t *)&_buf[off];
+            expect(gnrc_rpl_routes_target_get(opt, &targets[numof]) == 0);
+            off += sizeof(gnrc_rpl_opt_t) + opt->length;
+        }
+
+        expect(gnrc_rpl_routes_update(parent, targets, numof, &_addrs[node],
+                                      IFACE, LIFETIME, now) == numof);
+    }
+
+    return bytes;
+}
+
+static void _simulate(unsigned nodes, int mode, uint32_t *bytes,
+                      uint32_t *nib_ops)
+{
+    for (unsigned i = 0; i <= nodes; i++) {
+        gnrc_rpl_routes_init(&_tables[i]);
+        _addr_init(&_addrs[i], (i == 0) ? 0 : _subtree(i), i);
+        if ((mode == MODE_PREFIX) && (i != 0) && (_parent(i) == 0)) {
+            /* routers below the root were delegated a prefix */
+            ipv6_addr_t prefix;
+            _addr_init(&prefix, i, 0);
+            gnrc_rpl_routes_aggregate(&_tables[i], &prefix, 64);
+        }
+    }
+
+    *bytes = 0;
+    for (unsigned round = 0; round < ROUNDS; round++) {
+        uint32_t now = round * ROUND_TIME;
+
+        if (round == 1) {
+            /* the first round installs the routes, the following rounds
+             * refresh them */
+            *bytes = 0;
+            _nib_ops = 0;
+        }
+        /* children have higher numbers than their parents */
+        for (unsigned i = nodes; i > 0; i--) {
+            gnrc_rpl_routes_expire(&_tables[i], now);
+            *bytes += _send_daos(i, mode, now);
+        }
+    }
+    *bytes /= ROUNDS - 1;
+    *nib_ops = _nib_ops / (ROUNDS - 1);
+    _at_root = true;
+
+    /* each node is reached through the router of its subtree */
+    for (unsigned i = 1; i <= nodes; i++) {
+        const gnrc_rpl_route_t *route = gnrc_rpl_routes_lookup(&_tables[0],
+                                                               &_addrs[i],
+                                                               0);
+        expect(route);
+        expect(ipv6_addr_equal(&_tables[0].next_hops[route->next_hop].addr,
+                               &_addrs[_subtree(i)]));
+        expect(route->prefix_len == ((mode == MODE_PREFIX) ? 64 : 128));
+    }
+}
+
+/* time to install the routes to all nodes at root in ns per route */
+static uint32_t _install_time(unsigned nodes)
+{
+    gnrc_rpl_routes_target_t targets[CONFIG_GNRC_RPL_DAO_TARGETS_MAX];
+    uint32_t time = 0;
+
+    for (unsigned run = 0; run < ROUNDS; run++) {
+        gnrc_rpl_routes_init(&_tables[0]);
+
+        uint32_t start = ztimer_now(ZTIMER_USEC);
+        /* the deepest nodes are announced first, as in the simulation */
+        for (unsigned i = nodes; i > 0;) {
+            unsigned numof = 0;
+            unsigned child = _subtree(i);
+            while ((i > 0) && (numof < ARRAY_SIZE(targets)) &&
+                   (_subtree(i) == child)) {
+                targets[numof++] = _target(&_addrs[i--], 128);
+            }
+            gnrc_rpl_routes_update(&_tables[0], targets, numof, &_addrs[child],
+                                   IFACE, LIFETIME, 0);
+        }
+        time += ztimer_now(ZTIMER_USEC) - start;
+        expect(_tables[0].numof == nodes);
+    }
+
+    return time * 1000 / (ROUNDS * nodes);
+}
+
+static void _benchmark(unsigned nodes)
+{
+    uint32_t bytes[MODE_NUMOF];
+    uint32_t nib_ops[MODE_NUMOF];
+
+    for (int mode = 0; mode < MODE_NUMOF; mode++) {
+        _simulate(nodes, mode, &bytes[mode], &nib_ops[mode]);
+    }
+    expect(bytes[MODE_AGGREGATED] < bytes[MODE_LEGACY]);
+    expect(bytes[MODE_PREFIX] < bytes[MODE_AGGREGATED]);
+    expect(nib_ops[MODE_AGGREGATED] < nib_ops[MODE_LEGACY]);
+
+    print_u32_dec(nodes);
+    print_str(" nodes: DAO bytes/min legacy ");
+    print_u32_dec(bytes[MODE_LEGACY]);
+    print_str(", aggregated ");
+    print_u32_dec(bytes[MODE_AGGREGATED]);
+    print_str(", prefix ");
+    print_u32_dec(bytes[MODE_PREFIX]);
+    print_str("\n");
+
+    print_u32_dec(nodes);
+    print_str(" nodes: NIB ops/min at root legacy ");
+    print_u32_dec(nib_ops[MODE_LEGACY]);
+    print_str(", aggregated ");
+    print_u32_dec(nib_ops[MODE_AGGREGATED]);
+    print_str("\n");
+
+    print_u32_dec(nodes);
+    print_str(" nodes: route install at root ");
+    print_u32_dec(_install_time(nodes));
+    print_str(" ns\n");
+}
+
+int main(void)
+{
+    _test_update();
+    _test_no_path();
+    _test_expiry();
+    _test_clear();
+    _test_targets();
+    _test_aggregation();
+
+    _benchmark(50);
+    _benchmark(NODES_MAX);
+
+    puts("SUCCESS");
+    return 0;
+}
@@ -0,0 +1,28 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2021 Gunar Schorcht
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    for test in ("update", "No-Path", "expiry", "clear", "targets",
+                 "aggregation"):
+        child.expect_exact("Testing {} ...".format(test))
+        child.expect_exact("Done")
+    for nodes in (50, 200):
+        child.expect(r"{} nodes: DAO bytes/min legacy \d+, aggregated \d+, "
+                     r"prefix \d+".format(nodes))
+        child.expect(r"{} nodes: NIB ops/min at root legacy \d+, "
+                     r"aggregated \d+".format(nodes))
+        child.expect(r"{} nodes: route install at root \d+ ns".format(nodes))
+    child.expect_exact("SUCCESS")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc, timeout=60))
@@ -33,7 +33,7 @@ DNS_MSG_COMP_MASK = b"\xc0"
 TEST_NAME = "example.org"
 TEST_A_DATA = "10.0.0.1"
 TEST_AAAA_DATA = "2001:db8::1"
-TEST_QDCOUNT = 2
+TEST_QDCOUNT = 1
 TEST_ANCOUNT = 2
 
 
@@ -49,49 +49,53 @@ class Server(threading.Thread):
             else:
                 sockaddr = ("", bind_port)
             self.socket.bind(sockaddr)
+        self.socket.settimeout(0.1)
         self.stopped = False
-        self.enter_loop = threading.Event()
+        self.reply = None
 
     def run(self):
-        while True:
-            self.enter_loop.wait()
-            self.enter_loop.clear()
-            if self.stopped:
-                return
-            p, remote = self.socket.recvfrom(1500)
+        while not self.stopped:
+            try:
+                p, remote = self.socket.recvfrom(1500)
+            except socket.timeout:
+                continue
             p = DNS(raw(p))
             # check received packet for correctness
             assert(p is not None)
             assert(p[DNS].qr == 0)
             assert(p[DNS].opcode == 0)
-            # has two queries
+            # AAAA and A are queried separately
             assert(p[DNS].qdcount == TEST_QDCOUNT)
-            qdcount = p[DNS].qdcount
-            # both for TEST_NAME
+            assert(p[DNS].id != 0)
             assert(p[DNS].qd[0].qname == TEST_NAME.encode("utf-8") + b".")
-            assert(p[DNS].qd[1].qname == TEST_NAME.encode("utf-8") + b".")
-            assert(any(p[DNS].qd[i].qtype == DNS_RR_TYPE_A
-                       for i in range(qdcount)))    # one is A
-            assert(any(p[DNS].qd[i].qtype == DNS_RR_TYPE_AAAA
-                       for i in range(qdcount)))    # one is AAAA
-            if self.reply is not None:
-                self.socket.sendto(raw(self.reply), remote)
-                self.reply = None
+            assert(p[DNS].qd[0].qtype in (DNS_RR_TYPE_A, DNS_RR_TYPE_AAAA))
+            reply = self.reply
+            if reply is not None:
+                # the reply has to carry the ID of the query
+                reply = raw(reply(p[DNS].qd[0]))
+                reply = p[DNS].id.to_bytes(2, "big") + reply[2:]
+                self.socket.sendto(reply, remote)
 
     def listen(self, reply=None):
+        """Answers all following queries with the packet returned by
+        reply for the question of the query"""
         self.reply = reply
-        self.enter_loop.set()
 
     def stop(self):
         self.stopped = True
-        self.enter_loop.set()
-        self.socket.close()
         self.join()
+        self.socket.close()
 
 
 server = None
 
 
+def _reply(qd=None, **kwargs):
+    """Returns a function that builds a reply for the question of a query,
+    the question is repeated in the reply unless qd is given"""
+    return lambda query: DNS(qr=1, qd=query if qd is None else qd, **kwargs)
+
+
 def check_and_search_output(cmd, pattern, res_group, *args, **kwargs):
     output = subprocess.check_output(cmd, *args, **kwargs).decode("utf-8")
     for line in output.splitlines():
@@ -139,14 +143,12 @@ def successful_dns_request(child, name, exp_addr=None):
 
 
 def test_success(child):
-    server.listen(DNS(qr=1, qdcount=TEST_QDCOUNT, ancount=TEST_ANCOUNT,
-                      qd=(DNSQR(qname=TEST_NAME, qtype=DNS_RR_TYPE_AAAA) /
-                          DNSQR(qname=TEST_NAME, qtype=DNS_RR_TYPE_A)),
-                      an=(DNSRR(rrname=TEST_NAME, type=DNS_RR_TYPE_AAAA,
-                                rdlen=DNS_RR_TYPE_AAAA_DLEN,
-                                rdata=TEST_AAAA_DATA) /
-                          DNSRR(rrname=TEST_NAME, type=DNS_RR_TYPE_A,
-                                rdlen=DNS_RR_TYPE_A_DLEN, rdata=TEST_A_DATA))))
+    server.listen(_reply(qdcount=TEST_QDCOUNT, ancount=TEST_ANCOUNT,
+                         an=(DNSRR(rrname=TEST_NAME, type=DNS_RR_TYPE_AAAA,
+                                   rdlen=DNS_RR_TYPE_AAAA_DLEN,
+                                   rdata=TEST_AAAA_DATA) /
+                             DNSRR(rrname=TEST_NAME, type=DNS_RR_TYPE_A,
+                                   rdlen=DNS_RR_TYPE_A_DLEN, rdata=TEST_A_DATA))))
     assert(successful_dns_request(child, TEST_NAME, TEST_AAAA_DATA))
 
 
@@ -157,116 +159,100 @@ def test_timeout(child):
 
 
 def test_too_short_response(child):
-    server.listen(Raw(b"\x00\x00\x81\x00"))
+    server.listen(lambda qd: Raw(b"\x00\x00\x81\x00"))
     assert(not successful_dns_request(child, TEST_NAME))
 
 
 def test_qdcount_too_large1(child):
     # as reported in https://github.com/RIOT-OS/RIOT/issues/10739
-    server.listen(base64.b64decode("AACEAwkmAAAAAAAAKioqKioqKioqKioqKioqKioqKio="))
+    server.listen(lambda qd: Raw(base64.b64decode(
+        "AACEAwkmAAAAAAAAKioqKioqKioqKioqKioqKioqKio=")))
     assert(not successful_dns_request(child, TEST_NAME))
 
 
 def test_qdcount_too_large2(child):
-    server.listen(DNS(qr=1, qdcount=40961, ancount=TEST_ANCOUNT,
-                      qd=(DNSQR(qname=TEST_NAME, qtype=DNS_RR_TYPE_AAAA) /
-                          DNSQR(qname=TEST_NAME, qtype=DNS_RR_TYPE_A)),
-                      an=(DNSRR(rrname=TEST_NAME, type=DNS_RR_TYPE_AAAA,
-                                rdlen=DNS_RR_TYPE_AAAA_DLEN,
-                                rdata=TEST_AAAA_DATA) /
-                          DNSRR(rrname=TEST_NAME, type=DNS_RR_TYPE_A,
-                                rdlen=DNS_RR_TYPE_A_DLEN, rdata=TEST_A_DATA))))
+    server.listen(_reply(qdcount=40961, ancount=TEST_ANCOUNT,
+                         an=(DNSRR(rrname=TEST_NAME, type=DNS_RR_TYPE_AAAA,
+                                   rdlen=DNS_RR_TYPE_AAAA_DLEN,
+                                   rdata=TEST_AAAA_DATA) /
+                             DNSRR(rrname=TEST_NAME, type=DNS_RR_TYPE_A,
+                                   rdlen=DNS_RR_TYPE_A_DLEN, rdata=TEST_A_DATA))))
     assert(not successful_dns_request(child, TEST_NAME))
 
 
 def test_ancount_too_large1(child):
-    server.listen(DNS(qr=1, qdcount=TEST_QDCOUNT, ancount=2714,
-                      qd=(DNSQR(qname=TEST_NAME, qtype=DNS_RR_TYPE_AAAA) /
-                          DNSQR(qname=TEST_NAME, qtype=DNS_RR_TYPE_A)),
-                      an=(DNSRR(rrname=TEST_NAME, type=DNS_RR_TYPE_AAAA,
-                                rdlen=DNS_RR_TYPE_AAAA_DLEN,
-                                rdata=TEST_AAAA_DATA) /
-                          DNSRR(rrname=TEST_NAME, type=DNS_RR_TYPE_A,
-                                rdlen=DNS_RR_TYPE_A_DLEN, rdata=TEST_A_DATA))))
+    server.listen(_reply(qdcount=TEST_QDCOUNT, ancount=2714,
+                         an=(DNSRR(rrname=TEST_NAME, type=DNS_RR_TYPE_AAAA,
+                                   rdlen=DNS_RR_TYPE_AAAA_DLEN,
+                                   rdata=TEST_AAAA_DATA) /
+                             DNSRR(rrname=TEST_NAME, type=DNS_RR_TYPE_A,
+                                   rdlen=DNS_RR_TYPE_A_DLEN, rdata=TEST_A_DATA))))
     assert(not successful_dns_request(child, TEST_NAME, TEST_AAAA_DATA))
 
 
 def test_ancount_too_large2(child):
-    server.listen(DNS(qr=1, qdcount=TEST_QDCOUNT, ancount=19888,
-                      qd=(DNSQR(qname=TEST_NAME, qtype=DNS_RR_TYPE_AAAA) /
-                          DNSQR(qname=TEST_NAME, qtype=DNS_RR_TYPE_A)),
-                      an="\0"))
+    server.listen(_reply(qdcount=TEST_QDCOUNT, ancount=19888,
+                         an="\0"))
     assert(not successful_dns_request(child, TEST_NAME))
 
 
 def test_bad_compressed_message_query(child):
-    server.listen(DNS(qr=1, qdcount=1, ancount=1,
-                      qd=DNS_MSG_COMP_MASK))
+    server.listen(_reply(qdcount=1, ancount=1,
+                         qd=DNS_MSG_COMP_MASK))
     assert(not successful_dns_request(child, TEST_NAME))
 
 
 def test_bad_compressed_message_answer(child):
-    server.listen(DNS(qr=1, qdcount=TEST_QDCOUNT, ancount=TEST_ANCOUNT,
-                      qd=(DNSQR(qname=TEST_NAME, qtype=DNS_RR_TYPE_AAAA) /
-                          DNSQR(qname=TEST_NAME, qtype=DNS_RR_TYPE_A)),
-                      an=DNS_MSG_COMP_MASK))
+    server.listen(_reply(qdcount=TEST_QDCOUNT, ancount=TEST_ANCOUNT,
+                         an=DNS_MSG_COMP_MASK))
     assert(not successful_dns_request(child, TEST_NAME))
 
 
 def test_malformed_hostname_query(child):
-    server.listen(DNS(qr=1, qdcount=TEST_QDCOUNT, ancount=0,
-                      qd=(DNSQR(qname=TEST_NAME, qtype=DNS_RR_TYPE_AAAA) /
-                          # need to use byte string here to induce wrong label
-                          # lengths
-                          b"\xafexample\x03org\x00\x00\x1c\x00\x01")))
+    server.listen(_reply(qdcount=TEST_QDCOUNT, ancount=0,
+                         # need to use byte string here to induce wrong label
+                         # lengths
+                         qd=b"\xafexample\x03org\x00\x00\x1c\x00\x01"))
     assert(not successful_dns_request(child, TEST_NAME))
 
 
 def test_malformed_hostname_answer(child):
-    server.listen(DNS(qr=1, qdcount=TEST_QDCOUNT, ancount=TEST_ANCOUNT,
-                      qd=(DNSQR(qname=TEST_NAME, qtype=DNS_RR_TYPE_AAAA) /
-                          DNSQR(qname=TEST_NAME, qtype=DNS_RR_TYPE_A)),
-                      # need to use byte string here to induce wrong label
-                      # lengths
-                      an=(b"\xaftest\x00\x00\x1c\x00\x01\x00\x00\x00\x00\x00\x10"
-                          b"\x20\x01\x0d\xb8\x00\x00\x00\x00\x00\x00\x00\x00\x00"
-                          b"\x00\x00\x01" /
-                          DNSQR(qname=TEST_NAME, qtype=DNS_RR_TYPE_A))))
+    server.listen(_reply(qdcount=TEST_QDCOUNT, ancount=TEST_ANCOUNT,
+                         # need to use byte string here to induce wrong label
+                         # lengths
+                         an=(b"\xaftest\x00\x00\x1c\x00\x01\x00\x00\x00\x00\x00\x10"
+                             b"\x20\x01\x0d\xb8\x00\x00\x00\x00\x00\x00\x00\x00\x00"
+                             b"\x00\x00\x01" /
+                             DNSQR(qname=TEST_NAME, qtype=DNS_RR_TYPE_A))))
     assert(not successful_dns_request(child, TEST_NAME))
 
 
 def test_addrlen_too_large(child):
-    server.listen(DNS(qr=1, qdcount=TEST_QDCOUNT, ancount=TEST_ANCOUNT,
-                      qd=(DNSQR(qname=TEST_NAME, qtype=DNS_RR_TYPE_AAAA) /
-                          DNSQR(qname=TEST_NAME, qtype=DNS_RR_TYPE_A)),
-                      an=(DNSRR(rrname=TEST_NAME, type=DNS_RR_TYPE_AAAA,
-                                rdlen=18549, rdata=TEST_AAAA_DATA) /
-                          DNSRR(rrname=TEST_NAME, type=DNS_RR_TYPE_A,
-                                rdlen=DNS_RR_TYPE_A_DLEN, rdata=TEST_A_DATA))))
+    server.listen(_reply(qdcount=TEST_QDCOUNT, ancount=TEST_ANCOUNT,
+                         an=(DNSRR(rrname=TEST_NAME, type=DNS_RR_TYPE_AAAA,
+                                   rdlen=18549, rdata=TEST_AAAA_DATA) /
+                             DNSRR(rrname=TEST_NAME, type=DNS_RR_TYPE_A,
+                                   rdlen=DNS_RR_TYPE_A_DLEN, rdata=TEST_A_DATA))))
     assert(not successful_dns_request(child, TEST_NAME, TEST_AAAA_DATA))
 
 
 def test_addrlen_wrong_ip6(child):
-    server.listen(DNS(qr=1, qdcount=TEST_QDCOUNT, ancount=TEST_ANCOUNT,
-                      qd=(DNSQR(qname=TEST_NAME, qtype=DNS_RR_TYPE_AAAA) /
-                          DNSQR(qname=TEST_NAME, qtype=DNS_RR_TYPE_A)),
-                      an=(DNSRR(rrname=TEST_NAME, type=DNS_RR_TYPE_AAAA,
-                                rdlen=DNS_RR_TYPE_AAAA_DLEN + 1,
-                                rdata=(TEST_AAAA_DATA)) /
-                          DNSRR(rrname=TEST_NAME, type=DNS_RR_TYPE_A,
-                                rdlen=DNS_RR_TYPE_A_DLEN, rdata=TEST_A_DATA))))
+    server.listen(_reply(qdcount=TEST_QDCOUNT, ancount=TEST_ANCOUNT,
+                         an=(DNSRR(rrname=TEST_NAME, type=DNS_RR_TYPE_AAAA,
+                                   rdlen=DNS_RR_TYPE_AAAA_DLEN + 1,
+                                   rdata=(TEST_AAAA_DATA)) /
+                             DNSRR(rrname=TEST_NAME, type=DNS_RR_TYPE_A,
+                                   rdlen=DNS_RR_TYPE_A_DLEN, rdata=TEST_A_DATA))))
     assert(not successful_dns_request(child, TEST_NAME, TEST_AAAA_DATA))
 
 
 def test_addrlen_wrong_ip4(child):
-    server.listen(DNS(qr=1, qdcount=TEST_QDCOUNT, ancount=TEST_ANCOUNT,
-                      qd=(DNSQR(qname=TEST_NAME, qtype=DNS_RR_TYPE_AAAA) /
-                          DNSQR(qname=TEST_NAME, qtype=DNS_RR_TYPE_A)),
-                      an=(DNSRR(rrname=TEST_NAME, type=DNS_RR_TYPE_A,
-                                rdlen=DNS_RR_TYPE_A - 1, rdata=TEST_A_DATA) /
-                          DNSRR(rrname=TEST_NAME, type=DNS_RR_TYPE_AAAA,
-                                rdlen=DNS_RR_TYPE_AAAA_DLEN,
-                                rdata=TEST_AAAA_DATA))))
+    server.listen(_reply(qdcount=TEST_QDCOUNT, ancount=TEST_ANCOUNT,
+                         an=(DNSRR(rrname=TEST_NAME, type=DNS_RR_TYPE_A,
+                                   rdlen=DNS_RR_TYPE_A - 1, rdata=TEST_A_DATA) /
+                             DNSRR(rrname=TEST_NAME, type=DNS_RR_TYPE_AAAA,
+                                   rdlen=DNS_RR_TYPE_AAAA_DLEN,
+                                   rdata=TEST_AAAA_DATA))))
     assert(not successful_dns_request(child, TEST_NAME, TEST_AAAA_DATA))
 
 
@@ -0,0 +1,509 @@
+/*
+ * Copyright (C) 2021 Gunar Schorcht
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Tests and benchmark of the burst transmission of the SubMAC
+ *
+ * The SubMAC is used with a mock radio without hardware CSMA-CA and
+ * retransmissions. The airtime of the frames and the ACKs is emulated with
+ * sleeps, a configurable share of the CCAs fails. The tests check the frame
+ * pending bit and the burst statistics. The benchmark measures the time
+ * needed to send all 6LoWPAN fragments of a 1280 byte datagram with single
+ * frames and as a burst.
+ *
+ * @author      Gunar Schorcht <gunar@schorcht.net>
+ * @}
+ */
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "byteorder.h"
+#include "fmt.h"
+#include "kernel_defines.h"
+#include "net/ieee802154.h"
+#include "net/ieee802154/submac.h"
+#include "net/sixlowpan.h"
+#include "xtimer.h"
+
+#include "test_utils/expect.h"
+
+#define DATAGRAM_SIZE       (1280U)
+#define DATAGRAMS           (20U)
+#define FRAG_PAYLOAD        (96U)   /**< datagram bytes per fragment */
+#define FRAGS_MAX           ((DATAGRAM_SIZE + FRAG_PAYLOAD - 1) / FRAG_PAYLOAD)
+#define MHR_LEN             (21U)   /**< long addresses, PAN ID compressed */
+#define BUSY_PERCENT        (10U)   /**< share of failed CCAs */
+
+#define US_PER_BYTE         (32U)   /**< 250 kbit/s O-QPSK */
+#define PHY_OVERHEAD        (6U)    /**< preamble, SFD and PHR */
+#define CCA_US              (128U)
+#define ACK_US              (192U + (5U + PHY_OVERHEAD) * US_PER_BYTE)
+
+static ieee802154_submac_t _submac;
+static ieee802154_dev_t _dev;
+
+static uint8_t _mhr[MHR_LEN];
+static uint8_t _payload[sizeof(sixlowpan_frag_n_t) + FRAG_PAYLOAD];
+static iolist_t _iol_payload = { .iol_base = _payload };
+static iolist_t _iol = { .iol_next = &_iol_payload, .iol_base = _mhr,
+                         .iol_len = sizeof(_mhr) };
+
+/* state of the mock radio */
+static uint8_t _fcf;
+static size_t _len;
+static bool _tx_requested;
+static bool _cca_busy;
+static bool _ack_timer;
+static unsigned _busy_percent;
+static unsigned _busy_ccas;     /**< number of following CCAs that fail */
+static unsigned _acks_lost;
+static unsigned _transmissions;
+static uint8_t _backoff_masks[8];   /**< backoff of the transmission attempts */
+
+/* result of the last transmission */
+static int _tx_status;
+
+static uint32_t _rand_state;
+
+static uint32_t _rand(void)
+{
+    /* xorshift32 */
+    _rand_state ^= _rand_state << 13;
+    _rand_state ^= _rand_state >> 17;
+    _rand_state ^= _rand_state << 5;
+    return _rand_state;
+}
+
+static int _write(ieee802154_dev_t *dev, const iolist_t *psdu)
+{
+    (void)dev;
+    _fcf = ((uint8_t *)psdu->iol_base)[0];
+    _len = iolist_size(psdu);
+    return 0;
+}
+
+static int _request_transmit(ieee802154_dev_t *dev)
+{
+    (void)dev;
+    _tx_requested = true;
+    if (_busy_ccas) {
+        _busy_ccas--;
+        _cca_busy = true;
+    }
+    else {
+        _cca_busy = (_rand() % 100) < _busy_percent;
+    }
+    if (_transmissions < ARRAY_SIZE(_backoff_masks)) {
+        _backoff_masks[_transmissions] = _submac.backoff_mask;
+    }
+    _transmissions++;
+    return 0;
+}
+
+static int _confirm_transmit(ieee802154_dev_t *dev, ieee802154_tx_info_t *info)
+{
+    (void)dev;
+    info->status = _cca_busy ? TX_STATUS_MEDIUM_BUSY : TX_STATUS_SUCCESS;
+    info->retrans = -1;
+    return 0;
+}
+
+static int _len_cb(ieee802154_dev_t *dev)
+{
+    (void)dev;
+    return 3;
+}
+
+static int _read(ieee802154_dev_t *dev, void *buf, size_t size,
+                 ieee802154_rx_info_t *info)
+{
+    (void)dev;
+    (void)info;
+    static const uint8_t ack[] = { IEEE802154_FCF_TYPE_ACK, 0, 0 };
+
+    if (size < sizeof(ack)) {
+        return -ENOBUFS;
+    }
+    memcpy(buf, ack, sizeof(ack));
+    return sizeof(ack);
+}
+
+static int _ok(ieee802154_dev_t *dev)
+{
+    (void)dev;
+    return 0;
+}
+
+static int _set_trx_state(ieee802154_dev_t *dev, ieee802154_trx_state_t state)
+{
+    (void)dev;
+    (void)state;
+    return 0;
+}
+
+static int _set_cca_threshold(ieee802154_dev_t *dev, int8_t threshold)
+{
+    (void)dev;
+    (void)threshold;
+    return 0;
+}
+
+static int _config_phy(ieee802154_dev_t *dev, const ieee802154_phy_conf_t *conf)
+{
+    (void)dev;
+    (void)conf;
+    return 0;
+}
+
+static int _set_hw_addr_filter(ieee802154_dev_t *dev,
+                               const network_uint16_t *short_addr,
+                               const eui64_t *ext_addr, const uint16_t *pan_id)
+{
+    (void)dev;
+    (void)short_addr;
+    (void)ext_addr;
+    (void)pan_id;
+    return 0;
+}
+
+static int _set_rx_mode(ieee802154_dev_t *dev, ieee802154_rx_mode_t mode)
+{
+    (void)dev;
+    (void)mode;
+    return 0;
+}
+
+static const ieee802154_radio_ops_t _ops = {
+    .caps = IEEE802154_CAP_24_GHZ | IEEE802154_CAP_IRQ_TX_DONE |
+            IEEE802154_CAP_PHY_OQPSK,
+    .write = _write,
+    .request_transmit = _request_transmit,
+    .confirm_transmit = _confirm_transmit,
+    .len = _len_cb,
+    .read = _read,
+    .off = _ok,
+    .request_on = _ok,
+    .confirm_on = _ok,
+    .request_set_trx_state = _set_trx_state,
+    .confirm_set_trx_state = _ok,
+    .set_cca_threshold = _set_cca_threshold,
+    .config_phy = _config_phy,
+    .set_hw_addr_filter = _set_hw_addr_filter,
+    .set_rx_mode = _set_rx_mode,
+};
+
+void ieee802154_submac_ack_timer_set(ieee802154_submac_t *submac, uint16_t us)
+{
+    (void)submac;
+    (void)us;
+    _ack_timer = true;
+}
+
+void ieee802154_submac_ack_timer_cancel(ieee802154_submac_t *submac)
+{
+    (void)submac;
+    _ack_timer = false;
+}
+
+static void _rx_done(ieee802154_submac_t *submac)
+{
+    (void)submac;
+}
+
+static void _tx_done(ieee802154_submac_t *submac, int status,
+                     ieee802154_tx_info_t *info)
+{
+    (void)submac;
+    (void)info;
+    _tx_status = status;
+}
+
+static const ieee802154_submac_cb_t _cb = {
+    .rx_done = _rx_done,
+    .tx_done = _tx_done,
+};
+
+/* emulates the radio until the SubMAC finished the transmission */
+static int _run(void)
+{
+    while (_submac.tx) {
+        expect(_tx_requested);
+        _tx_requested = false;
+
+        if (_cca_busy) {
+            xtimer_usleep(CCA_US);
+        }
+        else {
+            xtimer_usleep(CCA_US + (_len + 2 + PHY_OVERHEAD) * US_PER_BYTE);
+        }
+        ieee802154_submac_tx_done_cb(&_submac);
+
+        if (_ack_timer) {
+            xtimer_usleep(ACK_US);
+            if (_acks_lost) {
+                _acks_lost--;
+                _ack_timer = false;
+                ieee802154_submac_ack_timeout_fired(&_submac);
+            }
+            else {
+                ieee802154_submac_rx_done_cb(&_submac);
+            }
+        }
+    }
+    return _tx_status;
+}
+
+/* prepares the fragment starting at offset of the datagram */
+static void _frag(uint16_t tag, unsigned offset)
+{
+    sixlowpan_frag_n_t *hdr = (sixlowpan_frag_n_t *)_payload;
+    unsigned len = DATAGRAM_SIZE - offset;
+
+    if (len > FRAG_PAYLOAD) {
+        len = FRAG_PAYLOAD;
+    }
+
+    hdr->disp_size = byteorder_htons(DATAGRAM_SIZE);
+    hdr->tag = byteorder_htons(tag);
+    if (offset == 0) {
+        hdr->disp_size.u8[0] |= SIXLOWPAN_FRAG_1_DISP;
+        _iol_payload.iol_len = sizeof(sixlowpan_frag_t) + len;
+    }
+    else {
+        hdr->disp_size.u8[0] |= SIXLOWPAN_FRAG_N_DISP;
+        hdr->offset = offset / 8;
+        _iol_payload.iol_len = sizeof(sixlowpan_frag_n_t) + len;
+    }
+}
+
+static int _send(bool burst, bool more)
+{
+    int res = burst ? ieee802154_send_burst(&_submac, &_iol, more)
+                    : ieee802154_send(&_submac, &_iol);
+
+    expect(res == 0);
+    return _run();
+}
+
+/* sends all fragments of a datagram, returns the time needed */
+static uint32_t _send_datagram(uint16_t tag, bool burst)
+{
+    uint32_t start = xtimer_now_usec();
+
+    for (unsigned offset = 0; offset < DATAGRAM_SIZE; offset += FRAG_PAYLOAD) {
+        bool more = (offset + FRAG_PAYLOAD) < DATAGRAM_SIZE;
+
+        _frag(tag, offset);
+        expect(_send(burst, more) == TX_STATUS_SUCCESS);
+        expect(!!(_fcf & IEEE802154_FCF_FRAME_PEND) == (burst && more));
+    }
+
+    return xtimer_now_usec() - start;
+}
+
+static void _init(void)
+{
+    const network_uint16_t short_addr = { .u8 = { 0x00, 0x01 } };
+    const eui64_t ext_addr = { .uint8 = { 0x02, 0x00, 0x4b, 0x12,
+                                          0x00, 0x00, 0x00, 0x01 } };
+
+    _dev.driver = &_ops;
+    _submac.dev = &_dev;
+    _submac.cb = &_cb;
+    expect(ieee802154_submac_init(&_submac, &short_addr, &ext_addr) == 0);
+
+    _busy_percent = 0;
+    _busy_ccas = 0;
+    _acks_lost = 0;
+    _rand_state = 0x20210806;
+}
+
+static void test_frame_pending(void)
+{
+    const ieee802154_submac_burst_stats_t *stats;
+
+    _init();
+    stats = ieee802154_get_burst_stats(&_submac);
+
+    _send_datagram(1, true);
+    expect(stats->bursts == 1);
+    expect(stats->frames == FRAGS_MAX);
+    expect(stats->fast == FRAGS_MAX - 1);
+    expect(stats->aborted == 0);
+
+    /* the frame pending bit is cleared again for single frames */
+    _send_datagram(2, false);
+    expect(stats->frames == FRAGS_MAX);
+
+    /* a single frame ends the burst */
+    _frag(3, 0);
+    expect(_send(true, true) == TX_STATUS_SUCCESS);
+    expect(_send(false, false) == TX_STATUS_SUCCESS);
+    expect(_send(true, false) == TX_STATUS_SUCCESS);
+    expect(stats->bursts == 3);
+    expect(stats->fast == FRAGS_MAX - 1);
+
+    puts("frame pending: OK");
+}
+
+static void test_abort(void)
+{
+    const ieee802154_submac_burst_stats_t *stats;
+
+    _init();
+    stats = ieee802154_get_burst_stats(&_submac);
+
+    _frag(1, 0);
+    expect(_send(true, true) == TX_STATUS_SUCCESS);
+
+    /* all CCAs fail, the burst is aborted */
+    _busy_percent = 100;
+    _transmissions = 0;
+    _frag(1, FRAG_PAYLOAD);
+    expect(_send(true, true) == TX_STATUS_MEDIUM_BUSY);
+    expect(_transmissions == _submac.csma_retries + 1U);
+    expect(stats->aborted == 1);
+
+    /* the next frame starts a new burst with the regular backoff */
+    _busy_percent = 0;
+    expect(_send(true, true) == TX_STATUS_SUCCESS);
+    expect(stats->bursts == 2);
+    expect(stats->frames == 3);
+    expect(stats->fast == 1);
+
+    puts("abort: OK");
+}
+
+static void test_busy(void)
+{
+    const ieee802154_submac_burst_stats_t *stats;
+    uint8_t regular_mask;
+
+    _init();
+    stats = ieee802154_get_burst_stats(&_submac);
+
+    /* the backoff of a regular frame after its first failed CCA */
+    _busy_ccas = 1;
+    _transmissions = 0;
+    _frag(1, 0);
+    expect(_send(false, false) == TX_STATUS_SUCCESS);
+    expect(_transmissions == 2);
+    regular_mask = _backoff_masks[1];
+
+    _frag(1, 0);
+    expect(_send(true, true) == TX_STATUS_SUCCESS);
+
+    /* the first CCA of the frame fails, it continues with the backoff of a
+     * regular frame after its first failed CCA */
+    _busy_ccas = 1;
+    _transmissions = 0;
+    _frag(1, FRAG_PAYLOAD);
+    expect(_send(true, true) == TX_STATUS_SUCCESS);
+    expect(_transmissions == 2);
+    expect(_backoff_masks[0] == (1 << CONFIG_IEEE802154_SUBMAC_BURST_BE) - 1);
+    expect(_backoff_masks[1] == regular_mask);
+    expect(_backoff_masks[1] != (1 << _submac.be.min) - 1);
+    expect((stats->fast == 1) && (stats->aborted == 0));
+
+    /* the next frame of the burst uses the burst backoff again */
+    _transmissions = 0;
+    expect(_send(true, false) == TX_STATUS_SUCCESS);
+    expect(_backoff_masks[0] == (1 << CONFIG_IEEE802154_SUBMAC_BURST_BE) - 1);
+    expect(stats->fast == 2);
+
+    puts("busy: OK");
+}
+
+static void test_retransmission(void)
+{
+    const ieee802154_submac_burst_stats_t *stats;
+
+    _init();
+    stats = ieee802154_get_burst_stats(&_submac);
+    _mhr[0] |= IEEE802154_FCF_ACK_REQ;
+
+    _frag(1, 0);
+    expect(_send(true, true) == TX_STATUS_SUCCESS);
+
+    /* retransmissions use the regular backoff */
+    _acks_lost = 2;
+    _transmissions = 0;
+    _frag(1, FRAG_PAYLOAD);
+    expect(_send(true, true) == TX_STATUS_SUCCESS);
+    expect(_transmissions == 3);
+    expect(stats->fast == 1);
+
+    /* all retransmissions fail, the burst is aborted */
+    _acks_lost = IEEE802154_SUBMAC_MAX_RETRANSMISSIONS + 1;
+    expect(_send(true, true) == TX_STATUS_NO_ACK);
+    expect(stats->aborted == 1);
+    expect(_send(true, false) == TX_STATUS_SUCCESS);
+    expect(stats->bursts == 2);
+    expect(stats->fast == 2);
+
+    puts("retransmission: OK");
+}
+
+static uint32_t bench(bool burst)
+{
+    uint32_t usec = 0;
+
+    _init();
+    _busy_percent = BUSY_PERCENT;
+    _mhr[0] |= IEEE802154_FCF_ACK_REQ;
+
+    for (unsigned i = 0; i < DATAGRAMS; i++) {
+        usec += _send_datagram(i, burst);
+    }
+
+    print_str(burst ? "burst" : "single");
+    print_str(": ");
+    print_u32_dec(usec / DATAGRAMS);
+    print_str(" us per datagram\n");
+
+    return usec;
+}
+
+int main(void)
+{
+    /* data frame, PAN ID compression, long addresses */
+    _mhr[0] = IEEE802154_FCF_TYPE_DATA | IEEE802154_FCF_PAN_COMP;
+    _mhr[1] = IEEE802154_FCF_DST_ADDR_LONG | IEEE802154_FCF_SRC_ADDR_LONG;
+
+    test_frame_pending();
+    test_abort();
+    test_busy();
+    test_retransmission();
+
+    uint32_t single = bench(false);
+    uint32_t burst = bench(true);
+
+    const ieee802154_submac_burst_stats_t *stats =
+        ieee802154_get_burst_stats(&_submac);
+    print_str("bursts: ");
+    print_u32_dec(stats->bursts);
+    print_str(", frames: ");
+    print_u32_dec(stats->frames);
+    print_str(", fast: ");
+    print_u32_dec(stats->fast);
+    print_str(", aborted: ");
+    print_u32_dec(stats->aborted);
+    print_str("\n");
+
+    expect(stats->frames == DATAGRAMS * FRAGS_MAX);
+    expect(burst < single);
+
+    puts("SUCCESS");
+    return 0;
+}
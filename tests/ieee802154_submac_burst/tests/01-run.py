@@ -0,0 +1,23 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2021 Gunar Schorcht
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    for test in ("frame pending", "abort", "busy", "retransmission"):
+        child.expect_exact("{}: OK".format(test))
+    for mode in ("single", "burst"):
+        child.expect(r"{}: \d+ us per datagram".format(mode))
+    child.expect(r"bursts: \d+, frames: \d+, fast: \d+, aborted: \d+")
+    child.expect_exact("SUCCESS")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc, timeout=60))
@@ -0,0 +1,237 @@
+/*
+ * Copyright (C) 2021 Gunar Schorcht
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Tests and benchmark of the link layer address filter
+ *
+ * The tests compare the filter in whitelist mode with a reference list while
+ * addresses of different length are added and removed. The benchmark
+ * measures the frames per second that are checked with 8, 128 and 1024
+ * entries in the list, half of the frames are from listed addresses.
+ *
+ * @author      Gunar Schorcht <gunar@schorcht.net>
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "fmt.h"
+#include "net/l2filter.h"
+#include "timex.h"
+#include "ztimer.h"
+
+#include "test_utils/expect.h"
+
+#define BENCH_FRAMES        (200000UL)
+#define CHURN_ADDRS         (3 * CONFIG_L2FILTER_LISTSIZE / 2)
+
+static l2filter_list_t _list;
+static bool _listed[CHURN_ADDRS];
+static uint32_t _rand_state;
+
+static uint32_t _rand(void)
+{
+    /* xorshift32 */
+    _rand_state ^= _rand_state << 13;
+    _rand_state ^= _rand_state >> 17;
+    _rand_state ^= _rand_state << 5;
+    return _rand_state;
+}
+
+/* long addresses that differ only in the last bytes, every fourth address
+ * is a short address */
+static size_t _addr(uint32_t node, uint8_t *addr)
+{
+    static const uint8_t prefix[] = { 0x02, 0x00, 0x4b, 0x12 };
+
+    if ((node % 4) == 3) {
+        addr[0] = node >> 8;
+        addr[1] = node;
+        return 2;
+    }
+    memcpy(addr, prefix, sizeof(prefix));
+    addr[4] = node >> 24;
+    addr[5] = node >> 16;
+    addr[6] = node >> 8;
+    addr[7] = node;
+    return 8;
+}
+
+static bool _pass(uint32_t node)
+{
+    uint8_t addr[CONFIG_L2FILTER_ADDR_MAXLEN];
+    size_t len = _addr(node, addr);
+
+    return l2filter_pass(&_list, addr, len);
+}
+
+static int _add(uint32_t node)
+{
+    uint8_t addr[CONFIG_L2FILTER_ADDR_MAXLEN];
+    size_t len = _addr(node, addr);
+
+    return l2filter_add(&_list, addr, len);
+}
+
+static int _rm(uint32_t node)
+{
+    uint8_t addr[CONFIG_L2FILTER_ADDR_MAXLEN];
+    size_t len = _addr(node, addr);
+
+    return l2filter_rm(&_list, addr, len);
+}
+
+static void test_add_rm(void)
+{
+    uint8_t addr[CONFIG_L2FILTER_ADDR_MAXLEN];
+
+    /* a list initialized with zeros is empty */
+    expect(!_pass(1));
+    expect(_add(1) == 0);
+    expect(_pass(1) && !_pass(3));
+
+    l2filter_init(&_list);
+    expect(!_pass(1));
+    expect(_rm(1) == -ENOENT);
+
+    /* an address of length 0 would be an empty entry */
+    expect(l2filter_add(&_list, addr, 0) == -EINVAL);
+    expect(!_pass(1));
+
+    expect(_add(5) == 0);
+    expect(_add(3) == 0);
+    expect(_add(1) == 0);
+    expect(_pass(1) && _pass(3) && _pass(5));
+    expect(!_pass(2) && !_pass(7));
+
+    /* the same bytes with another length are another address */
+    _addr(1, addr);
+    expect(!l2filter_pass(&_list, addr, 4));
+
+    /* an address added twice is listed until it is removed twice */
+    expect(_add(3) == 0);
+    expect(_rm(3) == 0);
+    expect(_pass(3));
+    expect(_rm(3) == 0);
+    expect(!_pass(3));
+    expect(_rm(3) == -ENOENT);
+    expect(_pass(1) && _pass(5));
+
+    puts("add/rm: OK");
+}
+
+static void test_full(void)
+{
+    l2filter_init(&_list);
+
+    for (uint32_t i = 0; i < CONFIG_L2FILTER_LISTSIZE; i++) {
+        expect(_add(CONFIG_L2FILTER_LISTSIZE - i) == 0);
+    }
+    expect(_add(0) == -ENOMEM);
+    expect(!_pass(0));
+    expect(_rm(CONFIG_L2FILTER_LISTSIZE) == 0);
+    expect(_add(0) == 0);
+    expect(_pass(0) && _pass(1) && !_pass(CONFIG_L2FILTER_LISTSIZE));
+
+    puts("full: OK");
+}
+
+static void test_churn(void)
+{
+    unsigned numof = 0;
+
+    l2filter_init(&_list);
+    memset(_listed, 0, sizeof(_listed));
+    _rand_state = 0x20210804;
+
+    for (unsigned i = 0; i < 4 * CHURN_ADDRS; i++) {
+        uint32_t node = _rand() % CHURN_ADDRS;
+
+        if (_listed[node]) {
+            expect(_rm(node) == 0);
+            _listed[node] = false;
+            numof--;
+        }
+        else if (numof < CONFIG_L2FILTER_LISTSIZE) {
+            expect(_add(node) == 0);
+            _listed[node] = true;
+            numof++;
+        }
+
+        if ((i % 64) == 0) {
+            for (uint32_t j = 0; j < CHURN_ADDRS; j++) {
+                expect(_pass(j) == _listed[j]);
+            }
+        }
+    }
+
+    /* sorted, with the empty entries at the end */
+    for (unsigned i = 1; i < CONFIG_L2FILTER_LISTSIZE; i++) {
+        const l2filter_t *a = &_list.entries[i - 1];
+        const l2filter_t *b = &_list.entries[i];
+        if (b->addr_len == 0) {
+            continue;
+        }
+        expect(a->addr_len != 0);
+        expect((a->addr_len < b->addr_len) ||
+               ((a->addr_len == b->addr_len) &&
+                (memcmp(a->addr, b->addr, a->addr_len) < 0)));
+    }
+
+    puts("churn: OK");
+}
+
+static void bench(unsigned entries)
+{
+    static uint8_t addrs[64][CONFIG_L2FILTER_ADDR_MAXLEN];
+    static size_t lens[64];
+    unsigned passed = 0;
+
+    l2filter_init(&_list);
+    _rand_state = 0x20210805;
+
+    for (uint32_t i = 0; i < entries; i++) {
+        expect(_add(2 * i) == 0);
+    }
+    /* half of the addresses are listed */
+    for (unsigned i = 0; i < 64; i++) {
+        lens[i] = _addr(2 * (_rand() % entries) + (i % 2), addrs[i]);
+    }
+
+    uint32_t start = ztimer_now(ZTIMER_USEC);
+    for (unsigned long i = 0; i < BENCH_FRAMES; i++) {
+        passed += l2filter_pass(&_list, addrs[i % 64], lens[i % 64]);
+    }
+    uint32_t usec = ztimer_now(ZTIMER_USEC) - start;
+
+    expect(passed == BENCH_FRAMES / 2);
+
+    print_u32_dec(entries);
+    print_str(" entries: ");
+    print_u64_dec((uint64_t)BENCH_FRAMES * US_PER_SEC / (usec ? usec : 1));
+    print_str(" frames/s\n");
+}
+
+int main(void)
+{
+    test_add_rm();
+    test_full();
+    test_churn();
+
+    bench(8);
+    bench(128);
+    bench(1024);
+
+    puts("SUCCESS");
+    return 0;
+}
@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2021 Gunar Schorcht
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test of the software interrupt masking of native
+ *
+ * Timer interrupts that occur while interrupts are disabled have to be
+ * deferred and have to be handled as soon as interrupts are enabled again.
+ *
+ * @author      Gunar Schorcht <gunar@schorcht.net>
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "irq.h"
+#include "xtimer.h"
+
+#include "test_utils/expect.h"
+
+#define TIMEOUT_US      (1000U)
+#define WAIT_US         (10 * TIMEOUT_US)
+#define TIMERS_NUMOF    (3U)
+
+static volatile unsigned _fired;
+
+static void _cb(void *arg)
+{
+    (void)arg;
+    expect(irq_is_in());
+    _fired++;
+}
+
+static void _busy_wait(uint32_t us)
+{
+    uint32_t start = xtimer_now_usec();
+
+    while (xtimer_now_usec() - start < us) {}
+}
+
+static void test_defer(void)
+{
+    xtimer_t timer = { .callback = _cb };
+
+    _fired = 0;
+    unsigned state = irq_disable();
+    xtimer_set(&timer, TIMEOUT_US);
+    _busy_wait(WAIT_US);
+    /* the interrupt is deferred ... */
+    expect(_fired == 0);
+    irq_restore(state);
+    /* ... and handled when interrupts are enabled again */
+    expect(_fired == 1);
+
+    puts("defer: OK");
+}
+
+static void test_nested(void)
+{
+    xtimer_t timer = { .callback = _cb };
+
+    _fired = 0;
+    unsigned outer = irq_disable();
+    xtimer_set(&timer, TIMEOUT_US);
+    unsigned inner = irq_disable();
+    _busy_wait(WAIT_US);
+    /* restoring the disabled state does not dispatch the interrupt */
+    irq_restore(inner);
+    expect(_fired == 0);
+    irq_restore(outer);
+    expect(_fired == 1);
+
+    puts("nested: OK");
+}
+
+static void test_multiple(void)
+{
+    xtimer_t timers[TIMERS_NUMOF];
+
+    _fired = 0;
+    for (unsigned i = 0; i < TIMERS_NUMOF; i++) {
+        timers[i].callback = _cb;
+        unsigned state = irq_disable();
+        xtimer_set(&timers[i], TIMEOUT_US);
+        /* every timer expires while interrupts are disabled */
+        _busy_wait(WAIT_US);
+        expect(_fired == i);
+        irq_restore(state);
+        expect(_fired == i + 1);
+    }
+
+    puts("multiple: OK");
+}
+
+int main(void)
+{
+    test_defer();
+    test_nested();
+    test_multiple();
+
+    puts("SUCCESS");
+    return 0;
+}
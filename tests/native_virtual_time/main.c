@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2021 Gunar Schorcht
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test of the virtual time of native
+ *
+ * The test checks that reading the time does not advance it, that timers
+ * expire exactly at their deadline in the order of their deadlines, and
+ * that the time of a long sleep is skipped. The test runner times out if
+ * the sleep takes real time.
+ *
+ * @author      Gunar Schorcht <gunar@schorcht.net>
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+
+#include "irq.h"
+#include "kernel_defines.h"
+#include "xtimer.h"
+
+#include "test_utils/expect.h"
+
+#define LONG_SLEEP_S    (3600U)
+
+/* the timers are set in this order */
+static const uint32_t _offsets[] = { 5000, 1000, 3000, 2000, 4000 };
+
+static xtimer_t _timers[ARRAY_SIZE(_offsets)];
+static uint32_t _start;
+static uint32_t _expired[ARRAY_SIZE(_offsets)];
+static volatile unsigned _expired_numof;
+
+static void _cb(void *arg)
+{
+    (void)arg;
+    _expired[_expired_numof++] = xtimer_now_usec() - _start;
+}
+
+static void test_read(void)
+{
+    unsigned state = irq_disable();
+    uint32_t now = xtimer_now_usec();
+
+    for (unsigned i = 0; i < 1000; i++) {
+        expect(xtimer_now_usec() == now);
+    }
+    irq_restore(state);
+
+    puts("read: OK");
+}
+
+static void test_order(void)
+{
+    _expired_numof = 0;
+    _start = xtimer_now_usec();
+    for (unsigned i = 0; i < ARRAY_SIZE(_offsets); i++) {
+        _timers[i].callback = _cb;
+        xtimer_set(&_timers[i], _offsets[i]);
+    }
+
+    xtimer_usleep(10000);
+    expect(_expired_numof == ARRAY_SIZE(_offsets));
+    for (unsigned i = 0; i < ARRAY_SIZE(_offsets); i++) {
+        printf("timer %u expired at %" PRIu32 " us\n", i, _expired[i]);
+        /* expiry in the order of the deadlines, exactly at the deadline */
+        expect(_expired[i] == (i + 1) * 1000);
+    }
+
+    puts("order: OK");
+}
+
+static void test_skip(void)
+{
+    uint64_t start = xtimer_now_usec64();
+
+    xtimer_sleep(LONG_SLEEP_S);
+    uint64_t slept = xtimer_now_usec64() - start;
+    expect(slept >= LONG_SLEEP_S * US_PER_SEC);
+    expect(slept < LONG_SLEEP_S * US_PER_SEC + US_PER_MS);
+
+    puts("skip: OK");
+}
+
+int main(void)
+{
+    test_read();
+    test_order();
+    test_skip();
+
+    puts("SUCCESS");
+    return 0;
+}
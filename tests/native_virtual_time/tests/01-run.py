@@ -0,0 +1,24 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2021 Gunar Schorcht
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    child.expect_exact("read: OK")
+    for i in range(5):
+        child.expect_exact("timer {} expired at {} us".format(i, (i + 1) * 1000))
+    child.expect_exact("order: OK")
+    # one hour of virtual time has to pass within the timeout of the runner
+    child.expect_exact("skip: OK")
+    child.expect_exact("SUCCESS")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc, timeout=10))
@@ -0,0 +1,317 @@
+/*
+ * Copyright (C) 2021 Gunar Schorcht
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test of the burst mode of the IEEE 802.15.4 SubMAC netdev
+ *
+ * 6LoWPAN fragments are sent through the netdev of a mock radio. The test
+ * checks that the fragments of a datagram are sent as a burst, i.e. that the
+ * frame pending bit is set for all fragments but the last one, and that
+ * other frames are sent as single frames.
+ *
+ * @author      Gunar Schorcht <gunar@schorcht.net>
+ * @}
+ */
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "byteorder.h"
+#include "kernel_defines.h"
+#include "net/ieee802154.h"
+#include "net/netdev/ieee802154_submac.h"
+#include "net/sixlowpan.h"
+
+#include "test_utils/expect.h"
+
+#define DATAGRAM_SIZE       (288U)
+#define FRAG_PAYLOAD        (96U)   /**< datagram bytes per fragment */
+#define FRAGS               (DATAGRAM_SIZE / FRAG_PAYLOAD)
+#define MHR_LEN             (21U)   /**< long addresses, PAN ID compressed */
+
+static netdev_ieee802154_submac_t _netdev;
+static ieee802154_dev_t _dev;
+
+static uint8_t _mhr[MHR_LEN];
+static uint8_t _payload[sizeof(sixlowpan_frag_n_t) + FRAG_PAYLOAD];
+static iolist_t _iol_payload = { .iol_base = _payload };
+static iolist_t _iol = { .iol_next = &_iol_payload, .iol_base = _mhr,
+                         .iol_len = sizeof(_mhr) };
+
+/* state of the mock radio */
+static uint8_t _fcf;
+static bool _tx_requested;
+
+/* events of the netdev */
+static bool _isr_pending;
+static bool _tx_complete;
+
+static int _write(ieee802154_dev_t *dev, const iolist_t *psdu)
+{
+    (void)dev;
+    _fcf = ((uint8_t *)psdu->iol_base)[0];
+    return 0;
+}
+
+static int _request_transmit(ieee802154_dev_t *dev)
+{
+    (void)dev;
+    _tx_requested = true;
+    return 0;
+}
+
+static int _confirm_transmit(ieee802154_dev_t *dev, ieee802154_tx_info_t *info)
+{
+    (void)dev;
+    info->status = TX_STATUS_SUCCESS;
+    info->retrans = -1;
+    return 0;
+}
+
+static int _len(ieee802154_dev_t *dev)
+{
+    (void)dev;
+    return 0;
+}
+
+static int _read(ieee802154_dev_t *dev, void *buf, size_t size,
+                 ieee802154_rx_info_t *info)
+{
+    (void)dev;
+    (void)buf;
+    (void)size;
+    (void)info;
+    return -ENOBUFS;
+}
+
+static int _ok(ieee802154_dev_t *dev)
+{
+    (void)dev;
+    return 0;
+}
+
+static int _set_trx_state(ieee802154_dev_t *dev, ieee802154_trx_state_t state)
+{
+    (void)dev;
+    (void)state;
+    return 0;
+}
+
+static int _set_cca_threshold(ieee802154_dev_t *dev, int8_t threshold)
+{
+    (void)dev;
+    (void)threshold;
+    return 0;
+}
+
+static int _config_phy(ieee802154_dev_t *dev, const ieee802154_phy_conf_t *conf)
+{
+    (void)dev;
+    (void)conf;
+    return 0;
+}
+
+static int _set_hw_addr_filter(ieee802154_dev_t *dev,
+                               const network_uint16_t *short_addr,
+                               const eui64_t *ext_addr, const uint16_t *pan_id)
+{
+    (void)dev;
+    (void)short_addr;
+    (void)ext_addr;
+    (void)pan_id;
+    return 0;
+}
+
+static int _set_rx_mode(ieee802154_dev_t *dev, ieee802154_rx_mode_t mode)
+{
+    (void)dev;
+    (void)mode;
+    return 0;
+}
+
+static const ieee802154_radio_ops_t _ops = {
+    .caps = IEEE802154_CAP_24_GHZ | IEEE802154_CAP_IRQ_TX_DONE |
+            IEEE802154_CAP_PHY_OQPSK,
+    .write = _write,
+    .request_transmit = _request_transmit,
+    .confirm_transmit = _confirm_transmit,
+    .len = _len,
+    .read = _read,
+    .off = _ok,
+    .request_on = _ok,
+    .confirm_on = _ok,
+    .request_set_trx_state = _set_trx_state,
+    .confirm_set_trx_state = _ok,
+    .set_cca_threshold = _set_cca_threshold,
+    .config_phy = _config_phy,
+    .set_hw_addr_filter = _set_hw_addr_filter,
+    .set_rx_mode = _set_rx_mode,
+};
+
+static void _event_cb(netdev_t *netdev, netdev_event_t event)
+{
+    (void)netdev;
+    if (event == NETDEV_EVENT_ISR) {
+        _isr_pending = true;
+    }
+    else if (event == NETDEV_EVENT_TX_COMPLETE) {
+        _tx_complete = true;
+    }
+}
+
+/* sends the frame through the netdev and completes the transmission */
+static void _send(void)
+{
+    netdev_t *netdev = (netdev_t *)&_netdev;
+
+    _tx_complete = false;
+    expect(netdev->driver->send(netdev, &_iol) == 0);
+    expect(_tx_requested);
+    _tx_requested = false;
+
+    _dev.cb(&_dev, IEEE802154_RADIO_CONFIRM_TX_DONE);
+    expect(_isr_pending);
+    _isr_pending = false;
+    netdev->driver->isr(netdev);
+    expect(_tx_complete);
+}
+
+/* prepares the fragment starting at offset of the datagram */
+static void _frag(uint16_t tag, unsigned offset)
+{
+    sixlowpan_frag_n_t *hdr = (sixlowpan_frag_n_t *)_payload;
+
+    hdr->disp_size = byteorder_htons(DATAGRAM_SIZE);
+    hdr->tag = byteorder_htons(tag);
+    if (offset == 0) {
+        hdr->disp_size.u8[0] |= SIXLOWPAN_FRAG_1_DISP;
+        _iol_payload.iol_len = sizeof(sixlowpan_frag_t) + FRAG_PAYLOAD;
+    }
+    else {
+        hdr->disp_size.u8[0] |= SIXLOWPAN_FRAG_N_DISP;
+        hdr->offset = offset / 8;
+        _iol_payload.iol_len = sizeof(sixlowpan_frag_n_t) + FRAG_PAYLOAD;
+    }
+}
+
+static bool _frame_pending(void)
+{
+    return _fcf & IEEE802154_FCF_FRAME_PEND;
+}
+
+static void test_fragments(void)
+{
+    const ieee802154_submac_burst_stats_t *stats =
+        ieee802154_get_burst_stats(&_netdev.submac);
+
+    for (unsigned offset = 0; offset < DATAGRAM_SIZE; offset += FRAG_PAYLOAD) {
+        _frag(1, offset);
+        _send();
+        expect(_frame_pending() == (offset + FRAG_PAYLOAD < DATAGRAM_SIZE));
+    }
+    expect(stats->bursts == 1);
+    expect(stats->frames == FRAGS);
+
+    puts("fragments: OK");
+}
+
+static void test_split_header(void)
+{
+    const ieee802154_submac_burst_stats_t *stats =
+        ieee802154_get_burst_stats(&_netdev.submac);
+    /* the header of the subsequent fragments is split across two entries */
+    iolist_t iol_payload = { .iol_base = &_payload[2] };
+
+    _iol_payload.iol_next = &iol_payload;
+    for (unsigned offset = 0; offset < DATAGRAM_SIZE; offset += FRAG_PAYLOAD) {
+        _frag(2, offset);
+        iol_payload.iol_len = _iol_payload.iol_len - 2;
+        _iol_payload.iol_len = 2;
+        _send();
+        expect(_frame_pending() == (offset + FRAG_PAYLOAD < DATAGRAM_SIZE));
+    }
+    _iol_payload.iol_next = NULL;
+    expect(stats->bursts == 2);
+    expect(stats->frames == 2 * FRAGS);
+
+    puts("split header: OK");
+}
+
+static void test_new_datagram(void)
+{
+    const ieee802154_submac_burst_stats_t *stats =
+        ieee802154_get_burst_stats(&_netdev.submac);
+
+    /* the last fragment of the datagram is never sent */
+    _frag(3, 0);
+    _send();
+    _frag(3, FRAG_PAYLOAD);
+    _send();
+    expect(stats->bursts == 3);
+    expect(stats->fast == 2 * (FRAGS - 1) + 1);
+
+    /* the first fragment of the next datagram starts a new burst */
+    for (unsigned offset = 0; offset < DATAGRAM_SIZE; offset += FRAG_PAYLOAD) {
+        _frag(4, offset);
+        _send();
+    }
+    expect(stats->bursts == 4);
+    expect(stats->fast == 3 * (FRAGS - 1) + 1);
+
+    puts("new datagram: OK");
+}
+
+static void test_no_fragment(void)
+{
+    const ieee802154_submac_burst_stats_t *stats =
+        ieee802154_get_burst_stats(&_netdev.submac);
+
+    /* an IPHC header is not sent as part of a burst */
+    _payload[0] = SIXLOWPAN_IPHC1_DISP;
+    _iol_payload.iol_len = FRAG_PAYLOAD;
+    _send();
+    expect(!_frame_pending());
+
+    /* neither is a fragment of a frame with enabled security */
+    _frag(5, 0);
+    _mhr[0] |= IEEE802154_FCF_SECURITY_EN;
+    _send();
+    _mhr[0] &= ~IEEE802154_FCF_SECURITY_EN;
+    expect(!_frame_pending());
+
+    expect(stats->frames == 4 * FRAGS - 1);
+
+    puts("no fragment: OK");
+}
+
+int main(void)
+{
+    netdev_t *netdev = (netdev_t *)&_netdev;
+
+    /* data frame, PAN ID compression, long addresses */
+    _mhr[0] = IEEE802154_FCF_TYPE_DATA | IEEE802154_FCF_PAN_COMP;
+    _mhr[1] = IEEE802154_FCF_DST_ADDR_LONG | IEEE802154_FCF_SRC_ADDR_LONG;
+
+    _dev.driver = &_ops;
+    expect(netdev_ieee802154_submac_init(&_netdev, &_dev) == 0);
+    netdev->event_callback = _event_cb;
+    expect(netdev->driver->init(netdev) == 0);
+
+    test_fragments();
+    test_split_header();
+    test_new_datagram();
+    test_no_fragment();
+
+    puts("SUCCESS");
+    return 0;
+}
@@ -0,0 +1,237 @@
+/*
+ * Copyright (C) 2021 Gunar Schorcht
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Tests and benchmark of the neighbor statistics table
+ *
+ * The tests check the L2 address index, the eviction of the least recently
+ * updated entry that is not fresh and the snapshot of the table. The
+ * benchmark measures the time per frame, i.e. for recording and updating a
+ * transmission and for updating a reception, with 16, 64 and 256 active
+ * neighbors.
+ *
+ * @author      Gunar Schorcht <gunar@schorcht.net>
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "fmt.h"
+#include "net/netif.h"
+#include "net/netstats/neighbor.h"
+#include "xtimer.h"
+
+#include "test_utils/expect.h"
+
+#define BENCH_FRAMES        (100000UL)
+#define L2ADDR_LEN          (8U)
+
+static netif_t _netif;
+static netstats_nb_t _snapshot[NETSTATS_NB_SIZE];
+static uint32_t _rand_state;
+
+static uint32_t _rand(void)
+{
+    /* xorshift32 */
+    _rand_state ^= _rand_state << 13;
+    _rand_state ^= _rand_state >> 17;
+    _rand_state ^= _rand_state << 5;
+    return _rand_state;
+}
+
+/* EUI-64 like addresses that differ only in the last bytes */
+static const uint8_t *_l2addr(uint32_t node)
+{
+    static uint8_t addr[L2ADDR_LEN] = { 0x02, 0x00, 0x4b, 0x12 };
+
+    addr[4] = node >> 24;
+    addr[5] = node >> 16;
+    addr[6] = node >> 8;
+    addr[7] = node;
+    return addr;
+}
+
+static netstats_nb_t *_rx(uint32_t node, unsigned times)
+{
+    netstats_nb_t *stats = NULL;
+
+    while (times--) {
+        stats = netstats_nb_update_rx(&_netif, _l2addr(node), L2ADDR_LEN, 50, 200);
+    }
+    return stats;
+}
+
+static bool _known(uint32_t node)
+{
+    netstats_nb_t stats;
+
+    return netstats_nb_get(&_netif, _l2addr(node), L2ADDR_LEN, &stats);
+}
+
+static void test_lookup(void)
+{
+    netstats_nb_t stats;
+
+    netstats_nb_init(&_netif);
+    expect(!_known(1));
+
+    for (uint32_t i = 0; i < NETSTATS_NB_SIZE; i++) {
+        expect(_rx(i, 1) != NULL);
+    }
+    for (uint32_t i = 0; i < NETSTATS_NB_SIZE; i++) {
+        expect(netstats_nb_get(&_netif, _l2addr(i), L2ADDR_LEN, &stats));
+        expect(memcmp(stats.l2_addr, _l2addr(i), L2ADDR_LEN) == 0);
+        expect(stats.rx_count == 1);
+    }
+    /* the same bytes with another length are another neighbor */
+    expect(!netstats_nb_get(&_netif, _l2addr(1), L2ADDR_LEN - 2, &stats));
+
+    /* TX is counted for the recorded neighbor */
+    netstats_nb_record(&_netif, _l2addr(7), L2ADDR_LEN);
+    netstats_nb_t *entry = netstats_nb_update_tx(&_netif, NETSTATS_NB_SUCCESS, 3);
+    expect(entry && (memcmp(entry->l2_addr, _l2addr(7), L2ADDR_LEN) == 0));
+    expect((entry->tx_count == 1) && (entry->tx_fail == 0));
+    expect(entry->etx > NETSTATS_NB_ETX_INIT * NETSTATS_NB_ETX_DIVISOR);
+
+    /* multicast is not recorded */
+    netstats_nb_record(&_netif, NULL, 0);
+    expect(netstats_nb_update_tx(&_netif, NETSTATS_NB_SUCCESS, 1) == NULL);
+
+    puts("lookup: OK");
+}
+
+static void test_eviction(void)
+{
+    netstats_nb_init(&_netif);
+
+    /* none of the entries is fresh, the least recently updated is replaced */
+    for (uint32_t i = 0; i < NETSTATS_NB_SIZE; i++) {
+        _rx(i, 1);
+    }
+    _rx(0, 1);
+    expect(_rx(NETSTATS_NB_SIZE, 1) != NULL);
+    expect(_known(0) && !_known(1) && _known(2));
+    expect(_rx(NETSTATS_NB_SIZE + 1, 1) != NULL);
+    expect(!_known(2) && _known(3));
+
+    /* fresh entries are kept, even if they are older */
+    netstats_nb_init(&_netif);
+    for (uint32_t i = 0; i < NETSTATS_NB_SIZE; i++) {
+        _rx(i, (i == NETSTATS_NB_SIZE / 2) ? 1 : NETSTATS_NB_FRESHNESS_TARGET);
+    }
+    expect(_rx(NETSTATS_NB_SIZE, 1) != NULL);
+    expect(_known(0) && !_known(NETSTATS_NB_SIZE / 2));
+
+    /* no entry is replaced if all are fresh */
+    _rx(NETSTATS_NB_SIZE, NETSTATS_NB_FRESHNESS_TARGET);
+    expect(_rx(NETSTATS_NB_SIZE + 1, 1) == NULL);
+    expect(!_known(NETSTATS_NB_SIZE + 1));
+
+    puts("eviction: OK");
+}
+
+static void test_churn(void)
+{
+    netstats_nb_init(&_netif);
+    _rand_state = 0x20210802;
+
+    /* the index must stay consistent while entries are replaced */
+    for (unsigned i = 0; i < 20 * NETSTATS_NB_SIZE; i++) {
+        uint32_t node = _rand() % (3 * NETSTATS_NB_SIZE);
+        netstats_nb_t *stats = _rx(node, 1);
+        expect(stats && (memcmp(stats->l2_addr, _l2addr(node), L2ADDR_LEN) == 0));
+        expect(_known(node));
+    }
+
+    unsigned numof = netstats_nb_snapshot(&_netif, _snapshot, NETSTATS_NB_SIZE);
+    expect(numof == NETSTATS_NB_SIZE);
+    for (unsigned i = 0; i < numof; i++) {
+        netstats_nb_t stats;
+        expect(netstats_nb_get(&_netif, _snapshot[i].l2_addr,
+                               _snapshot[i].l2_addr_len, &stats));
+        for (unsigned j = 0; j < i; j++) {
+            expect(memcmp(_snapshot[i].l2_addr, _snapshot[j].l2_addr,
+                          L2ADDR_LEN) != 0);
+        }
+    }
+
+    puts("churn: OK");
+}
+
+static void test_snapshot(void)
+{
+    netstats_nb_init(&_netif);
+    expect(netstats_nb_snapshot(&_netif, _snapshot, NETSTATS_NB_SIZE) == 0);
+
+    for (uint32_t i = 0; i < 4; i++) {
+        _rx(i, i + 1);
+    }
+    _rx(1, 1);
+
+    /* most recently updated first */
+    expect(netstats_nb_snapshot(&_netif, _snapshot, NETSTATS_NB_SIZE) == 4);
+    expect(memcmp(_snapshot[0].l2_addr, _l2addr(1), L2ADDR_LEN) == 0);
+    expect(_snapshot[0].rx_count == 3);
+    expect(memcmp(_snapshot[1].l2_addr, _l2addr(3), L2ADDR_LEN) == 0);
+    expect(memcmp(_snapshot[3].l2_addr, _l2addr(0), L2ADDR_LEN) == 0);
+
+    /* the copies are not changed by later updates */
+    _rx(3, 1);
+    expect(_snapshot[1].rx_count == 4);
+
+    expect(netstats_nb_snapshot(&_netif, _snapshot, 2) == 2);
+    expect(memcmp(_snapshot[0].l2_addr, _l2addr(3), L2ADDR_LEN) == 0);
+
+    puts("snapshot: OK");
+}
+
+static void bench(unsigned neighbors)
+{
+    netstats_nb_init(&_netif);
+    _rand_state = 0x20210803;
+
+    for (uint32_t i = 0; i < neighbors; i++) {
+        _rx(i, NETSTATS_NB_FRESHNESS_TARGET);
+    }
+
+    uint32_t start = xtimer_now_usec();
+    for (unsigned long i = 0; i < BENCH_FRAMES; i++) {
+        const uint8_t *addr = _l2addr(_rand() % neighbors);
+
+        netstats_nb_record(&_netif, addr, L2ADDR_LEN);
+        netstats_nb_update_tx(&_netif, NETSTATS_NB_SUCCESS, 1);
+        netstats_nb_update_rx(&_netif, _l2addr(_rand() % neighbors),
+                              L2ADDR_LEN, 50, 200);
+    }
+    uint32_t ns = (uint64_t)(xtimer_now_usec() - start) * 1000 / BENCH_FRAMES;
+
+    print_u32_dec(neighbors);
+    print_str(" neighbors: ");
+    print_u32_dec(ns);
+    print_str(" ns per frame\n");
+}
+
+int main(void)
+{
+    test_lookup();
+    test_eviction();
+    test_churn();
+    test_snapshot();
+
+    bench(16);
+    bench(64);
+    bench(256);
+
+    puts("SUCCESS");
+    return 0;
+}
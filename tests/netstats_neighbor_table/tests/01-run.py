@@ -0,0 +1,22 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2021 Gunar Schorcht
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    for test in ("lookup", "eviction", "churn", "snapshot"):
+        child.expect_exact("{}: OK".format(test))
+    for neighbors in (16, 64, 256):
+        child.expect(r"{} neighbors: \d+ ns per frame".format(neighbors))
+    child.expect_exact("SUCCESS")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc, timeout=60))
@@ -0,0 +1,194 @@
+/*
+ * Copyright (C) 2021 Gunar Schorcht
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Tests for poll() and select() on UDP sockets
+ *
+ * The sockets talk to each other over the IPv6 loopback address, so no
+ * network interface is needed.
+ *
+ * @author      Gunar Schorcht <gunar@schorcht.net>
+ * @}
+ */
+
+#include <limits.h>
+#include <poll.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "thread.h"
+#include "xtimer.h"
+
+#include "test_utils/expect.h"
+
+#define TEST_PORT           (4242U)
+#define TEST_SOCKETS        (3U)
+#define TEST_DELAY_US       (10U * US_PER_MS)
+
+static int _sender;
+static int _receivers[TEST_SOCKETS];
+static char _stack[THREAD_STACKSIZE_DEFAULT];
+
+static void _send(unsigned idx)
+{
+    struct sockaddr_in6 dst = {
+        .sin6_family = AF_INET6,
+        .sin6_port = htons(TEST_PORT + idx),
+        .sin6_addr = IN6ADDR_LOOPBACK_INIT,
+    };
+    uint8_t byte = idx;
+
+    expect(sendto(_sender, &byte, sizeof(byte), 0, (struct sockaddr *)&dst,
+                  sizeof(dst)) == sizeof(byte));
+}
+
+static void _recv(unsigned idx)
+{
+    uint8_t byte;
+
+    expect(recv(_receivers[idx], &byte, sizeof(byte), 0) == sizeof(byte));
+    expect(byte == idx);
+}
+
+static void *_delayed_send(void *arg)
+{
+    xtimer_usleep(TEST_DELAY_US);
+    _send((uintptr_t)arg);
+    return NULL;
+}
+
+static void _send_later(unsigned idx)
+{
+    thread_create(_stack, sizeof(_stack), THREAD_PRIORITY_MAIN - 1,
+                  THREAD_CREATE_STACKTEST, _delayed_send, (void *)(uintptr_t)idx,
+                  "sender");
+}
+
+static void _setup(void)
+{
+    _sender = socket(AF_INET6, SOCK_DGRAM, IPPROTO_UDP);
+    expect(_sender >= 0);
+    for (unsigned i = 0; i < TEST_SOCKETS; i++) {
+        struct sockaddr_in6 local = {
+            .sin6_family = AF_INET6,
+            .sin6_port = htons(TEST_PORT + i),
+            .sin6_addr = IN6ADDR_ANY_INIT,
+        };
+
+        _receivers[i] = socket(AF_INET6, SOCK_DGRAM, IPPROTO_UDP);
+        expect(_receivers[i] >= 0);
+        expect(bind(_receivers[i], (struct sockaddr *)&local,
+                    sizeof(local)) == 0);
+    }
+}
+
+static void test_pollout(void)
+{
+    struct pollfd fds = { .fd = _sender, .events = POLLIN | POLLOUT };
+
+    /* sending a datagram never blocks */
+    expect(poll(&fds, 1, -1) == 1);
+    expect(fds.revents == POLLOUT);
+    puts("pollout: OK");
+}
+
+static void test_poll_timeout(void)
+{
+    struct pollfd fds = { .fd = _receivers[0], .events = POLLIN };
+    uint32_t start = xtimer_now_usec();
+
+    expect(poll(&fds, 1, 10) == 0);
+    expect(fds.revents == 0);
+    expect((xtimer_now_usec() - start) >= (10U * US_PER_MS));
+    puts("poll timeout: OK");
+}
+
+static void test_pollin(void)
+{
+    struct pollfd fds = { .fd = _receivers[0], .events = POLLIN };
+
+    _send(0);
+    expect(poll(&fds, 1, 100) == 1);
+    expect(fds.revents == POLLIN);
+    _recv(0);
+    expect(poll(&fds, 1, 0) == 0);
+    puts("pollin: OK");
+}
+
+static void test_poll_ready_list(void)
+{
+    struct pollfd fds[TEST_SOCKETS + 1];
+
+    for (unsigned i = 0; i < TEST_SOCKETS; i++) {
+        fds[i].fd = _receivers[i];
+        fds[i].events = POLLIN;
+    }
+    fds[TEST_SOCKETS].fd = -1;
+    /* wakes up only for the datagram, although the timeout does not fit
+     * into a single xtimer period */
+    _send_later(1);
+    expect(poll(fds, TEST_SOCKETS + 1, INT_MAX) == 1);
+    expect((fds[0].revents == 0) && (fds[1].revents == POLLIN) &&
+           (fds[2].revents == 0) && (fds[3].revents == 0));
+    _recv(1);
+    puts("poll ready list: OK");
+}
+
+static void test_select_ready_list(void)
+{
+    fd_set readfds;
+    int nfds = 0;
+
+    FD_ZERO(&readfds);
+    for (unsigned i = 0; i < TEST_SOCKETS; i++) {
+        FD_SET(_receivers[i], &readfds);
+        if (_receivers[i] >= nfds) {
+            nfds = _receivers[i] + 1;
+        }
+    }
+    _send_later(2);
+    expect(select(nfds, &readfds, NULL, NULL, NULL) == 1);
+    expect(!FD_ISSET(_receivers[0], &readfds) &&
+           !FD_ISSET(_receivers[1], &readfds) &&
+           FD_ISSET(_receivers[2], &readfds));
+    _recv(2);
+
+    /* the sender is reported writable right away */
+    fd_set writefds;
+    struct timeval timeout = { .tv_sec = 0, .tv_usec = 0 };
+
+    FD_ZERO(&writefds);
+    FD_SET(_sender, &writefds);
+    expect(select(_sender + 1, NULL, &writefds, NULL, &timeout) == 1);
+    expect(FD_ISSET(_sender, &writefds));
+    puts("select ready list: OK");
+}
+
+int main(void)
+{
+    _setup();
+
+    test_pollout();
+    test_poll_timeout();
+    test_pollin();
+    test_poll_ready_list();
+    test_select_ready_list();
+
+    puts("SUCCESS");
+    return 0;
+}
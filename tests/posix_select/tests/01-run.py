@@ -0,0 +1,23 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2021 Gunar Schorcht
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    child.expect_exact("pollout: OK")
+    child.expect_exact("poll timeout: OK")
+    child.expect_exact("pollin: OK")
+    child.expect_exact("poll ready list: OK")
+    child.expect_exact("select ready list: OK")
+    child.expect_exact("SUCCESS")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
@@ -0,0 +1,162 @@
+/*
+ * Copyright (C) 2021 Gunar Schorcht
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Tests for sendmsg() and recvmsg() on UDP sockets
+ *
+ * The sockets talk to each other over the IPv6 loopback address, so no
+ * network interface is needed.
+ *
+ * @author      Gunar Schorcht <gunar@schorcht.net>
+ * @}
+ */
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+#include "test_utils/expect.h"
+
+#define TEST_PORT           (4242U)
+#define TEST_SENDER_PORT    (4243U)
+#define TEST_LEN            (300U)
+
+static int _sender;
+static int _receiver;
+static uint8_t _tx_buf[SOCKET_SENDMSG_BUF_SIZE + 1];
+static uint8_t _rx_buf[TEST_LEN];
+
+static const struct sockaddr_in6 _dst = {
+    .sin6_family = AF_INET6,
+    .sin6_port = htons(TEST_PORT),
+    .sin6_addr = IN6ADDR_LOOPBACK_INIT,
+};
+
+static void _setup(void)
+{
+    struct sockaddr_in6 local = {
+        .sin6_family = AF_INET6,
+        .sin6_port = htons(TEST_PORT),
+        .sin6_addr = IN6ADDR_ANY_INIT,
+    };
+
+    _receiver = socket(AF_INET6, SOCK_DGRAM, IPPROTO_UDP);
+    expect(_receiver >= 0);
+    expect(bind(_receiver, (struct sockaddr *)&local, sizeof(local)) == 0);
+
+    local.sin6_port = htons(TEST_SENDER_PORT);
+    _sender = socket(AF_INET6, SOCK_DGRAM, IPPROTO_UDP);
+    expect(_sender >= 0);
+    expect(bind(_sender, (struct sockaddr *)&local, sizeof(local)) == 0);
+
+    for (unsigned i = 0; i < sizeof(_tx_buf); i++) {
+        _tx_buf[i] = i;
+    }
+}
+
+static ssize_t _sendmsg(size_t len)
+{
+    /* scatter the datagram over three buffers of different lengths */
+    struct iovec iov[] = {
+        { .iov_base = &_tx_buf[0], .iov_len = 1 },
+        { .iov_base = &_tx_buf[1], .iov_len = len / 2 },
+        { .iov_base = &_tx_buf[1 + (len / 2)], .iov_len = len - 1 - (len / 2) },
+    };
+    struct msghdr msg = {
+        .msg_name = (void *)&_dst,
+        .msg_namelen = sizeof(_dst),
+        .msg_iov = iov,
+        .msg_iovlen = 3,
+    };
+
+    return sendmsg(_sender, &msg, 0);
+}
+
+static void test_sendmsg_recvmsg(void)
+{
+    struct sockaddr_in6 src;
+    struct iovec iov[] = {
+        { .iov_base = &_rx_buf[0], .iov_len = 100 },
+        { .iov_base = &_rx_buf[100], .iov_len = TEST_LEN - 100 },
+    };
+    struct msghdr msg = {
+        .msg_name = &src,
+        .msg_namelen = sizeof(src),
+        .msg_iov = iov,
+        .msg_iovlen = 2,
+    };
+
+    /* longer than the former gather buffer of 128 bytes */
+    expect(_sendmsg(TEST_LEN) == TEST_LEN);
+    memset(_rx_buf, 0, sizeof(_rx_buf));
+    expect(recvmsg(_receiver, &msg, 0) == TEST_LEN);
+    expect(msg.msg_flags == 0);
+    expect(memcmp(_rx_buf, _tx_buf, TEST_LEN) == 0);
+    expect(msg.msg_namelen == sizeof(src));
+    expect(src.sin6_family == AF_INET6);
+    expect(ntohs(src.sin6_port) == TEST_SENDER_PORT);
+    puts("sendmsg/recvmsg: OK");
+}
+
+static void test_truncation(void)
+{
+    struct iovec iov = { .iov_base = _rx_buf, .iov_len = 10 };
+    struct msghdr msg = { .msg_iov = &iov, .msg_iovlen = 1 };
+
+    expect(_sendmsg(TEST_LEN) == TEST_LEN);
+    memset(_rx_buf, 0, sizeof(_rx_buf));
+    expect(recvmsg(_receiver, &msg, 0) == 10);
+    expect(msg.msg_flags & MSG_TRUNC);
+    expect(memcmp(_rx_buf, _tx_buf, 10) == 0);
+    puts("truncation: OK");
+}
+
+static void test_dontwait(void)
+{
+    struct iovec iov = { .iov_base = _rx_buf, .iov_len = sizeof(_rx_buf) };
+    struct msghdr msg = { .msg_iov = &iov, .msg_iovlen = 1 };
+
+    /* the truncated datagram was released completely */
+    errno = 0;
+    expect(recvmsg(_receiver, &msg, MSG_DONTWAIT) == -1);
+    expect(errno == EAGAIN);
+
+    expect(_sendmsg(20) == 20);
+    expect(recvmsg(_receiver, &msg, MSG_DONTWAIT) == 20);
+    expect(memcmp(_rx_buf, _tx_buf, 20) == 0);
+    puts("MSG_DONTWAIT: OK");
+}
+
+static void test_emsgsize(void)
+{
+    expect(_sendmsg(SOCKET_SENDMSG_BUF_SIZE + 1) == -1);
+    expect(errno == EMSGSIZE);
+    puts("EMSGSIZE: OK");
+}
+
+int main(void)
+{
+    _setup();
+
+    test_sendmsg_recvmsg();
+    test_truncation();
+    test_dontwait();
+    test_emsgsize();
+
+    puts("SUCCESS");
+    return 0;
+}
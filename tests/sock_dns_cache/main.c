@@ -0,0 +1,237 @@
+/*
+ * Copyright (C) 2021 Gunar Schorcht
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test of the caching and asynchronous sock DNS client
+ *
+ * The client queries a stand-in DNS server that is reached via the loopback
+ * address. The server counts the queries, so that it can be checked which
+ * lookups were answered from the cache.
+ *
+ * @author      Gunar Schorcht <gunar@schorcht.net>
+ * @}
+ */
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "event.h"
+#include "fmt.h"
+#include "net/ipv6/addr.h"
+#include "net/sock/dns.h"
+#include "thread.h"
+#include "ztimer.h"
+
+#include "test_utils/expect.h"
+
+#include "server.h"
+
+#define BENCH_NUMOF     (100U)
+#define WAITERS_NUMOF   (2U)
+
+static const uint8_t _dual6[] = { 0x20, 0x01, 0x0d, 0xb8, [15] = 0x01 };
+static const uint8_t _dual4[] = { 192, 0, 2, 1 };
+static const uint8_t _v4[] = { 192, 0, 2, 2 };
+static const uint8_t _slow[] = { 0x20, 0x01, 0x0d, 0xb8, [15] = 0x03 };
+static const uint8_t _async[] = { 0x20, 0x01, 0x0d, 0xb8, [15] = 0x04 };
+
+static char _stacks[WAITERS_NUMOF][THREAD_STACKSIZE_DEFAULT];
+static unsigned _waiters_done;
+
+static event_queue_t _queue;
+static sock_dns_async_t _query;
+static unsigned _async_done;
+
+static void _expect_query(const char *name, int family, int res,
+                          const uint8_t *addr, uint32_t queries)
+{
+    uint8_t addr_out[16];
+    uint32_t before = server_queries();
+
+    int tmp = sock_dns_query(name, addr_out, family);
+    if (tmp != res) {
+        printf("%s family %d: %d, expected %d\n", name, family, tmp, res);
+    }
+    expect(tmp == res);
+    if ((res > 0) && addr) {
+        expect(memcmp(addr_out, addr, res) == 0);
+    }
+    expect(server_queries() - before == queries);
+}
+
+static void _test_lookup(void)
+{
+    puts("Testing lookup ...");
+
+    /* AAAA and A are queried at the same time, AAAA is preferred */
+    _expect_query("dual.example", AF_UNSPEC, 16, _dual6, 2);
+    _expect_query("dual.example", AF_UNSPEC, 16, _dual6, 0);
+    _expect_query("DUAL.example", AF_INET6, 16, _dual6, 0);
+    _expect_query("dual.example", AF_INET, 4, _dual4, 1);
+    _expect_query("dual.example", AF_INET, 4, _dual4, 0);
+
+    /* the negative AAAA answer is cached as well */
+    _expect_query("v4.example", AF_UNSPEC, 4, _v4, 2);
+    _expect_query("v4.example", AF_UNSPEC, 4, _v4, 0);
+    _expect_query("v4.example", AF_INET6, -ENOENT, NULL, 0);
+
+    sock_dns_cache_flush();
+    _expect_query("dual.example", AF_INET6, 16, _dual6, 1);
+
+    /* names with the same hash are different entries */
+    _expect_query("costarring", AF_INET6, -ENOENT, NULL, 1);
+    _expect_query("liquid", AF_INET6, -ENOENT, NULL, 1);
+    _expect_query("LIQUID", AF_INET6, -ENOENT, NULL, 0);
+
+    puts("Done");
+}
+
+static void _test_negative(void)
+{
+    puts("Testing negative caching ...");
+
+    _expect_query("missing.example", AF_INET6, -ENOENT, NULL, 1);
+    _expect_query("missing.example", AF_INET6, -ENOENT, NULL, 0);
+    _expect_query("missing.example", AF_UNSPEC, -ENOENT, NULL, 2);
+    _expect_query("missing.example", AF_UNSPEC, -ENOENT, NULL, 0);
+    _expect_query("missing.example", AF_INET, -ENOENT, NULL, 0);
+
+    puts("Done");
+}
+
+static void _test_ttl(void)
+{
+    puts("Testing TTL ...");
+
+    _expect_query("short.example", AF_INET6, 16, NULL, 1);
+    _expect_query("short.example", AF_INET6, 16, NULL, 0);
+    ztimer_sleep(ZTIMER_MSEC, 1100);
+    _expect_query("short.example", AF_INET6, 16, NULL, 1);
+
+    puts("Done");
+}
+
+static void *_waiter(void *arg)
+{
+    (void)arg;
+    uint8_t addr[16];
+
+    expect(sock_dns_query("slow.example", addr, AF_INET6) == 16);
+    expect(memcmp(addr, _slow, sizeof(addr)) == 0);
+    _waiters_done++;
+
+    return NULL;
+}
+
+static void _test_coalescing(void)
+{
+    puts("Testing coalescing ...");
+
+    /* the waiters have a lower priority, they run while main waits for the
+     * reply of the server */
+    for (unsigned i = 0; i < WAITERS_NUMOF; i++) {
+        thread_create(_stacks[i], sizeof(_stacks[i]), THREAD_PRIORITY_MAIN + 1,
+                      THREAD_CREATE_STACKTEST, _waiter, NULL, "waiter");
+    }
+    _expect_query("slow.example", AF_INET6, 16, _slow, 1);
+    while (_waiters_done < WAITERS_NUMOF) {
+        ztimer_sleep(ZTIMER_MSEC, 10);
+    }
+
+    puts("Done");
+}
+
+static void _async_handler(event_t *event)
+{
+    sock_dns_async_t *query = container_of(event, sock_dns_async_t, super);
+
+    expect(query == &_query);
+    expect(query->res == 16);
+    expect(memcmp(query->addr, _async, sizeof(_async)) == 0);
+    _async_done++;
+}
+
+static void _test_async(void)
+{
+    puts("Testing async ...");
+
+    uint32_t before = server_queries();
+    expect(sock_dns_query_async(&_query, "async.example", AF_INET6, &_queue,
+                                _async_handler) == 0);
+    event_t *event = event_wait(&_queue);
+    event->handler(event);
+    expect(_async_done == 1);
+    expect(server_queries() - before == 1);
+
+    /* cached results are posted at once */
+    expect(sock_dns_query_async(&_query, "async.example", AF_INET6, &_queue,
+                                _async_handler) == 0);
+    event = event_get(&_queue);
+    expect(event == &_query.super);
+    event->handler(event);
+    expect(_async_done == 2);
+    expect(server_queries() - before == 1);
+
+    puts("Done");
+}
+
+static void _test_benchmark(void)
+{
+    uint8_t addr[16];
+    uint32_t uncached = 0;
+    uint32_t cached = 0;
+
+    puts("Testing latency ...");
+
+    for (unsigned i = 0; i < BENCH_NUMOF; i++) {
+        sock_dns_cache_flush();
+        uint32_t start = ztimer_now(ZTIMER_USEC);
+        expect(sock_dns_query("dual.example", addr, AF_INET6) == 16);
+        uncached += ztimer_now(ZTIMER_USEC) - start;
+
+        start = ztimer_now(ZTIMER_USEC);
+        expect(sock_dns_query("dual.example", addr, AF_INET6) == 16);
+        cached += ztimer_now(ZTIMER_USEC) - start;
+    }
+    expect(cached < uncached);
+
+    puts("Done");
+
+    print_str("uncached: ");
+    print_u32_dec(uncached / BENCH_NUMOF);
+    print_str(" us, cached: ");
+    print_u32_dec(cached / BENCH_NUMOF);
+    print_str(" us\n");
+}
+
+int main(void)
+{
+    event_queue_init(&_queue);
+
+    server_start();
+
+    ipv6_addr_set_loopback((ipv6_addr_t *)sock_dns_server.addr.ipv6);
+    sock_dns_server.family = AF_INET6;
+    sock_dns_server.port = SERVER_PORT;
+
+    _test_lookup();
+    _test_negative();
+    _test_ttl();
+    _test_coalescing();
+    _test_async();
+    _test_benchmark();
+
+    puts("SUCCESS");
+    return 0;
+}
@@ -0,0 +1,215 @@
+/*
+ * Copyright (C) 2021 Gunar Schorcht
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @brief       Stand-in DNS server for the sock DNS client test
+ *
+ * The server answers queries with one question from a fixed table. Unknown
+ * names are answered with NXDOMAIN, known names without a record of the
+ * requested type with an empty answer. Both negative answers contain an SOA
+ * record.
+ *
+ * @author      Gunar Schorcht <gunar@schorcht.net>
+ * @}
+ */
+
+#include <arpa/inet.h>
+#include <string.h>
+#include <strings.h>
+
+#include "kernel_defines.h"
+#include "net/dns.h"
+#include "net/sock/dns.h"
+#include "net/sock/udp.h"
+#include "thread.h"
+#include "ztimer.h"
+
+#include "test_utils/expect.h"
+
+#include "server.h"
+
+#define SOA_TTL         (600U)
+#define SOA_MINIMUM     (300U)
+
+typedef struct {
+    const char *name;
+    uint16_t type;
+    uint32_t ttl;
+    uint8_t addr[16];
+} record_t;
+
+static const record_t _records[] = {
+    { "dual.example", DNS_TYPE_AAAA, 300,
+      { 0x20, 0x01, 0x0d, 0xb8, [15] = 0x01 } },
+    { "dual.example", DNS_TYPE_A, 300, { 192, 0, 2, 1 } },
+    { "v4.example", DNS_TYPE_A, 300, { 192, 0, 2, 2 } },
+    { "short.example", DNS_TYPE_AAAA, 1,
+      { 0x20, 0x01, 0x0d, 0xb8, [15] = 0x02 } },
+    { "slow.example", DNS_TYPE_AAAA, 300,
+      { 0x20, 0x01, 0x0d, 0xb8, [15] = 0x03 } },
+    { "async.example", DNS_TYPE_AAAA, 300,
+      { 0x20, 0x01, 0x0d, 0xb8, [15] = 0x04 } },
+};
+
+static char _stack[THREAD_STACKSIZE_DEFAULT];
+static uint8_t _buf[SOCK_DNS_BUF_LEN];
+static uint32_t _queries;
+
+static size_t _put_short(uint8_t *out, uint16_t val)
+{
+    val = htons(val);
+    memcpy(out, &val, sizeof(val));
+    return sizeof(val);
+}
+
+static size_t _put_long(uint8_t *out, uint32_t val)
+{
+    val = htonl(val);
+    memcpy(out, &val, sizeof(val));
+    return sizeof(val);
+}
+
+/* decodes the name of the question, returns the length of the question */
+static size_t _get_question(const uint8_t *buf, size_t len, char *name,
+                            uint16_t *type)
+{
+    const uint8_t *pos = buf + sizeof(sock_dns_hdr_t);
+    char *out = name;
+
+    while (*pos) {
+        expect(pos + *pos + 1 < buf + len);
+        if (out != name) {
+            *out++ = '.';
+        }
+        memcpy(out, pos + 1, *pos);
+        out += *pos;
+        pos += *pos + 1;
+    }
+    *out = '\0';
+    pos++;
+
+    uint16_t tmp;
+    memcpy(&tmp, pos, sizeof(tmp));
+    *type = ntohs(tmp);
+    pos += RR_TYPE_LENGTH + RR_CLASS_LENGTH;
+
+    return pos - (buf + sizeof(sock_dns_hdr_t));
+}
+
+static size_t _put_soa(uint8_t *pos)
+{
+    uint8_t *start = pos;
+
+    /* the root zone, no real server would use it */
+    *pos++ = 0;
+    pos += _put_short(pos, DNS_TYPE_SOA);
+    pos += _put_short(pos, DNS_CLASS_IN);
+    pos += _put_long(pos, SOA_TTL);
+    pos += _put_short(pos, 22);
+    *pos++ = 0;                         /* MNAME */
+    *pos++ = 0;                         /* RNAME */
+    pos += _put_long(pos, 1);           /* SERIAL */
+    pos += _put_long(pos, 3600);        /* REFRESH */
+    pos += _put_long(pos, 600);         /* RETRY */
+    pos += _put_long(pos, 86400);       /* EXPIRE */
+    pos += _put_long(pos, SOA_MINIMUM); /* MINIMUM */
+
+    return pos - start;
+}
+
+static size_t _reply(uint8_t *buf, size_t len, uint32_t *delay)
+{
+    sock_dns_hdr_t *hdr = (sock_dns_hdr_t *)buf;
+    char name[SOCK_DNS_MAX_NAME_LEN + 1];
+    uint16_t type;
+    bool known = false;
+
+    expect(ntohs(hdr->qdcount) == 1);
+    size_t qlen = _get_question(buf, len, name, &type);
+    uint8_t *pos = buf + sizeof(*hdr) + qlen;
+
+    *delay = (strcasecmp(name, "slow.example") == 0) ? SERVER_SLOW_DELAY
+                                                     : SERVER_DELAY;
+
+    hdr->flags = htons(0x8180);
+    hdr->ancount = 0;
+    hdr->nscount = 0;
+    hdr->arcount = 0;
+
+    for (unsigned i = 0; i < ARRAY_SIZE(_records); i++) {
+        const record_t *rec = &_records[i];
+        if (strcasecmp(name, rec->name) != 0) {
+            continue;
+        }
+        known = true;
+        if (rec->type != type) {
+            continue;
+        }
+        uint16_t addrlen = (type == DNS_TYPE_A) ? 4 : 16;
+        /* pointer to the name of the question */
+        pos += _put_short(pos, 0xc000 | sizeof(*hdr));
+        pos += _put_short(pos, type);
+        pos += _put_short(pos, DNS_CLASS_IN);
+        pos += _put_long(pos, rec->ttl);
+        pos += _put_short(pos, addrlen);
+        memcpy(pos, rec->addr, addrlen);
+        pos += addrlen;
+        hdr->ancount = htons(1);
+        return pos - buf;
+    }
+
+    if (!known) {
+        hdr->flags = htons(0x8183);     /* NXDOMAIN */
+    }
+    pos += _put_soa(pos);
+    hdr->nscount = htons(1);
+
+    return pos - buf;
+}
+
+static void *_server(void *arg)
+{
+    (void)arg;
+
+    sock_udp_ep_t local = SOCK_IPV6_EP_ANY;
+    sock_udp_t sock;
+
+    local.port = SERVER_PORT;
+    expect(sock_udp_create(&sock, &local, NULL, 0) == 0);
+
+    while (1) {
+        sock_udp_ep_t remote;
+        uint32_t delay;
+
+        ssize_t res = sock_udp_recv(&sock, _buf, sizeof(_buf),
+                                    SOCK_NO_TIMEOUT, &remote);
+        if (res < (ssize_t)sizeof(sock_dns_hdr_t)) {
+            continue;
+        }
+        _queries++;
+        size_t len = _reply(_buf, res, &delay);
+        ztimer_sleep(ZTIMER_MSEC, delay);
+        sock_udp_send(&sock, _buf, len, &remote);
+    }
+
+    return NULL;
+}
+
+void server_start(void)
+{
+    thread_create(_stack, sizeof(_stack), THREAD_PRIORITY_MAIN - 2,
+                  THREAD_CREATE_STACKTEST, _server, NULL, "dns server");
+}
+
+uint32_t server_queries(void)
+{
+    return _queries;
+}
@@ -0,0 +1,56 @@
+/*
+ * Copyright (C) 2021 Gunar Schorcht
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @brief       Stand-in DNS server for the sock DNS client test
+ *
+ * @author      Gunar Schorcht <gunar@schorcht.net>
+ */
+#ifndef SERVER_H
+#define SERVER_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   UDP port of the server
+ */
+#define SERVER_PORT         (5353)
+
+/**
+ * @brief   Delay of all replies in ms
+ */
+#define SERVER_DELAY        (10U)
+
+/**
+ * @brief   Delay of the replies for "slow.example" in ms
+ */
+#define SERVER_SLOW_DELAY   (200U)
+
+/**
+ * @brief   Start the server thread
+ */
+void server_start(void);
+
+/**
+ * @brief   Number of queries received by the server
+ */
+uint32_t server_queries(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SERVER_H */
+/** @} */
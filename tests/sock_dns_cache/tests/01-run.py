@@ -0,0 +1,23 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2021 Gunar Schorcht
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    for test in ("lookup", "negative caching", "TTL", "coalescing", "async",
+                 "latency"):
+        child.expect_exact("Testing {} ...".format(test))
+        child.expect_exact("Done")
+    child.expect(r"uncached: \d+ us, cached: \d+ us")
+    child.expect_exact("SUCCESS")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc, timeout=30))